@@ -53,26 +53,15 @@ static void vTickTask( void *pvParameters )
 	}
 }
 
-extern xQueueHandle xRxedChars;
-
-
 /*
- *   This task will wake when a character is received on uart1.
- *   It will parse a line into the several tokens (separated by a space).
+ *   This task will wake when a line is received on uart1.
+ *   It will print the line and its tokens (separated by a space).
  */
 static void vParseTask( void *pvParameters )
 {
 	char  buffer[20];
-	int   buffer_position;
-	int   token[5] = {0,0,0,0,0};
-	int   current_token;
-	
-	int i, j;
-	
-	/* Used to wake the task at the correct frequency. */
-	portTickType xLastExecutionTime; 
-	
-	char tmp;
+	int   length;
+	int   i;
 
 	uart1_puts("Parse task initializing...");
 
@@ -80,51 +69,23 @@ static void vParseTask( void *pvParameters )
 	
 	for( ;; )
 	{
-		/* Wait until it is time for the next cycle. */
-		if( xQueueReceive( xRxedChars, &tmp, portMAX_DELAY  ) )
-        {
-            // pcRxedMessage now points to the struct AMessage variable posted
-            // by vATask.
-            //uart1_putc('(');
-            //uart1_putc(tmp);
-            //uart1_putc(')');
-            
-            if (tmp == '\n' || tmp == '\r')
-            {
-	            buffer[buffer_position] = '\0';
-	            token[current_token + 1] = buffer_position;
-	            uart1_putc('{');
-		        uart1_puts(buffer);
-			    uart1_puts("}\n\r");
-	            for (i = 0; i <= current_token && i < 5; i++)
-	            {
-		        	j = 0;
-		        	uart1_putc('[');
-		        	while (token[i]+j < token[i+1])
-		        	{
-		        		uart1_putc(buffer[token[i] + j++]);
-		        	}	
-		        	uart1_puts("]\n\r");
-		        } 
-            	buffer_position = 0;
-            	current_token = 0;
-            	token[0] = 0;
-            	token[1] = 0;
-            	token[2] = 0;
-            	token[3] = 0;
-            	token[4] = 0;
-            	if (tmp == '\r')
-            		uart1_puts("\n\r> ");
-            }
-            else if (tmp == ' ' && current_token < 5)
-            {
-	            //buffer[buffer_position++] = tmp;
-	            token[++current_token] = buffer_position;
-	            
-	        } 
-	        else if (buffer_position < 20)
-	        	buffer[buffer_position++] = tmp;
-        }
+		length = uart1_getline(buffer, sizeof(buffer));
+		if (length < 0)
+		{
+			uart1_puts("line too long\n\r> ");
+			continue;
+		}
+		uart1_putc('{');
+		uart1_puts(buffer);
+		uart1_puts("}\n\r[");
+		for (i = 0; i < length; i++)
+		{
+			if (buffer[i] == ' ')
+				uart1_puts("]\n\r[");
+			else
+				uart1_putc(buffer[i]);
+		}
+		uart1_puts("]\n\r> ");
 	}
 }
 
@@ -99,6 +99,10 @@
 	#include "FreeRTOS\portmacro.h"
 #endif
 
+#ifdef GCC_POSIX_PORT
+	#include "FreeRTOS/posix/portmacro.h"
+#endif
+
 #ifdef MPLAB_PIC18F_PORT
 	#include "..\..\Source\portable\MPLAB\PIC18F\portmacro.h"
 #endif
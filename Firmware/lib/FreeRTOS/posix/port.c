@@ -0,0 +1,190 @@
+/*
+	Port of FreeRTOS to POSIX hosts (Linux, Mac OS X) used by the gluonpilot
+	software-in-the-loop build (Firmware/sitl).
+
+	See portmacro.h for a description of how this port works.
+*/
+
+/*-----------------------------------------------------------
+ * Implementation of functions defined in portable.h for the POSIX port.
+ *----------------------------------------------------------*/
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+/* Scheduler include files. */
+#include "FreeRTOS/FreeRTOS.h"
+#include "FreeRTOS/task.h"
+
+/* Native stack size of the thread behind each task.  The FreeRTOS stack of
+the task is only used to store a reference to this thread. */
+#define portTHREAD_STACK_SIZE	( 256 * 1024 )
+
+/* The thread that backs a task. */
+typedef struct xTHREAD_RECORD
+{
+	pthread_t xThread;
+	pthread_cond_t xResume;		/*< Signalled when the thread is allowed to run. */
+	pdTASK_CODE pxCode;
+	void *pvParameters;
+	int iDeleted;
+} xThreadRecord;
+
+/* The TCB is private to tasks.c, but its first member is the top of stack. */
+extern void * volatile pxCurrentTCB;
+#define prvThreadOfTCB( pxTCB )	( ( xThreadRecord * ) **( ( portSTACK_TYPE ** ) ( pxTCB ) ) )
+
+/* Protects pxRunningThread and all the condition variables. */
+static pthread_mutex_t xRunMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t xSchedulerEnded = PTHREAD_COND_INITIALIZER;
+
+/* The only thread that may execute task code. */
+static xThreadRecord *pxRunningThread = NULL;
+static int iSchedulerEnded = pdFALSE;
+
+/*
+ * Blocks the calling thread until it is scheduled again.  Must be called with
+ * xRunMutex held.  Never returns for a deleted task.
+ */
+static void prvWaitForTurn( xThreadRecord *pxThread );
+
+/*
+ * Entry point of every task thread.
+ */
+static void *prvThreadEntry( void *pvThread );
+/*-----------------------------------------------------------*/
+
+portSTACK_TYPE *pxPortInitialiseStack( portSTACK_TYPE *pxTopOfStack, pdTASK_CODE pxCode, void *pvParameters )
+{
+xThreadRecord *pxThread;
+pthread_attr_t xAttributes;
+
+	pxThread = ( xThreadRecord * ) malloc( sizeof( xThreadRecord ) );
+	if( pxThread == NULL )
+	{
+		fprintf( stderr, "pxPortInitialiseStack: out of memory\n" );
+		abort();
+	}
+
+	pxThread->pxCode = pxCode;
+	pxThread->pvParameters = pvParameters;
+	pxThread->iDeleted = pdFALSE;
+	pthread_cond_init( &( pxThread->xResume ), NULL );
+
+	pthread_attr_init( &xAttributes );
+	pthread_attr_setdetachstate( &xAttributes, PTHREAD_CREATE_DETACHED );
+	pthread_attr_setstacksize( &xAttributes, portTHREAD_STACK_SIZE );
+	if( pthread_create( &( pxThread->xThread ), &xAttributes, prvThreadEntry, pxThread ) != 0 )
+	{
+		fprintf( stderr, "pxPortInitialiseStack: unable to create a thread\n" );
+		abort();
+	}
+	pthread_attr_destroy( &xAttributes );
+
+	*pxTopOfStack = ( portSTACK_TYPE ) pxThread;
+
+	return pxTopOfStack;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xPortStartScheduler( void )
+{
+	pthread_mutex_lock( &xRunMutex );
+
+	/* Hand the baton to the first task, then sleep until a task calls
+	vTaskEndScheduler(). */
+	pxRunningThread = prvThreadOfTCB( pxCurrentTCB );
+	pthread_cond_signal( &( pxRunningThread->xResume ) );
+
+	while( iSchedulerEnded == pdFALSE )
+	{
+		pthread_cond_wait( &xSchedulerEnded, &xRunMutex );
+	}
+
+	pthread_mutex_unlock( &xRunMutex );
+
+	return pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+	pthread_mutex_lock( &xRunMutex );
+	iSchedulerEnded = pdTRUE;
+	pxRunningThread = NULL;
+	pthread_cond_signal( &xSchedulerEnded );
+	pthread_mutex_unlock( &xRunMutex );
+
+	/* The thread of the calling task is parked here for good: main() returns
+	from vTaskStartScheduler() and ends the process. */
+	pthread_exit( NULL );
+}
+/*-----------------------------------------------------------*/
+
+void vPortYield( void )
+{
+xThreadRecord *pxThisThread = pxRunningThread;
+xThreadRecord *pxNextThread;
+
+	vTaskSwitchContext();
+
+	pxNextThread = prvThreadOfTCB( pxCurrentTCB );
+	if( pxNextThread == pxThisThread )
+	{
+		return;
+	}
+
+	pthread_mutex_lock( &xRunMutex );
+	pxRunningThread = pxNextThread;
+	pthread_cond_signal( &( pxNextThread->xResume ) );
+	prvWaitForTurn( pxThisThread );
+	pthread_mutex_unlock( &xRunMutex );
+}
+/*-----------------------------------------------------------*/
+
+void vPortCleanUpTCB( void *pxTCB )
+{
+xThreadRecord *pxThread = prvThreadOfTCB( pxTCB );
+
+	/* Called from the idle task before the TCB is freed: wake the thread of
+	the deleted task so it can terminate. */
+	pthread_mutex_lock( &xRunMutex );
+	pxThread->iDeleted = pdTRUE;
+	pthread_cond_signal( &( pxThread->xResume ) );
+	pthread_mutex_unlock( &xRunMutex );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitForTurn( xThreadRecord *pxThread )
+{
+	while( pxRunningThread != pxThread )
+	{
+		if( pxThread->iDeleted != pdFALSE )
+		{
+			pthread_mutex_unlock( &xRunMutex );
+			pthread_cond_destroy( &( pxThread->xResume ) );
+			free( pxThread );
+			pthread_exit( NULL );
+		}
+		pthread_cond_wait( &( pxThread->xResume ), &xRunMutex );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void *prvThreadEntry( void *pvThread )
+{
+xThreadRecord *pxThread = ( xThreadRecord * ) pvThread;
+
+	pthread_mutex_lock( &xRunMutex );
+	prvWaitForTurn( pxThread );
+	pthread_mutex_unlock( &xRunMutex );
+
+	pxThread->pxCode( pxThread->pvParameters );
+
+	/* Tasks should never return. */
+	vTaskDelete( NULL );
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
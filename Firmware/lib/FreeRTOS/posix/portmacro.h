@@ -0,0 +1,84 @@
+/*
+	Port of FreeRTOS to POSIX hosts (Linux, Mac OS X) used by the gluonpilot
+	software-in-the-loop build (Firmware/sitl).
+
+	Every task is backed by a POSIX thread, but only one of these threads is
+	allowed to run at any time: the scheduler hands a baton from thread to
+	thread on each context switch.  There is no timer interrupt; the tick is
+	generated by the application (see vApplicationIdleHook() in sitl_main.c)
+	so simulated time only advances when all tasks are blocked.  This makes a
+	simulation deterministic and lets it run much faster than real-time.
+*/
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*-----------------------------------------------------------
+ * Port specific definitions.
+ *
+ * The settings in this file configure FreeRTOS correctly for the
+ * given hardware and compiler.
+ *
+ * These settings should not be altered.
+ *-----------------------------------------------------------
+ */
+
+/* Type definitions.  The stack type has to be able to hold a pointer: the
+port keeps a reference to the thread of a task on top of its stack. */
+#define portCHAR		char
+#define portFLOAT		float
+#define portDOUBLE		double
+#define portLONG		long
+#define portSHORT		short
+#define portSTACK_TYPE	unsigned long
+#define portBASE_TYPE	long
+
+#if( configUSE_16_BIT_TICKS == 1 )
+	typedef unsigned portSHORT portTickType;
+	#define portMAX_DELAY ( portTickType ) 0xffff
+#else
+	typedef unsigned int portTickType;
+	#define portMAX_DELAY ( portTickType ) 0xffffffff
+#endif
+/*-----------------------------------------------------------*/
+
+/* Architecture specifics. */
+#define portBYTE_ALIGNMENT			8
+#define portSTACK_GROWTH			( -1 )
+#define portTICK_RATE_MS			( ( portTickType ) 1000 / configTICK_RATE_HZ )
+/*-----------------------------------------------------------*/
+
+/* Critical section management.  Simulated interrupts are only raised from
+the idle hook, so they can never preempt a task: disabling them is a no-op. */
+#define portDISABLE_INTERRUPTS()
+#define portENABLE_INTERRUPTS()
+#define portENTER_CRITICAL()
+#define portEXIT_CRITICAL()
+/*-----------------------------------------------------------*/
+
+/* Task utilities. */
+extern void vPortYield( void );
+#define portYIELD()					vPortYield()
+#define portEND_SWITCHING_ISR( xSwitchRequired ) if( xSwitchRequired ) vPortYield()
+
+/* Lets the thread of a deleted task terminate. */
+extern void vPortCleanUpTCB( void *pxTCB );
+#define portCLEAN_UP_TCB( pxTCB )	vPortCleanUpTCB( pxTCB )
+/*-----------------------------------------------------------*/
+
+/* Task function macros as described on the FreeRTOS.org WEB site. */
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
+/*-----------------------------------------------------------*/
+
+#define portNOP()
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PORTMACRO_H */
@@ -0,0 +1,170 @@
+/*!
+ *  Implements the command table of cmdtable.h.
+ *
+ *  The table is hashed with open addressing: a command goes in the first
+ *  free slot from the hash of its code on, and a lookup stops at the first
+ *  free slot.
+ *
+ *  @file     cmdtable.c
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include "numfmt/numfmt.h"
+
+#include "cmdtable.h"
+
+// 50 spreads the codes of communication_csv.c with at most 2 probes
+#define HASH(c1, c2)  (((unsigned int)(c1) * 50 + (unsigned int)(c2)) & (CMDTABLE_SLOTS - 1))
+
+
+static int valid_schema(const char *fields)
+{
+	int n;
+
+	for (n = 0; fields[n] != '\0'; n++)
+		if (n >= CMDTABLE_MAX_FIELDS ||
+		    (fields[n] != 'i' && fields[n] != 'l' && fields[n] != 'f' && fields[n] != 'c'))
+			return 0;
+	return 1;
+}
+
+
+static void clear(struct CommandTable *t)
+{
+	int s;
+
+	t->count = 0;
+	for (s = 0; s < CMDTABLE_SLOTS; s++)
+		t->slot[s] = 0;
+}
+
+
+/*!
+ *   @return The most probes a lookup of one of the commands takes, 0 when a
+ *           command has a bad code or schema, is there twice or doesn't fit:
+ *           the table is empty then
+ */
+int cmdtable_init(struct CommandTable *t, const struct Command *commands, int count)
+{
+	int i, s, probes, most = 0;
+
+	t->commands = commands;
+	clear(t);
+	if (count >= CMDTABLE_SLOTS)
+		return 0;
+
+	for (i = 0; i < count; i++)
+	{
+		if (commands[i].code[0] == '\0' || commands[i].code[1] == '\0' || ! valid_schema(commands[i].fields) ||
+		    cmdtable_find(t, commands[i].code[0], commands[i].code[1]) != 0)
+		{
+			clear(t);
+			return 0;
+		}
+		s = HASH(commands[i].code[0], commands[i].code[1]);
+		for (probes = 1; t->slot[s] != 0; probes++)
+			s = (s + 1) & (CMDTABLE_SLOTS - 1);
+		t->slot[s] = (unsigned char)(i + 1);
+		t->count = i + 1;
+		if (probes > most)
+			most = probes;
+	}
+	return most;
+}
+
+
+/*!
+ *   @return The command with code c1c2, 0 when there isn't one
+ */
+const struct Command *cmdtable_find(const struct CommandTable *t, char c1, char c2)
+{
+	const struct Command *command;
+	int s = HASH(c1, c2);
+
+	while (t->slot[s] != 0)
+	{
+		command = &t->commands[t->slot[s] - 1];
+		if (command->code[0] == c1 && command->code[1] == c2)
+			return command;
+		s = (s + 1) & (CMDTABLE_SLOTS - 1);
+	}
+	return 0;
+}
+
+
+/*!
+ *   Finds the fields of a line: token[i] becomes the position after the i-th
+ *   ';' or '*', the unused ones 0. token[0] is 0: the code.
+ *   @param token CMDTABLE_MAX_TOKEN + 1 positions
+ *   @return The number of separators, CMDTABLE_MAX_TOKEN + 1 when there are
+ *           too many
+ */
+int cmdtable_tokenize(const char *line, int length, int *token)
+{
+	int i, tokens = 0;
+
+	for (i = 0; i <= CMDTABLE_MAX_TOKEN; i++)
+		token[i] = 0;
+	for (i = 0; i < length; i++)
+	{
+		if (line[i] != ';' && line[i] != '*')
+			continue;
+		if (tokens >= CMDTABLE_MAX_TOKEN)
+			return CMDTABLE_MAX_TOKEN + 1;
+		token[++tokens] = i + 1;
+	}
+	return tokens;
+}
+
+
+/*!
+ *   Parses the fields of a tokenized line with the schema of the command.
+ *   The numbers end at the next separator: numfmt stops at the ';'.
+ *   @return The number of fields that were in the line
+ */
+int cmdtable_parse(const struct Command *command, const char *line, const int *token, int tokens,
+                   union CommandField *field)
+{
+	const char *text;
+	int n;
+
+	for (n = 0; command->fields[n] != '\0'; n++)
+	{
+		text = n < tokens ? &line[token[n + 1]] : "";
+		switch (command->fields[n])
+		{
+			case 'i':
+				field[n].i = (int)numfmt_parse_long(text);
+				break;
+			case 'l':
+				field[n].l = numfmt_parse_long(text);
+				break;
+			case 'f':
+				field[n].f = numfmt_parse_float(text);
+				break;
+			default:
+				field[n].c = *text;
+				break;
+		}
+	}
+	return n < tokens ? n : tokens;
+}
+
+
+/*!
+ *   Calls the handler of the command of a tokenized line (its first 2
+ *   characters) with its fields.
+ *   @return 0 when the command is unknown
+ */
+int cmdtable_dispatch(const struct CommandTable *t, const char *line, const int *token, int tokens)
+{
+	union CommandField field[CMDTABLE_MAX_FIELDS];
+	const struct Command *command = cmdtable_find(t, line[0], line[1]);
+
+	if (command == 0)
+		return 0;
+	cmdtable_parse(command, line, token, tokens, field);
+	command->handler(field);
+	return 1;
+}
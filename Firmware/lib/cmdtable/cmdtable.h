@@ -0,0 +1,64 @@
+#ifndef CMDTABLE_H
+#define CMDTABLE_H
+
+/*!
+ *  Table driven dispatching of the 2 letter commands of the CSV protocol.
+ *
+ *  A command is registered with its code ("PP"), the schema of its fields
+ *  and a handler. The schema has a letter per field, in the order of the
+ *  line:
+ *
+ *    i  int      numfmt_parse_long(), cast to int
+ *    l  long     numfmt_parse_long()
+ *    f  float    numfmt_parse_float()
+ *    c  char     the first character of the field
+ *
+ *  so "PP;1.5;0.1;0;-1;1;0" with schema "ffffff" calls the handler with
+ *  field[0].f = 1.5 ... field[5].f = 0. A field that is missing from the
+ *  line is 0 ('\0' for a c). The handlers don't touch the line.
+ *
+ *  cmdtable_init() hashes the codes into CMDTABLE_SLOTS slots, so finding a
+ *  command costs the same with 10 or 60 commands: a multiplication, and a
+ *  compare per probe: 2 at most for the commands of communication_csv.c,
+ *  which sitl/cmdtable_check.c checks.
+ *
+ *  @file     cmdtable.h
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#define CMDTABLE_MAX_TOKEN   10     //!< Separators in a line
+#define CMDTABLE_MAX_FIELDS  CMDTABLE_MAX_TOKEN
+#define CMDTABLE_SLOTS       64     //!< Power of 2, at most 255 commands
+
+//! The value of a field, the member of its schema letter
+union CommandField
+{
+	int i;
+	long l;
+	float f;
+	char c;
+};
+
+struct Command
+{
+	char code[3];                                       //!< 2 letters and the '\0'
+	const char *fields;                                 //!< Schema, see above
+	void (*handler)(const union CommandField *field);
+};
+
+struct CommandTable
+{
+	const struct Command *commands;
+	int count;
+	unsigned char slot[CMDTABLE_SLOTS];   //!< Index of the command + 1, 0 when free
+};
+
+int  cmdtable_init(struct CommandTable *t, const struct Command *commands, int count);
+const struct Command *cmdtable_find(const struct CommandTable *t, char c1, char c2);
+int  cmdtable_tokenize(const char *line, int length, int *token);
+int  cmdtable_parse(const struct Command *command, const char *line, const int *token, int tokens,
+                    union CommandField *field);
+int  cmdtable_dispatch(const struct CommandTable *t, const char *line, const int *token, int tokens);
+
+#endif // CMDTABLE_H
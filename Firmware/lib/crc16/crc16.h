@@ -0,0 +1,24 @@
+#ifndef CRC16_H
+#define CRC16_H
+
+/*!
+ *  CRC-16/CCITT-FALSE (polynomial 0x1021, initial value 0xFFFF) of binary
+ *  frames sent to the ground station. The check value of "123456789" is
+ *  0x29B1.
+ *
+ *  A crc over several pieces is computed by passing the result of one call
+ *  as "crc" of the next:
+ *
+ *    crc = crc16_update(CRC16_INIT, header, 4);
+ *    crc = crc16_update(crc, data, length);
+ *
+ *  @file     crc16.h
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#define CRC16_INIT  0xFFFF
+
+unsigned int crc16_update(unsigned int crc, const unsigned char *data, int length);
+
+#endif // CRC16_H
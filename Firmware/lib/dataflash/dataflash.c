@@ -33,11 +33,16 @@ unsigned char gp1_spi_comm_hw(unsigned char outgoing_byte);
 
 
 void gp1_dataflash_write_raw(int page, int size, unsigned char *buffer);
-void gp1_dataflash_read_raw(int page, int size, unsigned char *buffer);
+void gp1_dataflash_read_array(int page, int offset, int size, unsigned char *buffer);
+void gp1_dataflash_erase_block(int page);
+void gp1_dataflash_erase_sector(int page);
 int gp1_dataflash_read_Mbit();
 void gp1_dataflash_write(int page, int size, unsigned char *buffer);
 void gp1_dataflash_open();
 void gp1_dataflash_read(int page, int size, unsigned char *buffer);
+void gp1_dataflash_write_buffer(int buffer_nr, int size, unsigned char *buffer);
+void gp1_dataflash_program_buffer(int buffer_nr, int page);
+int gp1_dataflash_is_ready();
  
 #define v1o_CS   PORTFbits.RF0 //CSB
 
@@ -45,7 +50,8 @@ void gp1_dataflash_read(int page, int size, unsigned char *buffer);
 
 
 /****************** NEW v1q and newer modules! *******************/
-// Let's use the hardware module!
+// No hardware module: the dataflash (and the OSD) have MOSI on RF7 and MISO on
+// RF8, while the SPI1 module has them the other way around (SDI1 = RF7, SDO1 = RF8).
 //#define gp2_spi_comm(x) gp2_spi_comm_hw(x)
 #define gp2_spi_comm(x) gp2_spi_comm_bitbang(x)
 
@@ -59,11 +65,16 @@ unsigned char gp2_spi_comm_hw(unsigned char outgoing_byte);
 
 
 void gp2_dataflash_write_raw(int page, int size, unsigned char *buffer);
-void gp2_dataflash_read_raw(int page, int size, unsigned char *buffer);
+void gp2_dataflash_read_array(int page, int offset, int size, unsigned char *buffer);
+void gp2_dataflash_erase_block(int page);
+void gp2_dataflash_erase_sector(int page);
 int gp2_dataflash_read_Mbit();
 void gp2_dataflash_write(int page, int size, unsigned char *buffer);
 void gp2_dataflash_open();
 void gp2_dataflash_read(int page, int size, unsigned char *buffer);
+void gp2_dataflash_write_buffer(int buffer_nr, int size, unsigned char *buffer);
+void gp2_dataflash_program_buffer(int buffer_nr, int page);
+int gp2_dataflash_is_ready();
 
 #define v1o_CS   PORTFbits.RF0 //CSB
 
@@ -79,10 +90,42 @@ int START_LOG_PAGE = 5;
 int	LOG_INDEX_PAGE = 4;
 int	CONFIGURATION_PAGE = 0;
 int	NAVIGATION_PAGE = 2;
+int	LOG_JOURNAL_PAGE = 4080;  // the last 16 pages, see task_datalogger.c
 
 #define STATUS_RDY 0b10000000
 
 
+/*!
+ *   The 3 address bytes of a command, for a byte in a page:
+ *     528 bytes page size: xxPPPPPP | PPPPPPBB | BBBBBBBB
+ *     264 bytes page size: xxxPPPPP | PPPPPPPB | BBBBBBBB
+ */
+static void dataflash_address(int page, int offset, unsigned char *address)
+{
+	unsigned long a = PAGE_SIZE == 528 ? ((unsigned long)page << 10) : ((unsigned long)page << 9);
+
+	a |= offset;
+	address[0] = (a >> 16) & 0xFF;
+	address[1] = (a >> 8) & 0xFF;
+	address[2] = a & 0xFF;
+}
+
+
+/*!
+ *   The page that selects the sector of a page in a sector erase command:
+ *   sector 0 is split in 0a (pages 0...7) and 0b (8...255), told apart by page
+ *   bit 3 alone.
+ */
+static int dataflash_sector_page(int page)
+{
+	if (page < DATAFLASH_BLOCK_PAGES)
+		return 0;
+	if (page < DATAFLASH_SECTOR_PAGES)
+		return DATAFLASH_BLOCK_PAGES;
+	return page;
+}
+
+
 /**
  *   Initializes the SPI hardware
  */
@@ -94,6 +137,12 @@ void dataflash_open()
         dataflash.write = gp1_dataflash_write;
         dataflash.open = gp1_dataflash_open;
         dataflash.read = gp1_dataflash_read;
+        dataflash.write_buffer = gp1_dataflash_write_buffer;
+        dataflash.program_buffer = gp1_dataflash_program_buffer;
+        dataflash.is_ready = gp1_dataflash_is_ready;
+        dataflash.read_array = gp1_dataflash_read_array;
+        dataflash.erase_block = gp1_dataflash_erase_block;
+        dataflash.erase_sector = gp1_dataflash_erase_sector;
         gp1_dataflash_open();
     }
     else if (HARDWARE_VERSION == V01Q)
@@ -102,6 +151,12 @@ void dataflash_open()
         dataflash.write = gp2_dataflash_write;
         dataflash.open = gp2_dataflash_open;
         dataflash.read = gp2_dataflash_read;
+        dataflash.write_buffer = gp2_dataflash_write_buffer;
+        dataflash.program_buffer = gp2_dataflash_program_buffer;
+        dataflash.is_ready = gp2_dataflash_is_ready;
+        dataflash.read_array = gp2_dataflash_read_array;
+        dataflash.erase_block = gp2_dataflash_erase_block;
+        dataflash.erase_sector = gp2_dataflash_erase_sector;
         gp2_dataflash_open();
     }
 }
@@ -188,7 +243,19 @@ int gp1_dataflash_read_status()
 	// Write to buffer 1
 	gp1_spi_comm(0xD7);
 	return gp1_spi_comm(0x00);
-}	
+}
+
+
+/*!
+ *   Non-blocking poll of the RDY/BUSY bit: 0 while the chip is still
+ *   programming a page (up to 20ms on the AT45DB161D).
+ */
+int gp1_dataflash_is_ready()
+{
+	int status = gp1_dataflash_read_status();
+	gp1_dataflash_disable_spi();
+	return (status & STATUS_RDY) != 0;
+}
 
 inline void gp1_dataflash_enable_spi()
 {
@@ -287,8 +354,12 @@ void gp1_dataflash_write(int page, int size, unsigned char *buffer)
 			;
 		gp1_dataflash_write_raw(page+1, PAGE_SIZE, (unsigned char*) &(buffer[PAGE_SIZE]));
 
-        if (size > PAGE_SIZE*2)
+        if (size > PAGE_SIZE*2)   // the flight plan: 3 pages of 528 bytes
+        {
+            while ((gp1_dataflash_read_status()  & STATUS_RDY) == 0)
+                ;
             gp1_dataflash_write_raw(page+2, size - PAGE_SIZE*2, (unsigned char*) &(buffer[PAGE_SIZE*2]));
+        }
 	}	
 	/*
 	while (size > PAGE_SIZE)
@@ -303,28 +374,49 @@ void gp1_dataflash_write(int page, int size, unsigned char *buffer)
 	
 void gp1_dataflash_write_raw(int page, int size, unsigned char *buffer)
 {
-	int add1, add2;
+	gp1_dataflash_write_buffer(1, size, buffer);
+	gp1_dataflash_program_buffer(1, page);
+}
+
+
+/*!
+ *   Fills one of the two SRAM buffers of the chip (command 0x84 for buffer 1,
+ *   0x87 for buffer 2). This is allowed while the chip is busy programming the
+ *   other buffer into the main memory.
+ */
+void gp1_dataflash_write_buffer(int buffer_nr, int size, unsigned char *buffer)
+{
 	int i;
-	add1 = 0;
-	add2 = 0;
-	
+
 	gp1_dataflash_disable_spi();
-	
+
 	microcontroller_delay_us(1);
-	
+
 	gp1_dataflash_enable_spi();
-	
-	// Write to buffer 1
-	gp1_spi_comm(0x84);
-	gp1_spi_comm(0x00);   // select buffer1
-	gp1_spi_comm(0x00);   // select buffer1
-	gp1_spi_comm(0x00);   // select buffer1
-	
+
+	gp1_spi_comm(buffer_nr == 2 ? 0x87 : 0x84);
+	gp1_spi_comm(0x00);   // start at byte 0 of the buffer
+	gp1_spi_comm(0x00);
+	gp1_spi_comm(0x00);
+
 	for (i = 0; i < size; i++)
 		gp1_spi_comm(buffer[i]);
 
 	gp1_dataflash_disable_spi();
-	
+}
+
+
+/*!
+ *   Starts programming SRAM buffer 1 or 2 into a main memory page, with
+ *   built-in erase (command 0x83 or 0x86). Returns immediately: the chip stays
+ *   busy for up to 20ms, use is_ready() before programming the next page.
+ */
+void gp1_dataflash_program_buffer(int buffer_nr, int page)
+{
+	int add1, add2;
+	add1 = 0;
+	add2 = 0;
+
 	if (PAGE_SIZE == 528)
 	{
 		// For a page size of 528 bytes (16Mbit)
@@ -352,14 +444,17 @@ void gp1_dataflash_write_raw(int page, int size, unsigned char *buffer)
 	}	
 	
 	
+	gp1_dataflash_disable_spi();
+
 	microcontroller_delay_us(1);
+
 	gp1_dataflash_enable_spi();
 
-	gp1_spi_comm(0x83); // select buffer1
-	gp1_spi_comm(add1 & 0xFF); // select buffer1
-	gp1_spi_comm(add2 & 0xFF); // select buffer1
-	gp1_spi_comm(0x00); // select buffer1
-	
+	gp1_spi_comm(buffer_nr == 2 ? 0x86 : 0x83);
+	gp1_spi_comm(add1 & 0xFF);
+	gp1_spi_comm(add2 & 0xFF);
+	gp1_spi_comm(0x00);
+
 	gp1_dataflash_disable_spi();
 
 	// Now he's probably busy writing
@@ -367,78 +462,88 @@ void gp1_dataflash_write_raw(int page, int size, unsigned char *buffer)
 
 
 /*!
- *   This operation will read a page of maximum 524 byte
- *   Basically, I'm just following the datasheet:
- *      - Command 0xE8 allows us to read continuously from a certain page
+ *   Reads size bytes from the start of a page on, see gp1_dataflash_read_array().
  *
  *   Some simple simulations showed that it takes 0.7ms to read a page.
  */
- void gp1_dataflash_read(int page, int size, unsigned char *buffer)
+void gp1_dataflash_read(int page, int size, unsigned char *buffer)
 {
-	/*if (size > PAGE_SIZE)
-	{
-		dataflash_read_raw(page, PAGE_SIZE, buffer);
-		while (size > PAGE_SIZE)
-		{
-			size -= PAGE_SIZE;
-			buffer += PAGE_SIZE;
-			page += 1;
-			dataflash_read_raw(page, size > PAGE_SIZE ? PAGE_SIZE : size, buffer);
-		}	
-	} 
-	else*/
-	{
-		gp1_dataflash_read_raw(page, size, buffer);
-	}
+	gp1_dataflash_read_array(page, 0, size, buffer);
 }
 
 
-void gp1_dataflash_read_raw(int page, int size, unsigned char *buffer)
+/*!
+ *   Continuous array read (command 0xE8, also on the older AT45DB161B): after
+ *   the address the chip sends byte after byte, on to the next page at the
+ *   end of a page, for as long as the chip select stays low. Not while
+ *   the chip is still programming (right after a write): it reads garbage.
+ */
+void gp1_dataflash_read_array(int page, int offset, int size, unsigned char *buffer)
 {
-	int add1=0, add2=0;
+	unsigned char address[3];
 	int i;
-	
-	// For 528 bytes page size: xxPPPPPP | PPPPPPBB | BBBBBBBB
-	// For 264 bytes page size: xxxPPPPP | PPPPPPPB | BBBBBBBB
-	if (PAGE_SIZE == 528)
-	{
-		// Write buffer 1 to memory
-		// 3 don't care bits
-		// 12 bits for page
-		add1 = page;
-		add1 >>= 6;
-		add2 = page;
-		add2 <<= 2;
-	} 
-	else //if (PAGE_SIZE == 264)
-	{
-		add1 = page;
-		add1 >>= 7;
-		add2 = page;
-		add2 <<= 1;
-	}
 
-	
+	while ((gp1_dataflash_read_status() & STATUS_RDY) == 0)
+		;
+
+	dataflash_address(page, offset, address);
+
 	gp1_dataflash_disable_spi();
 	gp1_dataflash_enable_spi();
-	
+
 	gp1_spi_comm(0xE8);
-	gp1_spi_comm(add1 & 0xFF);  // 3 addr bytes   : 12 bytes: page - 10 bits: starting address
-	gp1_spi_comm(add2 & 0xFF);
-	gp1_spi_comm(0);
-	
-		
+	gp1_spi_comm(address[0]);
+	gp1_spi_comm(address[1]);
+	gp1_spi_comm(address[2]);
+
 	gp1_spi_comm(0);  // 4 don't care bytes
 	gp1_spi_comm(0);
 	gp1_spi_comm(0);
 	gp1_spi_comm(0);
 
 	for (i = 0; i < size; i++)
-	{
 		buffer[i] = gp1_spi_comm(0x00);
-	}	
-	
+
 	gp1_dataflash_disable_spi();
+}
+
+
+static void gp1_dataflash_erase(int command, int page)
+{
+	unsigned char address[3];
+
+	dataflash_address(page, 0, address);
+
+	gp1_dataflash_disable_spi();
+
+	microcontroller_delay_us(1);
+
+	gp1_dataflash_enable_spi();
+
+	gp1_spi_comm(command);
+	gp1_spi_comm(address[0]);
+	gp1_spi_comm(address[1]);
+	gp1_spi_comm(address[2]);
+
+	gp1_dataflash_disable_spi();
+}
+
+
+/*!
+ *   Erases the 8 pages of the block that holds page (command 0x50).
+ */
+void gp1_dataflash_erase_block(int page)
+{
+	gp1_dataflash_erase(0x50, page);
+}
+
+
+/*!
+ *   Erases the sector that holds page (command 0x7C, AT45DB161D only).
+ */
+void gp1_dataflash_erase_sector(int page)
+{
+	gp1_dataflash_erase(0x7C, dataflash_sector_page(page));
 }	
 
 
@@ -536,6 +641,19 @@ int gp2_dataflash_read_status()
 	return gp2_spi_comm(0x00);
 }
 
+
+/*!
+ *   Non-blocking poll of the RDY/BUSY bit: 0 while the chip is still
+ *   programming a page (up to 20ms on the AT45DB161D).
+ */
+int gp2_dataflash_is_ready()
+{
+	int status = gp2_dataflash_read_status();
+	gp2_dataflash_disable_spi();
+	return (status & STATUS_RDY) != 0;
+}
+
+
 inline void gp2_dataflash_enable_spi()
 {
    PORTBbits.RB2 = 1;  // disable OSD SPI
@@ -613,6 +731,31 @@ unsigned char gp2_spi_comm_bitbang(unsigned char outgoing_byte)
 }
 
 
+/*!
+ *    Clocks in size bytes with bit-banged SPI, for the data of a read. SDO
+ *    stays low, so every bit is only a clock pulse and a sample, without the
+ *    call and the output bit of gp2_spi_comm_bitbang().
+ */
+static void gp2_spi_read_bytes(unsigned char *buffer, int size)
+{
+	unsigned char incoming_byte, x;
+
+	PORTFbits.RF7 = 0;
+	while (size-- > 0)
+	{
+		incoming_byte = 0;
+		for (x = 0; x < 8; x++)
+		{
+			PORTFbits.RF6 = 0;   // the chip shifts the next bit out on the falling edge
+			incoming_byte <<= 1;
+			PORTFbits.RF6 = 1;
+			incoming_byte |= PORTFbits.RF8 & 0x01;
+		}
+		*buffer++ = incoming_byte;
+	}
+}
+
+
 /*!
  *   This operation will write buffer of maximum 528 bytes to the dataflash.
  *   Basically, I'm just following the datasheet:
@@ -634,8 +777,12 @@ void gp2_dataflash_write(int page, int size, unsigned char *buffer)
 			;
 		gp2_dataflash_write_raw(page+1, PAGE_SIZE, (unsigned char*) &(buffer[PAGE_SIZE]));
 
-        if (size > PAGE_SIZE*2)
+        if (size > PAGE_SIZE*2)   // the flight plan: 3 pages of 528 bytes
+        {
+            while ((gp2_dataflash_read_status()  & STATUS_RDY) == 0)
+                ;
             gp2_dataflash_write_raw(page+2, size - PAGE_SIZE*2, (unsigned char*) &(buffer[PAGE_SIZE*2]));
+        }
 	}
 	/*
 	while (size > PAGE_SIZE)
@@ -650,10 +797,19 @@ void gp2_dataflash_write(int page, int size, unsigned char *buffer)
 
 void gp2_dataflash_write_raw(int page, int size, unsigned char *buffer)
 {
-	int add1, add2;
+	gp2_dataflash_write_buffer(1, size, buffer);
+	gp2_dataflash_program_buffer(1, page);
+}
+
+
+/*!
+ *   Fills one of the two SRAM buffers of the chip (command 0x84 for buffer 1,
+ *   0x87 for buffer 2). This is allowed while the chip is busy programming the
+ *   other buffer into the main memory.
+ */
+void gp2_dataflash_write_buffer(int buffer_nr, int size, unsigned char *buffer)
+{
 	int i;
-	add1 = 0;
-	add2 = 0;
 
 	gp2_dataflash_disable_spi();
 
@@ -661,16 +817,28 @@ void gp2_dataflash_write_raw(int page, int size, unsigned char *buffer)
 
 	gp2_dataflash_enable_spi();
 
-	// Write to buffer 1
-	gp2_spi_comm(0x84);
-	gp2_spi_comm(0x00);   // select buffer1
-	gp2_spi_comm(0x00);   // select buffer1
-	gp2_spi_comm(0x00);   // select buffer1
+	gp2_spi_comm(buffer_nr == 2 ? 0x87 : 0x84);
+	gp2_spi_comm(0x00);   // start at byte 0 of the buffer
+	gp2_spi_comm(0x00);
+	gp2_spi_comm(0x00);
 
 	for (i = 0; i < size; i++)
 		gp2_spi_comm(buffer[i]);
 
 	gp2_dataflash_disable_spi();
+}
+
+
+/*!
+ *   Starts programming SRAM buffer 1 or 2 into a main memory page, with
+ *   built-in erase (command 0x83 or 0x86). Returns immediately: the chip stays
+ *   busy for up to 20ms, use is_ready() before programming the next page.
+ */
+void gp2_dataflash_program_buffer(int buffer_nr, int page)
+{
+	int add1, add2;
+	add1 = 0;
+	add2 = 0;
 
 	if (PAGE_SIZE == 528)
 	{
@@ -699,13 +867,16 @@ void gp2_dataflash_write_raw(int page, int size, unsigned char *buffer)
 	}
 
 
+	gp2_dataflash_disable_spi();
+
 	microcontroller_delay_us(1);
+
 	gp2_dataflash_enable_spi();
 
-	gp2_spi_comm(0x83); // select buffer1
-	gp2_spi_comm(add1 & 0xFF); // select buffer1
-	gp2_spi_comm(add2 & 0xFF); // select buffer1
-	gp2_spi_comm(0x00); // select buffer1
+	gp2_spi_comm(buffer_nr == 2 ? 0x86 : 0x83);
+	gp2_spi_comm(add1 & 0xFF);
+	gp2_spi_comm(add2 & 0xFF);
+	gp2_spi_comm(0x00);
 
 	gp2_dataflash_disable_spi();
 
@@ -714,78 +885,86 @@ void gp2_dataflash_write_raw(int page, int size, unsigned char *buffer)
 
 
 /*!
- *   This operation will read a page of maximum 524 byte
- *   Basically, I'm just following the datasheet:
- *      - Command 0xE8 allows us to read continuously from a certain page
+ *   Reads size bytes from the start of a page on, see gp2_dataflash_read_array().
  *
  *   Some simple simulations showed that it takes 0.7ms to read a page.
  */
- void gp2_dataflash_read(int page, int size, unsigned char *buffer)
+void gp2_dataflash_read(int page, int size, unsigned char *buffer)
 {
-	/*if (size > PAGE_SIZE)
-	{
-		dataflash_read_raw(page, PAGE_SIZE, buffer);
-		while (size > PAGE_SIZE)
-		{
-			size -= PAGE_SIZE;
-			buffer += PAGE_SIZE;
-			page += 1;
-			dataflash_read_raw(page, size > PAGE_SIZE ? PAGE_SIZE : size, buffer);
-		}
-	}
-	else*/
-	{
-		gp2_dataflash_read_raw(page, size, buffer);
-	}
+	gp2_dataflash_read_array(page, 0, size, buffer);
 }
 
 
-void gp2_dataflash_read_raw(int page, int size, unsigned char *buffer)
+/*!
+ *   Continuous array read (command 0xE8, also on the older AT45DB161B): after
+ *   the address the chip sends byte after byte, on to the next page at the
+ *   end of a page, for as long as the chip select stays low. Not while
+ *   the chip is still programming (right after a write): it reads garbage.
+ */
+void gp2_dataflash_read_array(int page, int offset, int size, unsigned char *buffer)
 {
-	int add1=0, add2=0;
-	int i;
+	unsigned char address[3];
 
-	// For 528 bytes page size: xxPPPPPP | PPPPPPBB | BBBBBBBB
-	// For 264 bytes page size: xxxPPPPP | PPPPPPPB | BBBBBBBB
-	if (PAGE_SIZE == 528)
-	{
-		// Write buffer 1 to memory
-		// 3 don't care bits
-		// 12 bits for page
-		add1 = page;
-		add1 >>= 6;
-		add2 = page;
-		add2 <<= 2;
-	}
-	else //if (PAGE_SIZE == 264)
-	{
-		add1 = page;
-		add1 >>= 7;
-		add2 = page;
-		add2 <<= 1;
-	}
+	while ((gp2_dataflash_read_status() & STATUS_RDY) == 0)
+		;
 
+	dataflash_address(page, offset, address);
 
 	gp2_dataflash_disable_spi();
 	gp2_dataflash_enable_spi();
 
 	gp2_spi_comm(0xE8);
-	gp2_spi_comm(add1 & 0xFF);  // 3 addr bytes   : 12 bytes: page - 10 bits: starting address
-	gp2_spi_comm(add2 & 0xFF);
-	gp2_spi_comm(0);
-
+	gp2_spi_comm(address[0]);
+	gp2_spi_comm(address[1]);
+	gp2_spi_comm(address[2]);
 
 	gp2_spi_comm(0);  // 4 don't care bytes
 	gp2_spi_comm(0);
 	gp2_spi_comm(0);
 	gp2_spi_comm(0);
 
-	for (i = 0; i < size; i++)
-	{
-		buffer[i] = gp2_spi_comm(0x00);
-	}
+	gp2_spi_read_bytes(buffer, size);
 
 	gp2_dataflash_disable_spi();
 }
 
 
+static void gp2_dataflash_erase(int command, int page)
+{
+	unsigned char address[3];
+
+	dataflash_address(page, 0, address);
+
+	gp2_dataflash_disable_spi();
+
+	microcontroller_delay_us(1);
+
+	gp2_dataflash_enable_spi();
+
+	gp2_spi_comm(command);
+	gp2_spi_comm(address[0]);
+	gp2_spi_comm(address[1]);
+	gp2_spi_comm(address[2]);
+
+	gp2_dataflash_disable_spi();
+}
+
+
+/*!
+ *   Erases the 8 pages of the block that holds page (command 0x50).
+ */
+void gp2_dataflash_erase_block(int page)
+{
+	gp2_dataflash_erase(0x50, page);
+}
+
+
+/*!
+ *   Erases the sector that holds page (command 0x7C, AT45DB161D only).
+ */
+void gp2_dataflash_erase_sector(int page)
+{
+	gp2_dataflash_erase(0x7C, dataflash_sector_page(page));
+}
+
+
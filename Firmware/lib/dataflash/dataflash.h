@@ -13,6 +13,7 @@ extern int START_LOG_PAGE;
 extern int LOG_INDEX_PAGE;
 extern int CONFIGURATION_PAGE;
 extern int NAVIGATION_PAGE;
+extern int LOG_JOURNAL_PAGE;
 
 
 struct Dataflash {
@@ -20,8 +21,27 @@ struct Dataflash {
         void (*read) (int page, int size, unsigned char *buffer);
         void (*write) (int page, int size, unsigned char *buffer);
         int (*read_Mbit) ();
+
+        // Double buffered writing: fill SRAM buffer 1 or 2 of the chip, then
+        // program it into a page in the background and poll is_ready().
+        void (*write_buffer) (int buffer_nr, int size, unsigned char *buffer);
+        void (*program_buffer) (int buffer_nr, int page);
+        int (*is_ready) ();
+
+        // Continuous array read: size bytes from byte "offset" of a page on,
+        // across page boundaries, with a single command.
+        void (*read_array) (int page, int offset, int size, unsigned char *buffer);
+
+        // Erase the block (DATAFLASH_BLOCK_PAGES) or the sector that holds a
+        // page. Returns immediately, poll is_ready(): a block takes up to
+        // 100ms, a sector up to 5s. Erased bytes read 0xFF.
+        void (*erase_block) (int page);
+        void (*erase_sector) (int page);
 } ;
 
+#define DATAFLASH_BLOCK_PAGES   8
+#define DATAFLASH_SECTOR_PAGES  256   // but sector 0: 0a (pages 0...7) and 0b (8...255)
+
 extern struct Dataflash dataflash;
 
 /*!
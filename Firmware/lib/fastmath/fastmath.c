@@ -0,0 +1,200 @@
+/*!
+ *  Float trigonometry and square roots without libm.
+ *
+ *  sin and cos reduce the angle to [-pi/4, pi/4] around the nearest multiple
+ *  of pi/2 (with pi/2 split in 3 parts, so the reduction itself is exact
+ *  enough), and evaluate the polynomial of sin or cos that belongs to the
+ *  quadrant. atan reduces its argument to [-tan(pi/8), tan(pi/8)] with
+ *  atan(x) = pi/2 - atan(1/x) and atan(x) = pi/4 + atan((x-1)/(x+1)).
+ *  The polynomials are the minimax ones of the Cephes library.
+ *
+ *  The square root starts from an estimate of 1/sqrt(x) taken from the float's
+ *  bits, and refines it with 3 Newton steps that only multiply.
+ *
+ *  @file     fastmath.c
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include <stdint.h>
+
+#include "fastmath/fastmath.h"
+
+#define PI_2   1.57079632679f
+#define PI_4   0.78539816340f
+#define TWO_PI 0.63661977236f    //!< 2/pi
+
+// pi/2 = PI_2_A + PI_2_B + PI_2_C, with few significant bits in PI_2_A and PI_2_B
+#define PI_2_A 1.5703125f
+#define PI_2_B 4.837512969970703125e-4f
+#define PI_2_C 7.54978995489188216e-8f
+
+#define TAN_PI_8   0.41421356237f
+#define TAN_3PI_8  2.41421356237f
+
+
+//! sin(x) for |x| <= pi/4
+static float sin_poly(float x)
+{
+	float z = x * x;
+	return ((-1.9515295891e-4f * z + 8.3321608736e-3f) * z - 1.6666654611e-1f) * z * x + x;
+}
+
+//! cos(x) for |x| <= pi/4
+static float cos_poly(float x)
+{
+	float z = x * x;
+	return ((2.443315711809948e-5f * z - 1.388731625493765e-3f) * z + 4.166664568298827e-2f) * z * z - 0.5f * z + 1.0f;
+}
+
+
+/*!
+ *  Reduces x to [-pi/4, pi/4].
+ *  @return The quadrant: x was the returned angle + quadrant * pi/2
+ */
+static int reduce(float *x)
+{
+	float q = *x * TWO_PI;
+	long n = (long)(q >= 0.0f ? q + 0.5f : q - 0.5f);
+	float fn = (float)n;
+
+	*x = ((*x - fn * PI_2_A) - fn * PI_2_B) - fn * PI_2_C;
+	return (int)(n & 3);
+}
+
+
+void fastmath_sincos(float x, float *s, float *c)
+{
+	float sp, cp;
+	int quadrant = reduce(&x);
+
+	sp = sin_poly(x);
+	cp = cos_poly(x);
+	switch (quadrant)
+	{
+		case 0: *s = sp;  *c = cp;  break;
+		case 1: *s = cp;  *c = -sp; break;
+		case 2: *s = -sp; *c = -cp; break;
+		default: *s = -cp; *c = sp; break;
+	}
+}
+
+
+float fastmath_sin(float x)
+{
+	switch (reduce(&x))
+	{
+		case 0: return sin_poly(x);
+		case 1: return cos_poly(x);
+		case 2: return -sin_poly(x);
+		default: return -cos_poly(x);
+	}
+}
+
+
+float fastmath_cos(float x)
+{
+	switch (reduce(&x))
+	{
+		case 0: return cos_poly(x);
+		case 1: return -sin_poly(x);
+		case 2: return -cos_poly(x);
+		default: return sin_poly(x);
+	}
+}
+
+
+float fastmath_tan(float x)
+{
+	float s, c;
+
+	fastmath_sincos(x, &s, &c);
+	return s / c;
+}
+
+
+float fastmath_atan(float x)
+{
+	float y, z;
+	int negative = x < 0.0f;
+
+	if (negative)
+		x = -x;
+
+	if (x > TAN_3PI_8)
+	{
+		y = PI_2;
+		x = -1.0f / x;
+	}
+	else if (x > TAN_PI_8)
+	{
+		y = PI_4;
+		x = (x - 1.0f) / (x + 1.0f);
+	}
+	else
+		y = 0.0f;
+
+	z = x * x;
+	y += (((8.05374449538e-2f * z - 1.38776856032e-1f) * z + 1.99777106478e-1f) * z - 3.33329491539e-1f) * z * x + x;
+
+	return negative ? -y : y;
+}
+
+
+/*!
+ *  Same conventions as atan2() of libm: the angle of (x, y) in [-pi, pi].
+ */
+float fastmath_atan2(float y, float x)
+{
+	float a;
+
+	if (x == 0.0f)
+	{
+		if (y > 0.0f)
+			return PI_2;
+		if (y < 0.0f)
+			return -PI_2;
+		return 0.0f;
+	}
+
+	a = fastmath_atan(y / x);
+	if (x < 0.0f)
+		a += (y < 0.0f) ? -2.0f * PI_2 : 2.0f * PI_2;
+	return a;
+}
+
+
+//! For |x| > 1 the argument is limited to +-1
+float fastmath_asin(float x)
+{
+	if (x >= 1.0f)
+		return PI_2;
+	if (x <= -1.0f)
+		return -PI_2;
+	return fastmath_atan2(x, fastmath_sqrt((1.0f - x) * (1.0f + x)));
+}
+
+
+//! 0 for x <= 0
+float fastmath_invsqrt(float x)
+{
+	union { float f; uint32_t i; } u;
+	float half = 0.5f * x, y;
+
+	if (x <= 0.0f)
+		return 0.0f;
+	u.f = x;
+	u.i = 0x5f375a86UL - (u.i >> 1);
+	y = u.f;
+	y = y * (1.5f - half * y * y);
+	y = y * (1.5f - half * y * y);
+	y = y * (1.5f - half * y * y);
+	return y;
+}
+
+
+//! 0 for x <= 0
+float fastmath_sqrt(float x)
+{
+	return x * fastmath_invsqrt(x);
+}
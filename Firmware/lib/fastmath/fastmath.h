@@ -0,0 +1,38 @@
+#ifndef FASTMATH_H
+#define FASTMATH_H
+
+/*!
+ *  Float trigonometry and square roots without libm.
+ *
+ *  The dsPIC's libm computes these in software, with full precision and a
+ *  lot of cycles. The routines here use a range reduction and a short
+ *  polynomial instead. Maximum errors, measured over the whole float range
+ *  of the arguments by sitl/fastmath_check.c:
+ *
+ *   function          argument               max. error
+ *   fastmath_sin/cos  |x| < 1000 rad         2e-7 (absolute)
+ *   fastmath_tan      |x| < pi/2 - 0.01      5e-7 relative
+ *   fastmath_atan     all                    2e-7 rad
+ *   fastmath_atan2    all                    4e-7 rad
+ *   fastmath_asin     [-1, 1]                5e-7 rad
+ *   fastmath_sqrt     [0, 1e30]              3e-7 relative
+ *   fastmath_invsqrt  (0, 1e30]              3e-7 relative
+ *
+ *  Larger angles lose precision in the range reduction, just like with libm.
+ *
+ *  @file     fastmath.h
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+float fastmath_sin(float x);
+float fastmath_cos(float x);
+void fastmath_sincos(float x, float *s, float *c);
+float fastmath_tan(float x);
+float fastmath_atan(float x);
+float fastmath_atan2(float y, float x);
+float fastmath_asin(float x);
+float fastmath_sqrt(float x);
+float fastmath_invsqrt(float x);
+
+#endif // FASTMATH_H
@@ -413,14 +413,12 @@ char gps_update_info(struct gps_info *gpsinfo)
 
 
 /*!
- *  Interrupt routine notifying us a new character is available from the
- *  GPS's uart module.
- *  This function buffers a valid (structure and checksum) RMC sentence. The
- *  used buffer is nmea_buffer_RMC.
+ *  Feeds a character received from the GPS's uart module to the NMEA parser.
+ *  This function buffers a valid (structure and checksum) RMC and GGA sentence.
+ *  The used buffers are nmea_buffer_RMC and nmea_buffer_GGA.
  */
-void __attribute__((__interrupt__, __shadow__, __auto_psv__)) _U2RXInterrupt(void)
+void gps_rx_char(unsigned char c)
 {
-	unsigned char c = U2RXREG;
 	//uart1_putc(c);
 	
  
@@ -534,5 +532,17 @@ void __attribute__((__interrupt__, __shadow__, __auto_psv__)) _U2RXInterrupt(voi
 				nmea_buffer_GGA_counter = 0;
 		}
 	}
+}
+
+
+#ifndef SITL  // the software-in-the-loop build calls gps_rx_char() from its simulated uart2
+/*!
+ *  Interrupt routine notifying us a new character is available from the
+ *  GPS's uart module.
+ */
+void __attribute__((__interrupt__, __shadow__, __auto_psv__)) _U2RXInterrupt(void)
+{
+	gps_rx_char(U2RXREG);
 	_U2RXIF = 0;
 }
+#endif
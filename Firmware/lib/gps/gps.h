@@ -36,11 +36,12 @@ char gps_update_info(struct gps_info *gpsinfo);
 
 void gps_wait_for_lock();
 
-void gps_config_output();
+void gps_config_output(struct GpsConfig *gpsconfig);
 
 void gps_open_port(struct GpsConfig *gpsconfig);
 
 int gps_valid_frames_receiving();
+void gps_rx_char(unsigned char c);
 
 
 #endif // GPS_H
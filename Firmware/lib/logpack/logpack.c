@@ -0,0 +1,125 @@
+/*!
+ *  Delta compression of log records, see logpack.h.
+ *
+ *  The differences are taken modulo the width of the wire type, so a field
+ *  that wraps around (an unsigned counter, the bit pattern of a float) still
+ *  gives a small difference.
+ *
+ *  @file     logpack.c
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include "logpack/logpack.h"
+
+static const unsigned char wire_bytes[] = { 1, 1, 2, 2, 4, 4, 4, 8 };
+
+
+/*!
+ *   Reads a field as an integer of its wire width. Narrower fields in the
+ *   struct are sign or zero extended.
+ */
+unsigned long long logpack_load(const struct LogpackField *f, const void *record)
+{
+	const unsigned char *p = (const unsigned char*)record + f->offset;
+	unsigned long long v = 0;
+	int bits = f->size * 8, i;
+
+	for (i = f->size - 1; i >= 0; i--)   // little endian
+		v = (v << 8) | p[i];
+	if ((f->type == LOGPACK_S8 || f->type == LOGPACK_S16 || f->type == LOGPACK_S32) && bits < 64 &&
+	    (v >> (bits - 1)) & 1)
+		v |= ~0ull << bits;
+	return v;
+}
+
+
+/*!
+ *   Stores the low wire_bytes of v in a field of any size: the upper bytes are
+ *   filled with the sign for the signed types.
+ */
+static void store(const struct LogpackField *f, unsigned char *record, unsigned long long v)
+{
+	unsigned char *p = record + f->offset;
+	int bits = wire_bytes[f->type] * 8, i;
+
+	if (bits < 64)
+	{
+		v &= (1ull << bits) - 1;
+		if ((f->type == LOGPACK_S8 || f->type == LOGPACK_S16 || f->type == LOGPACK_S32) && (v >> (bits - 1)) & 1)
+			v |= ~0ull << bits;
+	}
+	for (i = 0; i < f->size; i++, v >>= 8)   // little endian
+		p[i] = (unsigned char)v;
+}
+
+
+/*!
+ *   Packs "record" as the difference with "previous" (all zeros for the
+ *   first record of a page: a keyframe).
+ *   @return The number of bytes written to out, 0 when it doesn't fit in space
+ */
+int logpack_encode(const struct LogpackField *fields, int count, const void *record, const void *previous,
+                   unsigned char *out, int space)
+{
+	int i, n = 0;
+
+	for (i = 0; i < count; i++)
+	{
+		const struct LogpackField *f = &fields[i];
+		int bits = wire_bytes[f->type] * 8;
+		unsigned long long delta = logpack_load(f, record) - logpack_load(f, previous);
+		long long s;
+
+		// sign extend the difference from the wire width, then zig-zag
+		if (bits < 64)
+		{
+			delta <<= 64 - bits;
+			s = (long long)delta >> (64 - bits);
+		}
+		else
+			s = (long long)delta;
+		delta = ((unsigned long long)s << 1) ^ (unsigned long long)(s >> 63);
+
+		do
+		{
+			if (n >= space)
+				return 0;
+			out[n++] = (delta > 0x7F ? 0x80 : 0) | (unsigned char)(delta & 0x7F);
+			delta >>= 7;
+		} while (delta != 0);
+	}
+	return n;
+}
+
+
+/*!
+ *   Unpacks one record. "record" holds the previous record on entry (zeros
+ *   for the first one of a page).
+ *   @return The number of bytes read, 0 when the input is truncated
+ */
+int logpack_decode(const struct LogpackField *fields, int count, const unsigned char *in, int available,
+                   void *record)
+{
+	int i, n = 0;
+
+	for (i = 0; i < count; i++)
+	{
+		const struct LogpackField *f = &fields[i];
+		unsigned long long z = 0;
+		int shift = 0;
+		unsigned char b;
+
+		do
+		{
+			if (n >= available || shift >= 70)
+				return 0;
+			b = in[n++];
+			z |= (unsigned long long)(b & 0x7F) << shift;
+			shift += 7;
+		} while (b & 0x80);
+
+		store(f, record, logpack_load(f, record) + ((z >> 1) ^ (0ull - (z & 1))));
+	}
+	return n;
+}
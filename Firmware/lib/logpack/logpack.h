@@ -0,0 +1,56 @@
+#ifndef LOGPACK_H
+#define LOGPACK_H
+
+/*!
+ *  Delta compression of log records, field by field.
+ *
+ *  A record (any struct) is described by a table of its fields. Every field
+ *  is stored as the difference with the same field of the previous record,
+ *  zig-zag encoded (small negative numbers become small positive ones) and
+ *  written as a varint: 7 bits per byte, the high bit set when more bytes
+ *  follow. A field that didn't change takes a single byte.
+ *
+ *  The fields are stored with their own width ("wire type"), independent of
+ *  the size of int and long of the compiler: a record packed on the dsPIC
+ *  unpacks into the struct of a host build, and the other way around. Floats
+ *  are packed losslessly as their bit pattern. Both sides are little endian.
+ *
+ *  @file     logpack.h
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include <stddef.h>
+
+enum LogpackType
+{
+	LOGPACK_S8,
+	LOGPACK_U8,
+	LOGPACK_S16,
+	LOGPACK_U16,
+	LOGPACK_S32,
+	LOGPACK_U32,
+	LOGPACK_F32,
+	LOGPACK_F64
+};
+
+struct LogpackField
+{
+	unsigned int offset;    //!< In the struct
+	unsigned char size;     //!< In the struct
+	unsigned char type;     //!< enum LogpackType
+	unsigned char decimals; //!< How the value is printed: with this many decimals...
+	float scale;            //!< ...after multiplying it with scale
+	const char *name;       //!< Column name in the log readout (see logschema.h)
+};
+
+#define LOGPACK_FIELD(record, member, type, name, scale, decimals) \
+	{ offsetof(record, member), sizeof(((record*)0)->member), type, decimals, scale, name }
+
+int logpack_encode(const struct LogpackField *fields, int count, const void *record, const void *previous,
+                   unsigned char *out, int space);
+int logpack_decode(const struct LogpackField *fields, int count, const unsigned char *in, int available,
+                   void *record);
+unsigned long long logpack_load(const struct LogpackField *f, const void *record);
+
+#endif // LOGPACK_H
@@ -0,0 +1,296 @@
+/*!
+ *  Self-describing logs, see logschema.h.
+ *
+ *  @file     logschema.c
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "logpack/logschema.h"
+#include "numfmt/numfmt.h"
+
+
+static int put_name(unsigned char *out, int *n, int space, const char *name)
+{
+	int length = strlen(name) + 1;
+
+	if (*n + length > space)
+		return 0;
+	memcpy(&out[*n], name, length);
+	*n += length;
+	return 1;
+}
+
+
+/*!
+ *   Writes the schema record of a record type, without its id and length.
+ *   @return The number of bytes written, 0 when it doesn't fit in space
+ */
+int logschema_encode(const struct LogRecordType *type, int period, unsigned char *out, int space)
+{
+	int i, n = 3;
+	union { float f; unsigned char b[4]; } scale;   // little endian, as the records
+
+	if (space < n)
+		return 0;
+	out[0] = type->id;
+	out[1] = (unsigned char)period;
+	out[2] = type->count;
+	if (! put_name(out, &n, space, type->name))
+		return 0;
+
+	for (i = 0; i < type->count; i++)
+	{
+		const struct LogpackField *f = &type->fields[i];
+
+		if (n + 6 > space)
+			return 0;
+		scale.f = f->scale;
+		out[n++] = f->type;
+		out[n++] = f->decimals;
+		memcpy(&out[n], scale.b, 4);
+		n += 4;
+		if (! put_name(out, &n, space, f->name))
+			return 0;
+	}
+	return n;
+}
+
+
+void logschema_clear(struct LogSchema *s)
+{
+	s->records = 0;
+	s->fields = 0;
+	s->names_used = 0;
+}
+
+
+/*!
+ *   Copies a name of at most "length" bytes (the terminating 0 included).
+ *   @return NULL when it isn't terminated or there's no room left
+ */
+static const char *copy_name(struct LogSchema *s, const char *name, int length)
+{
+	char *copy = &s->names[s->names_used];
+	int i;
+
+	for (i = 0; i < length && s->names_used + i < LOGSCHEMA_NAMES_SIZE; i++)
+	{
+		copy[i] = name[i];
+		if (name[i] == '\0')
+		{
+			s->names_used += i + 1;
+			return copy;
+		}
+	}
+	return NULL;
+}
+
+
+static void commit(struct LogSchema *s, int id, int period, const char *name, int count)
+{
+	int r = s->records++, i;
+
+	s->id[r] = id;
+	s->period[r] = period;
+	s->first[r] = s->fields;
+	s->count[r] = count;
+	s->on_page[r] = 0;
+	s->name[r] = name;
+	for (i = s->fields; i < s->fields + count; i++)
+	{
+		s->field[i].offset = (i - s->fields) * sizeof(unsigned long long);
+		s->field[i].size = sizeof(unsigned long long);
+		s->value[i] = 0;
+	}
+	s->fields += count;
+}
+
+
+/*!
+ *   Adds the record type described by a schema record (without its id and
+ *   length). A type that is already known is kept as it is.
+ *   @return 0 when the schema record is invalid or there's no room left
+ */
+int logschema_add(struct LogSchema *s, const unsigned char *in, int length)
+{
+	int names_used = s->names_used, n = 3, i, count;
+	const char *name;
+
+	if (length < n)
+		return 0;
+	if (logschema_find(s, in[0]) >= 0)
+		return 1;
+	count = in[2];
+	if (s->records >= LOGSCHEMA_MAX_RECORDS || s->fields + count > LOGSCHEMA_MAX_FIELDS)
+		return 0;
+
+	name = copy_name(s, (const char*)&in[n], length - n);
+	if (name == NULL)
+		goto invalid;
+	n += strlen(name) + 1;
+
+	for (i = 0; i < count; i++)
+	{
+		struct LogpackField *f = &s->field[s->fields + i];
+		union { float f; unsigned char b[4]; } scale;
+
+		if (n + 6 > length || in[n] > LOGPACK_F64)
+			goto invalid;
+		f->type = in[n++];
+		f->decimals = in[n++];
+		memcpy(scale.b, &in[n], 4);
+		f->scale = scale.f;
+		n += 4;
+		f->name = copy_name(s, (const char*)&in[n], length - n);
+		if (f->name == NULL)
+			goto invalid;
+		n += strlen(f->name) + 1;
+	}
+	commit(s, in[0], in[1], name, count);
+	return 1;
+
+invalid:
+	s->names_used = names_used;
+	return 0;
+}
+
+
+/*!
+ *   Adds a record type known by the reader itself, for logs that lost their
+ *   schema records.
+ */
+int logschema_add_type(struct LogSchema *s, const struct LogRecordType *type)
+{
+	int names_used = s->names_used, i;
+	const char *name;
+
+	if (logschema_find(s, type->id) >= 0)
+		return 1;
+	if (s->records >= LOGSCHEMA_MAX_RECORDS || s->fields + type->count > LOGSCHEMA_MAX_FIELDS)
+		return 0;
+
+	name = copy_name(s, type->name, LOGSCHEMA_NAMES_SIZE);
+	for (i = 0; name != NULL && i < type->count; i++)
+	{
+		struct LogpackField *f = &s->field[s->fields + i];
+
+		*f = type->fields[i];
+		f->name = copy_name(s, type->fields[i].name, LOGSCHEMA_NAMES_SIZE);
+		if (f->name == NULL)
+			name = NULL;
+	}
+	if (name == NULL)
+	{
+		s->names_used = names_used;
+		return 0;
+	}
+	commit(s, type->id, type->period, name, type->count);
+	return 1;
+}
+
+
+/*!
+ *   @return The record type with this id, -1 when unknown
+ */
+int logschema_find(const struct LogSchema *s, int id)
+{
+	int r;
+
+	for (r = 0; r < s->records; r++)
+		if (s->id[r] == id)
+			return r;
+	return -1;
+}
+
+
+/*!
+ *   The first record of every type on a page is packed against zeros.
+ */
+void logschema_new_page(struct LogSchema *s)
+{
+	memset(s->on_page, 0, sizeof(s->on_page));
+}
+
+
+/*!
+ *   Unpacks a record (without its id) into the values of its fields.
+ *   @return The number of bytes read, 0 when the input is truncated
+ */
+int logschema_decode(struct LogSchema *s, int record, const unsigned char *in, int available)
+{
+	unsigned long long *values = &s->value[s->first[record]];
+
+	if (! s->on_page[record])
+	{
+		memset(values, 0, s->count[record] * sizeof(unsigned long long));
+		s->on_page[record] = 1;
+	}
+	return logpack_decode(&s->field[s->first[record]], s->count[record], in, available, values);
+}
+
+
+/*!
+ *   Takes the values of a record from its struct instead of a page, for logs
+ *   that aren't packed. "fields" describes the struct.
+ */
+int logschema_load(struct LogSchema *s, int record, const struct LogpackField *fields, const void *data)
+{
+	int i;
+
+	for (i = 0; i < s->count[record]; i++)
+		s->value[s->first[record] + i] = logpack_load(&fields[i], data);
+	return 1;
+}
+
+
+/*!
+ *   @return The latest value of a field, scaled
+ */
+double logschema_value(const struct LogSchema *s, int field)
+{
+	const struct LogpackField *f = &s->field[field];
+	unsigned long long v = s->value[field];
+	union { unsigned char b[8]; float f; double d; } bits;   // little endian
+	int i;
+
+	switch (f->type)
+	{
+		case LOGPACK_F32:
+		case LOGPACK_F64:
+			for (i = 0; i < 8; i++, v >>= 8)
+				bits.b[i] = (unsigned char)v;
+			return (f->type == LOGPACK_F32 ? bits.f : bits.d) * f->scale;
+		case LOGPACK_S8:
+		case LOGPACK_S16:
+		case LOGPACK_S32:
+			return (double)(long long)v * f->scale;
+		default:
+			return (double)v * f->scale;
+	}
+}
+
+
+/*!
+ *   Prints the latest value of a field, scaled. With numfmt on the dsPIC
+ *   (a DR readout), printf on a host: a double has more digits than numfmt
+ *   writes.
+ *   @return The length of the text
+ */
+int logschema_format(const struct LogSchema *s, int field, char *out, int size)
+{
+	const struct LogpackField *f = &s->field[field];
+
+	if (f->scale == 1.0f && f->decimals == 0 && f->type != LOGPACK_F32 && f->type != LOGPACK_F64)
+	{
+		if (f->type == LOGPACK_S8 || f->type == LOGPACK_S16 || f->type == LOGPACK_S32)
+			return numfmt_format(out, size, "%ld", (long)(long long)s->value[field]);
+		return numfmt_format(out, size, "%lu", (unsigned long)s->value[field]);
+	}
+	if (sizeof(double) > sizeof(float))
+		return snprintf(out, size, "%.*f", (int)f->decimals, logschema_value(s, field));
+	return numfmt_format(out, size, "%.*f", (int)f->decimals, logschema_value(s, field));
+}
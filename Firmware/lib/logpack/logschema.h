@@ -0,0 +1,73 @@
+#ifndef LOGSCHEMA_H
+#define LOGSCHEMA_H
+
+/*!
+ *  Self-describing logs: typed records, each packed with lib/logpack.
+ *
+ *  A log holds records of several types (GPS, attitude, raw sensors...),
+ *  each with its own rate. Every record starts with the id of its type.
+ *  Id 0 (LOGSCHEMA_ID) is a schema record, describing one record type:
+ *
+ *    [0][length][id][period][field count][name\0]
+ *       then per field: [wire type][decimals][scale: float][name\0]
+ *
+ *  A log starts with the schema records of all its types, so a reader only
+ *  needs this file to decode it: not the structs or the build options of the
+ *  firmware that wrote it.
+ *
+ *  A struct LogSchema collects the record types while reading, and holds the
+ *  latest value of every field ("sample and hold") to print a log as one
+ *  table with a column per field.
+ *
+ *  @file     logschema.h
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include "logpack/logpack.h"
+
+#define LOGSCHEMA_ID           0
+#define LOGSCHEMA_MAX_RECORDS  8      //!< Record types of a log
+#define LOGSCHEMA_MAX_FIELDS   40     //!< Fields of all record types together
+#define LOGSCHEMA_NAMES_SIZE   320    //!< Room for the names of the types and their fields
+
+//! A record type, as written
+struct LogRecordType
+{
+	unsigned char id;                   //!< 1...255
+	unsigned char period;               //!< Default rate, the meaning is up to the writer
+	const char *name;
+	const struct LogpackField *fields;
+	unsigned char count;
+};
+
+//! The record types of a log, as read
+struct LogSchema
+{
+	int records;
+	int fields;
+	int names_used;
+	unsigned char id[LOGSCHEMA_MAX_RECORDS];
+	unsigned char period[LOGSCHEMA_MAX_RECORDS];
+	unsigned char first[LOGSCHEMA_MAX_RECORDS];     //!< Index of the first field of the type
+	unsigned char count[LOGSCHEMA_MAX_RECORDS];
+	unsigned char on_page[LOGSCHEMA_MAX_RECORDS];   //!< 1 when value[] is the base of the next delta
+	const char *name[LOGSCHEMA_MAX_RECORDS];
+	struct LogpackField field[LOGSCHEMA_MAX_FIELDS];   //!< offset: within the values of its record type
+	unsigned long long value[LOGSCHEMA_MAX_FIELDS];    //!< Latest value, as an integer of its wire type
+	char names[LOGSCHEMA_NAMES_SIZE];
+};
+
+int  logschema_encode(const struct LogRecordType *type, int period, unsigned char *out, int space);
+
+void logschema_clear(struct LogSchema *s);
+int  logschema_add(struct LogSchema *s, const unsigned char *in, int length);
+int  logschema_add_type(struct LogSchema *s, const struct LogRecordType *type);
+int  logschema_find(const struct LogSchema *s, int id);
+void logschema_new_page(struct LogSchema *s);
+int  logschema_decode(struct LogSchema *s, int record, const unsigned char *in, int available);
+int  logschema_load(struct LogSchema *s, int record, const struct LogpackField *fields, const void *data);
+double logschema_value(const struct LogSchema *s, int field);
+int  logschema_format(const struct LogSchema *s, int field, char *out, int size);
+
+#endif // LOGSCHEMA_H
@@ -0,0 +1,438 @@
+/*!
+ *  Implements the number formatting and parsing of numfmt.h.
+ *
+ *  Floats are taken apart with a union: they are IEEE 754 singles on the
+ *  dsPIC and on the hosts of the SITL build. The 64 bits intermediates
+ *  are library calls on the dsPIC too, but a handful per number instead of
+ *  the floating point divisions of printf and atof.
+ *
+ *  @file     numfmt.c
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include <stdint.h>
+
+#include "numfmt.h"
+
+#define TOP_BIT  0x8000000000000000ULL
+
+static const unsigned long powers_of_10[NUMFMT_MAX_DECIMALS + 1] =
+	{ 1UL, 10UL, 100UL, 1000UL, 10000UL, 100000UL, 1000000UL, 10000000UL, 100000000UL, 1000000000UL };
+
+
+static char *copy(char *s, const char *text)
+{
+	while (*text != '\0')
+		*s++ = *text++;
+	*s = '\0';
+	return s;
+}
+
+
+char *numfmt_uint(char *s, unsigned long x)
+{
+	char digits[20];   // 10 on the dsPIC, 64 bits longs on a host
+	unsigned int small;
+	int n = 0;
+
+	while (x > 0xFFFFUL)   // 32 bits divisions are library calls on the dsPIC...
+	{
+		digits[n++] = '0' + (char)(x % 10);
+		x /= 10;
+	}
+	small = (unsigned int)x;   // ...16 bits ones are a single instruction
+	do
+	{
+		digits[n++] = '0' + (char)(small % 10);
+		small /= 10;
+	} while (small > 0);
+
+	while (n > 0)
+		*s++ = digits[--n];
+	*s = '\0';
+	return s;
+}
+
+
+char *numfmt_int(char *s, long x)
+{
+	if (x < 0)
+	{
+		*s++ = '-';
+		return numfmt_uint(s, 0UL - (unsigned long)x);
+	}
+	return numfmt_uint(s, (unsigned long)x);
+}
+
+
+char *numfmt_hex(char *s, unsigned long x)
+{
+	static const char hex_digits[] = "0123456789abcdef";
+	int shift = sizeof(x) * 8 - 4;
+
+	while (shift > 0 && (x >> shift) == 0)
+		shift -= 4;
+	for (; shift >= 0; shift -= 4)
+		*s++ = hex_digits[(x >> shift) & 0xF];
+	*s = '\0';
+	return s;
+}
+
+
+static char *uint64(char *s, unsigned long long x)
+{
+	char digits[20];
+	int n = 0;
+
+	while (x > 0xFFFFFFFFULL)
+	{
+		digits[n++] = '0' + (char)(x % 10);
+		x /= 10;
+	}
+	s = numfmt_uint(s, (unsigned long)x);
+	while (n > 0)
+		*s++ = digits[--n];
+	*s = '\0';
+	return s;
+}
+
+
+/*!
+ *   x = mantissa * 2^exponent exactly, so x * 10^decimals is the integer
+ *   mantissa * 10^decimals (at most 54 bits) shifted by the exponent, and
+ *   the bits shifted out decide the rounding.
+ */
+char *numfmt_fixed(char *s, float x, int decimals)
+{
+	union { float f; uint32_t l; } bits;
+	unsigned long long value, rest, half;
+	uint32_t mantissa;
+	unsigned long fraction;
+	int exponent, i;
+
+	if (decimals < 0)
+		decimals = 0;
+	if (decimals > NUMFMT_MAX_DECIMALS)
+		decimals = NUMFMT_MAX_DECIMALS;
+
+	bits.f = x;
+	if (bits.l & 0x80000000UL)
+		*s++ = '-';   // "-0.000" for a small negative number, as printf
+	exponent = (int)((bits.l >> 23) & 0xFF);
+	mantissa = bits.l & 0x7FFFFFUL;
+	if (exponent == 0xFF)
+		return copy(s, mantissa != 0 ? "nan" : "inf");
+	if (exponent == 0)
+		exponent = 1;   // denormal, no implicit bit
+	else
+		mantissa |= 0x800000UL;
+	exponent -= 150;
+
+	value = (unsigned long long)mantissa * powers_of_10[decimals];
+	if (exponent > 0)
+	{
+		if (exponent > 63 || value > (TOP_BIT - 1) >> exponent)
+			return copy(s, "inf");
+		value <<= exponent;
+	}
+	else if (exponent < 0)
+	{
+		if (exponent < -63)
+			value = 0;   // less than 2^-9: rounds to 0
+		else
+		{
+			half = 1ULL << (-exponent - 1);
+			rest = value & ((half << 1) - 1);
+			value >>= -exponent;
+			if (rest > half || (rest == half && (value & 1)))   // half to even
+				value++;
+		}
+	}
+
+	if (value <= 0xFFFFFFFFULL)
+	{
+		s = numfmt_uint(s, (unsigned long)value / powers_of_10[decimals]);
+		fraction = (unsigned long)value % powers_of_10[decimals];
+	}
+	else
+	{
+		s = uint64(s, value / powers_of_10[decimals]);
+		fraction = (unsigned long)(value % powers_of_10[decimals]);
+	}
+	if (decimals > 0)
+	{
+		*s++ = '.';
+		for (i = decimals - 1; i >= 0; i--)
+		{
+			s[i] = '0' + (char)(fraction % 10);
+			fraction /= 10;
+		}
+		s += decimals;
+		*s = '\0';
+	}
+	return s;
+}
+
+
+int numfmt_vformat(char *buffer, int size, const char *format, va_list ap)
+{
+	char number[NUMFMT_SIZE];
+	const char *text;
+	int length = 0, is_long, decimals;
+
+	if (size <= 0)
+		return 0;
+	for (; *format != '\0'; format++)
+	{
+		if (*format != '%')
+		{
+			if (length < size - 1)
+				buffer[length++] = *format;
+			continue;
+		}
+
+		format++;
+		decimals = 6;
+		if (*format == '.')
+		{
+			format++;
+			if (*format == '*')
+			{
+				decimals = va_arg(ap, int);
+				format++;
+			}
+			else
+				for (decimals = 0; *format >= '0' && *format <= '9'; format++)
+					decimals = decimals * 10 + (*format - '0');
+		}
+		is_long = *format == 'l';
+		if (is_long)
+			format++;
+
+		text = number;
+		switch (*format)
+		{
+			case 'd':
+			case 'i':
+				numfmt_int(number, is_long ? va_arg(ap, long) : va_arg(ap, int));
+				break;
+			case 'u':
+				numfmt_uint(number, is_long ? va_arg(ap, unsigned long) : va_arg(ap, unsigned int));
+				break;
+			case 'x':
+				numfmt_hex(number, is_long ? va_arg(ap, unsigned long) : va_arg(ap, unsigned int));
+				break;
+			case 'f':
+				numfmt_fixed(number, (float)va_arg(ap, double), decimals);
+				break;
+			case 'c':
+				number[0] = (char)va_arg(ap, int);
+				number[1] = '\0';
+				break;
+			case 's':
+				text = va_arg(ap, const char *);
+				break;
+			case '\0':   // a '%' at the end
+				buffer[length] = '\0';
+				return length;
+			default:     // "%%", and anything unknown as it is
+				number[0] = *format;
+				number[1] = '\0';
+				break;
+		}
+		while (*text != '\0' && length < size - 1)
+			buffer[length++] = *text++;
+	}
+	buffer[length] = '\0';
+	return length;
+}
+
+
+/*!
+ *   Like snprintf(), but returns the length that was written: at most
+ *   size - 1.
+ */
+int numfmt_format(char *buffer, int size, const char *format, ...)
+{
+	va_list ap;
+	int length;
+
+	va_start(ap, format);
+	length = numfmt_vformat(buffer, size, format, ap);
+	va_end(ap);
+	return length;
+}
+
+
+static const char *skip_sign(const char *s, int *negative)
+{
+	while (*s == ' ' || (*s >= '\t' && *s <= '\r'))
+		s++;
+	*negative = *s == '-';
+	if (*s == '-' || *s == '+')
+		s++;
+	return s;
+}
+
+
+/*!
+ *   As atol(): stops at the first character that isn't a digit.
+ */
+long numfmt_parse_long(const char *s)
+{
+	unsigned long x = 0;
+	int negative;
+
+	s = skip_sign(s, &negative);
+	for (; *s >= '0' && *s <= '9'; s++)
+		x = x * 10 + (unsigned long)(*s - '0');
+	return (long)(negative ? 0UL - x : x);
+}
+
+
+static int leading_zeros(unsigned long long m)
+{
+	int n = 0;
+
+	while ((m >> 48) == 0)
+	{
+		m <<= 16;
+		n += 16;
+	}
+	while ((m & TOP_BIT) == 0)
+	{
+		m <<= 1;
+		n++;
+	}
+	return n;
+}
+
+
+/*!
+ *   The first 19 significant digits become m, x = m * 10^exponent10. That is
+ *   brought to x = m * 2^exponent2 with m normalized (top bit set), 9 decimal
+ *   digits at a time. Every step rounds m down: "inexact" remembers it, to
+ *   round a seemingly exact half up.
+ */
+float numfmt_parse_float(const char *s)
+{
+	union { float f; uint32_t l; } bits;
+	unsigned long long m = 0, hi, lo, q, r, rest, half;
+	unsigned long scale;
+	uint32_t mantissa;
+	int negative, negative_exponent, digits = 0, exponent10 = 0, exponent2, e, k, shift, inexact = 0;
+
+	s = skip_sign(s, &negative);
+	for (; *s >= '0' && *s <= '9'; s++)
+	{
+		if (digits < 19)
+		{
+			m = m * 10 + (unsigned long long)(*s - '0');
+			if (m > 0)
+				digits++;
+		}
+		else
+		{
+			exponent10++;
+			if (*s != '0')
+				inexact = 1;
+		}
+	}
+	if (*s == '.')
+	{
+		for (s++; *s >= '0' && *s <= '9'; s++)
+		{
+			if (digits < 19)
+			{
+				m = m * 10 + (unsigned long long)(*s - '0');
+				if (m > 0)
+					digits++;
+				exponent10--;
+			}
+			else if (*s != '0')
+				inexact = 1;
+		}
+	}
+	if (*s == 'e' || *s == 'E')
+	{
+		s = skip_sign(s + 1, &negative_exponent);
+		for (e = 0; *s >= '0' && *s <= '9'; s++)
+			if (e < 1000)
+				e = e * 10 + (*s - '0');
+		exponent10 += negative_exponent ? -e : e;
+	}
+
+	bits.l = 0;
+	if (m == 0 || digits + exponent10 < -46)         // below half the smallest denormal
+		;
+	else if (digits - 1 + exponent10 >= 39)          // above the largest float
+		bits.l = 0x7F800000UL;
+	else
+	{
+		shift = leading_zeros(m);
+		m <<= shift;
+		exponent2 = -shift;
+		while (exponent10 > 0)
+		{
+			k = exponent10 > 9 ? 9 : exponent10;
+			scale = powers_of_10[k];
+			hi = (m >> 32) * scale;                  // m * scale = hi * 2^32 + lo
+			lo = (m & 0xFFFFFFFFULL) * scale;
+			hi += lo >> 32;
+			lo &= 0xFFFFFFFFULL;
+			shift = leading_zeros(hi);
+			m = (hi << shift) | ((lo << shift) >> 32);
+			if (((lo << shift) & 0xFFFFFFFFULL) != 0)
+				inexact = 1;
+			exponent2 += 32 - shift;
+			exponent10 -= k;
+		}
+		while (exponent10 < 0)
+		{
+			k = -exponent10 > 9 ? 9 : -exponent10;
+			scale = powers_of_10[k];
+			q = m / scale;
+			r = m % scale;
+			shift = leading_zeros(q);
+			m = (q << shift) + (r << shift) / scale;    // m * 2^shift / scale, rounded down
+			if ((r << shift) % scale != 0)
+				inexact = 1;
+			exponent2 -= shift;
+			exponent10 += k;
+		}
+
+		// x = m * 2^exponent2: the biased float exponent is exponent2 + 63 + 127
+		e = exponent2 + 190;
+		shift = 40;
+		if (e < 1)
+		{
+			shift = 41 - e;   // denormal
+			e = 1;
+		}
+		if (shift > 64)
+			mantissa = 0;
+		else if (shift == 64)
+			mantissa = m > TOP_BIT || (m == TOP_BIT && inexact);
+		else
+		{
+			mantissa = (uint32_t)(m >> shift);
+			half = 1ULL << (shift - 1);
+			rest = m & ((half << 1) - 1);
+			if (rest > half || (rest == half && (inexact || (mantissa & 1))))
+				mantissa++;
+		}
+		// the implicit bit of the mantissa (or a carry out of it) adds to the exponent
+		if (e >= 255)
+			bits.l = 0x7F800000UL;
+		else
+		{
+			bits.l = ((uint32_t)(e - 1) << 23) + mantissa;
+			if (bits.l > 0x7F800000UL)
+				bits.l = 0x7F800000UL;
+		}
+	}
+	if (negative)
+		bits.l |= 0x80000000UL;
+	return bits.f;
+}
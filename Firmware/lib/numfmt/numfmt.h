@@ -0,0 +1,53 @@
+#ifndef NUMFMT_H
+#define NUMFMT_H
+
+/*!
+ *  Number formatting and parsing for the communication protocol, without
+ *  printf, scanf, atoi or atof.
+ *
+ *  The dsPIC's printf formats a float with software floating point divisions
+ *  for every digit, and its atof is not much cheaper. Here a float is
+ *  written as fixed point decimal: its 24 bits mantissa times 10^decimals,
+ *  shifted by its exponent, in integer arithmetic. This gives exactly the
+ *  digits of printf's "%.*f", rounded half to even, as long as
+ *  |x| * 10^decimals < 2^63 (larger numbers are written as "inf"). A double
+ *  is a float on the dsPIC; on a host numfmt writes doubles with the
+ *  precision of a float.
+ *
+ *  numfmt_parse_float() reads the decimal digits as a 64 bits integer and
+ *  scales it by the power of 10 in integer arithmetic too. The result is
+ *  the nearest float, like strtof(), except within about 1e-17 (relative)
+ *  of the halfway point between 2 floats. Denormals are parsed, "inf" and
+ *  "nan" aren't (0).
+ *
+ *  Nothing is allocated: the numfmt_* writers write the number and a '\0'
+ *  to the caller's buffer (at most NUMFMT_SIZE bytes) and return a pointer
+ *  to that '\0', so they can be chained to build a line. numfmt_format()
+ *  does the same for a printf format, with the conversions of the protocol:
+ *  %d %i %u %x %c %s %%, the "l" modifier, and %f, %.Nf and %.*f with at
+ *  most 9 decimals. No field widths or flags.
+ *
+ *  Checked against the C library (snprintf, strtof) by sitl/numfmt_check.c.
+ *
+ *  @file     numfmt.h
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include <stdarg.h>
+
+#define NUMFMT_SIZE          32   //!< Longest number with its '\0'
+#define NUMFMT_MAX_DECIMALS  9
+
+char *numfmt_int(char *s, long x);
+char *numfmt_uint(char *s, unsigned long x);
+char *numfmt_hex(char *s, unsigned long x);
+char *numfmt_fixed(char *s, float x, int decimals);
+
+int numfmt_format(char *buffer, int size, const char *format, ...);
+int numfmt_vformat(char *buffer, int size, const char *format, va_list ap);
+
+long numfmt_parse_long(const char *s);
+float numfmt_parse_float(const char *s);
+
+#endif // NUMFMT_H
@@ -45,7 +45,7 @@ void pid_init(struct pid *pid, float d_gain, float p_gain, float i_gain, float i
 
 __attribute__((__const__)) int isNaN_PID (float* f)
 {
-	const int* rep = ((const int*) f) + 1;
+	const unsigned short* rep = ((const unsigned short*) f) + 1;
 	return ((*rep & 0x7F00) == 0x7F00);
 }
 
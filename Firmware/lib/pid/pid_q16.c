@@ -0,0 +1,129 @@
+/*!
+ *  Fixed point (Q16.16) PID controllers, updated as a bank.
+ *
+ *  pid_q16_update() computes the same as pid_update() in pid.c:
+ *    d = (position - d_state) / dt * d_gain, or 0 below d_term_min_var
+ *    i_state += position * dt, limited to [i_min, i_max]
+ *    out = d + i_state * i_gain + position * p_gain
+ *  but the division by dt is done once when the gains are loaded, the three
+ *  terms are summed in 64 bit with a single rounding and the output is
+ *  limited to [out_min, out_max]. There is no NaN check: a q16 can't be NaN.
+ *
+ *  The dsPIC's DSP instructions work on Q1.15 operands, which are too small
+ *  for gains and errors above 1, so plain 32x32 bit multiplies are used.
+ *
+ *  @file     pid_q16.c
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include "pid/pid_q16.h"
+
+
+/*!
+ *  Empties the bank.
+ *  @param dt  The fixed time between two updates, in seconds.
+ */
+void pid_q16_init(struct pid_q16_bank *bank, float dt)
+{
+	bank->loops = 0;
+	bank->dt = (uint32_t)(dt * 4294967296.0f);
+}
+
+
+/*!
+ *  Adds a loop to the bank, with the gains and the state of pid.
+ *  @param out_min Lower limit of the output.
+ *  @param out_max Upper limit of the output.
+ *  @return The index of the loop, or -1 when the bank is full.
+ */
+int pid_q16_add(struct pid_q16_bank *bank, const struct pid *pid, float out_min, float out_max)
+{
+	int loop = bank->loops;
+
+	if (loop >= PID_Q16_MAX_LOOPS)
+		return -1;
+	bank->loops++;
+
+	pid_q16_set_gains(bank, loop, pid);
+	bank->out_min[loop] = q16_from_float(out_min);
+	bank->out_max[loop] = q16_from_float(out_max);
+	bank->i_state[loop] = q16_from_float(pid->i_state);
+	bank->d_state[loop] = q16_from_float(pid->d_state);
+	return loop;
+}
+
+
+/*!
+ *  (Re)loads the gains and limits of a loop, e.g. after they were changed
+ *  through the configuration. The state of the loop is kept.
+ */
+void pid_q16_set_gains(struct pid_q16_bank *bank, int loop, const struct pid *pid)
+{
+	float dt = bank->dt * (1.0f / 4294967296.0f);
+
+	bank->p_gain[loop] = q16_from_float(pid->p_gain);
+	bank->i_gain[loop] = q16_from_float(pid->i_gain);
+	bank->d_gain_per_dt[loop] = q16_from_float(pid->d_gain / dt);
+	bank->d_min_delta[loop] = q16_from_float(pid->d_term_min_var * dt);
+	bank->i_min[loop] = q16_from_float(pid->i_min);
+	bank->i_max[loop] = q16_from_float(pid->i_max);
+}
+
+
+void pid_q16_reset(struct pid_q16_bank *bank, int loop)
+{
+	bank->i_state[loop] = 0;
+	bank->d_state[loop] = 0;
+}
+
+
+/*!
+ *  Updates one loop of the bank.
+ *  @param position The reading (proportional term).
+ *  @return The calculated pid output.
+ */
+q16 pid_q16_update(struct pid_q16_bank *bank, int loop, q16 position)
+{
+	int64_t acc;
+	q16 delta, i_state;
+
+	delta = q16_saturate((int64_t)position - bank->d_state[loop]);   // D-term
+	bank->d_state[loop] = position;
+
+	// to eliminate jittering which wears out servos
+	if (delta < bank->d_min_delta[loop] && delta > -bank->d_min_delta[loop])
+		acc = 0;
+	else
+		acc = (int64_t)delta * bank->d_gain_per_dt[loop];
+
+	// I-term. A q16 dt of 20ms is 0.02% off, enough to make the integrator drift: dt has 32 fractional bits
+	i_state = q16_saturate((int64_t)bank->i_state[loop] + (((int64_t)position * bank->dt + 0x80000000L) >> 32));
+	if (i_state > bank->i_max[loop])
+		i_state = bank->i_max[loop];
+	else if (i_state < bank->i_min[loop])
+		i_state = bank->i_min[loop];
+	bank->i_state[loop] = i_state;
+	acc += (int64_t)i_state * bank->i_gain[loop];
+
+	acc += (int64_t)position * bank->p_gain[loop];   // P-term
+
+	acc = (acc + 0x8000) >> 16;
+	if (acc > bank->out_max[loop])
+		return bank->out_max[loop];
+	if (acc < bank->out_min[loop])
+		return bank->out_min[loop];
+	return (q16)acc;
+}
+
+
+/*!
+ *  Updates every loop of the bank: out[i] is the output for position[i].
+ */
+void pid_q16_update_all(struct pid_q16_bank *bank, const q16 *position, q16 *out)
+{
+	int loop;
+
+	for (loop = 0; loop < bank->loops; loop++)
+		out[loop] = pid_q16_update(bank, loop, position[loop]);
+}
@@ -0,0 +1,47 @@
+#ifndef PID_Q16_H
+#define PID_Q16_H
+
+/*!
+ *  Fixed point (Q16.16) PID controllers, updated as a bank.
+ *
+ *  The gains are taken from the float struct pid of the configuration, so
+ *  the flash layout doesn't change. Per loop 1/dt and the derivative
+ *  threshold are precomputed, and the integrator and the output saturate at
+ *  their limits instead of overflowing.
+ *
+ *  The bank is a struct of arrays: pid_q16_update_all() updates every loop
+ *  in one pass over the same fields.
+ *
+ *  @file     pid_q16.h
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include "pid/pid.h"
+#include "q16/q16.h"
+
+#define PID_Q16_MAX_LOOPS 4
+
+struct pid_q16_bank
+{
+	int loops;
+	uint32_t dt;                            //!< In seconds, 32 fractional bits (dt < 1s)
+	q16 p_gain[PID_Q16_MAX_LOOPS];
+	q16 i_gain[PID_Q16_MAX_LOOPS];
+	q16 d_gain_per_dt[PID_Q16_MAX_LOOPS];   //!< d_gain / dt
+	q16 d_min_delta[PID_Q16_MAX_LOOPS];     //!< d_term_min_var * dt
+	q16 i_min[PID_Q16_MAX_LOOPS], i_max[PID_Q16_MAX_LOOPS];
+	q16 out_min[PID_Q16_MAX_LOOPS], out_max[PID_Q16_MAX_LOOPS];
+	q16 i_state[PID_Q16_MAX_LOOPS];
+	q16 d_state[PID_Q16_MAX_LOOPS];
+};
+
+void pid_q16_init(struct pid_q16_bank *bank, float dt);
+int pid_q16_add(struct pid_q16_bank *bank, const struct pid *pid, float out_min, float out_max);
+void pid_q16_set_gains(struct pid_q16_bank *bank, int loop, const struct pid *pid);
+void pid_q16_reset(struct pid_q16_bank *bank, int loop);
+
+q16 pid_q16_update(struct pid_q16_bank *bank, int loop, q16 position);
+void pid_q16_update_all(struct pid_q16_bank *bank, const q16 *position, q16 *out);
+
+#endif // PID_Q16_H
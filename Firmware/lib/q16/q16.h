@@ -0,0 +1,133 @@
+#ifndef Q16_H
+#define Q16_H
+
+/*!
+ *  Q16.16 fixed point arithmetic.
+ *
+ *  A q16 is a 32 bit signed integer with 16 fractional bits: range
+ *  [-32768, 32768) with a resolution of 1/65536. Products and quotients are
+ *  done in 64 bit so they are exact before the final rounding, and give the
+ *  same results on the dsPIC as on a host.
+ *
+ *  @file     q16.h
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include <stdint.h>
+
+typedef int32_t q16;
+
+#define Q16_ONE        ((q16)65536L)
+#define Q16_MAX        ((q16)INT32_MAX)
+#define Q16_MIN        ((q16)INT32_MIN)
+
+//! For constants only: rounds a floating point expression to a q16 at compile time
+#define Q16(x)         ((q16)((x) >= 0 ? (x) * 65536.0 + 0.5 : (x) * 65536.0 - 0.5))
+
+
+static inline q16 q16_from_float(float f)
+{
+	return (q16)(f * 65536.0f);
+}
+
+static inline float q16_to_float(q16 a)
+{
+	return (float)a * (1.0f / 65536.0f);
+}
+
+static inline q16 q16_saturate(int64_t a)
+{
+	if (a > Q16_MAX)
+		return Q16_MAX;
+	if (a < Q16_MIN)
+		return Q16_MIN;
+	return (q16)a;
+}
+
+//! Rounds a 64 bit Q32 intermediate (sum of q16 products) back to q16
+static inline q16 q16_from_q32(int64_t a)
+{
+	return q16_saturate((a + 0x8000) >> 16);
+}
+
+static inline q16 q16_mul(q16 a, q16 b)
+{
+	return q16_from_q32((int64_t)a * b);
+}
+
+//! a*b + c*d with a single rounding
+static inline q16 q16_dot2(q16 a, q16 b, q16 c, q16 d)
+{
+	return q16_from_q32((int64_t)a * b + (int64_t)c * d);
+}
+
+//! a*b + c*d + e*f with a single rounding
+static inline q16 q16_dot3(q16 a, q16 b, q16 c, q16 d, q16 e, q16 f)
+{
+	return q16_from_q32((int64_t)a * b + (int64_t)c * d + (int64_t)e * f);
+}
+
+//! Saturates instead of dividing by zero
+static inline q16 q16_div(q16 a, q16 b)
+{
+	if (b == 0)
+		return a >= 0 ? Q16_MAX : Q16_MIN;
+	return q16_saturate(((int64_t)a << 16) / b);
+}
+
+//! Integer square root (bit by bit, no division)
+static inline uint32_t q16_isqrt64(uint64_t x)
+{
+	uint64_t result = 0, bit = (uint64_t)1 << 62;
+
+	while (bit > x)
+		bit >>= 2;
+	while (bit != 0)
+	{
+		if (x >= result + bit)
+		{
+			x -= result + bit;
+			result = (result >> 1) + bit;
+		}
+		else
+			result >>= 1;
+		bit >>= 2;
+	}
+	return (uint32_t)result;
+}
+
+static inline q16 q16_sqrt(q16 a)
+{
+	return a <= 0 ? 0 : (q16)q16_isqrt64((uint64_t)a << 16);
+}
+
+//! sqrt(a*a + b*b) without overflowing the squares
+static inline q16 q16_hypot(q16 a, q16 b)
+{
+	return q16_saturate(q16_isqrt64((uint64_t)((int64_t)a * a) + (uint64_t)((int64_t)b * b)));
+}
+
+/*!
+ *  Sine and cosine of an angle in radians, any value. The angle is reduced
+ *  to [-pi/4, pi/4] around the nearest multiple of pi/2 and the Taylor
+ *  polynomials up to r^7 and r^6 are evaluated there: a few 1/65536 off.
+ */
+static inline void q16_sincos(q16 x, q16 *s, q16 *c)
+{
+	int32_t k = (int32_t)(((int64_t)x * Q16(0.636619772) + 0x80000000LL) >> 32);  // x * 2/pi, rounded
+	q16 r = x - (q16)(((int64_t)k * 1686629713LL + 0x2000) >> 14);               // pi/2 as Q30
+	q16 r2 = q16_mul(r, r);
+	q16 sin_r = r + q16_mul(r, q16_mul(r2, Q16(-1.0/6.0) + q16_mul(r2, Q16(1.0/120.0) + q16_mul(r2, Q16(-1.0/5040.0)))));
+	q16 cos_r = Q16_ONE + q16_mul(r2, Q16(-1.0/2.0) + q16_mul(r2, Q16(1.0/24.0) + q16_mul(r2, Q16(-1.0/720.0))));
+
+	switch (k & 3)
+	{
+		case 0:  *s = sin_r;  *c = cos_r;  break;
+		case 1:  *s = cos_r;  *c = -sin_r; break;
+		case 2:  *s = -sin_r; *c = -cos_r; break;
+		default: *s = -cos_r; *c = sin_r;  break;
+	}
+}
+
+#endif // Q16_H
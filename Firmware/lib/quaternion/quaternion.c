@@ -10,21 +10,20 @@
  *  @since    0.1
  */
  
-#include <errno.h>
 #include <math.h>
 #include "quaternion.h"
+#include "fastmath/fastmath.h"
 
 /*!
  *	 Initialize quaternion (q[4]) with roll, pitch and yaw euclidian angles.
  */
 void quaternion_from_attitude (const float roll, const float pitch, const float yaw, float* q)
 {
-	float cos_roll_2 = cosf(roll/2.0);
-	float sin_roll_2 = sinf(roll/2.0);
-	float cos_pitch_2 = cosf(pitch/2.0);
-	float sin_pitch_2 = sinf(pitch/2.0);
-	float cos_yaw_2 = cosf(yaw/2.0);
-	float sin_yaw_2 = sinf(yaw/2.0);
+	float cos_roll_2, sin_roll_2, cos_pitch_2, sin_pitch_2, cos_yaw_2, sin_yaw_2;
+
+	fastmath_sincos(roll/2.0, &sin_roll_2, &cos_roll_2);
+	fastmath_sincos(pitch/2.0, &sin_pitch_2, &cos_pitch_2);
+	fastmath_sincos(yaw/2.0, &sin_yaw_2, &cos_yaw_2);
 
 	q[0] = cos_roll_2 * cos_pitch_2 * cos_yaw_2 + sin_roll_2 * sin_pitch_2 * sin_yaw_2;
 	q[1] = sin_roll_2 * cos_pitch_2 * cos_yaw_2 - cos_roll_2 * sin_pitch_2 * sin_yaw_2;
@@ -67,47 +66,34 @@ void quaternion_update_with_rates (const float rollrate, const float pitchrate,
 
 float quaternion_to_roll (const float* q)
 {
-	float r;
-	errno = 0;
-	r = atan2( 2.0 * ( q[2]*q[3] + q[0]*q[1] ) ,
-	             (1.0 - 2.0 * (q[1]*q[1] + q[2]*q[2])) );  
-	if (errno)
-		return  0.0;
-	else
-		return r;
+	return fastmath_atan2( 2.0 * ( q[2]*q[3] + q[0]*q[1] ) ,
+	                       (1.0 - 2.0 * (q[1]*q[1] + q[2]*q[2])) );  
 }	
 
 float quaternion_to_pitch(const float* q)
 {
-	float r;
-	errno = 0;
-	r = asinf( -2.0 * (q[1]*q[3] - q[0]*q[2]) );	
-	if (errno)
+	float r = -2.0 * (q[1]*q[3] - q[0]*q[2]);
+
+	if (r > 1.0 || r < -1.0)   // asin's domain error
 		return  0.0;
 	else
-		return r;
+		return fastmath_asin(r);
 }
 
 
 float quaternion_to_yaw(const float* q)
 {
-	float r;
-	errno = 0;
-	r = atan2( 2.0 * ( q[0]*q[3] + q[1]*q[2] ) ,
-	          (1.0 - 2.0 * (q[2]*q[2] + q[3]*q[3])) );  
-	if (errno)
-		return  0.0;
-	else
-		return r;
+	return fastmath_atan2( 2.0 * ( q[0]*q[3] + q[1]*q[2] ) ,
+	                       (1.0 - 2.0 * (q[2]*q[2] + q[3]*q[3])) );  
 }	
 
 void quaternion_normalize(float *q)
 {
-	float norm = sqrtf(q[0]*q[0] + q[1]*q[1] + q[2]*q[2] + q[3]*q[3]);
+	float inv_norm = fastmath_invsqrt(q[0]*q[0] + q[1]*q[1] + q[2]*q[2] + q[3]*q[3]);
 
-	q[0] /= norm;	
-	q[1] /= norm;
-	q[2] /= norm;
-	q[3] /= norm;
+	q[0] *= inv_norm;	
+	q[1] *= inv_norm;
+	q[2] *= inv_norm;
+	q[3] *= inv_norm;
 }
 
@@ -1,16 +1,41 @@
 
+#include <string.h>
+
 #include "microcontroller/microcontroller.h"
 #include "uart1_queue/uart1_queue.h"
 
 #include "FreeRTOS/FreeRTOS.h"
 #include "FreeRTOS/queue.h"
 #include "FreeRTOS/task.h"
+#include "FreeRTOS/semphr.h"
+
+#define TX_MASK (UART1_TX_BUFFER_SIZE - 1)
+#define RX_MASK (UART1_RX_BUFFER_SIZE - 1)
+#define RX_POLL_TICKS (( portTickType ) 10 / portTICK_RATE_MS)   // a line that ends in a block is found this late
+
+/*
+ *   Receiving: DMA channel 1 copies every received character into rx_buffer,
+ *   in continuous ping-pong mode over its two halves, so it's a ring buffer
+ *   filled without the CPU. The dsPIC33F DMA can't tell how far it got in a
+ *   block: uart1_getline() clears every character it reads, a '\0' is a
+ *   position the DMA didn't write yet. The task is woken at the end of every
+ *   block, and every RX_POLL_TICKS to find the end of a shorter line.
+ */
+static char rx_buffer[UART1_RX_BUFFER_SIZE] __attribute__((space(dma),aligned(UART1_RX_BUFFER_SIZE)));
+static unsigned int rx_read = 0;            // next character for uart1_getline()
+static xSemaphoreHandle rx_block_done;
+volatile unsigned int uart1_rx_overruns = 0;
 
-xQueueHandle xRxedChars;
+static char tx_buffer[UART1_TX_BUFFER_SIZE];
+static volatile unsigned int tx_head = 0;   // next free position, moved by the writers
+static volatile unsigned int tx_tail = 0;   // next character to send, moved by _U1TXInterrupt
+volatile unsigned int uart1_tx_overflows = 0;
+static long baudrate;
 
 void uart1_queue_init(long baud)
 {
-    xRxedChars = xQueueCreate( 300, ( unsigned portBASE_TYPE ) sizeof( char ) ); // problem in simulation mode if buffer is too small
+	vSemaphoreCreateBinary( rx_block_done );
+	memset(rx_buffer, 0, sizeof(rx_buffer));
 
 	// configure U2MODE
 	U1MODEbits.UARTEN = 0;	// Bit15 TX, RX DISABLED, ENABLE at end of func
@@ -33,9 +58,10 @@ void uart1_queue_init(long baud)
 	//  U2BRG = 65
 	
 	U1BRG = (int)(FCY / (16*baud) - 1);	
+	baudrate = baud;
 	
 	// Load all values in for U1STA SFR
-	U1STAbits.UTXISEL1 = 0;	//Bit15 Int when Char is transferred (1/2 config!)
+	U1STAbits.UTXISEL1 = 1;	//Bit15 Int when the transmit buffer becomes empty (1/2 config!)
 	
 	U1STAbits.UTXINV = 0;	//Bit14 N/A, IRDA config
 	U1STAbits.UTXISEL0 = 0;	//Bit13 Other half of Bit15
@@ -46,81 +72,262 @@ void uart1_queue_init(long baud)
 
 	//IPC7 = 0x4400;	// Mid Range Interrupt Priority level, no urgent reason
 
-//	IFS1bits.U1TXIF = 0;	// Clear the Transmit Interrupt Flag
-	//IEC1bits.U1TXIE = 1;	// Enable Transmit Interrupts
+	IEC0bits.U1TXIE = 0;	// Enabled by uart1_put() when there is something to send
 
-	IEC0bits.U1RXIE = 1;	// Enable Recieve Interrupts
+	IEC0bits.U1RXIE = 0;	// Received characters are moved by DMA1, not by an interrupt
+	IEC4bits.U1EIE = 1;		// Overrun errors would stop the receiver
+
+	DMA1CONbits.SIZE = 1;	// Bytes
+	DMA1CONbits.DIR = 0;	// Peripheral to RAM
+	DMA1CONbits.AMODE = 0;	// Register indirect with post-increment
+	DMA1CONbits.MODE = 2;	// Continuous, ping-pong: a block in each half of rx_buffer
+	DMA1REQ = 11;			// UART1RX
+	DMA1PAD = (volatile unsigned int) &U1RXREG;
+	DMA1STA = __builtin_dmaoffset(rx_buffer);
+	DMA1STB = __builtin_dmaoffset(rx_buffer) + UART1_RX_BUFFER_SIZE / 2;
+	DMA1CNT = UART1_RX_BUFFER_SIZE / 2 - 1;
+	IFS0bits.DMA1IF = 0;
+	IEC0bits.DMA1IE = 1;
+	DMA1CONbits.CHEN = 1;
 
 	U1MODEbits.UARTEN = 1;	// And turn the peripheral on
 
 	U1STAbits.UTXEN = 1;
-    _U1RXIP = configKERNEL_INTERRUPT_PRIORITY; // same as freerots?
+    _DMA1IP = configKERNEL_INTERRUPT_PRIORITY;
+    _U1EIP = configKERNEL_INTERRUPT_PRIORITY;
+    _U1TXIP = configKERNEL_INTERRUPT_PRIORITY;
+    IFS0bits.U1TXIF = 1;    // Set while the transmit buffer is empty: _U1TXInterrupt runs when enabled
 }	
 
-static const char newline = '\n';
-void __attribute__((__interrupt__, auto_psv)) _U1RXInterrupt( void )
+/*!
+ *   A block (half of rx_buffer) is full: wakes uart1_getline(). The DMA
+ *   continues in the other half, which should have been read by now.
+ */
+void __attribute__((__interrupt__, auto_psv)) _DMA1Interrupt( void )
 {
-	char cChar;
+	static int next_block = 1;
 	portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
 
-	/* Get the character and post it on the queue of Rxed characters.
-	If the post causes a task to wake force a context switch as the woken task
-	may have a higher priority than the task we have interrupted. */
+	IFS0bits.DMA1IF = 0;
+	if (rx_buffer[next_block * UART1_RX_BUFFER_SIZE / 2] != '\0')
+		uart1_rx_overruns++;   // not read yet, it will be overwritten
+	next_block ^= 1;
+	xSemaphoreGiveFromISR( rx_block_done, &xHigherPriorityTaskWoken );
+	if( xHigherPriorityTaskWoken != pdFALSE )
+	{
+		taskYIELD();
+	}
+}
 
 
-    if (U1STAbits.OERR) // buffer overrun, no way we can receive correct data! (add '\n' to reset parser)
+void __attribute__((__interrupt__, auto_psv)) _U1ErrInterrupt( void )
+{
+    if (U1STAbits.OERR) // buffer overrun, the receiver stops until it is cleared
     {
         U1STAbits.OERR = 0;
-        //uart1_puts("\r\nreceive buffer overrun\r\n");
-        //xQueueSendFromISR( xRxedChars, &newline, &xHigherPriorityTaskWoken );  // reset parser
+        uart1_rx_overruns++;
     }
-	
-	while( U1STAbits.URXDA )
+	IFS4bits.U1EIF = 0;
+}
+
+
+/*!
+ *   @return 1 when the character at rx_read was received: it isn't '\0', or
+ *           it is a '\0' that was received because characters after it were
+ *           (the DMA writes the ring in order)
+ */
+static int rx_available()
+{
+	int i;
+
+	for (i = 0; i < 8; i++)
+		if (rx_buffer[(rx_read + i) & RX_MASK] != '\0')
+			return 1;
+	return 0;
+}
+
+
+/*!
+ *   Waits for a complete line and copies it to "line", without the '\r' or
+ *   '\n' at its end. Empty lines are skipped.
+ *   @return The length of the line, -1 when it didn't fit in size (the
+ *           characters up to the end of the line are dropped)
+ */
+int uart1_getline(char *line, int size)
+{
+	int length = 0;
+
+	for (;;)
 	{
-		cChar = U1RXREG;
-		if (xQueueSendFromISR( xRxedChars, &cChar, &xHigherPriorityTaskWoken ) == errQUEUE_FULL)  // oh no, the queue is full
-        {
-            if (xQueueReset(xRxedChars) == pdFALSE)  // empty it to avoid another full queue in the near future
-            {
-                uart1_puts("\r\nUnable to reset a blocked queue\r\n");
-            } else
-            {
-                uart1_puts("\r\nQueue reset\r\n");
-                xQueueSendFromISR( xRxedChars, &newline, &xHigherPriorityTaskWoken );  // reset parser
-            }
-        }
+		char c;
+
+		if (! rx_available())
+		{
+			xSemaphoreTake( rx_block_done, RX_POLL_TICKS );
+			continue;
+		}
+		c = rx_buffer[rx_read];
+		rx_buffer[rx_read] = '\0';
+		rx_read = (rx_read + 1) & RX_MASK;
+
+		if (c == '\n' || c == '\r')
+		{
+			if (length > 0 && length < size)
+			{
+				line[length] = '\0';
+				return length;
+			}
+			if (length >= size)
+				return -1;
+		}
+		else if (c != '\0' && length++ < size - 1)
+			line[length - 1] = c;
 	}
-	IFS0bits.U1RXIF = 0;
-	// NO YIELDING! We are in an interrupt routine, and parsing input is not urgent anyway
-    if( xHigherPriorityTaskWoken != pdFALSE )
+}
+
+/*!
+ *   Fills the 4 character transmit FIFO from the ring buffer. Interrupts again
+ *   when the FIFO is empty, until the ring buffer is.
+ */
+void __attribute__((__interrupt__, auto_psv)) _U1TXInterrupt( void )
+{
+	IFS0bits.U1TXIF = 0;
+	while (tx_tail != tx_head && ! U1STAbits.UTXBF)
 	{
-		taskYIELD();
+		U1TXREG = tx_buffer[tx_tail];
+		tx_tail = (tx_tail + 1) & TX_MASK;
 	}
+	if (tx_tail == tx_head)
+		IEC0bits.U1TXIE = 0;
 }
 
-void uart1_puts(char *str)
+
+/*!
+ *   @return 1 when _U1TXInterrupt can't run: before the scheduler starts (the
+ *           kernel keeps the interrupts masked once a task is created), in an
+ *           interrupt routine or in a critical section.
+ */
+static int tx_masked()
 {
-	while(*str != '\0')
+	return SRbits.IPL >= _U1TXIP;
+}
+
+
+/*!
+ *   Sends the ring buffer and then str, waiting for the uart: for when the
+ *   transmit interrupt can't empty the buffer.
+ */
+static void tx_polled(char *str, int len)
+{
+	while (tx_tail != tx_head)
 	{
 		while(U1STAbits.UTXBF)
 			;  /* wait if the buffer is full */
-		U1TXREG = *str++;   /* transfer data byte to TX reg */
+		U1TXREG = tx_buffer[tx_tail];
+		tx_tail = (tx_tail + 1) & TX_MASK;
+	}
+	while(len-- > 0)
+	{
+		while(U1STAbits.UTXBF)
+			;
+		U1TXREG = *str++;
 	}
 }
 
+
+unsigned int uart1_tx_free()
+{
+	return (tx_tail - tx_head - 1) & TX_MASK;
+}
+
+
+long uart1_baudrate()
+{
+	return baudrate;
+}
+
+
+/*!
+ *   Queues len characters without waiting. When they don't all fit, nothing
+ *   is queued and uart1_tx_overflows is incremented.
+ */
 void uart1_put(char *str, int len)
 {
-	while(len-- > 0)
+	unsigned int first;
+
+	if (tx_masked())
 	{
-		while(U1STAbits.UTXBF)
-			;  /* wait if the buffer is full */
-		U1TXREG = *str++;   /* transfer data byte to TX reg */
+		tx_polled(str, len);
+		return;
 	}
+	INTERRUPT_PROTECT(
+		if (len > uart1_tx_free())
+		{
+			uart1_tx_overflows++;
+			len = 0;
+		}
+		first = UART1_TX_BUFFER_SIZE - tx_head;   // room up to the end of the ring
+		if (first > len)
+			first = len;
+		memcpy(&tx_buffer[tx_head], str, first);
+		memcpy(tx_buffer, str + first, len - first);
+		tx_head = (tx_head + len) & TX_MASK;
+	);
+	if (len > 0)
+		IEC0bits.U1TXIE = 1;   // _U1TXInterrupt runs right away when the uart is idle (U1TXIF is set)
 }
 
+
+void uart1_puts(char *str)
+{
+	uart1_put(str, strlen(str));
+}
+
+
 void uart1_putc(char c)
 {
-	while(U1STAbits.UTXBF)
-			;
-	U1TXREG = c;
+	uart1_put(&c, 1);
+}
+
+
+/*!
+ *   Waits (in a task) until there is room for "space" characters.
+ */
+void uart1_tx_wait(unsigned int space)
+{
+	while (uart1_tx_free() < space)
+	{
+		if (tx_masked())
+			tx_polled(NULL, 0);
+		else
+			vTaskDelay(1);
+	}
+}
+
+
+/*!
+ *   Queues len characters, waiting for room when the buffer is full.
+ */
+void uart1_put_wait(char *str, int len)
+{
+	while (len > 0)
+	{
+		int n = len < UART1_TX_BUFFER_SIZE / 2 ? len : UART1_TX_BUFFER_SIZE / 2;
+
+		uart1_tx_wait(n);
+		uart1_put(str, n);
+		str += n;
+		len -= n;
+	}
+}
+
+
+/*!
+ *   Called by the C library for printf and everything else that goes to
+ *   stdout or stderr: these end up in the ring buffer too.
+ */
+int write(int handle, void *buffer, unsigned int len)
+{
+	uart1_put((char*)buffer, len);
+	return len;
 }
@@ -1,7 +1,30 @@
 
+/*!
+ *  Everything sent to uart1 (uart1_put*, and printf through write()) goes
+ *  into a ring buffer that the transmit interrupt empties in the background,
+ *  so the tasks don't wait for the characters to go out at 57600 baud.
+ *  A write that doesn't fit in the buffer is dropped as a whole and counted
+ *  in uart1_tx_overflows. uart1_put_wait() and uart1_tx_wait() wait for room
+ *  instead, for output that may not be lost (log readouts, command replies).
+ *
+ *  Received characters are moved into a ring buffer by DMA, the task that
+ *  reads them (uart1_getline()) is woken per line instead of per character.
+ */
+
+#define UART1_TX_BUFFER_SIZE 512    // power of 2
+#define UART1_RX_BUFFER_SIZE 256    // power of 2, in DMA RAM
+
+extern volatile unsigned int uart1_tx_overflows;   // writes dropped because the buffer was full
+extern volatile unsigned int uart1_rx_overruns;    // received characters lost: read too late
+
 void uart1_queue_init(long baud);
 void uart1_puts(char *str);
 void uart1_putc(char c);
 void uart1_put(char *str, int len);
+void uart1_put_wait(char *str, int len);
+unsigned int uart1_tx_free();
+long uart1_baudrate();
+void uart1_tx_wait(unsigned int space);
+int uart1_getline(char *line, int size);
 
 
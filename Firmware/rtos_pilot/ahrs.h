@@ -1,6 +1,9 @@
 #ifndef AHRS_H
 #define AHRS_H
 
+// Fixed point attitude filter (ahrs_kalman_2x3_q16.c) instead of ahrs_kalman_2x3.c
+//#define AHRS_FIXED_POINT 1
+
 void ahrs_filter(float dt);
 void ahrs_init();
 
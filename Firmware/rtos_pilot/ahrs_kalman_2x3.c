@@ -6,6 +6,10 @@
  *
  *  y = measurement = [acc_x acc_y acc_z]
  *
+ *  R is diagonal, so the three accelerometer axes are fused one after the
+ *  other: each needs a scalar division instead of a 3x3 inverse. Only the
+ *  upper half of the symmetric P is stored: P = [P[0] P[1]; P[1] P[2]].
+ *
  *  See http://www.gluonpilot.com/wiki/Matlab_attitude_estimation
  *
  *  @file     ahrs_kalman_2x3.c
@@ -14,6 +18,10 @@
  *  @since    0.1
  */
  
+#include "ahrs.h"
+
+#ifndef AHRS_FIXED_POINT
+
 #ifdef ENABLE_QUADROCOPTER
 #error Please use ahrs_simple_quaternion_c for multicopter use!
 #endif
@@ -21,6 +29,7 @@
 #include <math.h>
  
 #include "button/button.h"
+#include "fastmath/fastmath.h"
 #include "matrix/matrix.h"
 #include "pid/pid.h"
 #include "quaternion/quaternion.h"
@@ -30,13 +39,9 @@
 #include "common.h"
 
 
-static float sin_lookup[182];  // lookup table to avoid sinus calculations
-
 float gravity_to_roll(float a_y, float a_z);
 float gravity_to_pitch(float a_x, float a_z);
 
-inline float fast_sin(float x);
-inline float fast_cos(float x);
 __attribute__((__const__)) int isNaN (float* f) ;
 
 static float pitch_rad = 0.0, roll_rad = 0.0;
@@ -46,14 +51,6 @@ float roll_rad_sum_error = 0.0;
 
 void ahrs_init()
 {
-	float x;
-	int i;
-	
-	for (x=(-3.14159f), i = 0; i < 181; x+=(2.0f/180.0f*3.14159f), i++)
-	{
-		sin_lookup[i] = sinf(x);
-	}	
-	
 	// initialize our attitude with the current accelerometer's data
 	//printf("-> %f %f %f <-\r\n", sensor_data.acc_x, sensor_data.acc_y, sensor_data.acc_z);
     pitch_rad = gravity_to_pitch(sensor_data.acc_x, sensor_data.acc_z);
@@ -138,12 +135,14 @@ void ahrs_filter(float dt)
 	static float sin_pitch=0.0;
 	static float cos_pitch=1.0;
 	static float tan_pitch=0.0;
-	static float df_dx[4] = {0.0, 0.0, 0.0, 0.0};
-	static float P[4] = {1.0, 0.0, 0.0, 1.0};
-	static float tmp1[9];
-	static float tmp2[9];
+	static float df_dx[3] = {0.0, 0.0, 0.0};
+	static float P[3] = {1.0, 0.0, 1.0};
 	static float dh_dx_3x2[6];
-	static float L[6];
+	// x-axis = forward acceleration (not compensated), so less thrustworthy
+	// z-axis = vertical acceleration (not compensated for the moment, possibly using barometer?)
+	static const float R[3] = {40.0f, 30.0f, 35.0f};
+	float tmp1[3];
+	float tmp2[2];
 
 
 	/*if (button_down())
@@ -170,10 +169,8 @@ void ahrs_filter(float dt)
 	normalize(pitch_rad, roll_rad, sensor_data.yaw);
 	normalize_pitch_roll();
     
-	sin_roll = fast_sin(roll_rad);
-    cos_roll = fast_cos(roll_rad);
-    sin_pitch = fast_sin(pitch_rad);
-    cos_pitch = fast_cos(pitch_rad);
+	fastmath_sincos(roll_rad, &sin_roll, &cos_roll);
+	fastmath_sincos(pitch_rad, &sin_pitch, &cos_pitch);
 
     if (fabs(cos_pitch) < 0.02f)  // to avoid /0 and very large values. Here we will assume the values cant be larger than +-89
     {
@@ -194,19 +191,17 @@ void ahrs_filter(float dt)
 
 	//    A = df_dx;
     //    P = P + dt * (A*P + P*A' + Q);
-    
-    /* optimize me: P is symmectric: P[1] = P[2] */
-    matrix_2x2_mul(df_dx, P, tmp1);   // A * P = tmp1
-    matrix_2x2_mul_transp(P, df_dx, tmp2);  //  P * A' = tmp2
-    tmp2[0] += 0.1f + tmp1[0];     // Q(1) = 0.1 for roll
-    tmp2[1] += tmp1[1];
-    //tmp2[2] += tmp1[2];
-    tmp2[3] += 0.04f + tmp1[3];    // Q(2) = 0.02 for pitch, because the accelerometer is undergoing more non-compensated accelerations (at take-off for example)
-    P[0] += tmp2[0] * dt;
-    P[1] += tmp2[1] * dt;
-    //P[2] += tmp2[2] * dt;
-    P[2] = P[1];
-    P[3] += tmp2[3] * dt;
+    // A*P + P*A' is symmetric, so only its upper half is calculated
+    {
+        float ap_00 = df_dx[0] * P[0] + df_dx[1] * P[1];  // (A*P)[0][0]
+        float ap_01 = df_dx[0] * P[1] + df_dx[1] * P[2];  // (A*P)[0][1]
+        float ap_10 = df_dx[2] * P[0];                    // (A*P)[1][0] = (P*A')[0][1]
+        float ap_11 = df_dx[2] * P[1];                    // (A*P)[1][1]
+
+        P[0] += (2.0f * ap_00 + 0.1f) * dt;     // Q(1) = 0.1 for roll
+        P[1] += (ap_01 + ap_10) * dt;
+        P[2] += (2.0f * ap_11 + 0.04f) * dt;    // Q(2) = 0.04 for pitch, because the accelerometer is undergoing more non-compensated accelerations (at take-off for example)
+    }
     
     ////////////////////////////////
     
@@ -226,13 +221,14 @@ void ahrs_filter(float dt)
 	    float w_dpitch = cos_roll * (cos_pitch * sensor_data.gps.speed_ms - sin_pitch * dh);*/
 	    
 	    /* Without dh: */
-	  	float u = sqrt(sensor_data.gps.speed_ms*sensor_data.gps.speed_ms + dh*dh);
+	  	float u = fastmath_sqrt(sensor_data.gps.speed_ms*sensor_data.gps.speed_ms + dh*dh);
 		float w = dh*cos_pitch*cos_roll; //cos_roll * sin_pitch * sensor_data.gps.speed_ms;
 	
 	    //float w_droll = -sin_roll * (sin_pitch * sensor_data.gps.speed_ms);
 	    //float u_dpitch = -sin_pitch * sensor_data.gps.speed_ms;
 	    //float w_dpitch = cos_roll * (cos_pitch * sensor_data.gps.speed_ms);
 	    float w_droll = 0.0; float u_dpitch = 0.0; float w_dpitch = 0.0;
+	    int j;
 
 
 	    dh_dx_3x2[0] = sensor_data.q/G*w_droll;
@@ -242,59 +238,6 @@ void ahrs_filter(float dt)
 	    dh_dx_3x2[4] = sin_roll*cos_pitch - sensor_data.p*w_droll/G;
 	    dh_dx_3x2[5] = cos_roll*sin_pitch + (sensor_data.p*w_dpitch - sensor_data.q*u_dpitch)/G;
 	    
-	    /*
-	    C = dh_dx;  %C:3x2   P:2x2
-		L = P*C'*(R + C*P*C')^-1;  % 2x3
-	   	P = (eye(2,2) - L*C)*P;
-	   	*/
-	   	matrix_3x2_times_2x2(dh_dx_3x2, P, tmp1);  // C * P = tmp1
-	   	matrix_3x2_times_3x2_transp(tmp1, dh_dx_3x2, tmp2);  // tmp1 * C' = tmp2
-	   	//R = diag([0.25 0.25 0.25]);
-	   	
-	   	
-	   	tmp2[0] += 40.0f;   // x-axis = forward acceleration (not compensated), so less thrustworthy
-	   	tmp2[4] += 30.0f;
-	   	tmp2[8] += 35.0f;   // z-axis = vertical acceleration (not compensated for the moment, possibly using barometer?)
-	   	
-        float d;
-        //INVERT_3X3(tmp1, d, tmp2); // result = tmp1
-        DETERMINANT_3X3 (d, tmp2);
-        if (fabs(d) < 0.01f)
-        {
-            uart1_puts("\r\n!!\r\n"); // debug output to let us know
-            if (d > 0.0)
-            {
-                SCALE_ADJOINT_3X3 (tmp1, 9999.0f, tmp2);
-            }
-            else // if (d < 0.0)
-            {
-                SCALE_ADJOINT_3X3 (tmp1, -9999.0f, tmp2);
-            }
-        }
-        else
-        {
-            SCALE_ADJOINT_3X3 (tmp1, (1.0 / (d)), tmp2);
-        }
-
-
-	   	// P * C'  [2x3] = tmp2
-	   	matrix_2x2_times_3x2_transp(P, dh_dx_3x2, tmp2);  // P * C' = tmp2
-	   	
-	   	// L = tmp2 * tmp1   [2x3]
-	   	matrix_2x3_times_3x3(tmp2, tmp1, L);
-	   	
-	   	// P = (eye(2,2) - L*C)*P;
-	   	matrix_2x3_times_3x2(L, dh_dx_3x2, tmp1);
-	   	tmp2[0] = 1.0f - tmp1[0];
-	   	tmp2[1] = -tmp1[1];
-	   	tmp2[2] = -tmp1[2];
-	   	tmp2[3] = 1.0f - tmp1[3];
-	   	matrix_2x2_mul(tmp2, P, tmp1);
-	   	P[0] = tmp1[0];
-	   	P[1] = tmp1[1];
-	   	P[2] = tmp1[2];
-	   	P[3] = tmp1[3];
-	   	
 	   	/*
 	   	h = [q(i)*w/G + sin_pitch; ...
 	         (r(i)*u - p(i)*w )/G - cos_pitch*sin_roll; ...
@@ -305,10 +248,32 @@ void ahrs_filter(float dt)
 	    tmp1[1] = sensor_data.acc_y - ((sensor_data.r*u - sensor_data.p*w)/G - cos_pitch*sin_roll);
 	    tmp1[2] = sensor_data.acc_z - ((sensor_data.p*w - sensor_data.q*u)/G  - cos_pitch*cos_roll);
 		
-		// x = x + L*([a_x(i);a_y(i);a_z(i)] - h);
+		/*
+		C = dh_dx;  %C:3x2   P:2x2
+		x = x + L*([a_x(i);a_y(i);a_z(i)] - h);   with L = P*C'*(R + C*P*C')^-1
+		P = (eye(2,2) - L*C)*P;
 		
-		tmp2[0] = L[0] * tmp1[0] + L[1] * tmp1[1] +  L[2] * tmp1[2];  // roll "error"
-		tmp2[1] = L[3] * tmp1[0] + L[4] * tmp1[1] +  L[5] * tmp1[2];  // pitch "error"
+		One axis k at a time, with c = C(k,:):
+		s = c*P*c' + R(k,k);  l = P*c'/s;
+		x = x + l*(y(k) - h(k) - c*(x - x_prior));  P = P - l*s*l';
+		which gives the same x and P. s >= R(k,k), so there is no singular case.
+		*/
+		tmp2[0] = 0.0f;  // roll "error"
+		tmp2[1] = 0.0f;  // pitch "error"
+		for (j = 0; j < 3; j++)
+		{
+			float c0 = dh_dx_3x2[M3x2(j,0)], c1 = dh_dx_3x2[M3x2(j,1)];
+			float pc0 = P[0] * c0 + P[1] * c1;   // P * c'
+			float pc1 = P[1] * c0 + P[2] * c1;
+			float s_inv = 1.0f / (c0 * pc0 + c1 * pc1 + R[j]);
+			float e = (tmp1[j] - c0 * tmp2[0] - c1 * tmp2[1]) * s_inv;
+
+			tmp2[0] += pc0 * e;
+			tmp2[1] += pc1 * e;
+			P[0] -= pc0 * pc0 * s_inv;
+			P[1] -= pc0 * pc1 * s_inv;
+			P[2] -= pc1 * pc1 * s_inv;
+		}
 		
 	    roll_rad = roll_rad + tmp2[0];
 	    pitch_rad = pitch_rad + tmp2[1];
@@ -356,7 +321,7 @@ void ahrs_filter(float dt)
 		float XH = mx*cos_pitch + my*sin_roll*sin_pitch + mz*cos_roll*sin_pitch;
 
         
-        float magneto_yaw = atan2f (-YH, XH);
+        float magneto_yaw = fastmath_atan2(-YH, XH);
         
         if (magneto_yaw >= DEG2RAD(360.0))
 				magneto_yaw -= DEG2RAD(360.0);
@@ -435,7 +400,7 @@ void ahrs_filter(float dt)
 
 __attribute__((__const__)) int isNaN (float* f)
  {
-        int* rep = ((int*) f) + 1;
+        unsigned short* rep = ((unsigned short*) f) + 1;
         return ((*rep & 0x7F00) == 0x7F00);
  }
 
@@ -447,7 +412,7 @@ __attribute__((__const__)) int isNaN (float* f)
  */
 float gravity_to_roll(float a_y, float a_z)
 {
-	float roll_acc = atan(a_y / a_z);
+	float roll_acc = fastmath_atan(a_y / a_z);
 	if (a_z > 0.0f)
 	{
 		if (a_y < 0.0f)	
@@ -466,7 +431,7 @@ float gravity_to_roll(float a_y, float a_z)
  */
 float gravity_to_pitch(float a_x, float a_z)
 {
-	float pitch_acc = -atan(a_x / a_z); // replace with asin?
+	float pitch_acc = -fastmath_atan(a_x / a_z); // replace with asin?
 
 	if (a_z > 0.0f)
 		pitch_acc =  -pitch_acc;
@@ -475,28 +440,4 @@ float gravity_to_pitch(float a_x, float a_z)
 }
 
 
-inline float fast_sin(float x)
-{
-	// -180..180 -> -60..60
-	//int i = (int)(x/(2.0f/(180.0f/3.14159f))) + (180/2);
-
-
-    // improve rounding
-	int i = (int)(x/0.034906585f) + 90;  // 0 = -180.. 180=+180
-
-    if (i < 0 || i > 180)
-        printf("\r\nSIN error: %d\r\n",(int) RAD2DEG(x));
-    if (i > 180)
-        i -= 180;
-    else if (i < 0)
-        i += 180;
-	return sin_lookup[i];
-}	
-inline float fast_cos(float x)
-{
-	// -180..180 -> 270..-90
-    double a = DEG2RAD(90.0f) - x;
-    if (a > DEG2RAD(180.0f))
-        a -= DEG2RAD(360.0f);
-	return fast_sin(a);
-}	
+#endif // AHRS_FIXED_POINT
@@ -0,0 +1,284 @@
+/*!
+ *  Fixed point (Q16.16) version of the 2x3 Kalman filter of ahrs_kalman_2x3.c.
+ *
+ *  Same state (roll, pitch), covariance, noise parameters and bias/yaw
+ *  handling, but computed with 32 bit integers and 64 bit intermediates
+ *  instead of emulated floats. Select it with AHRS_FIXED_POINT in ahrs.h.
+ *
+ *  sensor_data stays float: the gyros, accelerometers and GPS speed are
+ *  converted on entry, the attitude on exit. p_bias and q_bias are kept in
+ *  sensor_data as floats because communication_csv.c resets them.
+ *
+ *  The fixed point filter does not give the same numbers as the float one,
+ *  but it does give the same numbers on every platform: the ahrs_replay_q16
+ *  tool in sitl/ runs both over a log and reports how far they are apart.
+ *
+ *  @file     ahrs_kalman_2x3_q16.c
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include "ahrs.h"
+
+#ifdef AHRS_FIXED_POINT
+
+#ifdef ENABLE_QUADROCOPTER
+#error Please use ahrs_simple_quaternion_c for multicopter use!
+#endif
+#ifdef F1E_STEERING
+#error The magnetometer heading of F1E_STEERING is only implemented in ahrs_kalman_2x3.c
+#endif
+
+#include <math.h>
+
+#include "fastmath/fastmath.h"
+#include "matrix/matrix.h"
+#include "q16/q16.h"
+
+#include "sensors.h"
+#include "configuration.h"
+#include "common.h"
+
+
+#define Q16_DEG(x)   Q16(DEG2RAD(x))
+#define Q16_G        Q16(G)
+
+static float gravity_to_roll(float a_y, float a_z);
+static float gravity_to_pitch(float a_x, float a_z);
+
+static q16 pitch_rad = 0, roll_rad = 0;
+static q16 pitch_rad_sum_error = 0;
+static q16 roll_rad_sum_error = 0;
+
+
+void ahrs_init()
+{
+	// initialize our attitude with the current accelerometer's data
+	pitch_rad = q16_from_float(gravity_to_pitch(sensor_data.acc_x, sensor_data.acc_z));
+	roll_rad = q16_from_float(gravity_to_roll(sensor_data.acc_y, sensor_data.acc_z));
+	sensor_data.p_bias = 0.0f;
+	sensor_data.q_bias = 0.0f;
+
+	sensor_data.pitch = q16_to_float(pitch_rad) - config.sensors.neutral_pitch;
+	sensor_data.roll = q16_to_float(roll_rad);
+}
+
+
+//! (-180..180]
+static q16 wrap_180(q16 a)
+{
+	if (a > Q16_DEG(180.0) || a < Q16_DEG(-180.0))
+	{
+		a %= Q16_DEG(360.0);
+		if (a > Q16_DEG(180.0))
+			a -= Q16_DEG(360.0);
+		else if (a < Q16_DEG(-180.0))
+			a += Q16_DEG(360.0);
+	}
+	return a;
+}
+
+
+//! pitch = (-90,90]; roll = (-180,180]
+static void normalize_pitch_roll()
+{
+	pitch_rad = wrap_180(pitch_rad);
+	roll_rad = wrap_180(roll_rad);
+
+	if (pitch_rad > Q16_DEG(90.0))
+	{
+		pitch_rad = Q16_DEG(180.0) - pitch_rad;
+		roll_rad += Q16_DEG(180.0);
+		sensor_data.yaw += DEG2RAD(180.0f);
+	}
+	else if (pitch_rad < Q16_DEG(-90.0))
+	{
+		pitch_rad = Q16_DEG(-180.0) - pitch_rad;
+		roll_rad += Q16_DEG(180.0);
+		sensor_data.yaw += DEG2RAD(180.0f);
+	}
+	roll_rad = wrap_180(roll_rad);
+}
+
+
+void ahrs_filter(float dt)
+{
+	static int i = 0;
+	static q16 sin_roll = 0;
+	static q16 cos_roll = Q16_ONE;
+	static q16 sin_pitch = 0;
+	static q16 cos_pitch = Q16_ONE;
+	static q16 tan_pitch = 0;
+	static q16 df_dx[3] = {0, 0, 0};
+	static q16 P[3] = {Q16_ONE, 0, Q16_ONE};  // upper half of the symmetric P
+	static q16 dh_dx_3x2[6];
+	static const q16 R[3] = {Q16(40.0), Q16(30.0), Q16(35.0)};
+	q16 tmp1[3];
+	q16 tmp2[2];
+	q16 q16_dt = q16_from_float(dt);
+	q16 p, q, r;
+
+	// correction from outer loop
+	sensor_data.p -= sensor_data.p_bias;
+	sensor_data.q -= sensor_data.q_bias;
+
+	p = q16_from_float(sensor_data.p);
+	q = q16_from_float(sensor_data.q);
+	r = q16_from_float(sensor_data.r);
+
+	roll_rad += q16_mul(q16_dt, p + q16_mul(q16_dot2(q, sin_roll, r, cos_roll), tan_pitch));
+	pitch_rad += q16_mul(q16_dt, q16_dot2(q, cos_roll, -r, sin_roll));
+	normalize_pitch_roll();
+
+	q16_sincos(roll_rad, &sin_roll, &cos_roll);
+	q16_sincos(pitch_rad, &sin_pitch, &cos_pitch);
+
+	if (cos_pitch < Q16(0.02) && cos_pitch > Q16(-0.02))  // to avoid /0 and very large values
+	{
+		if (cos_pitch < 0)
+			cos_pitch = Q16(-0.02);
+		else
+			cos_pitch = Q16(0.02);
+	}
+	tan_pitch = q16_div(sin_pitch, cos_pitch);
+
+	df_dx[0] = q16_mul(q16_dot2(q, cos_roll, -r, sin_roll), tan_pitch);
+	df_dx[1] = q16_div(q16_dot2(q, sin_roll, -r, cos_roll), q16_mul(cos_pitch, cos_pitch));
+	df_dx[2] = q16_dot2(-q, sin_roll, -r, cos_roll);
+
+	//    A = df_dx;
+	//    P = P + dt * (A*P + P*A' + Q);
+	tmp1[0] = q16_dot2(df_dx[0], P[0], df_dx[1], P[1]);                           // (A*P)[0][0]
+	tmp1[1] = q16_dot3(df_dx[0], P[1], df_dx[1], P[2], df_dx[2], P[0]);            // (A*P)[0][1] + (P*A')[0][1]
+	tmp1[2] = q16_mul(df_dx[2], P[1]);                                            // (A*P)[1][1]
+	P[0] += q16_mul(2 * tmp1[0] + Q16(0.1), q16_dt);     // Q(1) = 0.1 for roll
+	P[1] += q16_mul(tmp1[1], q16_dt);
+	P[2] += q16_mul(2 * tmp1[2] + Q16(0.04), q16_dt);    // Q(2) = 0.04 for pitch
+
+	////////////////////////////////
+
+	if (i++ % 2 == 0 &&    // only apply every other iteration
+	    fabs(sensor_data.acc_x) < 1.0f)   // only apply when the acceleration along the x-axis is not too large (take-off!)
+	{
+		q16 acc_x = q16_from_float(sensor_data.acc_x);
+		q16 acc_y = q16_from_float(sensor_data.acc_y);
+		q16 acc_z = q16_from_float(sensor_data.acc_z);
+		q16 dh = q16_from_float(-sensor_data.vertical_speed);
+		q16 u = q16_hypot(q16_from_float(sensor_data.gps.speed_ms), dh);
+		q16 w = q16_mul(dh, q16_mul(cos_pitch, cos_roll));
+		int j;
+
+		// dh_dx with w_droll = u_dpitch = w_dpitch = 0, see ahrs_kalman_2x3.c
+		dh_dx_3x2[0] = 0;
+		dh_dx_3x2[1] = cos_pitch;
+		dh_dx_3x2[2] = -q16_mul(cos_pitch, cos_roll);
+		dh_dx_3x2[3] = q16_mul(sin_roll, sin_pitch);
+		dh_dx_3x2[4] = q16_mul(sin_roll, cos_pitch);
+		dh_dx_3x2[5] = q16_mul(cos_roll, sin_pitch);
+
+		/*
+		h = [q(i)*w/G + sin_pitch; ...
+		     (r(i)*u - p(i)*w )/G - cos_pitch*sin_roll; ...
+		     (p(i)*w - q(i)*u)/G  - cos_pitch*cos_roll];
+		*/
+		tmp1[0] = acc_x - (q16_div(q16_mul(q, w), Q16_G) + sin_pitch);
+		tmp1[1] = acc_y - (q16_div(q16_dot2(r, u, -p, w), Q16_G) - q16_mul(cos_pitch, sin_roll));
+		tmp1[2] = acc_z - (q16_div(q16_dot2(p, w, -q, u), Q16_G) - q16_mul(cos_pitch, cos_roll));
+
+		// One accelerometer axis at a time, see ahrs_kalman_2x3.c. The gain
+		// P*c'/s is never stored: l*e and l*s*l' are divided by s in 64 bit,
+		// a q16 gain of ~0.03 would only have ~11 significant bits.
+		tmp2[0] = 0;  // roll "error"
+		tmp2[1] = 0;  // pitch "error"
+		for (j = 0; j < 3; j++)
+		{
+			q16 c0 = dh_dx_3x2[M3x2(j,0)], c1 = dh_dx_3x2[M3x2(j,1)];
+			q16 pc0 = q16_dot2(P[0], c0, P[1], c1);   // P * c'
+			q16 pc1 = q16_dot2(P[1], c0, P[2], c1);
+			q16 s = q16_dot2(c0, pc0, c1, pc1) + R[j];
+			q16 e = tmp1[j] - q16_dot2(c0, tmp2[0], c1, tmp2[1]);
+
+			tmp2[0] += q16_saturate((int64_t)pc0 * e / s);
+			tmp2[1] += q16_saturate((int64_t)pc1 * e / s);
+			P[0] -= q16_saturate((int64_t)pc0 * pc0 / s);
+			P[1] -= q16_saturate((int64_t)pc0 * pc1 / s);
+			P[2] -= q16_saturate((int64_t)pc1 * pc1 / s);
+		}
+
+		roll_rad += tmp2[0];
+		pitch_rad += tmp2[1];
+
+		if (roll_rad < Q16_DEG(55.0) && roll_rad > Q16_DEG(-55.0) &&
+		    pitch_rad < Q16_DEG(55.0) && pitch_rad > Q16_DEG(-55.0))
+		{
+			roll_rad_sum_error += tmp2[0];
+			pitch_rad_sum_error += tmp2[1];
+		}
+
+		if (pitch_rad < Q16_DEG(89.0) && pitch_rad > Q16_DEG(-89.0)) // to overcome secans +-inf
+		{
+			q16 yaw = q16_from_float(sensor_data.yaw);
+			q16 heading = q16_from_float(sensor_data.gps.heading_rad);
+
+			yaw += q16_mul(q16_div(q16_dot2(sin_roll, q, cos_roll, r), cos_pitch), q16_dt * 2);  // try to calculate yaw approx.
+			if (yaw >= Q16_DEG(360.0))
+				yaw -= Q16_DEG(360.0);
+			else if (yaw < 0)
+				yaw += Q16_DEG(360.0);
+			if (yaw - heading < Q16_DEG(250.0) && yaw - heading > Q16_DEG(-250.0) &&
+			    sensor_data.gps.satellites_in_view > 5)  // do not change if e.g. yaw = 355 deg and heading = 2 deg
+				yaw = q16_dot2(yaw, Q16(0.99), heading, Q16(0.01));
+			sensor_data.yaw = q16_to_float(yaw);
+		}
+
+		normalize_pitch_roll();
+	}
+	else if (i % 25 == 0) // outer loop at 2Hz
+	{
+		// change bias with a max of 0.1 deg/s per second
+		sensor_data.p_bias -= q16_to_float(BIND(roll_rad_sum_error / 10, Q16_DEG(-0.05), Q16_DEG(0.05)));
+		sensor_data.q_bias -= q16_to_float(BIND(pitch_rad_sum_error / 10, Q16_DEG(-0.05), Q16_DEG(0.05)));
+		roll_rad_sum_error = 0;
+		pitch_rad_sum_error = 0;
+	}
+
+	sensor_data.pitch = q16_to_float(pitch_rad) - config.sensors.neutral_pitch;
+	sensor_data.roll = q16_to_float(roll_rad);
+}
+
+
+/*!
+ *   Calculates roll using accelerometer input.
+ *
+ *   Makes sure the output is similar to the quaternion's output.
+ */
+static float gravity_to_roll(float a_y, float a_z)
+{
+	float roll_acc = fastmath_atan(a_y / a_z);
+	if (a_z > 0.0f)
+	{
+		if (a_y < 0.0f)
+			roll_acc =  roll_acc + 3.14159f;
+		else
+			roll_acc =  roll_acc - 3.14159f;
+	}
+	return roll_acc;
+}
+
+
+/*!
+ *   Calculates pitch using accelerometer input.
+ *
+ *   Makes sure the output is similar to the quaternion's output.
+ */
+static float gravity_to_pitch(float a_x, float a_z)
+{
+	float pitch_acc = -fastmath_atan(a_x / a_z);
+
+	if (a_z > 0.0f)
+		pitch_acc =  -pitch_acc;
+
+	return pitch_acc;
+}
+
+#endif // AHRS_FIXED_POINT
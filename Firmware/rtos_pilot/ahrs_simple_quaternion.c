@@ -20,6 +20,7 @@
 #include <stdio.h>
 
 #include "button/button.h"
+#include "fastmath/fastmath.h"
 #include "matrix/matrix.h"
 #include "pid/pid.h"
 #include "quaternion/quaternion.h"
@@ -57,7 +58,7 @@ void ahrs_init()
     pitch_rad = gravity_to_pitch(sensor_data.acc_x, sensor_data.acc_z);
     roll_rad = gravity_to_roll(sensor_data.acc_y, sensor_data.acc_z);
     hmc5843_read(&sensor_data.magnetometer_raw);
-	quaternion_from_attitude(roll_rad, pitch_rad, atan2f(-(float)sensor_data.magnetometer_raw.y.i16,(float)sensor_data.magnetometer_raw.x.i16)/3.14*180.0, q);
+	quaternion_from_attitude(roll_rad, pitch_rad, fastmath_atan2(-(float)sensor_data.magnetometer_raw.y.i16,(float)sensor_data.magnetometer_raw.x.i16)/3.14*180.0, q);
 	
 	p_bias = 0.0;
 	q_bias = 0.0;
@@ -102,28 +103,31 @@ void ahrs_filter2()
 	float q3q3 = q[3]*q[3];          
 	
 	// normalise the measurements
-	norm = sqrt(sensor_data.acc_x*sensor_data.acc_x + sensor_data.acc_y*sensor_data.acc_y + sensor_data.acc_z*sensor_data.acc_z);       
-	if (fabs(norm) > 0.001)
+	// (norm is the squared norm, and then its inverse)
+	norm = sensor_data.acc_x*sensor_data.acc_x + sensor_data.acc_y*sensor_data.acc_y + sensor_data.acc_z*sensor_data.acc_z;
+	if (norm > 0.001*0.001)
 	{
-		sensor_data.acc_x = sensor_data.acc_x / norm;
-		sensor_data.acc_y = sensor_data.acc_y / norm;
-		sensor_data.acc_z = sensor_data.acc_z / norm;
+		norm = fastmath_invsqrt(norm);
+		sensor_data.acc_x = sensor_data.acc_x * norm;
+		sensor_data.acc_y = sensor_data.acc_y * norm;
+		sensor_data.acc_z = sensor_data.acc_z * norm;
 	}
 	mx = (float)sensor_data.magnetometer_raw.x.i16;
 	my = (float)sensor_data.magnetometer_raw.y.i16;
 	mz = (float)sensor_data.magnetometer_raw.z.i16;
-	norm = sqrt(mx*mx + my*my + mz*mz);
-	if (fabs(norm) > 0.001)
+	norm = mx*mx + my*my + mz*mz;
+	if (norm > 0.001*0.001)
 	{
-		mx = mx / norm;
-		my = my / norm;
-		mz = mz / norm;         
+		norm = fastmath_invsqrt(norm);
+		mx = mx * norm;
+		my = my * norm;
+		mz = mz * norm;
 	}
 	// compute reference direction of flux
 	hx = 2*mx*(0.5 - q2q2 - q3q3) + 2*my*(q1q2 - q0q3) + 2*mz*(q1q3 + q0q2);
 	hy = 2*mx*(q1q2 + q0q3) + 2*my*(0.5 - q1q1 - q3q3) + 2*mz*(q2q3 - q0q1);
 	hz = 2*mx*(q1q3 - q0q2) + 2*my*(q2q3 + q0q1) + 2*mz*(0.5 - q1q1 - q2q2);         
-	bx = sqrt((hx*hx) + (hy*hy));
+	bx = fastmath_sqrt((hx*hx) + (hy*hy));
 	bz = hz;        
 	
 	// estimated direction of gravity and flux (v and w)
@@ -156,13 +160,14 @@ void ahrs_filter2()
 	q[3] = q[3] + (q[0]*sensor_data.r + q[1]*sensor_data.q - q[2]*sensor_data.p)*halfT;  
 	
 	// normalise quaternion
-	norm = sqrt(q[0]*q[0] + q[1]*q[1] + q[2]*q[2] + q[3]*q[3]);
-	if (fabs(norm) > 0.001)
+	norm = q[0]*q[0] + q[1]*q[1] + q[2]*q[2] + q[3]*q[3];
+	if (norm > 0.001*0.001)
 	{
-		q[0] = q[0] / norm;
-		q[1] = q[1] / norm;
-		q[2] = q[2] / norm;
-		q[3] = q[3] / norm;
+		norm = fastmath_invsqrt(norm);
+		q[0] = q[0] * norm;
+		q[1] = q[1] * norm;
+		q[2] = q[2] * norm;
+		q[3] = q[3] * norm;
 	}
 
 	sensor_data.roll = quaternion_to_roll(q);
@@ -253,7 +258,7 @@ void ahrs_filter(float dt)
  */
 inline float gravity_to_roll(float a_y, float a_z)
 {
-	double roll_acc = atanf(a_y / a_z);
+	double roll_acc = fastmath_atan(a_y / a_z);
 	if (a_z > 0.0)
 	{
 		if (a_y < 0.0)	
@@ -272,7 +277,7 @@ inline float gravity_to_roll(float a_y, float a_z)
  */
 inline float gravity_to_pitch(float a_x, float a_z)
 {
-	double pitch_acc = -atanf(a_x / a_z); // replace with asin?
+	double pitch_acc = -fastmath_atan(a_x / a_z); // replace with asin?
 
 	if (a_z > 0.0)
 		pitch_acc =  -pitch_acc;
@@ -23,6 +23,84 @@ void communication_telemetry_task( void *parameters );
 
 void communication_input_task( void *parameters );
 
+struct CommandTable;
+
+/*!
+ *    Fills a command table (lib/cmdtable) with the commands of
+ *    communication_input_task.
+ *    @return The result of cmdtable_init()
+ */
+int communication_commands(struct CommandTable *t);
+
+
+struct LogSchema;
+
+/*!
+ *    The DH and DD lines the DR command sends for a log
+ */
+void print_logrecord(struct LogSchema *s, int record);
+
+/*!
+ *    Binary frames of the DB command (log download), little endian:
+ *    [LOG_FRAME_SYNC1][LOG_FRAME_SYNC2][page: 2][length: 2][data][crc16: 2]
+ *    The crc (lib/crc16) covers page, length and data.
+ */
+#define LOG_FRAME_SYNC1   0xA5
+#define LOG_FRAME_SYNC2   0x5A
+#define LOG_FRAME_HEADER  6
+#define LOG_FRAME_END     0xFFFF   //!< Page of the frame that ends a download
+
+void print_logpages(int first, int last);
+
+
+/*!
+ *    Binary telemetry (see communication_binary.c), enabled with the TB
+ *    command until the next reboot. The streams of the telemetry task are
+ *    sent as frames instead of CSV lines, little endian:
+ *    [TELEMETRY_FRAME_SYNC1][TELEMETRY_FRAME_SYNC2][type][sequence][length][payload][crc16: 2]
+ *    The type is the second letter of the CSV line (TA -> 'A'), the sequence
+ *    number counts every frame so the receiver can count the lost ones. The
+ *    crc (lib/crc16) covers type, sequence, length and payload. Command
+ *    replies and messages stay CSV lines between the frames.
+ */
+#define TELEMETRY_FRAME_SYNC1   0xA5
+#define TELEMETRY_FRAME_SYNC2   0xC3
+#define TELEMETRY_FRAME_HEADER  5
+#define TELEMETRY_FRAME_SIZE(payload) (TELEMETRY_FRAME_HEADER + (payload) + 2)
+
+// The payloads, u = unsigned, s = signed, f = float. Scaled as the CSV lines.
+#define TELEMETRY_SIZE_R  12   //!< u16 acc x, y, z raw, u16 gyro x, y, z raw
+#define TELEMETRY_SIZE_P  12   //!< s16 acc x, y, z (mg), s16 p, q, r (mrad/s)
+#define TELEMETRY_SIZE_A  6    //!< s16 roll, pitch, yaw (mrad)
+#define TELEMETRY_SIZE_S  6    //!< u16 servo 2, 0, 3 (us), simulation mode only
+#define TELEMETRY_SIZE_H  6    //!< u32 pressure (Pa), s16 temperature
+#define TELEMETRY_SIZE_T  16   //!< u16 ppm channel 0...7 (us)
+#define TELEMETRY_SIZE_G  16   //!< u8 status, f32 latitude, longitude (rad), u16 speed (dm/s),
+                               //!< u16 heading (centirad), u8 satellites, s16 height (m)
+#define TELEMETRY_SIZE_C  19   //!< u8 flight mode, s16 line, s16 altitude, u16 battery 1 (dV),
+                               //!< u16 time airborne, u16 time in block (s), u8 rc link (%),
+                               //!< u8 throttle (%), s16 target altitude, u16 battery 2 (dV),
+                               //!< u16 used capacity (10 mAh)
+
+extern int telemetry_binary;
+
+// These return 0 when the uart is busy or its transmit buffer is full
+int telemetry_binary_raw();
+int telemetry_binary_processed();
+int telemetry_binary_attitude();
+int telemetry_binary_servos();
+int telemetry_binary_pressure();
+int telemetry_binary_rc();
+int telemetry_binary_gps();
+int telemetry_binary_control(int altitude, int rc_link, int throttle);
+
+/*!
+ *    Telemetry samples sent, deferred and dropped since boot (see
+ *    telemetry_scheduler.h). Also sent as a TQ line every 5 seconds when
+ *    samples were lost.
+ */
+void telemetry_report(unsigned int *sent, unsigned int *deferred, unsigned int *dropped);
+
 
 
 #endif // COMMUNICATION_H
@@ -0,0 +1,216 @@
+/*!
+ *  Implements the binary telemetry protocol, see communication.h.
+ *
+ *  The same streams as the CSV telemetry, but packed in fixed little endian
+ *  payloads: no float formatting and an attitude sample takes 13 bytes on
+ *  the radio link instead of about 35, a GPS sample 23 instead of about 60.
+ *
+ *  The frames are written with one uart1_put() under xUart1Semaphore, like
+ *  the CSV lines of printf_telemetry(): when the uart is busy or the frame
+ *  doesn't fit in the uart1 transmit buffer, it isn't sent and the
+ *  telemetry scheduler tries again later. The sequence number only counts
+ *  the frames that are sent, a gap means frames were lost on the link.
+ *
+ *  @file     communication_binary.c
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include "FreeRTOS/FreeRTOS.h"
+#include "FreeRTOS/task.h"
+#include "FreeRTOS/semphr.h"
+
+#include "uart1_queue/uart1_queue.h"
+#include "ppm_in/ppm_in.h"
+#include "servo/servo.h"
+#include "crc16/crc16.h"
+
+#include "sensors.h"
+#include "communication.h"
+#include "gluonscript.h"
+#include "handler_navigation.h"
+#include "task_control.h"
+
+int telemetry_binary = 0;   //!< Set by the TB command
+
+static unsigned char sequence = 0;
+
+extern xSemaphoreHandle xUart1Semaphore;
+
+
+static unsigned char *put8(unsigned char *p, unsigned int v)
+{
+	*p = (unsigned char)v;
+	return p + 1;
+}
+
+
+static unsigned char *put16(unsigned char *p, unsigned int v)
+{
+	p[0] = (unsigned char)v;
+	p[1] = (unsigned char)(v >> 8);
+	return p + 2;
+}
+
+
+static unsigned char *put32(unsigned char *p, unsigned long v)
+{
+	p = put16(p, (unsigned int)(v & 0xFFFF));
+	return put16(p, (unsigned int)(v >> 16));
+}
+
+
+static unsigned char *putf(unsigned char *p, float f)
+{
+	union { float f; unsigned long l; } bits;   // 32 bits, as a double on the dsPIC
+
+	bits.f = f;
+	return put32(p, bits.l);
+}
+
+
+/*!
+ *   Completes the frame around the payload (frame[TELEMETRY_FRAME_HEADER]...)
+ *   and sends it, when the uart is available.
+ *   @return 0 when it wasn't sent
+ */
+static int send_frame(unsigned char *frame, char type, int length)
+{
+	unsigned int crc;
+
+	if (xSemaphoreTake( xUart1Semaphore, 0 ) != pdTRUE)
+		return 0;
+	if (uart1_tx_free() < (unsigned int)TELEMETRY_FRAME_SIZE(length))
+	{
+		xSemaphoreGive( xUart1Semaphore );
+		return 0;
+	}
+
+	frame[0] = TELEMETRY_FRAME_SYNC1;
+	frame[1] = TELEMETRY_FRAME_SYNC2;
+	frame[2] = type;
+	frame[3] = sequence++;
+	frame[4] = length;
+	crc = crc16_update(CRC16_INIT, &frame[2], 3 + length);
+	put16(&frame[TELEMETRY_FRAME_HEADER + length], crc);
+	uart1_put((char*)frame, TELEMETRY_FRAME_SIZE(length));
+
+	xSemaphoreGive( xUart1Semaphore );
+	return 1;
+}
+
+
+int telemetry_binary_raw()
+{
+	unsigned char frame[TELEMETRY_FRAME_SIZE(TELEMETRY_SIZE_R)];
+	unsigned char *p = &frame[TELEMETRY_FRAME_HEADER];
+
+	p = put16(p, sensor_data.acc_x_raw);
+	p = put16(p, sensor_data.acc_y_raw);
+	p = put16(p, sensor_data.acc_z_raw);
+	p = put16(p, sensor_data.gyro_x_raw);
+	p = put16(p, sensor_data.gyro_y_raw);
+	put16(p, sensor_data.gyro_z_raw);
+	return send_frame(frame, 'R', TELEMETRY_SIZE_R);
+}
+
+
+int telemetry_binary_processed()
+{
+	unsigned char frame[TELEMETRY_FRAME_SIZE(TELEMETRY_SIZE_P)];
+	unsigned char *p = &frame[TELEMETRY_FRAME_HEADER];
+
+	p = put16(p, (int)(sensor_data.acc_x*1000));
+	p = put16(p, (int)(sensor_data.acc_y*1000));
+	p = put16(p, (int)(sensor_data.acc_z*1000));
+	p = put16(p, (int)(sensor_data.p*1000));
+	p = put16(p, (int)(sensor_data.q*1000));
+	put16(p, (int)(sensor_data.r*1000));
+	return send_frame(frame, 'P', TELEMETRY_SIZE_P);
+}
+
+
+int telemetry_binary_attitude()
+{
+	unsigned char frame[TELEMETRY_FRAME_SIZE(TELEMETRY_SIZE_A)];
+	unsigned char *p = &frame[TELEMETRY_FRAME_HEADER];
+
+	p = put16(p, (int)(sensor_data.roll*1000));
+	p = put16(p, (int)(sensor_data.pitch*1000));
+	put16(p, (int)(sensor_data.yaw*1000));
+	return send_frame(frame, 'A', TELEMETRY_SIZE_A);
+}
+
+
+int telemetry_binary_servos()
+{
+	unsigned char frame[TELEMETRY_FRAME_SIZE(TELEMETRY_SIZE_S)];
+	unsigned char *p = &frame[TELEMETRY_FRAME_HEADER];
+
+	p = put16(p, servo_read_us(2));
+	p = put16(p, servo_read_us(0));
+	put16(p, servo_read_us(3));
+	return send_frame(frame, 'S', TELEMETRY_SIZE_S);
+}
+
+
+int telemetry_binary_pressure()
+{
+	unsigned char frame[TELEMETRY_FRAME_SIZE(TELEMETRY_SIZE_H)];
+	unsigned char *p = &frame[TELEMETRY_FRAME_HEADER];
+
+	p = put32(p, (unsigned long)sensor_data.pressure);
+	put16(p, (int)sensor_data.temperature);
+	return send_frame(frame, 'H', TELEMETRY_SIZE_H);
+}
+
+
+int telemetry_binary_rc()
+{
+	unsigned char frame[TELEMETRY_FRAME_SIZE(TELEMETRY_SIZE_T)];
+	unsigned char *p = &frame[TELEMETRY_FRAME_HEADER];
+	int i;
+
+	for (i = 0; i < 8; i++)
+		p = put16(p, ppm.channel[i]);
+	return send_frame(frame, 'T', TELEMETRY_SIZE_T);
+}
+
+
+int telemetry_binary_gps()
+{
+	unsigned char frame[TELEMETRY_FRAME_SIZE(TELEMETRY_SIZE_G)];
+	unsigned char *p = &frame[TELEMETRY_FRAME_HEADER];
+
+	p = put8(p, (unsigned char)sensor_data.gps.status);
+	p = putf(p, sensor_data.gps.latitude_rad);
+	p = putf(p, sensor_data.gps.longitude_rad);
+	p = put16(p, (unsigned int)(sensor_data.gps.speed_ms*10));
+	p = put16(p, (unsigned int)(sensor_data.gps.heading_rad*100));
+	p = put8(p, sensor_data.gps.satellites_in_view);
+	put16(p, sensor_data.gps.height_m);
+	return send_frame(frame, 'G', TELEMETRY_SIZE_G);
+}
+
+
+/*!
+ *   The fields of the TC line that the telemetry task computes.
+ */
+int telemetry_binary_control(int altitude, int rc_link, int throttle)
+{
+	unsigned char frame[TELEMETRY_FRAME_SIZE(TELEMETRY_SIZE_C)];
+	unsigned char *p = &frame[TELEMETRY_FRAME_HEADER];
+
+	p = put8(p, control_state.flight_mode);
+	p = put16(p, gluonscript_data.current_codeline);
+	p = put16(p, altitude);
+	p = put16(p, sensor_data.battery1_voltage_10);
+	p = put16(p, navigation_data.time_airborne_s);
+	p = put16(p, navigation_data.time_block_s);
+	p = put8(p, rc_link);
+	p = put8(p, throttle);
+	p = put16(p, (int)navigation_data.desired_altitude_agl);
+	p = put16(p, sensor_data.battery2_voltage_10);
+	put16(p, (unsigned int)(sensor_data.battery1_mAh/10.0));
+	return send_frame(frame, 'C', TELEMETRY_SIZE_C);
+}
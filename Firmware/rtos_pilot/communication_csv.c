@@ -4,8 +4,8 @@
  *  Consists of 2 tasks: telemetry (continuous output) and input (respond to commands).
  *
  *   Commands:
- *   Telemetry: TR, TP, TA, TH, TT, TG
- *   Other: ST, SA, SI, SG, PP, PR, PH, FC, LC, LD, RC
+ *   Telemetry: TR, TP, TA, TH, TT, TG (or binary frames after TB, see communication_binary.c)
+ *   Other: see the command table, above communication_input_task()
  *
  *  @file     communication_csv.c
  *  @author   Tom Pycke
@@ -16,6 +16,7 @@
  
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <stdarg.h>
 
 #include "FreeRTOS/FreeRTOS.h"
@@ -30,6 +31,10 @@
 #include "ppm_in/ppm_in.h"
 #include "led/led.h"
 #include "servo/servo.h"
+#include "crc16/crc16.h"
+#include "dataflash/dataflash.h"
+#include "numfmt/numfmt.h"
+#include "cmdtable/cmdtable.h"
 
 #include "task_osd.h"
 #include "sensors.h"
@@ -38,17 +43,14 @@
 #include "task_datalogger.h"
 #include "handler_navigation.h"
 #include "handler_alarms.h"
+#include "control_mix.h"
+#include "telemetry_scheduler.h"
 
 #include "common.h"
 
-// Helper functions
-void print_signed_integer(int x, void (*printer)(char[]));
-void print_unsigned_integer(unsigned int x, void (*printer)(char[]));
-void print_logline(struct LogLine *l);
-void print_logline_simulation(struct LogLine *l);
-
 void print_configuration();
 void print_navigation();
+void print_mix();
 
 #define BUFFERSIZE 200
 static char  buffer[BUFFERSIZE];
@@ -56,56 +58,270 @@ static char  buffer[BUFFERSIZE];
 extern unsigned long idle_counter;
 
 #define COMM_BUFFER_LEN 100
-char comm_buffer[COMM_BUFFER_LEN];
+char comm_buffer[COMM_BUFFER_LEN + 6];   // room for "$" and "*xx\r\n"
 void comm_send_buffer_with_checksum(int length);
 
-// Only write to output when the uart is available
-#define printf_checksum_direct(T,...) \
-   if (xSemaphoreTake( xUart1Semaphore, 0 ) == pdTRUE) { \
-      comm_send_buffer_with_checksum(snprintf(comm_buffer, COMM_BUFFER_LEN, T, __VA_ARGS__)); \
-      xSemaphoreGive( xUart1Semaphore ); \
-      }
-
-// Write to output and wait at most 100ms until the semaphore becomes available
+// Write to output and wait at most 100ms until the semaphore becomes available,
+// then until there's room in the uart1 transmit buffer. The numbers are
+// formatted by lib/numfmt, not printf: %d %u %x %c %s %ld %lu and %f or %.Nf only.
 #define printf_checksum(T,...) \
    if (xSemaphoreTake( xUart1Semaphore, ( portTickType ) 100 / portTICK_RATE_MS )  == pdTRUE) { \
-      comm_send_buffer_with_checksum(snprintf(comm_buffer, COMM_BUFFER_LEN, T, __VA_ARGS__)); \
+      uart1_tx_wait(COMM_BUFFER_LEN + 6); \
+      comm_send_buffer_with_checksum(numfmt_format(comm_buffer, COMM_BUFFER_LEN, T, __VA_ARGS__)); \
       xSemaphoreGive( xUart1Semaphore ); \
       }
 
-// Write to output and wait at most 100ms until the semaphore becomes available
-#define printf_nochecksum(T,...) \
-   if (xSemaphoreTake( xUart1Semaphore, ( portTickType ) 100 / portTICK_RATE_MS )  == pdTRUE) { \
-      printf(T, __VA_ARGS__); \
-      xSemaphoreGive( xUart1Semaphore ); \
-      }
-
-#define printf_nochecksum_direct(T,...) \
+// Write a message followed by a line to output when the semaphore is available
+#define puts_line_direct(T,S) \
    if (xSemaphoreTake( xUart1Semaphore, ( portTickType ) 0 / portTICK_RATE_MS )  == pdTRUE) { \
-      printf(T, __VA_ARGS__); \
+      uart1_puts(T); \
+      uart1_puts(S); \
+      uart1_puts("\r\n"); \
       xSemaphoreGive( xUart1Semaphore ); \
       }
 
 #define printf_message(T) \
 	if (xSemaphoreTake( xUart1Semaphore, ( portTickType ) 100 / portTICK_RATE_MS )  == pdTRUE) { \
-      printf(T); \
+      uart1_tx_wait(COMM_BUFFER_LEN); \
+      uart1_puts(T); \
       xSemaphoreGive( xUart1Semaphore ); \
       }
 
 int check_checksum(char *s);
+extern char hex[];
 
 xSemaphoreHandle xUart1Semaphore;
 
+#define TELEMETRY_PERIOD_MS         100   // the streams count in these ticks...
+#define TELEMETRY_BINARY_PERIOD_MS  20    // ...or in these with binary telemetry
+#define TELEMETRY_REPORT_TICKS      50    // TQ line at most every 5 seconds (10Hz ticks)
+
+/*!
+ *   Sends a telemetry line when the uart is available and there is room for
+ *   it in the uart1 transmit buffer.
+ *   @return 0 when the line wasn't sent
+ */
+static int printf_telemetry(const char *format, ...)
+{
+	va_list ap;
+
+	if (xSemaphoreTake( xUart1Semaphore, 0 ) != pdTRUE)
+		return 0;
+	if (uart1_tx_free() < COMM_BUFFER_LEN + 6)
+	{
+		xSemaphoreGive( xUart1Semaphore );
+		return 0;
+	}
+	va_start(ap, format);
+	comm_send_buffer_with_checksum(numfmt_vformat(comm_buffer, COMM_BUFFER_LEN, format, ap));
+	va_end(ap);
+	xSemaphoreGive( xUart1Semaphore );
+	return 1;
+}
+
+
+///////////////////////////////////////////////////////////////
+//               GYRO AND ACCELEROMETER RAW                  //
+///////////////////////////////////////////////////////////////
+static int send_gyroaccraw()
+{
+	if (telemetry_binary)
+		return telemetry_binary_raw();
+	return printf_telemetry("TR;%u;%u;%u;%u;%u;%u", (sensor_data.acc_x_raw), (sensor_data.acc_y_raw),
+	                        (sensor_data.acc_z_raw), (sensor_data.gyro_x_raw),
+	                        (sensor_data.gyro_y_raw), (sensor_data.gyro_z_raw));
+}
+
+///////////////////////////////////////////////////////////////
+//            GYRO AND ACCELEROMETER PROCESSED              //
+///////////////////////////////////////////////////////////////
+static int send_gyroaccproc()
+{
+	if (telemetry_binary)
+		return telemetry_binary_processed();
+	return printf_telemetry("TP;%d;%d;%d;%d;%d;%d", (int)(sensor_data.acc_x*1000), (int)(sensor_data.acc_y*1000),
+	                        (int)(sensor_data.acc_z*1000), (int)(sensor_data.p*1000),
+	                        (int)(sensor_data.q*1000), (int)(sensor_data.r*1000));
+}
+
+///////////////////////////////////////////////////////////////
+//                         ATTITUDE                          //
+///////////////////////////////////////////////////////////////
+static int send_attitude()
+{
+	int *t = (int*)&sensor_data.pitch;
+
+	if (telemetry_binary)
+		return telemetry_binary_attitude();
+	return printf_telemetry("TA;%d;%d;%d;%x;%x", (int)(sensor_data.roll*1000), (int)(sensor_data.pitch*1000), (int)(sensor_data.yaw*1000), t[1], t[0]);
+}
+
+// With the attitude, in simulation mode
+static int send_servos()
+{
+	if (telemetry_binary)
+		return telemetry_binary_servos();
+	return printf_telemetry("TS;%d;%d;%d", servo_read_us(2), servo_read_us(0), servo_read_us(3));
+}
+
+///////////////////////////////////////////////////////////////
+//           SCP1000: PRESSURE & TEMPERATURE                 //
+///////////////////////////////////////////////////////////////
+static int send_pressuretemp()
+{
+	if (telemetry_binary)
+		return telemetry_binary_pressure();
+	return printf_telemetry("TH;%lu;%d", (unsigned long)(sensor_data.pressure), (int)sensor_data.temperature);
+}
+
+///////////////////////////////////////////////////////////////
+//                   RC TRANSMITTER INPUT                    //
+///////////////////////////////////////////////////////////////
+static int send_ppm()
+{
+	if (telemetry_binary)
+		return telemetry_binary_rc();
+	return printf_telemetry("TT;%u;%u;%u;%u;%u;%u;%u;%u", (unsigned int)ppm.channel[0], (unsigned int)ppm.channel[1],
+	                        (unsigned int)ppm.channel[2], (unsigned int)ppm.channel[3],
+	                        (unsigned int)ppm.channel[4], (unsigned int)ppm.channel[5],
+	                        (unsigned int)ppm.channel[6], (unsigned int)ppm.channel[7]);
+}
+
+///////////////////////////////////////////////////////////////
+//                        GPS BASIC                          //
+///////////////////////////////////////////////////////////////
+static int send_gpsbasic()
+{
+	if (telemetry_binary)
+		return telemetry_binary_gps();
+	return printf_telemetry("TG;%c;%.9f;%.9f;%u;%u;%u;%u", '0' + (unsigned char)sensor_data.gps.status,
+	                        sensor_data.gps.latitude_rad, sensor_data.gps.longitude_rad,
+	                        (unsigned int)(sensor_data.gps.speed_ms*10),
+	                        (unsigned int)(sensor_data.gps.heading_rad*100),
+	                        (unsigned int)(sensor_data.gps.satellites_in_view),
+	                        (unsigned int)(sensor_data.gps.height_m));
+}
+
+///////////////////////////////////////////////////////////////
+//                          CONTROL                          //
+///////////////////////////////////////////////////////////////
+//printf("TC;CONTROL_STATUS;LINE;HEIGHT(;CARROTX;CARROTY;CARROTH)");
+static int send_control()
+{
+	int sig_quality = 0;
+	if (config.control.use_pwm)
+	{
+		if (ppm.connection_alive)
+			sig_quality = 100;
+		else
+			sig_quality = 0;
+	} else // ppm
+		sig_quality = (100-ppm_signal_quality()*4);  // %
+
+	int throttle = (config.control.servo_neutral[3] - (int)servo_read_us(3))/10;
+	if (! config.control.reverse_servo4)
+		throttle = -throttle;
+	if (throttle < 0 || throttle > 100)
+		throttle = 0;
+
+	int altitude;
+	if (config.control.altitude_mode == GPS_ABSOLUTE)
+		altitude =  sensor_data.gps.height_m;
+	else if (config.control.altitude_mode == GPS_RELATIVE)
+		altitude = sensor_data.gps.height_m - navigation_data.home_gps_height;
+	else //if (config.control.altitude_mode == PRESSURE)
+		altitude = (int)(sensor_data.pressure_height - navigation_data.home_pressure_height);
+
+	if (telemetry_binary)
+		return telemetry_binary_control(altitude, sig_quality, throttle);
+	return printf_telemetry("TC;%d;%d;%d;%u;%d;%d;%d;%d;%d;%d;%u", (int)control_state.flight_mode,
+	                        gluonscript_data.current_codeline, altitude,
+	                        sensor_data.battery1_voltage_10,
+	                        navigation_data.time_airborne_s, navigation_data.time_block_s,
+	                        sig_quality, throttle, (int)navigation_data.desired_altitude_agl,
+	                        sensor_data.battery2_voltage_10,(unsigned int)(sensor_data.battery1_mAh/10.0));
+}
+
+
+enum TelemetryStreams { STREAM_ATTITUDE, STREAM_SERVOS, STREAM_CONTROL, STREAM_GPSBASIC, STREAM_PRESSURETEMP,
+                        STREAM_PPM, STREAM_GYROACCPROC, STREAM_GYROACCRAW, TELEMETRY_STREAMS };
+
+// Most valuable first. The sizes are set by telemetry_set_sizes().
+static struct TelemetryStream streams[TELEMETRY_STREAMS] =
+{
+	{ .send = &send_attitude,      .priority = 8 },
+	{ .send = &send_servos,        .priority = 7 },
+	{ .send = &send_control,       .priority = 6 },
+	{ .send = &send_gpsbasic,      .priority = 5 },
+	{ .send = &send_pressuretemp,  .priority = 3 },
+	{ .send = &send_ppm,           .priority = 2 },
+	{ .send = &send_gyroaccproc,   .priority = 1 },
+	{ .send = &send_gyroaccraw,    .priority = 1 }
+};
+// The CSV lines, typical length with "$" and "*xx\r\n"
+static const unsigned char csv_sizes[TELEMETRY_STREAMS] = { 36, 23, 40, 49, 19, 48, 40, 40 };
+static const unsigned char binary_sizes[TELEMETRY_STREAMS] =
+{
+	TELEMETRY_FRAME_SIZE(TELEMETRY_SIZE_A), TELEMETRY_FRAME_SIZE(TELEMETRY_SIZE_S),
+	TELEMETRY_FRAME_SIZE(TELEMETRY_SIZE_C), TELEMETRY_FRAME_SIZE(TELEMETRY_SIZE_G),
+	TELEMETRY_FRAME_SIZE(TELEMETRY_SIZE_H), TELEMETRY_FRAME_SIZE(TELEMETRY_SIZE_T),
+	TELEMETRY_FRAME_SIZE(TELEMETRY_SIZE_P), TELEMETRY_FRAME_SIZE(TELEMETRY_SIZE_R)
+};
+
+
+static void telemetry_set_sizes(const unsigned char *sizes)
+{
+	int i;
+
+	for (i = 0; i < TELEMETRY_STREAMS; i++)
+		streams[i].size = sizes[i];
+}
+
+
+/*!
+ *   The periods (in ticks of the telemetry task) come from the configuration,
+ *   the servos are sent with the attitude in simulation mode.
+ */
+static void telemetry_set_periods()
+{
+	streams[STREAM_ATTITUDE].period = config.telemetry.stream_Attitude;
+	streams[STREAM_SERVOS].period = control_state.simulation_mode ? config.telemetry.stream_Attitude : 0;
+	streams[STREAM_CONTROL].period = config.telemetry.stream_Control;
+	streams[STREAM_GPSBASIC].period = config.telemetry.stream_GpsBasic;
+	streams[STREAM_PRESSURETEMP].period = config.telemetry.stream_PressureTemp;
+	streams[STREAM_PPM].period = config.telemetry.stream_PPM;
+	streams[STREAM_GYROACCPROC].period = config.telemetry.stream_GyroAccProc;
+	streams[STREAM_GYROACCRAW].period = config.telemetry.stream_GyroAccRaw;
+}
+
+
+void telemetry_report(unsigned int *sent, unsigned int *deferred, unsigned int *dropped)
+{
+	int i;
+
+	*sent = *deferred = *dropped = 0;
+	for (i = 0; i < TELEMETRY_STREAMS; i++)
+	{
+		*sent += streams[i].sent;
+		*deferred += streams[i].deferred;
+		*dropped += streams[i].dropped;
+	}
+}
+
+
 /*!
  *    This task will send telemetry directly to uart1 at a rate of maximum 
- *    20 times a second.
+ *    10 times a second, 50 times with binary telemetry. The streams share
+ *    the link as telemetry_scheduler.c decides.
  *
  *    Used stackspace: 356 / 860 bytes
  */
 void communication_telemetry_task( void *parameters )
 {
-	int c = 0;
-	struct TelemetryConfig counters;
+	int c = 0, binary_ticks = 0, binary = -1;
+	int format_progress, last_format_progress = -1;
+	unsigned int sent, deferred, dropped, last_lost = 0;
+	struct TelemetryLink link;
 		
 	/* Used to wake the task at the correct frequency. */
 	portTickType xLastExecutionTime;
@@ -115,14 +331,6 @@ void communication_telemetry_task( void *parameters )
 	vTaskSetApplicationTaskTag( NULL, ( void * ) 6 );
 	vSemaphoreCreateBinary(xUart1Semaphore);
 	
-	counters.stream_PPM = 0;
-	counters.stream_GyroAccRaw = 0;
-	counters.stream_GyroAccProc = 0;
-	counters.stream_PressureTemp = 0;
-	counters.stream_GpsBasic = 0;
-	counters.stream_Control = 0;
-	counters.stream_Attitude = 0;
-	
 	uart1_puts("done\r\n");
 	
 	// delay a bit and send navigation and configuration
@@ -137,15 +345,26 @@ void communication_telemetry_task( void *parameters )
 	
 	for( ;; )
 	{
-		vTaskDelayUntil( &xLastExecutionTime, ( ( portTickType ) 100 / portTICK_RATE_MS ) );  // 10Hz
-		counters.stream_PPM++;
-		counters.stream_GyroAccRaw++;
-		counters.stream_GyroAccProc++;
-		counters.stream_PressureTemp++;
-		counters.stream_GpsBasic++;
-		counters.stream_Attitude++;
-		counters.stream_Control++;
-		
+		if (telemetry_binary)
+			vTaskDelayUntil( &xLastExecutionTime, ( ( portTickType ) TELEMETRY_BINARY_PERIOD_MS / portTICK_RATE_MS ) );  // 50Hz
+		else
+			vTaskDelayUntil( &xLastExecutionTime, ( ( portTickType ) TELEMETRY_PERIOD_MS / portTICK_RATE_MS ) );  // 10Hz
+
+		if (binary != telemetry_binary)   // TB command
+		{
+			binary = telemetry_binary;
+			telemetry_set_sizes(binary ? binary_sizes : csv_sizes);
+			telemetry_scheduler_init(&link, uart1_baudrate(),
+			                         1000 / (binary ? TELEMETRY_BINARY_PERIOD_MS : TELEMETRY_PERIOD_MS));
+		}
+		telemetry_set_periods();
+		telemetry_scheduler_tick(&link, streams, TELEMETRY_STREAMS);
+
+		// Every binary tick sends streams, the rest is done at 10Hz
+		if (binary && ++binary_ticks < TELEMETRY_PERIOD_MS / TELEMETRY_BINARY_PERIOD_MS)
+			continue;
+		binary_ticks = 0;
+			
 		if (c++ % 5 == 0)  // this counter will never be used at 20Hz
 			led1_on();
 		else
@@ -174,152 +393,540 @@ void communication_telemetry_task( void *parameters )
 			printf_message("!!! Panic: Battery low !!!\r\n");
 			battery_alarm.alarm_battery_panic++; // an ugly hack to make sure it's never printed again
 		}
-				
-		///////////////////////////////////////////////////////////////
-		//               GYRO AND ACCELEROMETER RAW                  //
-		///////////////////////////////////////////////////////////////
-		if (counters.stream_GyroAccRaw == config.telemetry.stream_GyroAccRaw)
-		{
-			printf_checksum_direct("TR;%u;%u;%u;%u;%u;%u", (sensor_data.acc_x_raw), (sensor_data.acc_y_raw),
-			                                    (sensor_data.acc_z_raw), (sensor_data.gyro_x_raw),
-			                                    (sensor_data.gyro_y_raw), (sensor_data.gyro_z_raw));
-			counters.stream_GyroAccRaw = 0;
-		} 
-		else if (counters.stream_GyroAccRaw > config.telemetry.stream_GyroAccRaw)
-			counters.stream_GyroAccRaw = 0;
-		
-		///////////////////////////////////////////////////////////////
-		//            GYRO AND ACCELEROMETER PROCESSED              //
-		///////////////////////////////////////////////////////////////
-		if (counters.stream_GyroAccProc == config.telemetry.stream_GyroAccProc)
-		{
-			printf_checksum_direct("TP;%d;%d;%d;%d;%d;%d", (int)(sensor_data.acc_x*1000), (int)(sensor_data.acc_y*1000),
-			                                        (int)(sensor_data.acc_z*1000), (int)(sensor_data.p*1000),
-			                                        (int)(sensor_data.q*1000), (int)(sensor_data.r*1000));
-		}	
-		else if (counters.stream_GyroAccProc > config.telemetry.stream_GyroAccProc)
-			counters.stream_GyroAccProc = 0;
-		
-		///////////////////////////////////////////////////////////////
-		//                         ATTITUDE                          //
-		///////////////////////////////////////////////////////////////	
-		if (counters.stream_Attitude == config.telemetry.stream_Attitude)
-		{
-            int *t = (int*)&sensor_data.pitch;
-
-			printf_checksum_direct("TA;%d;%d;%d;%x;%x", (int)(sensor_data.roll*1000), (int)(sensor_data.pitch*1000), (int)(sensor_data.yaw*1000), t[1], t[0]);
-
-			if (control_state.simulation_mode)
-			{
-				printf_checksum_direct("TS;%d;%d;%d", servo_read_us(2), servo_read_us(0), servo_read_us(3));
-			}
-			counters.stream_Attitude = 0;
-		} 
-		else if (counters.stream_Attitude > config.telemetry.stream_Attitude)
-			counters.stream_Attitude = 0;
-			
+
 		///////////////////////////////////////////////////////////////
-		//           SCP1000: PRESSURE & TEMPERATURE                 //
+		//                  DATALOG FORMAT PROGRESS                  //
 		///////////////////////////////////////////////////////////////
-		if (counters.stream_PressureTemp == config.telemetry.stream_PressureTemp)
+		format_progress = datalogger_format_progress();
+		if (format_progress != last_format_progress)
 		{
-			printf_checksum_direct("TH;%lu;%d", (unsigned long)(sensor_data.pressure), (int)sensor_data.temperature);
-			counters.stream_PressureTemp = 0;
+			printf_checksum("DF;%d", format_progress < 0 ? 100 : format_progress);   // DF;100 when done
+			last_format_progress = format_progress;
 		}
-		else if (counters.stream_PressureTemp > config.telemetry.stream_PressureTemp)
-			counters.stream_PressureTemp = 0;
-		
+
 		///////////////////////////////////////////////////////////////
-		//                   RC TRANSMITTER INPUT                    //
+		//                  TELEMETRY LINK REPORT                    //
 		///////////////////////////////////////////////////////////////
-		if (counters.stream_PPM == config.telemetry.stream_PPM)
+		telemetry_report(&sent, &deferred, &dropped);
+		if (c % TELEMETRY_REPORT_TICKS == 0 && dropped + uart1_tx_overflows != last_lost)
 		{
-			//vTaskGetRunTimeStats( buffer );
-			//uart1_puts(buffer);
-			printf_checksum_direct("TT;%u;%u;%u;%u;%u;%u;%u;%u", (unsigned int)ppm.channel[0], (unsigned int)ppm.channel[1],
-			                                          (unsigned int)ppm.channel[2], (unsigned int)ppm.channel[3],
-			                                          (unsigned int)ppm.channel[4], (unsigned int)ppm.channel[5],
-			                                          (unsigned int)ppm.channel[6], (unsigned int)ppm.channel[7]);
-			counters.stream_PPM = 0;
+			printf_checksum("TQ;%u;%u;%u;%u", sent, deferred, dropped, uart1_tx_overflows);   // totals since boot
+			last_lost = dropped + uart1_tx_overflows;
 		}
-		else if (counters.stream_PPM > config.telemetry.stream_PPM)
-			counters.stream_PPM = 0;
-		
-		///////////////////////////////////////////////////////////////
-		//                        GPS BASIC                          //
-		///////////////////////////////////////////////////////////////
-		if (counters.stream_GpsBasic == config.telemetry.stream_GpsBasic)
+	}
+}
+
+
+///////////////////////////////////////////////////////////////
+//                         COMMANDS                          //
+///////////////////////////////////////////////////////////////
+// The handlers of the command table below get the fields of the line
+// parsed with the schema of their command (see lib/cmdtable/cmdtable.h).
+
+static void command_write_navigation(const union CommandField *field)    // WN;line;opcode;x;y;a;b
+{
+	int i = field[0].i - 1;
+
+#ifdef LIMITED
+	//if (i < 2)
+		uart1_puts("Not allowed in Limited Edition!\r\n");
+#else
+	if (i < MAX_GLUONSCRIPTCODES)
+	{
+		gluonscript_data.codes[i].opcode = field[1].i;
+		gluonscript_data.codes[i].x = field[2].f;
+		gluonscript_data.codes[i].y = field[3].f;
+		gluonscript_data.codes[i].a = field[4].i;
+		gluonscript_data.codes[i].b = field[5].i;
+
+		if (navigation_data.relative_positions_calculated)
+			navigation_calculate_relative_position(i);
+
+		// confirm by sending it back...
+		printf_checksum("ND;%d;%d;%f;%f;%d;%d", i+1, gluonscript_data.codes[i].opcode,
+		                gluonscript_data.codes[i].x, gluonscript_data.codes[i].y,
+		                gluonscript_data.codes[i].a, gluonscript_data.codes[i].b);
+	}
+#endif
+}
+
+
+static void command_jump_navigation(const union CommandField *field)    // JN;line
+{
+	gluonscript_goto_from_gcs(field[0].i);
+}
+
+
+static void command_burn_navigation(const union CommandField *field)
+{
+	gluonscript_burn();
+	printf_message("\r\nScript burned to flash\r\n");
+}
+
+
+static void command_load_navigation(const union CommandField *field)
+{
+	gluonscript_load();
+	if (navigation_data.relative_positions_calculated)
+		navigation_calculate_relative_positions();
+}
+
+
+static void command_read_navigation(const union CommandField *field)
+{
+	print_navigation();
+}
+
+
+static void command_set_control(const union CommandField *field)
+{
+	config.control.servo_mix = field[0].c - '0';
+	config.control.max_pitch = field[1].f / 180.0 * 3.14;
+	config.control.max_roll = field[2].f / 180.0 * 3.14;
+	config.control.aileron_differential = field[3].i / 10;
+
+	config.control.waypoint_radius_m = field[4].f;
+	config.control.cruising_speed_ms = field[5].f;
+	config.control.stabilization_with_altitude_hold = field[6].l == 0? 0 : 1;
+	config.control.min_pitch = DEG2RAD(field[7].f);
+	config.control.altitude_mode = field[8].i;
+	if (config.control.altitude_mode < 1 || config.control.altitude_mode > 3)
+		config.control.altitude_mode = 1;
+	control_mix_changed();
+}
+
+
+static void command_set_gps(const union CommandField *field)    // SG;baudrate/10;waas
+{
+	config.gps.initial_baudrate = (long)(unsigned int)field[0].l * 10;
+	config.gps.operational_baudrate = 0;
+	config.gps.enable_waas = field[1].c == '1' ? 1 : 0;
+}
+
+
+static void set_pid(struct pid *pid, const union CommandField *field)
+{
+	pid->p_gain = field[0].f;
+	pid->i_gain = field[1].f;
+	pid->d_gain = field[2].f;
+	pid->i_min = field[3].f;
+	pid->i_max = field[4].f;
+	pid->d_term_min_var = field[5].f;
+	control_pid_changed();
+}
+
+
+static void command_set_pid_pitch2elevator(const union CommandField *field)
+{
+	set_pid(&config.control.pid_pitch2elevator, field);
+}
+
+
+static void command_set_pid_roll2aileron(const union CommandField *field)
+{
+	set_pid(&config.control.pid_roll2aileron, field);
+}
+
+
+static void command_set_pid_heading2roll(const union CommandField *field)
+{
+	set_pid(&config.control.pid_heading2roll, field);
+}
+
+
+static void command_set_pid_altitude2pitch(const union CommandField *field)
+{
+	set_pid(&config.control.pid_altitude2pitch, field);
+}
+
+
+static void command_set_autothrottle(const union CommandField *field)
+{
+	config.control.auto_throttle_min_pct = field[0].i;
+	config.control.auto_throttle_max_pct = field[1].i;
+	config.control.auto_throttle_cruise_pct = field[2].i;
+	config.control.auto_throttle_p_gain = field[3].i;
+	config.control.autopilot_auto_throttle = field[4].l == 1;
+}
+
+
+static void command_enable_simulation(const union CommandField *field)    // SE;date;time
+{
+	printf_message("Simulation enabled\r\n");
+	control_state.simulation_mode = 1;
+	sensor_data.gps.satellites_in_view = 9;
+	sensor_data.gps.status = ACTIVE;
+	sensor_data.gps.date = field[0].l;
+	sensor_data.gps.time = field[1].l;
+	navigation_data.home_pressure_height = 0;
+	navigation_data.home_gps_height = 0;
+}
+
+
+static void command_write_simulation(const union CommandField *field)
+{
+	if (control_state.simulation_mode == 1)
+	{
+		sensor_data.gps.longitude_rad = field[0].f;
+		sensor_data.gps.latitude_rad = field[1].f;
+		sensor_data.gps.heading_rad	= field[2].f;
+		sensor_data.yaw = sensor_data.gps.heading_rad;
+		sensor_data.gps.speed_ms = field[3].f;
+		sensor_data.pressure_height = (float)field[4].i;
+		sensor_data.roll =  field[5].f;
+		sensor_data.pitch =  field[6].f;
+		navigation_data.home_pressure_height = 0;
+		navigation_data.home_gps_height = 0;
+		//sensor_data.vertical_speed
+		//sensor_data.battery_voltage_10
+
+		//navigation_update();
+	}
+}
+
+
+static void command_set_telemetry(const union CommandField *field)
+{
+	config.telemetry.stream_GpsBasic = field[0].i;
+	config.telemetry.stream_GyroAccRaw = field[1].i;
+	config.telemetry.stream_GyroAccProc = field[2].i;
+	config.telemetry.stream_PPM = field[3].i;
+	config.telemetry.stream_PressureTemp = field[4].i;
+	config.telemetry.stream_Attitude = field[5].i;
+	config.telemetry.stream_Control = field[6].i;
+}
+
+
+static void command_set_accelerometer(const union CommandField *field)    // neutral
+{
+	config.sensors.acc_x_neutral = field[0].f;
+	config.sensors.acc_y_neutral = field[1].f;
+	config.sensors.acc_z_neutral = field[2].f;
+}
+
+
+static void command_set_gyro(const union CommandField *field)    // neutral
+{
+	config.sensors.gyro_x_neutral = field[0].f;
+	config.sensors.gyro_y_neutral = field[1].f;
+	config.sensors.gyro_z_neutral = field[2].f;
+}
+
+
+static void command_set_imu(const union CommandField *field)    // 6DOF settings
+{
+	config.sensors.imu_rotated = field[0].i;
+	config.sensors.neutral_pitch = DEG2RAD(field[1].f);
+}
+
+
+static void command_calibrate_gyro(const union CommandField *field)
+{
+	int i;
+	long x=0, y=0, z=0;
+	for (i = 0; i < 10; i++)
+	{
+		x += sensor_data.gyro_x_raw;
+		y += sensor_data.gyro_y_raw;
+		z += sensor_data.gyro_z_raw;
+		vTaskDelay(( ( portTickType ) 10 / portTICK_RATE_MS ) );  // delay 10ms
+	}
+	config.sensors.gyro_x_neutral = (float)(x / 10);
+	config.sensors.gyro_y_neutral = (float)(y / 10);
+	config.sensors.gyro_z_neutral = (float)(z / 10);
+
+	// reset bias offsets
+	sensor_data.p_bias = 0.0;
+	sensor_data.q_bias = 0.0;
+	uart1_puts("Gyros calibrated\r\n");
+}
+
+
+static void command_calibrate_accelerometer(const union CommandField *field)
+{
+	int i;
+	long x=0, y=0, z=0;
+	for (i = 0; i < 10; i++)
+	{
+		x += sensor_data.acc_x_raw;
+		y += sensor_data.acc_y_raw;
+		z += sensor_data.acc_z_raw;
+		vTaskDelay(( ( portTickType ) 10 / portTICK_RATE_MS ) );  // delay 10ms
+	}
+	config.sensors.acc_x_neutral = (float)(x / 10);
+	config.sensors.acc_y_neutral = (float)(y / 10);
+	config.sensors.acc_z_neutral = (float)(z / 10);
+	if (HARDWARE_VERSION < V01Q)
+		config.sensors.acc_z_neutral = (float)(z / 10) - 6600.0;
+	else
+	{
+		if (config.sensors.imu_rotated == 4)
 		{
-			printf_checksum_direct("TG;%c;%.9f;%.9f;%u;%u;%u;%u", '0' + (unsigned char)sensor_data.gps.status,
-			                                            sensor_data.gps.latitude_rad, sensor_data.gps.longitude_rad,
-			                                            (unsigned int)(sensor_data.gps.speed_ms*10),
-			                                            (unsigned int)(sensor_data.gps.heading_rad*100),
-			                                            (unsigned int)(sensor_data.gps.satellites_in_view),
-			                                            (unsigned int)(sensor_data.gps.height_m));
-			counters.stream_GpsBasic = 0;
+			config.sensors.acc_y_neutral = (float)(y / 10) + 4096.0;
 		}
-		else if (counters.stream_GpsBasic > config.telemetry.stream_GpsBasic)
-			counters.stream_GpsBasic = 0;
-			
-		///////////////////////////////////////////////////////////////
-		//                          CONTROL                          //
-		///////////////////////////////////////////////////////////////
-		//printf("TC;CONTROL_STATUS;LINE;HEIGHT(;CARROTX;CARROTY;CARROTH)");
-		if (counters.stream_Control == config.telemetry.stream_Control)
+		else
 		{
-			int sig_quality = 0;
-			if (config.control.use_pwm)
-            {
-	        	if (ppm.connection_alive)
-	        		sig_quality = 100;
-	        	else
-	        		sig_quality = 0;
-	        } else // ppm
-            	sig_quality = (100-ppm_signal_quality()*4);  // %
-            	
-			int throttle = (config.control.servo_neutral[3] - (int)servo_read_us(3))/10;
-			if (! config.control.reverse_servo4)
-				throttle = -throttle;
-			if (throttle < 0 || throttle > 100)
-				throttle = 0;
-			//printf("\r\n %d %d\r\n", config.control.servo_neutral[3], (int)servo_read_us(3));
-			
-            int altitude;
-            if (config.control.altitude_mode == GPS_ABSOLUTE)
-                altitude =  sensor_data.gps.height_m;
-            else if (config.control.altitude_mode == GPS_RELATIVE)
-                altitude = sensor_data.gps.height_m - navigation_data.home_gps_height;
-            else //if (config.control.altitude_mode == PRESSURE)
-                altitude = (int)(sensor_data.pressure_height - navigation_data.home_pressure_height);
-            
-			printf_checksum_direct("TC;%d;%d;%d;%u;%d;%d;%d;%d;%d;%d;%u", (int)control_state.flight_mode,
-			       gluonscript_data.current_codeline, altitude,
-			       sensor_data.battery1_voltage_10,
-			       navigation_data.time_airborne_s, navigation_data.time_block_s,
-			       sig_quality, throttle, (int)navigation_data.desired_altitude_agl,
-                   sensor_data.battery2_voltage_10,(unsigned int)(sensor_data.battery1_mAh/10.0));
-			 
-			counters.stream_Control = 0;
-			//printf_checksum_poll("-- %lu --", idle_counter);
-            //idle_counter = 0;
-			//printf_checksum_poll("-- %lu --", idle_counter);
+			config.sensors.acc_z_neutral = (float)(z / 10) - 4096.0;
 		}
-		else if (counters.stream_Control > config.telemetry.stream_Control)
-			counters.stream_Control = 0;
+	}
+	uart1_puts("Accelerometers calibrated\r\n");
+}
+
+
+static void command_set_input_channels(const union CommandField *field)    // SI;pwm;a...h per function
+{
+	config.control.use_pwm = field[0].c == '1';
+	config.control.channel_ap = field[1].c - 'a';
+	config.control.channel_motor = field[2].c - 'a';
+	config.control.channel_pitch = field[3].c - 'a';
+	config.control.channel_roll = field[4].c - 'a';
+	config.control.channel_yaw = field[5].c - 'a';
+}
+
+
+static void command_set_servo_reverse(const union CommandField *field)    // SR;bits;manual trim
+{
+	unsigned int tmp = (unsigned int)field[0].l;
+	config.control.reverse_servo1 = ((tmp & 1) != 0);
+	config.control.reverse_servo2 = ((tmp & 2) != 0);
+	config.control.reverse_servo3 = ((tmp & 4) != 0);
+	config.control.reverse_servo4 = ((tmp & 8) != 0);
+	config.control.reverse_servo5 = ((tmp & 16) != 0);
+	config.control.reverse_servo6 = ((tmp & 32) != 0);
+	config.control.manual_trim = field[1].c == '1'?1:0;
+	control_mix_changed();
+}
+
+
+static void command_set_servo_min_max(const union CommandField *field)    // SM;servo;min;neutral;max
+{
+	int nr = field[0].i;
+	config.control.servo_min[nr] = field[1].i;
+	config.control.servo_neutral[nr] = field[2].i;
+	config.control.servo_max[nr] = field[3].i;
+	control_mix_changed();
+}
+
+
+static void command_load_mix(const union CommandField *field)    // ML;type
+{
+	control_mix_custom_load(field[0].i);
+}
+
+
+static void command_set_mix_outputs(const union CommandField *field)    // MC;outputs;copter
+{
+	config.control.custom_mix.outputs = MAX(0, MIN(MIX_OUTPUTS, field[0].i));
+	config.control.custom_mix.copter = field[1].c == '1' ? 1 : 0;
+	control_mix_changed();
+}
+
+
+// MX;output;aileron;aileron differential;elevator;yaw;motor;roll;rudder stick;fixed neutral, in percent
+static void command_set_mix(const union CommandField *field)
+{
+	struct MixCustom *c = &config.control.custom_mix;
+	int nr = field[0].i, i;
+
+	if (nr < 0 || nr >= MIX_OUTPUTS)
+		return;
+	for (i = 0; i < MIX_INPUTS; i++)
+		c->coefficient[nr][i] = (signed char)MAX(-127, MIN(127, field[i + 1].i));
+	if (field[MIX_INPUTS + 1].c == '1')
+		c->fixed_neutral |= 1 << nr;
+	else
+		c->fixed_neutral &= ~(1 << nr);
+	if (c->outputs <= nr)
+		c->outputs = nr + 1;
+	control_mix_changed();
+}
+
+
+static void command_set_osd(const union CommandField *field)    // SO;bits;rssi;voltage low;voltage high
+{
+	unsigned long bits = (unsigned long)field[0].l;
+	osd_clear();
+	config.osd.show_altitude = ((bits & 1) != 0) ? 1 : 0;
+	config.osd.show_arrow_home = ((bits & 2) != 0) ? 1 : 0;
+	config.osd.show_artificial_horizon = ((bits & 4) != 0) ? 1 : 0;
+	config.osd.show_block_name = ((bits & 8) != 0) ? 1 : 0;
+	config.osd.show_current = ((bits & 16) != 0) ? 1 : 0;
+	config.osd.show_distance_home = ((bits & 32) != 0) ? 1 : 0;
+	config.osd.show_flight_time = (((bits & 64) != 0) ? 1 : 0);
+	config.osd.show_gps_status = ((bits & 128) != 0) ? 1 : 0;
+	config.osd.show_mah = ((bits & 256) != 0) ? 1 : 0;
+	config.osd.show_mode = ((bits & 512) != 0) ? 1 : 0;
+	config.osd.show_rc_link = ((bits & 1024) != 0) ? 1 : 0;
+	config.osd.show_speed = ((bits & 2048) != 0) ? 1 : 0;
+	config.osd.show_vario = ((bits & 4096) != 0) ? 1 : 0;
+	config.osd.show_voltage1 = ((bits & 8192) != 0) ? 1 : 0;
+	config.osd.show_voltage2 = ((bits & 16384) != 0) ? 1 : 0;
+	config.osd.show_block_name = ((bits & 32768) != 0) ? 1 : 0;
+	config.osd.rssi = (enum RssiMode) field[1].l;
+	config.osd.voltage_low  = (unsigned char) field[2].l;
+	config.osd.voltage_high  = (unsigned char) field[3].l;
+}
+
+
+static void command_format_datalog(const union CommandField *field)    // progress: DF;% in the telemetry
+{
+	datalogger_format();
+}
+
+
+static void command_datalog_index(const union CommandField *field)
+{
+	int i;
+	//uart1_puts("\n\r");
+	for (i = 0; i < MAX_INDEX; i++)
+		printf_checksum("DT;%d;%d;%ld;%ld", i, datalogger_journal.index[i].page_num, datalogger_journal.index[i].date, datalogger_journal.index[i].time);
+}
+
+
+static void command_reset(const union CommandField *field)
+{
+	if (field[0].l == 1123)  // double check
+	{
+		printf_message("Reboot command received...\r\n");
+		vTaskDelay( ( ( portTickType ) 1000 / portTICK_RATE_MS ) );  // 1s
+#ifdef SITL
+		vTaskEndScheduler();  // ends the simulation
+#else
+		asm("reset");
+#endif
+	}
+}
+
+
+static void command_datalog_read(const union CommandField *field)    // DR;log
+{
+	datalogger_disable();
+
+	while (datalogger_print_next_page(field[0].i, &print_logrecord))
+		;
+
+	//datalogger_enable();
+}
 
+
+static void command_datalog_binary_read(const union CommandField *field)    // DB;first page;last page
+{
+	datalogger_disable();
+	print_logpages(field[0].i, field[1].i);
+}
+
+
+static void command_datalog_period(const union CommandField *field)    // DP;id;period  until the next reboot
+{
+	if (! datalogger_set_period(field[0].i, field[1].i))
+		printf_message("Unknown record type\r\n");
+}
+
+
+static void command_binary_telemetry(const union CommandField *field)    // TB;1 binary telemetry, TB;0 CSV, until the next reboot
+{
+	telemetry_binary = field[0].l == 1;
+	printf_checksum("TB;%d", telemetry_binary);
+}
+
+
+static void command_write_configuration(const union CommandField *field)    // FC write to flash!
+{
+	configuration_write();
+	printf_message("Configuration burned to flash\r\n");
+}
+
+
+static void command_load_configuration(const union CommandField *field)    // from flash
+{
+	configuration_load();
+}
+
+
+static void command_load_default_configuration(const union CommandField *field)
+{
+	configuration_default();
+}
+
+
+static void command_read_configuration(const union CommandField *field)    // RC;A or RC;M (the custom mix)
+{
+	if (field[0].c == 'A')
+	{
+		if (xSemaphoreTake( xUart1Semaphore, ( portTickType ) 100 / portTICK_RATE_MS )  == pdTRUE)
+		{
+			print_configuration();
+			xSemaphoreGive( xUart1Semaphore );
+		}
 	}
+	else if (field[0].c == 'M')
+		print_mix();
 }
 
 
-extern xQueueHandle xRxedChars;
+/*!
+ *   All commands, with the schema of their fields (see cmdtable.h).
+ */
+static const struct Command commands[] =
+{
+	// navigation
+	{ "WN", "iiffii",    command_write_navigation },
+	{ "JN", "i",         command_jump_navigation },
+	{ "FN", "",          command_burn_navigation },
+	{ "LN", "",          command_load_navigation },
+	{ "RN", "",          command_read_navigation },
+	// configuration
+	{ "SC", "cffifflfi", command_set_control },
+	{ "SG", "lc",        command_set_gps },
+	{ "PP", "ffffff",    command_set_pid_pitch2elevator },
+	{ "PR", "ffffff",    command_set_pid_roll2aileron },
+	{ "PH", "ffffff",    command_set_pid_heading2roll },
+	{ "PA", "ffffff",    command_set_pid_altitude2pitch },
+	{ "AT", "iiiil",     command_set_autothrottle },
+	{ "ST", "iiiiiii",   command_set_telemetry },
+	{ "SA", "fff",       command_set_accelerometer },
+	{ "SY", "fff",       command_set_gyro },
+	{ "S6", "if",        command_set_imu },
+	{ "CG", "",          command_calibrate_gyro },
+	{ "CA", "",          command_calibrate_accelerometer },
+	{ "SI", "cccccc",    command_set_input_channels },
+	{ "SR", "lc",        command_set_servo_reverse },
+	{ "SM", "iiii",      command_set_servo_min_max },
+	{ "SO", "llll",      command_set_osd },
+	{ "ML", "i",         command_load_mix },
+	{ "MC", "ic",        command_set_mix_outputs },
+	{ "MX", "iiiiiiiic", command_set_mix },
+	{ "FC", "",          command_write_configuration },
+	{ "LC", "",          command_load_configuration },
+	{ "LD", "",          command_load_default_configuration },
+	{ "RC", "c",         command_read_configuration },
+	// simulation
+	{ "SE", "ll",        command_enable_simulation },
+	{ "SW", "ffffiff",   command_write_simulation },
+	// datalog
+	{ "FF", "",          command_format_datalog },
+	{ "FI", "",          command_datalog_index },
+	{ "DR", "i",         command_datalog_read },
+	{ "DB", "ii",        command_datalog_binary_read },
+	{ "DP", "ii",        command_datalog_period },
+	// other
+	{ "TB", "l",         command_binary_telemetry },
+	{ "ZZ", "l",         command_reset },
+};
+
+
+int communication_commands(struct CommandTable *t)
+{
+	return cmdtable_init(t, commands, sizeof(commands) / sizeof(commands[0]));
+}
 
-#define MAX_TOKEN 10
 
 /*!
  *   This task parses and executes all commands coming from the groundstation
- *   or configuration utility. It depends on uart1_queue.c because all data received
- *   on the uart1 is stored in a FreeRTOS queue. When there is data in the queue, the
- *   RTOS executes this function so the data can be parsed.
+ *   or configuration utility. It depends on uart1_queue.c: the received data is
+ *   stored in a ring buffer by DMA, and this task only runs when a complete line
+ *   is there (see uart1_getline()). The commands are looked up in the table
+ *   above.
  *
  *   Measured used stackspace: 388 / 2150 bytes
  *
@@ -327,25 +934,27 @@ extern xQueueHandle xRxedChars;
  */
 void communication_input_task( void *parameters )
 {
+	static struct CommandTable command_table;
 	static int   buffer_position;
-	static int   token[MAX_TOKEN+1] = {0,0,0,0,0,0,0,0,0,0,0};
+	static int   token[CMDTABLE_MAX_TOKEN+1];
 	static int   current_token;
 	
-	char tmp;
-
     int with_checksum = 0;  // did we receive the last line with a checksum?
 
     vTaskSetApplicationTaskTag( NULL, ( void * ) 4 );
 
 	uart1_puts("Console input task initializing...");
+	communication_commands(&command_table);
 	uart1_puts("done\r\n");
 	
 	for( ;; )
 	{
-		/* Wait until it is time for the next cycle. */
-		if( xQueueReceive( xRxedChars, &tmp, portMAX_DELAY  ) )
+		/* Wait for the next line. Room is left for the '\0' appended on errors below. */
+		buffer_position = uart1_getline(buffer, BUFFERSIZE - 1);
+		current_token = buffer_position < 0 ? 0 : cmdtable_tokenize(buffer, buffer_position, token);
+        if (buffer_position >= 0)
         {           
-            if (tmp == '\n' || tmp == '\r')
+            if (current_token <= CMDTABLE_MAX_TOKEN)
             {
 	            buffer[buffer_position] = '\0';
 	            //printf("\r\nChecking checksum: %s\r\n", buffer);
@@ -367,520 +976,28 @@ void communication_input_task( void *parameters )
 
                 if (buffer_position >= 2) // more than something empty: check checksum & start parsing
                 {
-                    char c1 = buffer[token[0]];
-                    char c2 = buffer[token[0] + 1];
-
                     if (!with_checksum) // don't parse data without a valid or without any checksum
                     {
-                        printf_nochecksum_direct("Data with invalid or no checksum received: %s\r\n", buffer);
-                    }
-                    // first handle all navigation
-                    else if (c2 == 'N')
-                    {
-                        ///////////////////////////////////////////////////////////////
-                        //                      WRITE NAVIGATION                     //
-                        ///////////////////////////////////////////////////////////////
-                        if (c1 == 'W')
-                        {
-                            int i = atoi(&(buffer[token[1]])) - 1;
-
-        #ifdef LIMITED
-            //if (i < 2)
-                uart1_puts("Not allowed in Limited Edition!\r\n");
-        #else
-                            if (i < MAX_GLUONSCRIPTCODES)
-                            {
-                                gluonscript_data.codes[i].opcode = atoi(&(buffer[token[2]]));
-                                gluonscript_data.codes[i].x = atof(&(buffer[token[3]]));
-                                gluonscript_data.codes[i].y = atof(&(buffer[token[4]]));
-                                gluonscript_data.codes[i].a = atoi(&(buffer[token[5]]));
-                                gluonscript_data.codes[i].b = atoi(&(buffer[token[6]]));
-
-                                if (navigation_data.relative_positions_calculated)
-                                    navigation_calculate_relative_position(i);
-
-                                // confirm by sending it back...
-                                printf_checksum("ND;%d;%d;%f;%f;%d;%d", i+1, gluonscript_data.codes[i].opcode,
-                                                gluonscript_data.codes[i].x, gluonscript_data.codes[i].y,
-                                                gluonscript_data.codes[i].a, gluonscript_data.codes[i].b);
-                            }
-        #endif
-                        }
-                        ///////////////////////////////////////////////////////////////
-                        //                 JUMP TO NAVIGATION LINE                   //
-                        ///////////////////////////////////////////////////////////////
-                        else if (c1 == 'J')
-                        {
-                            int number = atoi(&(buffer[token[1]]));
-                            gluonscript_goto_from_gcs(number);
-                        }
-                        ///////////////////////////////////////////////////////////////
-                        //                       BURN NAVIGATION                     //
-                        ///////////////////////////////////////////////////////////////
-                        else if (c1 == 'F')
-                        {
-                            gluonscript_burn();
-                            printf_message("\r\nScript burned to flash\r\n");
-                        }
-                        ///////////////////////////////////////////////////////////////
-                        //                       LOAD NAVIGATION                     //
-                        ///////////////////////////////////////////////////////////////
-                        else if (c1 == 'L')
-                        {
-                            gluonscript_load();
-                            if (navigation_data.relative_positions_calculated)
-                                navigation_calculate_relative_positions();
-                        }
-                        ///////////////////////////////////////////////////////////////
-                        //                       READ NAVIGATION                     //
-                        ///////////////////////////////////////////////////////////////
-                        else if (c1 == 'R')
-                        {
-                            print_navigation();
-                        }
-                    }
-                    ///////////////////////////////////////////////////////////////
-                    //                       SET CONTROL                         //
-                    ///////////////////////////////////////////////////////////////
-                    else if (c1 == 'S' && c2 == 'C')    // Set control
-                    {
-                        config.control.servo_mix = (buffer[token[1] + 0]) - '0';
-                        config.control.max_pitch = atof(&(buffer[token[2]])) / 180.0 * 3.14;
-                        config.control.max_roll = atof(&(buffer[token[3]])) / 180.0 * 3.14;
-                        config.control.aileron_differential = atoi(&(buffer[token[4]])) / 10;
-
-                        config.control.waypoint_radius_m = atof(&(buffer[token[5]]));
-                        config.control.cruising_speed_ms = atof(&(buffer[token[6]]));
-                        config.control.stabilization_with_altitude_hold = atoi(&(buffer[token[7]])) == 0? 0 : 1;
-                        config.control.min_pitch = DEG2RAD(atof(&(buffer[token[8]])));
-                        config.control.altitude_mode = atoi(&(buffer[token[9]]));
-                        if (config.control.altitude_mode < 1 || config.control.altitude_mode > 3)
-                            config.control.altitude_mode = 1;
-                    }
-                    ///////////////////////////////////////////////////////////////
-                    //                  SET GPS CONFIGURATION                    //
-                    ///////////////////////////////////////////////////////////////
-                    else if (c1 == 'S' && c2 == 'G')    // Set GPS
-                    {
-                        unsigned int x;
-                        sscanf(&(buffer[token[1]]), "%u", &x);
-                        config.gps.initial_baudrate = (long)x * 10;
-                        config.gps.operational_baudrate = 0;
-                        if (buffer[token[2]] == '1')
-                            config.gps.enable_waas = 1;
-                        else
-                            config.gps.enable_waas = 0;
-                    }
-                    ///////////////////////////////////////////////////////////////
-                    //                 SET PID PITCH 2 ELEVATOR                  //
-                    ///////////////////////////////////////////////////////////////
-                    else if (c1 == 'P' && c2 == 'P')    // Set PID
-                    {
-                        config.control.pid_pitch2elevator.p_gain = (float)atof(&(buffer[token[1]]));
-                        config.control.pid_pitch2elevator.i_gain = (float)atof(&(buffer[token[2]]));
-                        config.control.pid_pitch2elevator.d_gain = (float)atof(&(buffer[token[3]]));
-                        config.control.pid_pitch2elevator.i_min = (float)atof(&(buffer[token[4]]));
-                        config.control.pid_pitch2elevator.i_max = (float)atof(&(buffer[token[5]]));
-                        config.control.pid_pitch2elevator.d_term_min_var = (float)atof(&(buffer[token[6]]));
-                    }
-                    ///////////////////////////////////////////////////////////////
-                    //                  SET PID ROLL 2 AILERON                   //
-                    ///////////////////////////////////////////////////////////////
-                    else if (c1 == 'P' && c2 == 'R')    // Set PID
-                    {
-                        config.control.pid_roll2aileron.p_gain = (float)atof(&(buffer[token[1]]));
-                        config.control.pid_roll2aileron.i_gain = (float)atof(&(buffer[token[2]]));
-                        config.control.pid_roll2aileron.d_gain = (float)atof(&(buffer[token[3]]));
-                        config.control.pid_roll2aileron.i_min = (float)atof(&(buffer[token[4]]));
-                        config.control.pid_roll2aileron.i_max = (float)atof(&(buffer[token[5]]));
-                        config.control.pid_roll2aileron.d_term_min_var = (float)atof(&(buffer[token[6]]));
-                    }
-                    ///////////////////////////////////////////////////////////////
-                    //                SET PID HEADING 2 ROLL/YAW                 //
-                    ///////////////////////////////////////////////////////////////
-                    else if (c1 == 'P' && c2 == 'H')    // Set PID
-                    {
-                        config.control.pid_heading2roll.p_gain = (float)atof(&(buffer[token[1]]));
-                        config.control.pid_heading2roll.i_gain = (float)atof(&(buffer[token[2]]));
-                        config.control.pid_heading2roll.d_gain = (float)atof(&(buffer[token[3]]));
-                        config.control.pid_heading2roll.i_min = (float)atof(&(buffer[token[4]]));
-                        config.control.pid_heading2roll.i_max = (float)atof(&(buffer[token[5]]));
-                        config.control.pid_heading2roll.d_term_min_var = (float)atof(&(buffer[token[6]]));
-                    }
-                    ///////////////////////////////////////////////////////////////
-                    //                  SET PID ALTITUDE 2 PITCH                 //
-                    ///////////////////////////////////////////////////////////////
-                    else if (c1 == 'P' && c2 == 'A')    // Set PID
-                    {
-                        config.control.pid_altitude2pitch.p_gain = (float)atof(&(buffer[token[1]]));
-                        config.control.pid_altitude2pitch.i_gain = (float)atof(&(buffer[token[2]]));
-                        config.control.pid_altitude2pitch.d_gain = (float)atof(&(buffer[token[3]]));
-                        config.control.pid_altitude2pitch.i_min = (float)atof(&(buffer[token[4]]));
-                        config.control.pid_altitude2pitch.i_max = (float)atof(&(buffer[token[5]]));
-                        config.control.pid_altitude2pitch.d_term_min_var = (float)atof(&(buffer[token[6]]));
-                    }
-                    ///////////////////////////////////////////////////////////////
-                    //                  SET AUTOTHROTTLE                 //
-                    ///////////////////////////////////////////////////////////////
-                    else if (c1 == 'A' && c2 == 'T')    // Set PID
-                    {
-                        config.control.auto_throttle_min_pct = atoi(&(buffer[token[1]]));
-                        config.control.auto_throttle_max_pct = atoi(&(buffer[token[2]]));
-                        config.control.auto_throttle_cruise_pct = atoi(&(buffer[token[3]]));
-                        config.control.auto_throttle_p_gain = atoi(&(buffer[token[4]]));
-                        config.control.autopilot_auto_throttle = atoi(&(buffer[token[5]])) == 1;
+                        puts_line_direct("Data with invalid or no checksum received: ", buffer);
                     }
-
-                    ///////////////////////////////////////////////////////////////
-                    //                      ENABLE SIMULATION                    //
-                    ///////////////////////////////////////////////////////////////
-                    else if (c1 == 'S' && c2 == 'E')
-                    {
-                        printf_message("Simulation enabled\r\n");
-                        control_state.simulation_mode = 1;
-                        sensor_data.gps.satellites_in_view = 9;
-                        sensor_data.gps.status = ACTIVE;
-                        sensor_data.gps.date = atol(&(buffer[token[1]]));
-                        sensor_data.gps.time = atol(&(buffer[token[2]]));
-                        navigation_data.home_pressure_height = 0;
-                        navigation_data.home_gps_height = 0;
-                    }
-                    ///////////////////////////////////////////////////////////////
-                    //                      WRITE SIMULATION                    //
-                    ///////////////////////////////////////////////////////////////
-                    else if (c1 == 'S' && c2 == 'W')
-                    {
-                        if (control_state.simulation_mode == 1)
-                        {
-                            sensor_data.gps.longitude_rad = (float)atof(&(buffer[token[1]]));
-                            sensor_data.gps.latitude_rad = (float)atof(&(buffer[token[2]]));
-                            sensor_data.gps.heading_rad	= (float)atof(&(buffer[token[3]]));
-                            sensor_data.yaw = sensor_data.gps.heading_rad;
-                            sensor_data.gps.speed_ms = (float)atof(&(buffer[token[4]]));
-                            sensor_data.pressure_height = (float)atoi(&(buffer[token[5]]));
-                            sensor_data.roll =  (float)atof(&(buffer[token[6]]));
-                            sensor_data.pitch =  (float)atof(&(buffer[token[7]]));
-                            navigation_data.home_pressure_height = 0;
-                            navigation_data.home_gps_height = 0;
-                            //sensor_data.vertical_speed
-                            //sensor_data.battery_voltage_10
-
-                            //navigation_update();
-                        }
-                    }
-                    ///////////////////////////////////////////////////////////////
-                    //                      SET TELEMETRY                        //
-                    ///////////////////////////////////////////////////////////////
-                    else if (c1 == 'S' && c2 == 'T')    // Set Telemetry
-                    {
-                        config.telemetry.stream_GpsBasic = atoi(&(buffer[token[1]]));
-                        config.telemetry.stream_GyroAccRaw = atoi(&(buffer[token[2]]));
-                        config.telemetry.stream_GyroAccProc = atoi(&(buffer[token[3]]));
-                        config.telemetry.stream_PPM = atoi(&(buffer[token[4]]));
-                        config.telemetry.stream_PressureTemp = atoi(&(buffer[token[5]]));
-                        config.telemetry.stream_Attitude = atoi(&(buffer[token[6]]));
-                        config.telemetry.stream_Control = atoi(&(buffer[token[7]]));
-                    }
-                    ///////////////////////////////////////////////////////////////
-                    //                    SET ACCELEROMETER                      //
-                    ///////////////////////////////////////////////////////////////
-                    else if (c1 == 'S' && c2 == 'A')    // Set Accelerometer neutral
-                    {
-                        config.sensors.acc_x_neutral = (float)atof(&(buffer[token[1]]));
-                        config.sensors.acc_y_neutral = (float)atof(&(buffer[token[2]]));
-                        config.sensors.acc_z_neutral = (float)atof(&(buffer[token[3]]));
-                    }
-                    ///////////////////////////////////////////////////////////////
-                    //                        SET GYRO                           //
-                    ///////////////////////////////////////////////////////////////
-                    else if (c1 == 'S' && c2 == 'Y')    // Set Gyro neutral
-                    {
-                        config.sensors.gyro_x_neutral = (float)atof(&(buffer[token[1]]));
-                        config.sensors.gyro_y_neutral = (float)atof(&(buffer[token[2]]));
-                        config.sensors.gyro_z_neutral = (float)atof(&(buffer[token[3]]));
-                    }
-                    ///////////////////////////////////////////////////////////////
-                    //                        SET IMU                            //
-                    ///////////////////////////////////////////////////////////////
-                    else if (c1 == 'S' && c2 == '6')    // Set 6DOF settings
-                    {
-                        config.sensors.imu_rotated = atoi(&(buffer[token[1]]));
-                        config.sensors.neutral_pitch = DEG2RAD((float)atof(&(buffer[token[2]])));
-                    }
-                    ///////////////////////////////////////////////////////////////
-                    //                     CALIBRATE GYRO                        //
-                    ///////////////////////////////////////////////////////////////
-                    else if (c1 == 'C' && c2 == 'G')    // Calibrate gyro
-                    {
-                        int i;
-                        long x=0, y=0, z=0;
-                        for (i = 0; i < 10; i++)
-                        {
-                            x += sensor_data.gyro_x_raw;
-                            y += sensor_data.gyro_y_raw;
-                            z += sensor_data.gyro_z_raw;
-                            vTaskDelay(( ( portTickType ) 10 / portTICK_RATE_MS ) );  // delay 10ms
-                        }
-                        config.sensors.gyro_x_neutral = (float)(x / 10);
-                        config.sensors.gyro_y_neutral = (float)(y / 10);
-                        config.sensors.gyro_z_neutral = (float)(z / 10);
-
-                        // reset bias offsets
-                        sensor_data.p_bias = 0.0;
-                        sensor_data.q_bias = 0.0;
-                        printf("Gyros calibrated\r\n");
-                    }
-                    ///////////////////////////////////////////////////////////////
-                    //                    CALIBRATE ACCELERO                     //
-                    ///////////////////////////////////////////////////////////////
-                    else if (c1 == 'C' && c2 == 'A')    // Calibrate accelerometer
-                    {
-                        int i;
-                        long x=0, y=0, z=0;
-                        for (i = 0; i < 10; i++)
-                        {
-                            x += sensor_data.acc_x_raw;
-                            y += sensor_data.acc_y_raw;
-                            z += sensor_data.acc_z_raw;
-                            vTaskDelay(( ( portTickType ) 10 / portTICK_RATE_MS ) );  // delay 10ms
-                        }
-                        config.sensors.acc_x_neutral = (float)(x / 10);
-                        config.sensors.acc_y_neutral = (float)(y / 10);
-                        config.sensors.acc_z_neutral = (float)(z / 10);
-                        if (HARDWARE_VERSION < V01Q)
-                            config.sensors.acc_z_neutral = (float)(z / 10) - 6600.0;
-                        else
-                        {
-                            if (config.sensors.imu_rotated == 4)
-                            {
-                                config.sensors.acc_y_neutral = (float)(y / 10) + 4096.0;
-                            }
-                            else
-                            {
-                                config.sensors.acc_z_neutral = (float)(z / 10) - 4096.0;
-                            }
-                        }
-                        printf("Accelerometers calibrated\r\n");
-                    }
-                    ///////////////////////////////////////////////////////////////
-                    //                    SET INPUT CHANNELS                     //
-                    ///////////////////////////////////////////////////////////////
-                    else if (c1 == 'S' && c2 == 'I')    // Set Input Channel
-                    {
-                        config.control.use_pwm = (buffer[token[1] + 0]) == '1';
-                        config.control.channel_ap = (buffer[token[2] + 0] - 'a');
-                        config.control.channel_motor = (buffer[token[3] + 0] - 'a');
-                        config.control.channel_pitch = (buffer[token[4] + 0] - 'a');
-                        config.control.channel_roll = (buffer[token[5] + 0] - 'a');
-                        config.control.channel_yaw = (buffer[token[6] + 0] - 'a');
-
-                    }
-                    ///////////////////////////////////////////////////////////////
-                    //                    SET SERVO REVERSE                      //
-                    ///////////////////////////////////////////////////////////////
-                    else if (c1 == 'S' && c2 == 'R')    // Set servo reverse
-                    {
-                        unsigned int tmp = atoi(&(buffer[token[1]]));
-                        config.control.reverse_servo1 = ((tmp & 1) != 0);
-                        config.control.reverse_servo2 = ((tmp & 2) != 0);
-                        config.control.reverse_servo3 = ((tmp & 4) != 0);
-                        config.control.reverse_servo4 = ((tmp & 8) != 0);
-                        config.control.reverse_servo5 = ((tmp & 16) != 0);
-                        config.control.reverse_servo6 = ((tmp & 32) != 0);
-                        config.control.manual_trim = buffer[token[2]] == '1'?1:0;
-                    }
-                    ///////////////////////////////////////////////////////////////
-                    //                    SET MIN MAX                            //
-                    ///////////////////////////////////////////////////////////////
-                    else if (c1 == 'S' && c2 == 'M')    // Set servo reverse
-                    {
-                        int nr = atoi(&(buffer[token[1]]));
-                        int min = atoi(&(buffer[token[2]]));
-                        int neutral = atoi(&(buffer[token[3]]));
-                        int max = atoi(&(buffer[token[4]]));
-                        config.control.servo_min[nr] = min;
-                        config.control.servo_neutral[nr] = neutral;
-                        config.control.servo_max[nr] = max;
-                    }
-                    ///////////////////////////////////////////////////////////////
-                    //                    SET OSD                            //
-                    ///////////////////////////////////////////////////////////////
-                    else if (c1 == 'S' && c2 == 'O')    // Set osd
-                    {
-                        osd_clear();
-                        unsigned long bits = (unsigned long)atol(&(buffer[token[1]]));
-                        config.osd.show_altitude = ((bits & 1) != 0) ? 1 : 0;
-                        config.osd.show_arrow_home = ((bits & 2) != 0) ? 1 : 0;
-                        config.osd.show_artificial_horizon = ((bits & 4) != 0) ? 1 : 0;
-                        config.osd.show_block_name = ((bits & 8) != 0) ? 1 : 0;
-                        config.osd.show_current = ((bits & 16) != 0) ? 1 : 0;
-                        config.osd.show_distance_home = ((bits & 32) != 0) ? 1 : 0;
-                        config.osd.show_flight_time = (((bits & 64) != 0) ? 1 : 0);
-                        config.osd.show_gps_status = ((bits & 128) != 0) ? 1 : 0;
-                        config.osd.show_mah = ((bits & 256) != 0) ? 1 : 0;
-                        config.osd.show_mode = ((bits & 512) != 0) ? 1 : 0;
-                        config.osd.show_rc_link = ((bits & 1024) != 0) ? 1 : 0;
-                        config.osd.show_speed = ((bits & 2048) != 0) ? 1 : 0;
-                        config.osd.show_vario = ((bits & 4096) != 0) ? 1 : 0;
-                        config.osd.show_voltage1 = ((bits & 8192) != 0) ? 1 : 0;
-                        config.osd.show_voltage2 = ((bits & 16384) != 0) ? 1 : 0;
-                        config.osd.show_block_name = ((bits & 32768) != 0) ? 1 : 0;
-                        config.osd.rssi = (enum RssiMode) atoi(&(buffer[token[2]]));
-                        config.osd.voltage_low  = (unsigned char) atoi(&(buffer[token[3]]));
-                        config.osd.voltage_high  = (unsigned char) atoi(&(buffer[token[4]]));
-                    }
-                    ///////////////////////////////////////////////////////////////
-                    //                      FORMAT DATALOG                       //
-                    ///////////////////////////////////////////////////////////////
-                    else if (c1 == 'F' && c2 == 'F')
-                    {
-                        datalogger_format();
-                    }
-                    ///////////////////////////////////////////////////////////////
-                    //                    DATALOG INDEX TABLE                    //
-                    ///////////////////////////////////////////////////////////////
-                    else if (c1 == 'F' && c2 == 'I')
-                    {
-                        int i;
-                        //uart1_puts("\n\r");
-                        for (i = 0; i < MAX_INDEX; i++)
-                            printf_checksum("DT;%d;%d;%ld;%ld", i, datalogger_index_table[i].page_num, datalogger_index_table[i].date, datalogger_index_table[i].time);
-                    }
-                    ///////////////////////////////////////////////////////////////
-                    //                           RESET                           //
-                    ///////////////////////////////////////////////////////////////
-                    else if (c1 == 'Z' && c2 == 'Z')
-                    {
-                        if (atoi(&(buffer[token[1]])) == 1123)  // double check
-                        {
-                            printf_message("Reboot command received...\r\n");
-                            vTaskDelay( ( ( portTickType ) 1000 / portTICK_RATE_MS ) );  // 1s
-                            asm("reset");
-                        }
-                    }
-                    ///////////////////////////////////////////////////////////////
-                    //                       DATALOG READ                        //
-                    ///////////////////////////////////////////////////////////////
-                    else if (c1 == 'D' && c2 == 'R')
-                    {
-                        int i = atoi(&(buffer[token[1]]));
-
-    #ifdef DETAILED_LOG
-                        printf_message ("\r\nDH;Latitude;Longitude;SpeedGPS;HeadingGPS;HeightGPS;SatellitesGPS;");
-                        printf_message ("HeightBaro;Pitch;Roll;DesiredPitch;DesiredRoll;DesiredHeading;DesiredHeight;AccXG;AccYG;");
-                        printf_message ("AccZG;P;Q;R;TempC;FlightMode;NavigationLine\r\n");
-    #elif RAW_50HZ_LOG
-                        printf_message ("DH;Latitude;Longitude;Time;SpeedGPS;HeadingGPS;AccX;AccY;AccZ;GyroX;GyroY;GyroZ;HeightBaro;Pitch;Roll;PitchAcc\r\n");//;idg500-vref;FlightMode\r\n");
-    #else
-                        printf_message ("\r\nDH;Date;Time;Latitude;Longitude;SpeedGPS;HeadingGPS;HeightGPS;");
-                        printf_message ("HeightBaro;Pitch;Roll;Yaw;");
-                        printf_message ("TempC;FlightMode;NavigationLine;ServoTrigger\r\n");
-    #endif
-
-                        datalogger_disable();
-
-                        while (datalogger_print_next_page(i, &print_logline))
-                            ;
-
-
-                        /* ** SIMULATION ** */
-                        /*ahrs_init();
-                        while (datalogger_print_next_page(i, &print_logline_simulation))
-                            ;
-                        */
-                        //datalogger_enable();
-                    }
-                    ///////////////////////////////////////////////////////////////
-                    //                      WRITE TO FLASH                       //
-                    ///////////////////////////////////////////////////////////////
-                    else if (c1 == 'F' && c2 == 'C')    // FC write to flash!
-                    {
-                        configuration_write();
-                        printf_message("Configuration burned to flash\r\n");
-                    }
-                    ///////////////////////////////////////////////////////////////
-                    //                     LOAD FROM FLASH                       //
-                    ///////////////////////////////////////////////////////////////
-                    else if (c1 == 'L' && c2 == 'C')    // Load configuration from flash!
-                    {
-                        configuration_load();
-                    }
-                    ///////////////////////////////////////////////////////////////
-                    //                LOAD DEFAULT CONFIGURATION                 //
-                    ///////////////////////////////////////////////////////////////
-                    else if (c1 == 'L' && c2 == 'D')    // Load default configuration
-                    {
-                        configuration_default();
-                    }
-                    ///////////////////////////////////////////////////////////////
-                    //                  READ ALL CONFIGURATION                   //
-                    ///////////////////////////////////////////////////////////////
-                    else if (c1 == 'R' && c2 == 'C')    // RC;x  Read configuration
-                    {
-                        if (buffer[token[1]] == 'A')
-                        {
-                            if (xSemaphoreTake( xUart1Semaphore, ( portTickType ) 100 / portTICK_RATE_MS )  == pdTRUE)
-                            {
-                                print_configuration();
-                                xSemaphoreGive( xUart1Semaphore );
-                            }
-                        }
-                    }
-                    else if (current_token > 0)  // && \n or \r
+                    else if (! cmdtable_dispatch(&command_table, buffer, token, current_token) &&
+                             current_token > 0)  // && \n or \r
                     {
                         buffer[buffer_position++] = '\0';
                         buffer[buffer_position] = '\0';
-                        printf_nochecksum_direct("ERROR received data: %s\r\n", buffer);
+                        puts_line_direct("ERROR received data: ", buffer);
                     }
                 }
-            	buffer_position = 0;
-            	current_token = 0;
-            	token[0] = 0;
-            	token[1] = 0;
-            	token[2] = 0;
-            	token[3] = 0;
-            	token[4] = 0;
-            	token[5] = 0;
-            	token[6] = 0;
-            	token[7] = 0;
-            	token[8] = 0;
-                token[9] = 0;
-            }
-            else if (tmp == ';' || tmp == '*')  // new token
-            {
-				if  (current_token < MAX_TOKEN && buffer_position < BUFFERSIZE)
-				{
-	            	buffer[buffer_position++] = tmp;
-	            	token[++current_token] = buffer_position;
-				} 
-				else if (current_token >= MAX_TOKEN) // error!
-				{
-					buffer_position = 0;
-					current_token = 0;
-                    printf("\r\nError max token\r\n");
-				}
-	        } 
-            else if (buffer_position < BUFFERSIZE)  // no newline and no new token
-            {
-	        	buffer[buffer_position++] = tmp;
             }
             else
             {
-                printf("\r\nRx parser buffer overflow\r\n");
-                buffer_position = 0;
-            	current_token = 0;
-            	token[0] = 0;
-            	token[1] = 0;
-            	token[2] = 0;
-            	token[3] = 0;
-            	token[4] = 0;
-            	token[5] = 0;
-            	token[6] = 0;
-            	token[7] = 0;
-            	token[8] = 0;
-                token[9] = 0;
+                uart1_puts("\r\nError max token\r\n");
             }
         }
+        else
+        {
+            uart1_puts("\r\nRx parser buffer overflow\r\n");
+        }
 	}
 }
 
@@ -896,86 +1013,94 @@ void print_navigation()
 	}	
 }
 
+
+/*!
+ *     Sends the custom mix as the MC and MX commands that define it.
+ */
+void print_mix()
+{
+	const struct MixCustom *c = &config.control.custom_mix;
+	const signed char *p;
+	int i;
+
+	printf_checksum("MC;%d;%d", (int)c->outputs, (int)c->copter);
+	for (i = 0; i < MIX_OUTPUTS && i < c->outputs; i++)
+	{
+		p = c->coefficient[i];
+		printf_checksum("MX;%d;%d;%d;%d;%d;%d;%d;%d;%d", i, (int)p[0], (int)p[1], (int)p[2], (int)p[3], (int)p[4],
+		                (int)p[5], (int)p[6], (c->fixed_neutral >> i) & 1);
+	}
+}
+
+/*!
+ *     Writes a part of a line without checksum, formatted by numfmt_vformat().
+ */
+static void print_formatted(const char *format, ...)
+{
+	char line[COMM_BUFFER_LEN];
+	va_list ap;
+
+	va_start(ap, format);
+	numfmt_vformat(line, COMM_BUFFER_LEN, format, ap);
+	va_end(ap);
+	uart1_puts(line);
+}
+
 void print_configuration()
 {
 	int i;
 	uart1_puts("CA;"); // 21
 	
 	//config.sensors
-	print_unsigned_integer((unsigned int)config.sensors.acc_x_neutral, uart1_puts);
-	uart1_putc(';');
-	print_unsigned_integer((unsigned int)config.sensors.acc_y_neutral, uart1_puts);
-	uart1_putc(';');
-	print_unsigned_integer((unsigned int)config.sensors.acc_z_neutral, uart1_puts);
-	uart1_putc(';');
-	print_unsigned_integer((unsigned int)config.sensors.gyro_x_neutral, uart1_puts);
-	uart1_putc(';');
-	print_unsigned_integer((unsigned int)config.sensors.gyro_y_neutral, uart1_puts);
-	uart1_putc(';');
-	print_unsigned_integer((unsigned int)config.sensors.gyro_z_neutral, uart1_puts);
-	uart1_putc(';');
+	print_formatted("%u;%u;%u;%u;%u;%u;", (unsigned int)config.sensors.acc_x_neutral,
+	                (unsigned int)config.sensors.acc_y_neutral, (unsigned int)config.sensors.acc_z_neutral,
+	                (unsigned int)config.sensors.gyro_x_neutral, (unsigned int)config.sensors.gyro_y_neutral,
+	                (unsigned int)config.sensors.gyro_z_neutral);
 	
 	vTaskDelay(( ( portTickType ) 50 / portTICK_RATE_MS ) );  // 50ms
 							
 	//config.telemetry
-	print_unsigned_integer((unsigned int)config.telemetry.stream_GpsBasic, uart1_puts);
-	uart1_putc(';');
-	print_unsigned_integer((unsigned int)config.telemetry.stream_PPM, uart1_puts);
-	uart1_putc(';');
-	print_unsigned_integer((unsigned int)config.telemetry.stream_GyroAccRaw, uart1_puts);
-	uart1_putc(';');
-	print_unsigned_integer((unsigned int)config.telemetry.stream_GyroAccProc, uart1_puts);
-	uart1_putc(';');
-	print_unsigned_integer((unsigned int)config.telemetry.stream_PressureTemp, uart1_puts);
-	uart1_putc(';');
-	print_unsigned_integer((unsigned int)config.telemetry.stream_Attitude, uart1_puts);
-	uart1_putc(';');
+	print_formatted("%u;%u;%u;%u;%u;%u;", (unsigned int)config.telemetry.stream_GpsBasic,
+	                (unsigned int)config.telemetry.stream_PPM, (unsigned int)config.telemetry.stream_GyroAccRaw,
+	                (unsigned int)config.telemetry.stream_GyroAccProc, (unsigned int)config.telemetry.stream_PressureTemp,
+	                (unsigned int)config.telemetry.stream_Attitude);
 	
 	vTaskDelay(( ( portTickType ) 50 / portTICK_RATE_MS ) );  // 50ms
 	
 	//config.gps
-	print_unsigned_integer((unsigned int)(config.gps.initial_baudrate/10), uart1_puts);
-	uart1_putc(';');
-	print_unsigned_integer((unsigned int)(config.gps.operational_baudrate/10), uart1_puts);
-	uart1_putc(';');
+	print_formatted("%u;%u;", (unsigned int)(config.gps.initial_baudrate/10),
+	                (unsigned int)(config.gps.operational_baudrate/10));
 	
 	//config.control
-	print_unsigned_integer((unsigned int)(config.control.channel_ap), uart1_puts);
-	uart1_putc(';');
-	print_unsigned_integer((unsigned int)(config.control.channel_motor), uart1_puts);
-	uart1_putc(';');
-	print_unsigned_integer((unsigned int)(config.control.channel_pitch), uart1_puts);
-	uart1_putc(';');
-	print_unsigned_integer((unsigned int)(config.control.channel_roll), uart1_puts);
-	uart1_putc(';');
-	print_unsigned_integer((unsigned int)(config.control.channel_yaw), uart1_puts);
-	uart1_putc(';');
+	print_formatted("%u;%u;%u;%u;%u;", (unsigned int)(config.control.channel_ap),
+	                (unsigned int)(config.control.channel_motor), (unsigned int)(config.control.channel_pitch),
+	                (unsigned int)(config.control.channel_roll), (unsigned int)(config.control.channel_yaw));
 	
 	vTaskDelay(( ( portTickType ) 50 / portTICK_RATE_MS ) );  // 50ms
 
 	// control.pid
-	printf("%f;%f;%f;%f;%f;%f;", config.control.pid_pitch2elevator.p_gain,
+	print_formatted("%f;%f;%f;%f;%f;%f;", config.control.pid_pitch2elevator.p_gain,
 	                    config.control.pid_pitch2elevator.d_gain,
 	                    config.control.pid_pitch2elevator.i_gain,
 	                    config.control.pid_pitch2elevator.i_min,
 	                    config.control.pid_pitch2elevator.i_max,
 	                    config.control.pid_pitch2elevator.d_term_min_var);
 	vTaskDelay(( ( portTickType ) 50 / portTICK_RATE_MS ) );  // 50ms
-	printf("%f;%f;%f;%f;%f;%f;", config.control.pid_roll2aileron.p_gain,
+	print_formatted("%f;%f;%f;%f;%f;%f;", config.control.pid_roll2aileron.p_gain,
 	                    config.control.pid_roll2aileron.d_gain,
 	                    config.control.pid_roll2aileron.i_gain,
 	                    config.control.pid_roll2aileron.i_min,
 	                    config.control.pid_roll2aileron.i_max,
 	                    config.control.pid_roll2aileron.d_term_min_var);
 	vTaskDelay(( ( portTickType ) 50 / portTICK_RATE_MS ) );  // 50ms
-	printf("%f;%f;%f;%f;%f;%f;", config.control.pid_heading2roll.p_gain,
+	print_formatted("%f;%f;%f;%f;%f;%f;", config.control.pid_heading2roll.p_gain,
 	                    config.control.pid_heading2roll.d_gain,
 	                    config.control.pid_heading2roll.i_gain,
 	                    config.control.pid_heading2roll.i_min,
 	                    config.control.pid_heading2roll.i_max,
 	                    config.control.pid_heading2roll.d_term_min_var);
 	vTaskDelay(( ( portTickType ) 50 / portTICK_RATE_MS ) );  // 50ms
-	printf("%f;%f;%f;%f;%f;%f;", config.control.pid_altitude2pitch.p_gain,
+	print_formatted("%f;%f;%f;%f;%f;%f;", config.control.pid_altitude2pitch.p_gain,
 	                    config.control.pid_altitude2pitch.d_gain,
 	                    config.control.pid_altitude2pitch.i_gain,
 	                    config.control.pid_altitude2pitch.i_min,
@@ -983,34 +1108,34 @@ void print_configuration()
 	                    config.control.pid_altitude2pitch.d_term_min_var);
 	vTaskDelay(( ( portTickType ) 50 / portTICK_RATE_MS ) );  // 50ms
 	// servo_reverse
-	print_unsigned_integer(((int)config.control.reverse_servo1) +
-	                       ((int)config.control.reverse_servo2<<1) +
-	                       ((int)config.control.reverse_servo3<<2) +
-	                       ((int)config.control.reverse_servo4<<3) +
-	                       ((int)config.control.reverse_servo5<<4) +
-	                       ((int)config.control.reverse_servo6<<5), uart1_puts); 
+	print_formatted("%u", ((int)config.control.reverse_servo1) +
+	                      ((int)config.control.reverse_servo2<<1) +
+	                      ((int)config.control.reverse_servo3<<2) +
+	                      ((int)config.control.reverse_servo4<<3) +
+	                      ((int)config.control.reverse_servo5<<4) +
+	                      ((int)config.control.reverse_servo6<<5));
 	                     
 	// servo max/min/neutral
 	for (i = 0; i < 6; i++)
 	{
-		printf(";%d;%d;%d", config.control.servo_min[i], config.control.servo_max[i], config.control.servo_neutral[i]);
+		print_formatted(";%d;%d;%d", config.control.servo_min[i], config.control.servo_max[i], config.control.servo_neutral[i]);
 	}	
 	vTaskDelay(( ( portTickType ) 50 / portTICK_RATE_MS ) );  // 50ms
 	
-	printf(";%d", (int)config.control.use_pwm);
+	print_formatted(";%d", (int)config.control.use_pwm);
 	
-	printf(";%d;%d;%d;%d;%d", (int)config.control.servo_mix, 
+	print_formatted(";%d;%d;%d;%d;%d", (int)config.control.servo_mix, 
 	                     	     (int)(RAD2DEG(config.control.max_pitch)+0.5), 
 	                     	     (int)(RAD2DEG(config.control.max_roll)+0.5),
 	                   	         (int)(config.control.waypoint_radius_m),
 	                 	         (int)(config.control.cruising_speed_ms));
-	printf(";%d;%d;%d", (int)(config.control.stabilization_with_altitude_hold), 
+	print_formatted(";%d;%d;%d", (int)(config.control.stabilization_with_altitude_hold), 
 	                    config.control.aileron_differential*10, config.telemetry.stream_Control);
 	vTaskDelay(( ( portTickType ) 50 / portTICK_RATE_MS ) );  // 50ms
-    printf(";%d;%d;%d;%d;%d", (int)config.control.autopilot_auto_throttle, config.control.auto_throttle_min_pct, config.control.auto_throttle_max_pct,
+    print_formatted(";%d;%d;%d;%d;%d", (int)config.control.autopilot_auto_throttle, config.control.auto_throttle_min_pct, config.control.auto_throttle_max_pct,
 	                    config.control.auto_throttle_cruise_pct, config.control.auto_throttle_p_gain);
-	printf(";%d", (int)(RAD2DEG(config.control.min_pitch)-0.5));
-	printf(";%d;%d;%u", (int)config.control.manual_trim, (int)config.control.altitude_mode, (unsigned int)config.gps.enable_waas);
+	print_formatted(";%d", (int)(RAD2DEG(config.control.min_pitch)-0.5));
+	print_formatted(";%d;%d;%u", (int)config.control.manual_trim, (int)config.control.altitude_mode, (unsigned int)config.gps.enable_waas);
 
     // osd
     unsigned int bitmask = 0;
@@ -1030,199 +1155,159 @@ void print_configuration()
                 (config.osd.show_voltage1? 8192 : 0) +
                 (config.osd.show_voltage2? 16384 : 0) +
                 (config.osd.show_block_name? 32768 : 0) ;
-    printf(";%u;%u;%u;%u", bitmask, (unsigned int)config.osd.rssi, (unsigned int)config.osd.voltage_low, (unsigned int)config.osd.voltage_high);
-    printf(";%d;%d", (int)config.sensors.imu_rotated, (int)RAD2DEG(config.sensors.neutral_pitch));
+    print_formatted(";%u;%u;%u;%u", bitmask, (unsigned int)config.osd.rssi, (unsigned int)config.osd.voltage_low, (unsigned int)config.osd.voltage_high);
+    print_formatted(";%d;%d", (int)config.sensors.imu_rotated, (int)RAD2DEG(config.sensors.neutral_pitch));
     uart1_puts("\r\n");
 }		
 
 
-/*!
- *     This function sends LogLine l to the communication channel.
- */ 
-void print_logline(struct LogLine *l)
-{
-#ifdef DETAILED_LOG
-	// Normal logging
-	printf_nochecksum ("DD;%f;%f;", RAD2DEG(l->gps_latitude_rad), RAD2DEG(l->gps_longitude_rad));
-	printf_nochecksum ("%f;%d;%d;%d;", ((float)l->gps_speed_m_s)/100.0, l->gps_heading, l->gps_height_m, (int)l->gps_satellites);
-	printf_nochecksum ("%d;%d;", l->height_m, l->pitch);
-	printf_nochecksum ("%d;", l->roll);
-	printf_nochecksum ("%d;%d;%d;%d;", l->desired_pitch, l->desired_roll, l->desired_heading, l->desired_height);
-	printf_nochecksum ("%f;", l->acc_x_g);
-	printf_nochecksum ("%f;%f;", l->acc_y_g, l->acc_z_g);
-	printf_nochecksum ("%d;%d;%d;", l->p, l->q, l->r);
-	printf_nochecksum ("%d;%d;%d\r\n", (int)l->temperature_c, (int)l->control_state, l->navigation_code_line+1);
-
-#elif RAW_50HZ_LOG
-	// Raw sensor logging @ 50Hz
-	printf ("DD;%f;%f;", l->gps_latitude_rad*(180.0/3.14159), l->gps_longitude_rad*(180.0/3.14159));
-	printf ("%lu;%f;%d;", l->gps_time, ((float)l->gps_speed_m_s_10) / 10.0, ((int)l->gps_heading_2)*2);
-
-	printf ("%u;%u;%u;", l->acc_x, l->acc_y, l->acc_z);
-	printf ("%u;%u;%u;", l->gyro_x, l->gyro_y, l->gyro_z);
-
-//	printf ("%f;%d;%d;%d;%u;%d\r\n", ((float)l->height_m_5) / 5.0, l->pitch, l->roll, l->pitch_acc, l->idg500_vref, l->control_state);
-	printf ("%f;%d;%d;%d\r\n", ((float)l->height_m_5) / 5.0, l->pitch, l->roll, l->pitch_acc);
-#else
-	// Normal logging
-	//printf_nochecksum ("DD;%lu;%lu;%.9f;%.9f;", l->date, l->time, RAD2DEG(l->gps_latitude_rad), RAD2DEG(l->gps_longitude_rad));
-	//printf_nochecksum ("%f;%d;%d;", ((float)l->gps_speed_m_s)/3.0, l->gps_heading, l->gps_height_m);
-	//printf_nochecksum ("%d;%d;%d;%d;", l->height_m, l->pitch, l->roll, l->yaw);
-	//printf_nochecksum ("%d;%d;%d;%u\r\n", (int)l->temperature_c, (int)l->control_state, l->navigation_code_line+1, l->servo_trigger);
-
-    printf_checksum("DD;%lu;%lu;%.6f;%.6f;%.1f;%d;%d;%d;%d;%d;%d;%d;%d;%d;%u",
-                            l->date, l->time, RAD2DEG(l->gps_latitude_rad), RAD2DEG(l->gps_longitude_rad),
-                            ((float)l->gps_speed_m_s)/3.0, l->gps_heading, l->gps_height_m,
-                            l->height_m, l->pitch, l->roll, l->yaw,
-                            (int)l->temperature_c, (int)l->control_state, l->navigation_code_line+1, l->servo_trigger);
-#endif
-}	
+static void print_string_wait(const char *str)
+{
+	uart1_put_wait((char*)str, strlen(str));
+}
 
 
-#ifdef RAW_50HZ_LOG
-void print_logline_simulation(struct LogLine *l)
+//! print_string_wait() that adds str to the checksum of the line
+static unsigned char print_string_wait_checksum(const char *str, unsigned char checksum)
 {
-	static int i = 0;
-	static float last_height;
-	
-	sensor_data.acc_x_raw = l->acc_x;
-	sensor_data.acc_y_raw = l->acc_y;
-	sensor_data.acc_z_raw = l->acc_z;
-	sensor_data.gyro_x_raw = l->gyro_x;
-	sensor_data.gyro_y_raw = l->gyro_y;
-	sensor_data.gyro_z_raw = l->gyro_z;
-	sensor_data.gps.speed_ms = (float)l->gps_speed_m_s_10/10.0;
-	sensor_data.pressure_height = ((float)l->height_m_5) / 5.0;
-	
-	i++;
-	if (last_height != sensor_data.pressure_height)
-	{
-		float dt = (float)i * 0.02;
-		i = 0;
-		sensor_data.vertical_speed = sensor_data.vertical_speed * 0.5 + (sensor_data.pressure_height - last_height)/dt * 0.5;
-		last_height = sensor_data.pressure_height;
-		sensor_data.vertical_speed = 0.0;
-	}	
-	
-	sensor_data.acc_x = ((float)(sensor_data.acc_x_raw) - (float)config.sensors.acc_x_neutral) / (-6600.0*-1.0);
-	sensor_data.acc_y = ((float)(sensor_data.acc_y_raw) - (float)config.sensors.acc_y_neutral) / (-6600.0*-1.0);
-	sensor_data.acc_z = ((float)(sensor_data.acc_z_raw) - (float)config.sensors.acc_z_neutral) / (-6600.0);
-			
-	// scale to rad/sec
-	sensor_data.p = ((float)(sensor_data.gyro_x_raw)-config.sensors.gyro_x_neutral) * (-0.02518315*3.14159/180.0 * -1.0);  // 0.02518315f
-	sensor_data.q = ((float)(sensor_data.gyro_y_raw)-config.sensors.gyro_y_neutral) * (-0.02538315*3.14159/180.0 * -1.0);
-	sensor_data.r = ((float)(sensor_data.gyro_z_raw)-config.sensors.gyro_z_neutral) * (0.0062286*3.14159/180.0);  //(2^16-1 - (2^5-1)) / 3.3 * 0.0125*(22)/(22+12)
-	
-	ahrs_filter();
-	
-	l->pitch = (sensor_data.pitch/3.14*180.0);
-	l->roll = (sensor_data.roll/3.14*180.0);
-	print_logline(l);
-	//printf ("%f;%f;%f\r\n", sensor_data.pitch, sensor_data.roll, sensor_data.pitch_acc );
-}	
-#endif
+	const char *c;
+
+	for (c = str; *c != '\0'; c++)
+		checksum ^= *c;
+	uart1_put_wait((char*)str, c - str);
+	return checksum;
+}
 
 
 /*!
- *  Sends a signed integer as a string to a function.
- *  This function converts integer x to a series of characters and sends
- *  them one by one to function printer. Faster than printf, obviously.
- *  @param x The signed integer
- *  @param printer The function that the signed integer will be send to as a
- *                 string. It must have one argument: a pointer to an array 
- *                 of chars.
+ *     Sends a record of a log as a DD line: the type of the record followed by
+ *     the latest value of every field of the log (see struct LogSchema), as
+ *     "$DD;...*xx" like printf_checksum(). The line is too long for
+ *     comm_buffer, so the checksum is kept while the fields are sent. With
+ *     record < 0 it sends the names of the fields as a DH line instead.
+ *     Waits for the uart: nothing of a log readout is dropped.
  */
-void print_signed_integer(int x, void (*printer)(char[]))
+void print_logrecord(struct LogSchema *s, int record)
 {
-	static char tmpChar[2] = "0";
-	unsigned int radix,
-                 i, converted;
-	char emptyChar = ' ';
-	
-	if (x < 0)
-	{
-		printer("-");
-		x*=-1;
-	}
-	else if (x == 0)
+	char value[24];
+	unsigned char checksum = 0;
+	int i;
+
+	if (xSemaphoreTake( xUart1Semaphore, ( portTickType ) 100 / portTICK_RATE_MS ) != pdTRUE)
+		return;
+
+	if (record < 0)
 	{
-		printer("0");
-		return;	
+		print_string_wait("\r\nDH;Record");
+		for (i = 0; i < s->fields; i++)
+		{
+			print_string_wait(";");
+			print_string_wait(s->field[i].name);
+		}
 	}
-	converted = (unsigned int) x;
-	// auto-align on 16bit size (655.. = 5 positions)
-	for (radix=10000, i=0; i < 5; radix/=10, i++)
+	else
 	{
-		if (converted > radix-1) {
-			tmpChar[0] =  '0' + (converted/radix);
-			printer(tmpChar);
-			converted = converted % radix;
-			emptyChar = '0';
-		} else if (emptyChar == '0') {
-			printer("0");
+		print_string_wait("$");
+		checksum = print_string_wait_checksum("DD;", checksum);
+		checksum = print_string_wait_checksum(s->name[record], checksum);
+		for (i = 0; i < s->fields; i++)
+		{
+			value[0] = ';';
+			logschema_format(s, i, &value[1], sizeof(value) - 1);
+			checksum = print_string_wait_checksum(value, checksum);
 		}
+		value[0] = '*';
+		value[1] = hex[checksum/16];
+		value[2] = hex[checksum%16];
+		value[3] = '\0';
+		print_string_wait(value);
 	}
+	print_string_wait("\r\n");
+	xSemaphoreGive( xUart1Semaphore );
 }
 
 
+static void print_logframe(unsigned int page, unsigned char *data, int length)
+{
+	unsigned char header[LOG_FRAME_HEADER];
+	unsigned int crc;
+
+	header[0] = LOG_FRAME_SYNC1;
+	header[1] = LOG_FRAME_SYNC2;
+	header[2] = page & 0xFF;
+	header[3] = (page >> 8) & 0xFF;
+	header[4] = length & 0xFF;
+	header[5] = (length >> 8) & 0xFF;
+	crc = crc16_update(CRC16_INIT, &header[2], 4);
+	crc = crc16_update(crc, data, length);
+
+	if (xSemaphoreTake( xUart1Semaphore, ( portTickType ) 100 / portTICK_RATE_MS ) == pdTRUE)
+	{
+		uart1_put_wait((char*)header, LOG_FRAME_HEADER);
+		uart1_put_wait((char*)data, length);
+		header[0] = crc & 0xFF;
+		header[1] = (crc >> 8) & 0xFF;
+		uart1_put_wait((char*)header, 2);
+		xSemaphoreGive( xUart1Semaphore );
+	}
+}
 
 
 /*!
- *  Sends an unsigned integer as a string to a function.
- *  This function converts integer x to a series of characters and sends
- *  them one by one to function printer. Faster than printf, obviously.
- *  @param x The unsigned integer
- *  @param printer The function that the unsigned integer will be send to as a
- *                 string. It must have one argument: a pointer to an array 
- *                 of chars.
+ *     Sends dataflash pages first...last as binary frames (see communication.h),
+ *     followed by a frame with page LOG_FRAME_END. A page with all bytes the
+ *     same (formatted or erased) is sent as 1 byte.
+ *
+ *     A frame that doesn't arrive (lost semaphore, bad crc) is simply missing:
+ *     the host asks for the missing pages again with a new DB command.
  */
-void print_unsigned_integer(unsigned int x, void (*printer)(char[]))
+void print_logpages(int first, int last)
 {
-	static char tmpChar[2] = "0";
-	unsigned int radix,
-                 i, converted;
-	char emptyChar = ' ';
-	
-	if (x == 0)
+	unsigned char *data;
+	int page, length;
+
+	first = MAX(first, 0);
+	last = MIN(last, MAX_PAGE);
+	for (page = first; page <= last; page++)
 	{
-		printer("0");
-		return;	
-	}
-	converted = (unsigned int) x;
-	// auto-align on 16bit size (655.. = 5 positions)
-	for (radix=10000, i=0; i < 5; radix/=10, i++)
-	{
-		if (converted > radix-1) {
-			tmpChar[0] =  '0' + (converted/radix);
-			printer(tmpChar);
-			converted = converted % radix;
-			emptyChar = '0';
-		} else if (emptyChar == '0') {
-			printer("0");
-		}
+		data = datalogger_read_page(page);
+		if (data == NULL)
+			break;
+		for (length = 1; length < PAGE_SIZE && data[length] == data[0]; length++)
+			;
+		print_logframe(page, data, length == PAGE_SIZE ? 1 : PAGE_SIZE);
 	}
+	print_logframe(LOG_FRAME_END, NULL, 0);
 }
 
 
-
 char hex[] = {'0','1','2','3','4','5','6','7','8','9','a','b','c','d','e','f'};
+/*!
+ *     Sends the line in comm_buffer as "$line*xx\r\n", with one uart1_put():
+ *     when the transmit buffer is full the whole line is dropped, not a part.
+ */
 void comm_send_buffer_with_checksum(int length)
 {
-	char checksum = 0;
+	unsigned char checksum = 0;
 	int j;
-	uart1_putc('$');
-	for (j=0;j < length && j < COMM_BUFFER_LEN; j++)
+
+	if (length < 0)
+		return;
+	if (length > COMM_BUFFER_LEN - 1)   // a truncated line
+		length = COMM_BUFFER_LEN - 1;
+	for (j = length; j > 0; j--)
 	{
-		char c = comm_buffer[j];
-		uart1_putc(c);
-		checksum ^= c;
+		comm_buffer[j] = comm_buffer[j - 1];
+		checksum ^= comm_buffer[j];
 	}
-	uart1_putc('*');
+	comm_buffer[0] = '$';
+	comm_buffer[length + 1] = '*';
 	//0123456789ABCDEF
-	uart1_putc(hex[checksum/16]);
-	uart1_putc(hex[checksum%16]);
-	uart1_putc('\r');
-	uart1_putc('\n');
+	comm_buffer[length + 2] = hex[checksum/16];
+	comm_buffer[length + 3] = hex[checksum%16];
+	comm_buffer[length + 4] = '\r';
+	comm_buffer[length + 5] = '\n';
+	uart1_put(comm_buffer, length + 6);
 }
 
 int check_checksum(char *s)
@@ -18,6 +18,8 @@
 #include "sensors.h"
 #include "communication.h"
 #include "configuration.h"
+#include "control_mix.h"
+#include "task_datalogger.h"
 
 //! Memory allocation for the configuration data.
 struct Configuration config;
@@ -33,6 +35,8 @@ int HARDWARE_VERSION;
 void configuration_load()
 {
 	dataflash.read(CONFIGURATION_PAGE, sizeof(struct Configuration), (unsigned char*)&config);
+	control_mix_changed();
+	control_pid_changed();
 }
 
 
@@ -90,7 +94,7 @@ void configuration_determine_hardware_version()
  */
 void configuration_write()
 {
-	dataflash.write(CONFIGURATION_PAGE, sizeof(struct Configuration), (unsigned char*)&config);
+	datalogger_write(CONFIGURATION_PAGE, sizeof(struct Configuration), (unsigned char*)&config);
 }
 
 
@@ -133,6 +137,7 @@ void configuration_default()
 	config.control.min_pitch = -10.0/180.0*3.14;
 	config.control.max_roll = 40.0/180.0*3.14;
 	config.control.servo_mix = AILERON;
+	control_mix_custom_load(AILERON);
 	
 	config.control.stabilization_with_altitude_hold = 0;
     config.control.auto_throttle_cruise_pct = 90;
@@ -145,6 +150,7 @@ void configuration_default()
 	pid_init(&config.control.pid_pitch2elevator , 0.0, 0.7, 0.0, -1.0, 1.0, 0.0);
 	pid_init(&config.control.pid_roll2aileron, 0.0, 0.5, 0.0, -1.0, 1.0, 0.0);
 	pid_init(&config.control.pid_altitude2pitch, 0.0, 0.03, 0.0, -1.0, 1.0, 0.0);
+	control_pid_changed();
 	
 	config.control.waypoint_radius_m = 30;
 	
@@ -0,0 +1,283 @@
+/*!
+ *  Servo mixing: from aileron_out, elevator_out, yaw_out and motor_out to the
+ *  servo and motor outputs.
+ *
+ *  Every mix type is a table of coefficients (mix_presets). When the
+ *  configuration changes, control_mix_compile() turns the table of the
+ *  configured type into a MixMatrix: the servo reversing is applied to the
+ *  coefficients, the aileron differential to its column, and the neutral
+ *  and limits of every servo are copied. control_mix_out() then only does a
+ *  matrix-vector multiplication, the same for every mix type.
+ *
+ *  A new mix type (say a Y6 or an octocopter) is a new row in mix_presets and
+ *  a new MixTypes value, no new code. Without a new firmware, the mix type
+ *  CUSTOM uses the table in config.control.custom_mix: ML loads a preset in
+ *  it, MC and MX change its outputs (see communication_csv.c).
+ *
+ *  @file     control_mix.c
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "ppm_in/ppm_in.h"
+#include "servo/servo.h"
+
+#include "control_mix.h"
+#include "configuration.h"
+#include "sensors.h"
+
+#define COPTER_MOTOR_OFF 100   //!< motor_out below which all motors of a copter are off
+
+// Coefficients that are used a lot
+#define P1   MIX_ONE
+#define M1   (-MIX_ONE)
+#define P1_5 (MIX_ONE / 5)
+#define M1_5 (-MIX_ONE / 5)
+#define P1_10 (MIX_ONE / 10)          // cos(60) / 5
+#define M1_10 (-MIX_ONE / 10)
+#define PS60 (MIX_ONE * 866L / 5000)  // sin(60) / 5
+#define MS60 (-MIX_ONE * 866L / 5000)
+
+/*!
+ *  The mix types, in the order of enum MixTypes.
+ *  Columns: aileron, aileron differential, elevator, yaw, motor, roll, rudder stick.
+ *  The aileron differential column is multiplied with config.control.aileron_differential.
+ */
+static const struct MixPreset mix_presets[] =
+{
+	// AILERON: 1-2 ailerons, 3 elevator, 4 motor, 5 rudder, 6 roll stabilized
+	{ 6, 0, {
+		{ { P1, P1, 0,  0,  0,  0,  0 }, 0 },
+		{ { M1, P1, 0,  0,  0,  0,  0 }, 0 },
+		{ { 0,  0,  P1, 0,  0,  0,  0 }, 0 },
+		{ { 0,  0,  0,  0,  P1, 0,  0 }, 0 },
+		{ { 0,  0,  0,  M1, 0,  0,  0 }, 0 },
+		{ { 0,  0,  0,  0,  0,  P1, 0 }, 1 } } },
+	// DELTA_PLUS: 1-2 elevons, 4 motor, 5 roll stabilized
+	{ 5, 0, {
+		{ { M1, M1, M1, 0,  0,  0,  0 }, 0 },
+		{ { M1, P1, P1, 0,  0,  0,  0 }, 0 },
+		{ { 0,  0,  0,  0,  0,  0,  0 }, 0 },
+		{ { 0,  0,  0,  0,  P1, 0,  0 }, 0 },
+		{ { 0,  0,  0,  0,  0,  P1, 0 }, 1 } } },
+	// DELTA_MIN: 1-2 elevons, 4 motor, 5 roll stabilized
+	{ 5, 0, {
+		{ { M1, M1, P1, 0,  0,  0,  0 }, 0 },
+		{ { M1, P1, M1, 0,  0,  0,  0 }, 0 },
+		{ { 0,  0,  0,  0,  0,  0,  0 }, 0 },
+		{ { 0,  0,  0,  0,  P1, 0,  0 }, 0 },
+		{ { 0,  0,  0,  0,  0,  P1, 0 }, 1 } } },
+	/* QUADROCOPTER:
+	 *          >
+	 *          0
+	 *      < /   \ <
+	 *      3       1        FRONT
+	 *        \ > /
+	 *          2
+	 */
+	{ 4, 1, {
+		{ { P1_5, 0, 0,    P1_5, P1, 0, 0 }, 0 },
+		{ { 0,    0, P1_5, M1_5, P1, 0, 0 }, 0 },
+		{ { M1_5, 0, 0,    P1_5, P1, 0, 0 }, 0 },
+		{ { 0,    0, M1_5, M1_5, P1, 0, 0 }, 0 } } },
+	// AILERONS_FLAPERONS: as AILERON, with the rudder stick on both ailerons
+	{ 6, 0, {
+		{ { P1, P1, 0,  0,  0,  0,  M1 }, 0 },
+		{ { M1, P1, 0,  0,  0,  0,  M1 }, 0 },
+		{ { 0,  0,  P1, 0,  0,  0,  0 }, 0 },
+		{ { 0,  0,  0,  0,  P1, 0,  0 }, 0 },
+		{ { 0,  0,  0,  M1, 0,  0,  0 }, 0 },
+		{ { 0,  0,  0,  0,  0,  P1, 0 }, 1 } } },
+	// V_TAIL: 1-2 ailerons, 3 and 5 ruddervators, 4 motor, 6 roll stabilized
+	{ 6, 0, {
+		{ { P1, P1, 0,  0,  0,  0,  0 }, 0 },
+		{ { M1, P1, 0,  0,  0,  0,  0 }, 0 },
+		{ { 0,  0,  P1, M1, 0,  0,  0 }, 0 },
+		{ { 0,  0,  0,  0,  P1, 0,  0 }, 0 },
+		{ { 0,  0,  M1, M1, 0,  0,  0 }, 0 },
+		{ { 0,  0,  0,  0,  0,  P1, 0 }, 1 } } },
+	// DELTA_RUDDER: as DELTA_PLUS, with a rudder on 5 and the roll stabilized servo on 6
+	{ 6, 0, {
+		{ { M1, M1, M1, 0,  0,  0,  0 }, 0 },
+		{ { M1, P1, P1, 0,  0,  0,  0 }, 0 },
+		{ { 0,  0,  0,  0,  0,  0,  0 }, 0 },
+		{ { 0,  0,  0,  0,  P1, 0,  0 }, 0 },
+		{ { 0,  0,  0,  M1, 0,  0,  0 }, 0 },
+		{ { 0,  0,  0,  0,  0,  P1, 0 }, 1 } } },
+	// HEXACOPTER: motor 0 on the roll axis like the quadrocopter, then every 60 degrees
+	{ 6, 1, {
+		{ { P1_5,  0, 0,    P1_5, P1, 0, 0 }, 0 },
+		{ { P1_10, 0, PS60, M1_5, P1, 0, 0 }, 0 },
+		{ { M1_10, 0, PS60, P1_5, P1, 0, 0 }, 0 },
+		{ { M1_5,  0, 0,    M1_5, P1, 0, 0 }, 0 },
+		{ { M1_10, 0, MS60, P1_5, P1, 0, 0 }, 0 },
+		{ { P1_10, 0, MS60, M1_5, P1, 0, 0 }, 0 } } },
+};
+
+#define MIX_PRESETS (int)(sizeof(mix_presets) / sizeof(mix_presets[0]))
+
+static struct MixMatrix mix;
+static volatile int mix_valid = 0;
+static struct MixPreset custom_preset;   //!< config.control.custom_mix, as a preset
+
+
+/*!
+ *   Converts the custom mix of the configuration from percent to MIX_ONE.
+ */
+static const struct MixPreset *mix_custom()
+{
+	const struct MixCustom *c = &config.control.custom_mix;
+	int i, j;
+
+	custom_preset.outputs = c->outputs > MIX_OUTPUTS ? MIX_OUTPUTS : c->outputs;
+	custom_preset.copter = c->copter != 0;
+	for (i = 0; i < MIX_OUTPUTS; i++)
+	{
+		for (j = 0; j < MIX_INPUTS; j++)
+			custom_preset.output[i].coefficient[j] = (int)((long)c->coefficient[i][j] * MIX_ONE / 100);
+		custom_preset.output[i].fixed_neutral = (c->fixed_neutral >> i) & 1;
+	}
+	return &custom_preset;
+}
+
+
+static const struct MixPreset *mix_preset(enum MixTypes type)
+{
+	if (type == CUSTOM)
+		return mix_custom();
+	if ((int)type < 0 || (int)type >= MIX_PRESETS)
+		return &mix_presets[AILERON];
+	return &mix_presets[type];
+}
+
+
+int control_mix_is_copter(enum MixTypes type)
+{
+	return mix_preset(type)->copter;
+}
+
+
+/*!
+ *   Replaces the custom mix by a copy of a mix type, to start from.
+ */
+void control_mix_custom_load(enum MixTypes type)
+{
+	const struct MixPreset *preset = mix_preset(type);
+	struct MixCustom *c = &config.control.custom_mix;
+	int i, j;
+	long v;
+
+	c->outputs = preset->outputs;
+	c->copter = preset->copter;
+	c->fixed_neutral = 0;
+	for (i = 0; i < MIX_OUTPUTS; i++)
+	{
+		for (j = 0; j < MIX_INPUTS; j++)
+		{
+			v = (long)preset->output[i].coefficient[j] * 100;
+			c->coefficient[i][j] = (signed char)((v + (v >= 0 ? MIX_ONE / 2 : -MIX_ONE / 2)) / MIX_ONE);
+		}
+		if (preset->output[i].fixed_neutral)
+			c->fixed_neutral |= 1 << i;
+	}
+	control_mix_changed();
+}
+
+
+/*!
+ *   To be called after the mix type, the servo reversing, the aileron
+ *   differential or a servo's neutral or limits changed. The next
+ *   control_mix_out() compiles the mix again.
+ */
+void control_mix_changed()
+{
+	mix_valid = 0;
+}
+
+
+/*!
+ *   Builds the MixMatrix for the current configuration.
+ */
+void control_mix_compile()
+{
+	const struct MixPreset *preset = mix_preset(config.control.servo_mix);
+	unsigned int reverse = config.control.reverse_servo1 | config.control.reverse_servo2 << 1 |
+	                       config.control.reverse_servo3 << 2 | config.control.reverse_servo4 << 3 |
+	                       config.control.reverse_servo5 << 4 | config.control.reverse_servo6 << 5;
+	int i, j;
+
+	mix_valid = 1;   // before reading the configuration: a change during the compile is seen next time
+
+	if (preset->copter)
+		reverse = 0;
+
+	mix.outputs = preset->outputs;
+	mix.motor_cut = preset->copter;
+	for (i = 0; i < MIX_OUTPUTS; i++)
+	{
+		const struct MixPresetOutput *o = &preset->output[i];
+		int sign = (reverse & (1 << i)) ? -1 : 1;
+
+		for (j = 0; j < MIX_INPUTS; j++)
+			mix.coefficient[i][j] = sign * o->coefficient[j];
+		mix.coefficient[i][MIX_AILERON_DIFF] *= config.control.aileron_differential;
+		mix.offset[i] = o->fixed_neutral ? 1500 : config.control.servo_neutral[i];
+		mix.min[i] = config.control.servo_min[i];
+		mix.max[i] = config.control.servo_max[i];
+	}
+}
+
+
+/*!
+ *   Mixes variables aileron_out, elevator_out, yaw_out and motor_out into
+ *   the servo positions, according to the configured mixing type.
+ * 
+ *   Input: 
+ *      aileron_out: > 0 means right [-500..500]
+ *      elevator_out: > 0 means up   [-500..500]
+ *      motor_out: > 0 means on/more gas [0..1000]
+ *
+ */
+void control_mix_out()
+{
+	int input[MIX_INPUTS];
+	int i, motor_off;
+
+	if (! mix_valid)
+		control_mix_compile();
+
+	input[MIX_AILERON] = aileron_out;
+	input[MIX_AILERON_DIFF] = abs(aileron_out / 10);
+	input[MIX_ELEVATOR] = elevator_out;
+	input[MIX_YAW] = yaw_out;
+	input[MIX_MOTOR] = motor_out;
+	input[MIX_ROLL] = (int)(sensor_data.roll*636.0);
+	input[MIX_RUDDER_STICK] = ppm.channel[config.control.channel_yaw] - config.control.channel_neutral[config.control.channel_yaw];
+	motor_off = mix.motor_cut && motor_out < COPTER_MOTOR_OFF;   // safety
+
+	for (i = 0; i < mix.outputs; i++)
+	{
+		const int *c = mix.coefficient[i];
+		int32_t sum;
+		int out;
+
+		sum = (int32_t)c[MIX_AILERON] * input[MIX_AILERON] + (int32_t)c[MIX_AILERON_DIFF] * input[MIX_AILERON_DIFF] +
+		      (int32_t)c[MIX_ELEVATOR] * input[MIX_ELEVATOR] + (int32_t)c[MIX_YAW] * input[MIX_YAW] +
+		      (int32_t)c[MIX_MOTOR] * input[MIX_MOTOR] + (int32_t)c[MIX_ROLL] * input[MIX_ROLL] +
+		      (int32_t)c[MIX_RUDDER_STICK] * input[MIX_RUDDER_STICK];
+		out = (int)((sum + MIX_ONE / 2) >> MIX_SHIFT) + mix.offset[i];
+		if (motor_off)
+			out = 0;
+
+		if (out > mix.max[i])
+			out = mix.max[i];
+		if (out < mix.min[i])
+			out = mix.min[i];
+
+		servo_out[i] = out;
+		servo_set_us(i, out);
+	}
+}
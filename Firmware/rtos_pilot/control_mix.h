@@ -0,0 +1,48 @@
+#ifndef CONTROL_MIX_H
+#define CONTROL_MIX_H
+
+#include "task_control.h"
+
+// MIX_OUTPUTS and the mixer's inputs (enum MixInputs) are in task_control.h,
+// for the custom mix of the configuration
+#define MIX_SHIFT   10
+#define MIX_ONE     (1 << MIX_SHIFT)   //!< Coefficient 1.0: coefficients have 10 fractional bits
+
+//! One output of a mix, as it is defined in control_mix.c
+struct MixPresetOutput
+{
+	int coefficient[MIX_INPUTS];
+	unsigned int fixed_neutral : 1;   //!< Centered on 1500us instead of the servo's neutral
+};
+
+//! A mix type: outputs 0 up to outputs-1 are driven
+struct MixPreset
+{
+	int outputs;
+	unsigned int copter : 1;          //!< Outputs are motors: never reversed, off when motor_out < 100
+	struct MixPresetOutput output[MIX_OUTPUTS];
+};
+
+//! The current mix, with the servo reversing, the differential and the servo limits applied
+struct MixMatrix
+{
+	int outputs;
+	int coefficient[MIX_OUTPUTS][MIX_INPUTS];
+	int offset[MIX_OUTPUTS];
+	int min[MIX_OUTPUTS], max[MIX_OUTPUTS];
+	int motor_cut;
+};
+
+//! Contains the last calculated servo position
+extern int servo_out[MIX_OUTPUTS];
+
+//! Different outputs before mixing. Set by any of the control methods, and used by the servo mixing type.
+extern int elevator_out, aileron_out, yaw_out, motor_out;
+
+void control_mix_changed();
+void control_mix_compile();
+void control_mix_out();
+int control_mix_is_copter(enum MixTypes mix);
+void control_mix_custom_load(enum MixTypes type);
+
+#endif // CONTROL_MIX_H
@@ -0,0 +1,100 @@
+/*!
+ *  The record types of the log: their fields, how they are printed and how
+ *  often they are written by default.
+ *
+ *  Every session starts with the schema of these types (see lib/logpack/
+ *  logschema.h), so a field can be added, removed or renamed here without
+ *  breaking the readout of older logs. The names are the column names of the
+ *  DR command: Gluonconfig (KML export) relies on them.
+ *
+ *  @file     datalogger_records.c
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include "task_datalogger.h"
+
+// double is 32 bit on the dsPIC (the MPLAB projects don't pass -fno-short-double)
+// and 64 bit on the SITL host
+#define LOGPACK_DOUBLE (sizeof(double) == 8 ? LOGPACK_F64 : LOGPACK_F32)
+
+#define RAD2DEG_SCALE  57.29578f
+
+static const struct LogpackField gps_fields[] =
+{
+	LOGPACK_FIELD(struct LogGps, latitude_rad, LOGPACK_DOUBLE, "Latitude", RAD2DEG_SCALE, 6),
+	LOGPACK_FIELD(struct LogGps, longitude_rad, LOGPACK_DOUBLE, "Longitude", RAD2DEG_SCALE, 6),
+	LOGPACK_FIELD(struct LogGps, date, LOGPACK_U32, "Date", 1.0f, 0),
+	LOGPACK_FIELD(struct LogGps, time, LOGPACK_U32, "Time", 1.0f, 0),
+	LOGPACK_FIELD(struct LogGps, height_m, LOGPACK_S16, "HeightGPS", 1.0f, 0),
+	LOGPACK_FIELD(struct LogGps, speed_cm_s, LOGPACK_U16, "SpeedGPS", 0.01f, 2),
+	LOGPACK_FIELD(struct LogGps, heading_deg, LOGPACK_S16, "HeadingGPS", 1.0f, 0),
+	LOGPACK_FIELD(struct LogGps, satellites, LOGPACK_U8, "SatellitesGPS", 1.0f, 0),
+	LOGPACK_FIELD(struct LogGps, temperature_c, LOGPACK_S8, "TempC", 1.0f, 0),
+};
+
+static const struct LogpackField control_fields[] =
+{
+	LOGPACK_FIELD(struct LogControl, roll_deg, LOGPACK_S16, "Roll", 1.0f, 0),
+	LOGPACK_FIELD(struct LogControl, pitch_deg, LOGPACK_S16, "Pitch", 1.0f, 0),
+	LOGPACK_FIELD(struct LogControl, yaw_deg, LOGPACK_S16, "Yaw", 1.0f, 0),
+	LOGPACK_FIELD(struct LogControl, p_deg_s, LOGPACK_S16, "P", 1.0f, 0),
+	LOGPACK_FIELD(struct LogControl, q_deg_s, LOGPACK_S16, "Q", 1.0f, 0),
+	LOGPACK_FIELD(struct LogControl, r_deg_s, LOGPACK_S16, "R", 1.0f, 0),
+	LOGPACK_FIELD(struct LogControl, height_dm, LOGPACK_S16, "HeightBaro", 0.1f, 1),
+	LOGPACK_FIELD(struct LogControl, desired_roll_deg, LOGPACK_S16, "DesiredRoll", 1.0f, 0),
+	LOGPACK_FIELD(struct LogControl, desired_pitch_deg, LOGPACK_S16, "DesiredPitch", 1.0f, 0),
+	LOGPACK_FIELD(struct LogControl, desired_heading_deg, LOGPACK_S16, "DesiredHeading", 1.0f, 0),
+	LOGPACK_FIELD(struct LogControl, desired_height_m, LOGPACK_S16, "DesiredHeight", 1.0f, 0),
+};
+
+static const struct LogpackField imu_fields[] =
+{
+	LOGPACK_FIELD(struct LogImu, acc_x, LOGPACK_U16, "AccX", 1.0f, 0),
+	LOGPACK_FIELD(struct LogImu, acc_y, LOGPACK_U16, "AccY", 1.0f, 0),
+	LOGPACK_FIELD(struct LogImu, acc_z, LOGPACK_U16, "AccZ", 1.0f, 0),
+	LOGPACK_FIELD(struct LogImu, gyro_x, LOGPACK_U16, "GyroX", 1.0f, 0),
+	LOGPACK_FIELD(struct LogImu, gyro_y, LOGPACK_U16, "GyroY", 1.0f, 0),
+	LOGPACK_FIELD(struct LogImu, gyro_z, LOGPACK_U16, "GyroZ", 1.0f, 0),
+};
+
+static const struct LogpackField event_fields[] =
+{
+	LOGPACK_FIELD(struct LogEvent, flight_mode, LOGPACK_S8, "FlightMode", 1.0f, 0),
+	LOGPACK_FIELD(struct LogEvent, navigation_line, LOGPACK_S16, "NavigationLine", 1.0f, 0),
+	LOGPACK_FIELD(struct LogEvent, servo_trigger, LOGPACK_U16, "ServoTrigger", 1.0f, 0),
+};
+
+#define FIELDS(f) f, sizeof(f) / sizeof(f[0])
+
+// Periods in ticks of datalogger_task() (50Hz). The raw sensors are only
+// logged on request (the DP command), they fill the flash 5 times faster.
+const struct LogRecordType log_record_types[LOG_RECORD_TYPES] =
+{
+	{ LOG_GPS,     10,            "Gps",     FIELDS(gps_fields) },       // 5Hz
+	{ LOG_CONTROL, 5,             "Control", FIELDS(control_fields) },   // 10Hz
+	{ LOG_IMU,     0,             "Imu",     FIELDS(imu_fields) },       // off, 1 for 50Hz
+	{ LOG_EVENT,   LOG_ON_CHANGE, "Event",   FIELDS(event_fields) },
+};
+
+
+static const struct LogpackField legacy_fields[] =
+{
+	LOGPACK_FIELD(struct LogLegacy, gps_latitude_rad, LOGPACK_DOUBLE, "Latitude", RAD2DEG_SCALE, 6),
+	LOGPACK_FIELD(struct LogLegacy, gps_longitude_rad, LOGPACK_DOUBLE, "Longitude", RAD2DEG_SCALE, 6),
+	LOGPACK_FIELD(struct LogLegacy, date, LOGPACK_U32, "Date", 1.0f, 0),
+	LOGPACK_FIELD(struct LogLegacy, time, LOGPACK_U32, "Time", 1.0f, 0),
+	LOGPACK_FIELD(struct LogLegacy, gps_height_m, LOGPACK_S16, "HeightGPS", 1.0f, 0),
+	LOGPACK_FIELD(struct LogLegacy, gps_speed_m_s, LOGPACK_U8, "SpeedGPS", 1.0f / 3.0f, 1),
+	LOGPACK_FIELD(struct LogLegacy, gps_heading, LOGPACK_S16, "HeadingGPS", 1.0f, 0),
+	LOGPACK_FIELD(struct LogLegacy, pitch, LOGPACK_S16, "Pitch", 1.0f, 0),
+	LOGPACK_FIELD(struct LogLegacy, roll, LOGPACK_S16, "Roll", 1.0f, 0),
+	LOGPACK_FIELD(struct LogLegacy, yaw, LOGPACK_S16, "Yaw", 1.0f, 0),
+	LOGPACK_FIELD(struct LogLegacy, control_state, LOGPACK_S8, "FlightMode", 1.0f, 0),
+	LOGPACK_FIELD(struct LogLegacy, temperature_c, LOGPACK_S8, "TempC", 1.0f, 0),
+	LOGPACK_FIELD(struct LogLegacy, height_m, LOGPACK_S16, "HeightBaro", 1.0f, 0),
+	LOGPACK_FIELD(struct LogLegacy, navigation_code_line, LOGPACK_S16, "NavigationLine", 1.0f, 0),   // 0...
+	LOGPACK_FIELD(struct LogLegacy, servo_trigger, LOGPACK_U16, "ServoTrigger", 1.0f, 0),
+};
+
+const struct LogRecordType log_legacy_type = { LOG_LEGACY, 0, "Legacy", FIELDS(legacy_fields) };
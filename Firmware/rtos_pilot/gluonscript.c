@@ -23,6 +23,7 @@
 #include "task_control.h"
 #include "configuration.h"
 #include "gluonscript.h"
+#include "task_datalogger.h"
 
 
 volatile struct GluonscriptData gluonscript_data = {.current_codeline = 0, .last_code = 0, .tick = 0 };
@@ -353,7 +354,7 @@ struct GluonscriptCode * gluonscript_next_waypoint_code(int current_codeline)
 
 void gluonscript_burn()
 {
-	dataflash.write(NAVIGATION_PAGE, sizeof(gluonscript_data.codes), (unsigned char*) & (gluonscript_data.codes));
+	datalogger_write(NAVIGATION_PAGE, sizeof(gluonscript_data.codes), (unsigned char*) & (gluonscript_data.codes));
 }
 
 
@@ -20,6 +20,7 @@
 
 // Gluonpilot libraries
 #include "ppm_in/ppm_in.h"
+#include "fastmath/fastmath.h"
 
 #include "configuration.h"
 #include "sensors.h"
@@ -208,7 +209,7 @@ ScriptHandlerReturn navigation_handle_gluonscriptcommand (struct GluonscriptCode
   			float leg2 = MAX(leg_x * leg_x + leg_y * leg_y, 1.f);
   			float nav_leg_progress = ((sensor_data.gps.latitude_rad - navigation_data.last_waypoint_latitude_rad) * latitude_meter_per_radian * leg_x + 
   			                          (sensor_data.gps.longitude_rad - navigation_data.last_waypoint_longitude_rad) * longitude_meter_per_radian * leg_y) / leg2;
-  			float nav_leg_length = sqrtf(leg2);
+  			float nav_leg_length = fastmath_sqrt(leg2);
 
 			  /** distance of carrot (in meter) */
 			float carrot = 4.0f * sensor_data.gps.speed_ms;
@@ -320,7 +321,7 @@ ScriptHandlerReturn navigation_handle_gluonscriptcommand (struct GluonscriptCode
   			float leg2 = MAX(leg_x * leg_x + leg_y * leg_y, 1.f);
   			float nav_leg_progress = ((sensor_data.gps.latitude_rad - navigation_data.last_waypoint_latitude_rad) * latitude_meter_per_radian * leg_x + 
   			                          (sensor_data.gps.longitude_rad - navigation_data.last_waypoint_longitude_rad) * longitude_meter_per_radian * leg_y) / leg2;
-  			float nav_leg_length = sqrtf(leg2);
+  			float nav_leg_length = fastmath_sqrt(leg2);
 
 			  /** distance of carrot (in meter) */
 			float carrot = 4.0f * sensor_data.gps.speed_ms;
@@ -352,7 +353,7 @@ ScriptHandlerReturn navigation_handle_gluonscriptcommand (struct GluonscriptCode
   			float leg2 = MAX(leg_x * leg_x + leg_y * leg_y, 1.f);
   			float nav_leg_progress = ((sensor_data.gps.latitude_rad - navigation_data.last_waypoint_latitude_rad) * latitude_meter_per_radian * leg_x + 
   			                          (sensor_data.gps.longitude_rad - navigation_data.last_waypoint_longitude_rad) * longitude_meter_per_radian * leg_y) / leg2;
-  			float nav_leg_length = sqrtf(leg2);
+  			float nav_leg_length = fastmath_sqrt(leg2);
 
 			  /** distance of carrot (in meter) */
 			float carrot = 4.0f * sensor_data.gps.speed_ms;
@@ -376,7 +377,7 @@ ScriptHandlerReturn navigation_handle_gluonscriptcommand (struct GluonscriptCode
 	        // hard_aim
 	        float altitude_agl = (sensor_data.pressure_height - navigation_data.home_pressure_height);
 	        //float desired_pitch = -fabs(atanf(altitude_agl / (nav_leg_length*(1.0-nav_leg_progress))));
-	        float desired_pitch = -fabs(atanf(altitude_agl / (nav_leg_length*(1.0-nav_leg_progress_aim))));
+	        float desired_pitch = -fabs(fastmath_atan(altitude_agl / (nav_leg_length*(1.0-nav_leg_progress_aim))));
 
 	        navigation_data.desired_altitude_agl = desired_pitch / config.control.pid_altitude2pitch.p_gain + altitude_agl;
 
@@ -498,13 +499,15 @@ void navigation_do_circle(struct GluonscriptCode *current_code)
 	
 	navigation_data.desired_pre_bank = (distance_center > abs_r + distance_ahead*2.0 || 
 	                                   distance_center < abs_r - distance_ahead) ? 0 :
-  				                          atan(sensor_data.gps.speed_ms*sensor_data.gps.speed_ms / (G*r));
+  				                          fastmath_atan(sensor_data.gps.speed_ms*sensor_data.gps.speed_ms / (G*r));
 
-	float next_r = abs_r / cosf(rad_ahead); // CHANGE sqrt(r*r + distance_ahe^ ad*distance_ahead);
+	float next_r = abs_r / fastmath_cos(rad_ahead); // CHANGE sqrt(r*r + distance_ahe^ ad*distance_ahead);
 			
 	// max desired_heading
-	float pointlon = current_code->y + sinf(next_alpha) * next_r / longitude_meter_per_radian;
-	float pointlat = current_code->x + cosf(next_alpha) * next_r / latitude_meter_per_radian;
+	float sin_alpha, cos_alpha;
+	fastmath_sincos(next_alpha, &sin_alpha, &cos_alpha);
+	float pointlon = current_code->y + sin_alpha * next_r / longitude_meter_per_radian;
+	float pointlat = current_code->x + cos_alpha * next_r / latitude_meter_per_radian;
 	
 	
 	navigation_data.desired_heading_rad = navigation_heading_rad_fromto(sensor_data.gps.longitude_rad - pointlon,
@@ -532,7 +535,7 @@ void navigation_set_home()
 	navigation_data.home_latitude_rad = sensor_data.gps.latitude_rad;
 	navigation_data.home_gps_height = sensor_data.gps.height_m;
 	
-	cos_latitude = cos(sensor_data.gps.latitude_rad);
+	cos_latitude = fastmath_cos(sensor_data.gps.latitude_rad);
 	longitude_meter_per_radian = latitude_meter_per_radian * cos_latitude;  // approx
 	
 	// set loiter position to home
@@ -553,10 +556,10 @@ float navigation_heading_rad_fromto (float diff_long, float diff_lat)
 	//diff_lat *= cos_latitude;   // Local, flat earth approximation!
 	diff_long *= cos_latitude;   // Local, flat earth approximation!
 	
-	float waypointHeading = atan2(diff_long, -diff_lat);
+	float waypointHeading = fastmath_atan2(diff_long, -diff_lat);
 
 	// make clockwise direction positive (CCW is +ve as is)
-	if(sin(diff_long) > 0.0)
+	if(diff_long > 0.0f)   // same sign as sin(diff_long): |diff_long| < PI
 		waypointHeading = (2.0*PI) - waypointHeading;
 	else
 		waypointHeading = -waypointHeading;
@@ -583,5 +586,5 @@ float navigation_distance_between_meter(float long1, float long2, float lat1, fl
 	float difflong = (long1 - long2) * longitude_meter_per_radian;
 	float difflat = (lat1 - lat2) * latitude_meter_per_radian;
 
-	return sqrt(difflong*difflong + difflat*difflat);
+	return fastmath_sqrt(difflong*difflong + difflat*difflat);
 }
@@ -63,7 +63,7 @@ struct NavigationData
 };
 
 
-volatile extern struct NavigationData navigation_data;
+extern volatile struct NavigationData navigation_data;
 
 ScriptHandlerReturn navigation_handle_gluonscriptcommand (struct GluonscriptCode *code);
 
@@ -41,11 +41,11 @@ OBJECTDIR=build/${CND_CONF}/${IMAGE_TYPE}
 DISTDIR=dist/${CND_CONF}/${IMAGE_TYPE}
 
 # Object Files Quoted if spaced
-OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/_ext/1970174492/croutine.o ${OBJECTDIR}/_ext/1970174492/heap_1.o ${OBJECTDIR}/_ext/1970174492/list.o ${OBJECTDIR}/_ext/1970174492/port.o ${OBJECTDIR}/_ext/1970174492/portasm_dsPIC.o ${OBJECTDIR}/_ext/1970174492/queue.o ${OBJECTDIR}/_ext/1970174492/tasks.o ${OBJECTDIR}/_ext/1970174492/timers.o ${OBJECTDIR}/_ext/957539446/adc.o ${OBJECTDIR}/_ext/1077768206/bmp085.o ${OBJECTDIR}/_ext/1070193764/button.o ${OBJECTDIR}/_ext/968823332/dataflash.o ${OBJECTDIR}/_ext/957545600/gps.o ${OBJECTDIR}/_ext/1967121974/hmc5843.o ${OBJECTDIR}/_ext/957545584/i2c.o ${OBJECTDIR}/_ext/957550049/led.o ${OBJECTDIR}/_ext/773745621/matrix.o ${OBJECTDIR}/_ext/1785572984/max7456.o ${OBJECTDIR}/_ext/1843177418/microcontroller.o ${OBJECTDIR}/_ext/957554017/pid.o ${OBJECTDIR}/_ext/674232159/ppm_in.o ${OBJECTDIR}/_ext/667767512/pwm_in.o ${OBJECTDIR}/_ext/888521352/quaternion.o ${OBJECTDIR}/_ext/1429652139/scp1000.o ${OBJECTDIR}/_ext/1089077615/servo.o ${OBJECTDIR}/_ext/1591518261/uart1_queue.o ${OBJECTDIR}/_ext/1090805370/uart2.o ${OBJECTDIR}/_ext/2082761406/mpu6000.o ${OBJECTDIR}/_ext/1843177418/getErrLoc.o ${OBJECTDIR}/_ext/1472/communication_csv.o ${OBJECTDIR}/_ext/1472/configuration.o ${OBJECTDIR}/_ext/1472/gluonscript.o ${OBJECTDIR}/_ext/1472/rtos_pilot.o ${OBJECTDIR}/_ext/1472/handler_alarms.o ${OBJECTDIR}/_ext/1472/handler_trigger.o ${OBJECTDIR}/_ext/1472/handler_navigation.o ${OBJECTDIR}/_ext/1472/handler_flightplan_switch.o ${OBJECTDIR}/_ext/1472/task_gps.o ${OBJECTDIR}/_ext/1472/task_datalogger.o ${OBJECTDIR}/_ext/1472/task_control.o ${OBJECTDIR}/_ext/1472/task_sensors_analog.o ${OBJECTDIR}/_ext/1472/sensors.o ${OBJECTDIR}/_ext/1472/task_sensors_mpu6000.o ${OBJECTDIR}/_ext/1472/handler_maximum_range.o ${OBJECTDIR}/_ext/1472/task_osd.o ${OBJECTDIR}/_ext/1472/ahrs_kalman_2x3.o
-POSSIBLE_DEPFILES=${OBJECTDIR}/_ext/1970174492/croutine.o.d ${OBJECTDIR}/_ext/1970174492/heap_1.o.d ${OBJECTDIR}/_ext/1970174492/list.o.d ${OBJECTDIR}/_ext/1970174492/port.o.d ${OBJECTDIR}/_ext/1970174492/portasm_dsPIC.o.d ${OBJECTDIR}/_ext/1970174492/queue.o.d ${OBJECTDIR}/_ext/1970174492/tasks.o.d ${OBJECTDIR}/_ext/1970174492/timers.o.d ${OBJECTDIR}/_ext/957539446/adc.o.d ${OBJECTDIR}/_ext/1077768206/bmp085.o.d ${OBJECTDIR}/_ext/1070193764/button.o.d ${OBJECTDIR}/_ext/968823332/dataflash.o.d ${OBJECTDIR}/_ext/957545600/gps.o.d ${OBJECTDIR}/_ext/1967121974/hmc5843.o.d ${OBJECTDIR}/_ext/957545584/i2c.o.d ${OBJECTDIR}/_ext/957550049/led.o.d ${OBJECTDIR}/_ext/773745621/matrix.o.d ${OBJECTDIR}/_ext/1785572984/max7456.o.d ${OBJECTDIR}/_ext/1843177418/microcontroller.o.d ${OBJECTDIR}/_ext/957554017/pid.o.d ${OBJECTDIR}/_ext/674232159/ppm_in.o.d ${OBJECTDIR}/_ext/667767512/pwm_in.o.d ${OBJECTDIR}/_ext/888521352/quaternion.o.d ${OBJECTDIR}/_ext/1429652139/scp1000.o.d ${OBJECTDIR}/_ext/1089077615/servo.o.d ${OBJECTDIR}/_ext/1591518261/uart1_queue.o.d ${OBJECTDIR}/_ext/1090805370/uart2.o.d ${OBJECTDIR}/_ext/2082761406/mpu6000.o.d ${OBJECTDIR}/_ext/1843177418/getErrLoc.o.d ${OBJECTDIR}/_ext/1472/communication_csv.o.d ${OBJECTDIR}/_ext/1472/configuration.o.d ${OBJECTDIR}/_ext/1472/gluonscript.o.d ${OBJECTDIR}/_ext/1472/rtos_pilot.o.d ${OBJECTDIR}/_ext/1472/handler_alarms.o.d ${OBJECTDIR}/_ext/1472/handler_trigger.o.d ${OBJECTDIR}/_ext/1472/handler_navigation.o.d ${OBJECTDIR}/_ext/1472/handler_flightplan_switch.o.d ${OBJECTDIR}/_ext/1472/task_gps.o.d ${OBJECTDIR}/_ext/1472/task_datalogger.o.d ${OBJECTDIR}/_ext/1472/task_control.o.d ${OBJECTDIR}/_ext/1472/task_sensors_analog.o.d ${OBJECTDIR}/_ext/1472/sensors.o.d ${OBJECTDIR}/_ext/1472/task_sensors_mpu6000.o.d ${OBJECTDIR}/_ext/1472/handler_maximum_range.o.d ${OBJECTDIR}/_ext/1472/task_osd.o.d ${OBJECTDIR}/_ext/1472/ahrs_kalman_2x3.o.d
+OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/_ext/1970174492/croutine.o ${OBJECTDIR}/_ext/1970174492/heap_1.o ${OBJECTDIR}/_ext/1970174492/list.o ${OBJECTDIR}/_ext/1970174492/port.o ${OBJECTDIR}/_ext/1970174492/portasm_dsPIC.o ${OBJECTDIR}/_ext/1970174492/queue.o ${OBJECTDIR}/_ext/1970174492/tasks.o ${OBJECTDIR}/_ext/1970174492/timers.o ${OBJECTDIR}/_ext/957539446/adc.o ${OBJECTDIR}/_ext/1077768206/bmp085.o ${OBJECTDIR}/_ext/1070193764/button.o ${OBJECTDIR}/_ext/968823332/dataflash.o ${OBJECTDIR}/_ext/957545600/gps.o ${OBJECTDIR}/_ext/1967121974/hmc5843.o ${OBJECTDIR}/_ext/957545584/i2c.o ${OBJECTDIR}/_ext/957550049/led.o ${OBJECTDIR}/_ext/773745621/matrix.o ${OBJECTDIR}/_ext/1785572984/max7456.o ${OBJECTDIR}/_ext/1843177418/microcontroller.o ${OBJECTDIR}/_ext/957554017/pid.o ${OBJECTDIR}/_ext/957554017/pid_q16.o ${OBJECTDIR}/_ext/118348622/fastmath.o ${OBJECTDIR}/_ext/1074671951/crc16.o ${OBJECTDIR}/_ext/1284920371/logpack.o ${OBJECTDIR}/_ext/1284920371/logschema.o ${OBJECTDIR}/_ext/726865999/numfmt.o ${OBJECTDIR}/_ext/815200446/cmdtable.o ${OBJECTDIR}/_ext/674232159/ppm_in.o ${OBJECTDIR}/_ext/667767512/pwm_in.o ${OBJECTDIR}/_ext/888521352/quaternion.o ${OBJECTDIR}/_ext/1429652139/scp1000.o ${OBJECTDIR}/_ext/1089077615/servo.o ${OBJECTDIR}/_ext/1591518261/uart1_queue.o ${OBJECTDIR}/_ext/1090805370/uart2.o ${OBJECTDIR}/_ext/2082761406/mpu6000.o ${OBJECTDIR}/_ext/1843177418/getErrLoc.o ${OBJECTDIR}/_ext/1472/communication_csv.o ${OBJECTDIR}/_ext/1472/communication_binary.o ${OBJECTDIR}/_ext/1472/configuration.o ${OBJECTDIR}/_ext/1472/gluonscript.o ${OBJECTDIR}/_ext/1472/rtos_pilot.o ${OBJECTDIR}/_ext/1472/handler_alarms.o ${OBJECTDIR}/_ext/1472/handler_trigger.o ${OBJECTDIR}/_ext/1472/handler_navigation.o ${OBJECTDIR}/_ext/1472/handler_flightplan_switch.o ${OBJECTDIR}/_ext/1472/task_gps.o ${OBJECTDIR}/_ext/1472/task_datalogger.o ${OBJECTDIR}/_ext/1472/task_control.o ${OBJECTDIR}/_ext/1472/control_mix.o ${OBJECTDIR}/_ext/1472/datalogger_records.o ${OBJECTDIR}/_ext/1472/task_sensors_analog.o ${OBJECTDIR}/_ext/1472/sensors.o ${OBJECTDIR}/_ext/1472/task_sensors_mpu6000.o ${OBJECTDIR}/_ext/1472/telemetry_scheduler.o ${OBJECTDIR}/_ext/1472/handler_maximum_range.o ${OBJECTDIR}/_ext/1472/task_osd.o ${OBJECTDIR}/_ext/1472/ahrs_kalman_2x3.o ${OBJECTDIR}/_ext/1472/ahrs_kalman_2x3_q16.o
+POSSIBLE_DEPFILES=${OBJECTDIR}/_ext/1970174492/croutine.o.d ${OBJECTDIR}/_ext/1970174492/heap_1.o.d ${OBJECTDIR}/_ext/1970174492/list.o.d ${OBJECTDIR}/_ext/1970174492/port.o.d ${OBJECTDIR}/_ext/1970174492/portasm_dsPIC.o.d ${OBJECTDIR}/_ext/1970174492/queue.o.d ${OBJECTDIR}/_ext/1970174492/tasks.o.d ${OBJECTDIR}/_ext/1970174492/timers.o.d ${OBJECTDIR}/_ext/957539446/adc.o.d ${OBJECTDIR}/_ext/1077768206/bmp085.o.d ${OBJECTDIR}/_ext/1070193764/button.o.d ${OBJECTDIR}/_ext/968823332/dataflash.o.d ${OBJECTDIR}/_ext/957545600/gps.o.d ${OBJECTDIR}/_ext/1967121974/hmc5843.o.d ${OBJECTDIR}/_ext/957545584/i2c.o.d ${OBJECTDIR}/_ext/957550049/led.o.d ${OBJECTDIR}/_ext/773745621/matrix.o.d ${OBJECTDIR}/_ext/1785572984/max7456.o.d ${OBJECTDIR}/_ext/1843177418/microcontroller.o.d ${OBJECTDIR}/_ext/957554017/pid.o.d ${OBJECTDIR}/_ext/957554017/pid_q16.o.d ${OBJECTDIR}/_ext/118348622/fastmath.o.d ${OBJECTDIR}/_ext/1074671951/crc16.o.d ${OBJECTDIR}/_ext/1284920371/logpack.o.d ${OBJECTDIR}/_ext/1284920371/logschema.o.d ${OBJECTDIR}/_ext/726865999/numfmt.o.d ${OBJECTDIR}/_ext/815200446/cmdtable.o.d ${OBJECTDIR}/_ext/674232159/ppm_in.o.d ${OBJECTDIR}/_ext/667767512/pwm_in.o.d ${OBJECTDIR}/_ext/888521352/quaternion.o.d ${OBJECTDIR}/_ext/1429652139/scp1000.o.d ${OBJECTDIR}/_ext/1089077615/servo.o.d ${OBJECTDIR}/_ext/1591518261/uart1_queue.o.d ${OBJECTDIR}/_ext/1090805370/uart2.o.d ${OBJECTDIR}/_ext/2082761406/mpu6000.o.d ${OBJECTDIR}/_ext/1843177418/getErrLoc.o.d ${OBJECTDIR}/_ext/1472/communication_csv.o.d ${OBJECTDIR}/_ext/1472/communication_binary.o.d ${OBJECTDIR}/_ext/1472/configuration.o.d ${OBJECTDIR}/_ext/1472/gluonscript.o.d ${OBJECTDIR}/_ext/1472/rtos_pilot.o.d ${OBJECTDIR}/_ext/1472/handler_alarms.o.d ${OBJECTDIR}/_ext/1472/handler_trigger.o.d ${OBJECTDIR}/_ext/1472/handler_navigation.o.d ${OBJECTDIR}/_ext/1472/handler_flightplan_switch.o.d ${OBJECTDIR}/_ext/1472/task_gps.o.d ${OBJECTDIR}/_ext/1472/task_datalogger.o.d ${OBJECTDIR}/_ext/1472/task_control.o.d ${OBJECTDIR}/_ext/1472/control_mix.o.d ${OBJECTDIR}/_ext/1472/datalogger_records.o.d ${OBJECTDIR}/_ext/1472/task_sensors_analog.o.d ${OBJECTDIR}/_ext/1472/sensors.o.d ${OBJECTDIR}/_ext/1472/task_sensors_mpu6000.o.d ${OBJECTDIR}/_ext/1472/telemetry_scheduler.o.d ${OBJECTDIR}/_ext/1472/handler_maximum_range.o.d ${OBJECTDIR}/_ext/1472/task_osd.o.d ${OBJECTDIR}/_ext/1472/ahrs_kalman_2x3.o.d ${OBJECTDIR}/_ext/1472/ahrs_kalman_2x3_q16.o.d
 
 # Object Files
-OBJECTFILES=${OBJECTDIR}/_ext/1970174492/croutine.o ${OBJECTDIR}/_ext/1970174492/heap_1.o ${OBJECTDIR}/_ext/1970174492/list.o ${OBJECTDIR}/_ext/1970174492/port.o ${OBJECTDIR}/_ext/1970174492/portasm_dsPIC.o ${OBJECTDIR}/_ext/1970174492/queue.o ${OBJECTDIR}/_ext/1970174492/tasks.o ${OBJECTDIR}/_ext/1970174492/timers.o ${OBJECTDIR}/_ext/957539446/adc.o ${OBJECTDIR}/_ext/1077768206/bmp085.o ${OBJECTDIR}/_ext/1070193764/button.o ${OBJECTDIR}/_ext/968823332/dataflash.o ${OBJECTDIR}/_ext/957545600/gps.o ${OBJECTDIR}/_ext/1967121974/hmc5843.o ${OBJECTDIR}/_ext/957545584/i2c.o ${OBJECTDIR}/_ext/957550049/led.o ${OBJECTDIR}/_ext/773745621/matrix.o ${OBJECTDIR}/_ext/1785572984/max7456.o ${OBJECTDIR}/_ext/1843177418/microcontroller.o ${OBJECTDIR}/_ext/957554017/pid.o ${OBJECTDIR}/_ext/674232159/ppm_in.o ${OBJECTDIR}/_ext/667767512/pwm_in.o ${OBJECTDIR}/_ext/888521352/quaternion.o ${OBJECTDIR}/_ext/1429652139/scp1000.o ${OBJECTDIR}/_ext/1089077615/servo.o ${OBJECTDIR}/_ext/1591518261/uart1_queue.o ${OBJECTDIR}/_ext/1090805370/uart2.o ${OBJECTDIR}/_ext/2082761406/mpu6000.o ${OBJECTDIR}/_ext/1843177418/getErrLoc.o ${OBJECTDIR}/_ext/1472/communication_csv.o ${OBJECTDIR}/_ext/1472/configuration.o ${OBJECTDIR}/_ext/1472/gluonscript.o ${OBJECTDIR}/_ext/1472/rtos_pilot.o ${OBJECTDIR}/_ext/1472/handler_alarms.o ${OBJECTDIR}/_ext/1472/handler_trigger.o ${OBJECTDIR}/_ext/1472/handler_navigation.o ${OBJECTDIR}/_ext/1472/handler_flightplan_switch.o ${OBJECTDIR}/_ext/1472/task_gps.o ${OBJECTDIR}/_ext/1472/task_datalogger.o ${OBJECTDIR}/_ext/1472/task_control.o ${OBJECTDIR}/_ext/1472/task_sensors_analog.o ${OBJECTDIR}/_ext/1472/sensors.o ${OBJECTDIR}/_ext/1472/task_sensors_mpu6000.o ${OBJECTDIR}/_ext/1472/handler_maximum_range.o ${OBJECTDIR}/_ext/1472/task_osd.o ${OBJECTDIR}/_ext/1472/ahrs_kalman_2x3.o
+OBJECTFILES=${OBJECTDIR}/_ext/1970174492/croutine.o ${OBJECTDIR}/_ext/1970174492/heap_1.o ${OBJECTDIR}/_ext/1970174492/list.o ${OBJECTDIR}/_ext/1970174492/port.o ${OBJECTDIR}/_ext/1970174492/portasm_dsPIC.o ${OBJECTDIR}/_ext/1970174492/queue.o ${OBJECTDIR}/_ext/1970174492/tasks.o ${OBJECTDIR}/_ext/1970174492/timers.o ${OBJECTDIR}/_ext/957539446/adc.o ${OBJECTDIR}/_ext/1077768206/bmp085.o ${OBJECTDIR}/_ext/1070193764/button.o ${OBJECTDIR}/_ext/968823332/dataflash.o ${OBJECTDIR}/_ext/957545600/gps.o ${OBJECTDIR}/_ext/1967121974/hmc5843.o ${OBJECTDIR}/_ext/957545584/i2c.o ${OBJECTDIR}/_ext/957550049/led.o ${OBJECTDIR}/_ext/773745621/matrix.o ${OBJECTDIR}/_ext/1785572984/max7456.o ${OBJECTDIR}/_ext/1843177418/microcontroller.o ${OBJECTDIR}/_ext/957554017/pid.o ${OBJECTDIR}/_ext/957554017/pid_q16.o ${OBJECTDIR}/_ext/118348622/fastmath.o ${OBJECTDIR}/_ext/1074671951/crc16.o ${OBJECTDIR}/_ext/1284920371/logpack.o ${OBJECTDIR}/_ext/1284920371/logschema.o ${OBJECTDIR}/_ext/726865999/numfmt.o ${OBJECTDIR}/_ext/815200446/cmdtable.o ${OBJECTDIR}/_ext/674232159/ppm_in.o ${OBJECTDIR}/_ext/667767512/pwm_in.o ${OBJECTDIR}/_ext/888521352/quaternion.o ${OBJECTDIR}/_ext/1429652139/scp1000.o ${OBJECTDIR}/_ext/1089077615/servo.o ${OBJECTDIR}/_ext/1591518261/uart1_queue.o ${OBJECTDIR}/_ext/1090805370/uart2.o ${OBJECTDIR}/_ext/2082761406/mpu6000.o ${OBJECTDIR}/_ext/1843177418/getErrLoc.o ${OBJECTDIR}/_ext/1472/communication_csv.o ${OBJECTDIR}/_ext/1472/communication_binary.o ${OBJECTDIR}/_ext/1472/configuration.o ${OBJECTDIR}/_ext/1472/gluonscript.o ${OBJECTDIR}/_ext/1472/rtos_pilot.o ${OBJECTDIR}/_ext/1472/handler_alarms.o ${OBJECTDIR}/_ext/1472/handler_trigger.o ${OBJECTDIR}/_ext/1472/handler_navigation.o ${OBJECTDIR}/_ext/1472/handler_flightplan_switch.o ${OBJECTDIR}/_ext/1472/task_gps.o ${OBJECTDIR}/_ext/1472/task_datalogger.o ${OBJECTDIR}/_ext/1472/task_control.o ${OBJECTDIR}/_ext/1472/control_mix.o ${OBJECTDIR}/_ext/1472/datalogger_records.o ${OBJECTDIR}/_ext/1472/task_sensors_analog.o ${OBJECTDIR}/_ext/1472/sensors.o ${OBJECTDIR}/_ext/1472/task_sensors_mpu6000.o ${OBJECTDIR}/_ext/1472/telemetry_scheduler.o ${OBJECTDIR}/_ext/1472/handler_maximum_range.o ${OBJECTDIR}/_ext/1472/task_osd.o ${OBJECTDIR}/_ext/1472/ahrs_kalman_2x3.o ${OBJECTDIR}/_ext/1472/ahrs_kalman_2x3_q16.o
 
 
 CFLAGS=
@@ -183,6 +183,48 @@ ${OBJECTDIR}/_ext/957554017/pid.o: ../../lib/pid/pid.c  nbproject/Makefile-${CND
 	${MP_CC} $(MP_EXTRA_CC_PRE)  ../../lib/pid/pid.c  -o ${OBJECTDIR}/_ext/957554017/pid.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/957554017/pid.o.d"        -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1  -omf=elf -mlarge-code -mlarge-data -O1 -I"..\..\lib\FreeRTOS" -I"..\..\lib" -I"..\..\lib\button" -I"..\..\lib\adc" -I".." -I"..\..\lib\i2c" -I"..\..\lib\bmp085" -I"..\..\lib\hmc5843" -I"..\..\lib\max7456" -I"..\..\lib\matrix" -I"..\..\lib\quaternion" -I"..\..\lib\pid" -I"..\..\lib\pwm_in" -I"..\..\lib\led" -I"..\..\lib\ppm_in" -I"..\..\lib\uart2" -I"..\..\lib\uart1_queue" -I"..\..\lib\servo" -I"..\..\lib\scp1000" -I"..\..\lib\microcontroller" -I"..\..\lib\gps" -I"..\..\lib\dataflash" -DMPLAB_DSPIC_PORT -DENABLE_QUADROCOPTER -msmart-io=1 -Wall -msfr-warn=off
 	@${FIXDEPS} "${OBJECTDIR}/_ext/957554017/pid.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
 	
+${OBJECTDIR}/_ext/957554017/pid_q16.o: ../../lib/pid/pid_q16.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/_ext/957554017 
+	@${RM} ${OBJECTDIR}/_ext/957554017/pid_q16.o.d 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  ../../lib/pid/pid_q16.c  -o ${OBJECTDIR}/_ext/957554017/pid_q16.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/957554017/pid_q16.o.d"        -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1  -omf=elf -mlarge-code -mlarge-data -O1 -I"..\..\lib\FreeRTOS" -I"..\..\lib" -I"..\..\lib\button" -I"..\..\lib\adc" -I".." -I"..\..\lib\i2c" -I"..\..\lib\bmp085" -I"..\..\lib\hmc5843" -I"..\..\lib\max7456" -I"..\..\lib\matrix" -I"..\..\lib\quaternion" -I"..\..\lib\pid" -I"..\..\lib\pwm_in" -I"..\..\lib\led" -I"..\..\lib\ppm_in" -I"..\..\lib\uart2" -I"..\..\lib\uart1_queue" -I"..\..\lib\servo" -I"..\..\lib\scp1000" -I"..\..\lib\microcontroller" -I"..\..\lib\gps" -I"..\..\lib\dataflash" -DMPLAB_DSPIC_PORT -DENABLE_QUADROCOPTER -msmart-io=1 -Wall -msfr-warn=off
+	@${FIXDEPS} "${OBJECTDIR}/_ext/957554017/pid_q16.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/_ext/118348622/fastmath.o: ../../lib/fastmath/fastmath.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/_ext/118348622 
+	@${RM} ${OBJECTDIR}/_ext/118348622/fastmath.o.d 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  ../../lib/fastmath/fastmath.c  -o ${OBJECTDIR}/_ext/118348622/fastmath.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/118348622/fastmath.o.d"        -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1  -omf=elf -mlarge-code -mlarge-data -O1 -I"..\..\lib\FreeRTOS" -I"..\..\lib" -I"..\..\lib\button" -I"..\..\lib\adc" -I".." -I"..\..\lib\i2c" -I"..\..\lib\bmp085" -I"..\..\lib\hmc5843" -I"..\..\lib\max7456" -I"..\..\lib\matrix" -I"..\..\lib\quaternion" -I"..\..\lib\pid" -I"..\..\lib\pwm_in" -I"..\..\lib\led" -I"..\..\lib\ppm_in" -I"..\..\lib\uart2" -I"..\..\lib\uart1_queue" -I"..\..\lib\servo" -I"..\..\lib\scp1000" -I"..\..\lib\microcontroller" -I"..\..\lib\gps" -I"..\..\lib\dataflash" -DMPLAB_DSPIC_PORT -DENABLE_QUADROCOPTER -msmart-io=1 -Wall -msfr-warn=off
+	@${FIXDEPS} "${OBJECTDIR}/_ext/118348622/fastmath.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/_ext/1074671951/crc16.o: ../../lib/crc16/crc16.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/_ext/1074671951 
+	@${RM} ${OBJECTDIR}/_ext/1074671951/crc16.o.d 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  ../../lib/crc16/crc16.c  -o ${OBJECTDIR}/_ext/1074671951/crc16.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/1074671951/crc16.o.d"        -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1  -omf=elf -mlarge-code -mlarge-data -O1 -I"..\..\lib\FreeRTOS" -I"..\..\lib" -I"..\..\lib\button" -I"..\..\lib\adc" -I".." -I"..\..\lib\i2c" -I"..\..\lib\bmp085" -I"..\..\lib\hmc5843" -I"..\..\lib\max7456" -I"..\..\lib\matrix" -I"..\..\lib\quaternion" -I"..\..\lib\pid" -I"..\..\lib\pwm_in" -I"..\..\lib\led" -I"..\..\lib\ppm_in" -I"..\..\lib\uart2" -I"..\..\lib\uart1_queue" -I"..\..\lib\servo" -I"..\..\lib\scp1000" -I"..\..\lib\microcontroller" -I"..\..\lib\gps" -I"..\..\lib\dataflash" -DMPLAB_DSPIC_PORT -DENABLE_QUADROCOPTER -msmart-io=1 -Wall -msfr-warn=off
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1074671951/crc16.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/_ext/1284920371/logpack.o: ../../lib/logpack/logpack.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/_ext/1284920371 
+	@${RM} ${OBJECTDIR}/_ext/1284920371/logpack.o.d 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  ../../lib/logpack/logpack.c  -o ${OBJECTDIR}/_ext/1284920371/logpack.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/1284920371/logpack.o.d"        -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1  -omf=elf -mlarge-code -mlarge-data -O1 -I"..\..\lib\FreeRTOS" -I"..\..\lib" -I"..\..\lib\button" -I"..\..\lib\adc" -I".." -I"..\..\lib\i2c" -I"..\..\lib\bmp085" -I"..\..\lib\hmc5843" -I"..\..\lib\max7456" -I"..\..\lib\matrix" -I"..\..\lib\quaternion" -I"..\..\lib\pid" -I"..\..\lib\pwm_in" -I"..\..\lib\led" -I"..\..\lib\ppm_in" -I"..\..\lib\uart2" -I"..\..\lib\uart1_queue" -I"..\..\lib\servo" -I"..\..\lib\scp1000" -I"..\..\lib\microcontroller" -I"..\..\lib\gps" -I"..\..\lib\dataflash" -DMPLAB_DSPIC_PORT -DENABLE_QUADROCOPTER -msmart-io=1 -Wall -msfr-warn=off
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1284920371/logpack.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/_ext/1284920371/logschema.o: ../../lib/logpack/logschema.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/_ext/1284920371 
+	@${RM} ${OBJECTDIR}/_ext/1284920371/logschema.o.d 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  ../../lib/logpack/logschema.c  -o ${OBJECTDIR}/_ext/1284920371/logschema.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/1284920371/logschema.o.d"        -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1  -omf=elf -mlarge-code -mlarge-data -O1 -I"..\..\lib\FreeRTOS" -I"..\..\lib" -I"..\..\lib\button" -I"..\..\lib\adc" -I".." -I"..\..\lib\i2c" -I"..\..\lib\bmp085" -I"..\..\lib\hmc5843" -I"..\..\lib\max7456" -I"..\..\lib\matrix" -I"..\..\lib\quaternion" -I"..\..\lib\pid" -I"..\..\lib\pwm_in" -I"..\..\lib\led" -I"..\..\lib\ppm_in" -I"..\..\lib\uart2" -I"..\..\lib\uart1_queue" -I"..\..\lib\servo" -I"..\..\lib\scp1000" -I"..\..\lib\microcontroller" -I"..\..\lib\gps" -I"..\..\lib\dataflash" -DMPLAB_DSPIC_PORT -DENABLE_QUADROCOPTER -msmart-io=1 -Wall -msfr-warn=off
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1284920371/logschema.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/_ext/726865999/numfmt.o: ../../lib/numfmt/numfmt.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/_ext/726865999 
+	@${RM} ${OBJECTDIR}/_ext/726865999/numfmt.o.d 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  ../../lib/numfmt/numfmt.c  -o ${OBJECTDIR}/_ext/726865999/numfmt.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/726865999/numfmt.o.d"        -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1  -omf=elf -mlarge-code -mlarge-data -O1 -I"..\..\lib\FreeRTOS" -I"..\..\lib" -I"..\..\lib\button" -I"..\..\lib\adc" -I".." -I"..\..\lib\i2c" -I"..\..\lib\bmp085" -I"..\..\lib\hmc5843" -I"..\..\lib\max7456" -I"..\..\lib\matrix" -I"..\..\lib\quaternion" -I"..\..\lib\pid" -I"..\..\lib\pwm_in" -I"..\..\lib\led" -I"..\..\lib\ppm_in" -I"..\..\lib\uart2" -I"..\..\lib\uart1_queue" -I"..\..\lib\servo" -I"..\..\lib\scp1000" -I"..\..\lib\microcontroller" -I"..\..\lib\gps" -I"..\..\lib\dataflash" -DMPLAB_DSPIC_PORT -DENABLE_QUADROCOPTER -msmart-io=1 -Wall -msfr-warn=off
+	@${FIXDEPS} "${OBJECTDIR}/_ext/726865999/numfmt.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/_ext/815200446/cmdtable.o: ../../lib/cmdtable/cmdtable.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/_ext/815200446 
+	@${RM} ${OBJECTDIR}/_ext/815200446/cmdtable.o.d 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  ../../lib/cmdtable/cmdtable.c  -o ${OBJECTDIR}/_ext/815200446/cmdtable.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/815200446/cmdtable.o.d"        -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1  -omf=elf -mlarge-code -mlarge-data -O1 -I"..\..\lib\FreeRTOS" -I"..\..\lib" -I"..\..\lib\button" -I"..\..\lib\adc" -I".." -I"..\..\lib\i2c" -I"..\..\lib\bmp085" -I"..\..\lib\hmc5843" -I"..\..\lib\max7456" -I"..\..\lib\matrix" -I"..\..\lib\quaternion" -I"..\..\lib\pid" -I"..\..\lib\pwm_in" -I"..\..\lib\led" -I"..\..\lib\ppm_in" -I"..\..\lib\uart2" -I"..\..\lib\uart1_queue" -I"..\..\lib\servo" -I"..\..\lib\scp1000" -I"..\..\lib\microcontroller" -I"..\..\lib\gps" -I"..\..\lib\dataflash" -DMPLAB_DSPIC_PORT -DENABLE_QUADROCOPTER -msmart-io=1 -Wall -msfr-warn=off
+	@${FIXDEPS} "${OBJECTDIR}/_ext/815200446/cmdtable.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
 ${OBJECTDIR}/_ext/674232159/ppm_in.o: ../../lib/ppm_in/ppm_in.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} ${OBJECTDIR}/_ext/674232159 
 	@${RM} ${OBJECTDIR}/_ext/674232159/ppm_in.o.d 
@@ -237,6 +279,12 @@ ${OBJECTDIR}/_ext/1472/communication_csv.o: ../communication_csv.c  nbproject/Ma
 	${MP_CC} $(MP_EXTRA_CC_PRE)  ../communication_csv.c  -o ${OBJECTDIR}/_ext/1472/communication_csv.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/1472/communication_csv.o.d"        -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1  -omf=elf -mlarge-code -mlarge-data -O1 -I"..\..\lib\FreeRTOS" -I"..\..\lib" -I"..\..\lib\button" -I"..\..\lib\adc" -I".." -I"..\..\lib\i2c" -I"..\..\lib\bmp085" -I"..\..\lib\hmc5843" -I"..\..\lib\max7456" -I"..\..\lib\matrix" -I"..\..\lib\quaternion" -I"..\..\lib\pid" -I"..\..\lib\pwm_in" -I"..\..\lib\led" -I"..\..\lib\ppm_in" -I"..\..\lib\uart2" -I"..\..\lib\uart1_queue" -I"..\..\lib\servo" -I"..\..\lib\scp1000" -I"..\..\lib\microcontroller" -I"..\..\lib\gps" -I"..\..\lib\dataflash" -DMPLAB_DSPIC_PORT -DENABLE_QUADROCOPTER -msmart-io=1 -Wall -msfr-warn=off
 	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/communication_csv.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
 	
+${OBJECTDIR}/_ext/1472/communication_binary.o: ../communication_binary.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/_ext/1472 
+	@${RM} ${OBJECTDIR}/_ext/1472/communication_binary.o.d 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  ../communication_binary.c  -o ${OBJECTDIR}/_ext/1472/communication_binary.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/1472/communication_binary.o.d"        -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1  -omf=elf -mlarge-code -mlarge-data -O1 -I"..\..\lib\FreeRTOS" -I"..\..\lib" -I"..\..\lib\button" -I"..\..\lib\adc" -I".." -I"..\..\lib\i2c" -I"..\..\lib\bmp085" -I"..\..\lib\hmc5843" -I"..\..\lib\max7456" -I"..\..\lib\matrix" -I"..\..\lib\quaternion" -I"..\..\lib\pid" -I"..\..\lib\pwm_in" -I"..\..\lib\led" -I"..\..\lib\ppm_in" -I"..\..\lib\uart2" -I"..\..\lib\uart1_queue" -I"..\..\lib\servo" -I"..\..\lib\scp1000" -I"..\..\lib\microcontroller" -I"..\..\lib\gps" -I"..\..\lib\dataflash" -DMPLAB_DSPIC_PORT -DENABLE_QUADROCOPTER -msmart-io=1 -Wall -msfr-warn=off
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/communication_binary.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
 ${OBJECTDIR}/_ext/1472/configuration.o: ../configuration.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} ${OBJECTDIR}/_ext/1472 
 	@${RM} ${OBJECTDIR}/_ext/1472/configuration.o.d 
@@ -297,6 +345,18 @@ ${OBJECTDIR}/_ext/1472/task_control.o: ../task_control.c  nbproject/Makefile-${C
 	${MP_CC} $(MP_EXTRA_CC_PRE)  ../task_control.c  -o ${OBJECTDIR}/_ext/1472/task_control.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/1472/task_control.o.d"        -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1  -omf=elf -mlarge-code -mlarge-data -O1 -I"..\..\lib\FreeRTOS" -I"..\..\lib" -I"..\..\lib\button" -I"..\..\lib\adc" -I".." -I"..\..\lib\i2c" -I"..\..\lib\bmp085" -I"..\..\lib\hmc5843" -I"..\..\lib\max7456" -I"..\..\lib\matrix" -I"..\..\lib\quaternion" -I"..\..\lib\pid" -I"..\..\lib\pwm_in" -I"..\..\lib\led" -I"..\..\lib\ppm_in" -I"..\..\lib\uart2" -I"..\..\lib\uart1_queue" -I"..\..\lib\servo" -I"..\..\lib\scp1000" -I"..\..\lib\microcontroller" -I"..\..\lib\gps" -I"..\..\lib\dataflash" -DMPLAB_DSPIC_PORT -DENABLE_QUADROCOPTER -msmart-io=1 -Wall -msfr-warn=off
 	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/task_control.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
 	
+${OBJECTDIR}/_ext/1472/control_mix.o: ../control_mix.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/_ext/1472 
+	@${RM} ${OBJECTDIR}/_ext/1472/control_mix.o.d 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  ../control_mix.c  -o ${OBJECTDIR}/_ext/1472/control_mix.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/1472/control_mix.o.d"        -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1  -omf=elf -mlarge-code -mlarge-data -O1 -I"..\..\lib\FreeRTOS" -I"..\..\lib" -I"..\..\lib\button" -I"..\..\lib\adc" -I".." -I"..\..\lib\i2c" -I"..\..\lib\bmp085" -I"..\..\lib\hmc5843" -I"..\..\lib\max7456" -I"..\..\lib\matrix" -I"..\..\lib\quaternion" -I"..\..\lib\pid" -I"..\..\lib\pwm_in" -I"..\..\lib\led" -I"..\..\lib\ppm_in" -I"..\..\lib\uart2" -I"..\..\lib\uart1_queue" -I"..\..\lib\servo" -I"..\..\lib\scp1000" -I"..\..\lib\microcontroller" -I"..\..\lib\gps" -I"..\..\lib\dataflash" -DMPLAB_DSPIC_PORT -DENABLE_QUADROCOPTER -msmart-io=1 -Wall -msfr-warn=off
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/control_mix.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/_ext/1472/datalogger_records.o: ../datalogger_records.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/_ext/1472 
+	@${RM} ${OBJECTDIR}/_ext/1472/datalogger_records.o.d 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  ../datalogger_records.c  -o ${OBJECTDIR}/_ext/1472/datalogger_records.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/1472/datalogger_records.o.d"        -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1  -omf=elf -mlarge-code -mlarge-data -O1 -I"..\..\lib\FreeRTOS" -I"..\..\lib" -I"..\..\lib\button" -I"..\..\lib\adc" -I".." -I"..\..\lib\i2c" -I"..\..\lib\bmp085" -I"..\..\lib\hmc5843" -I"..\..\lib\max7456" -I"..\..\lib\matrix" -I"..\..\lib\quaternion" -I"..\..\lib\pid" -I"..\..\lib\pwm_in" -I"..\..\lib\led" -I"..\..\lib\ppm_in" -I"..\..\lib\uart2" -I"..\..\lib\uart1_queue" -I"..\..\lib\servo" -I"..\..\lib\scp1000" -I"..\..\lib\microcontroller" -I"..\..\lib\gps" -I"..\..\lib\dataflash" -DMPLAB_DSPIC_PORT -DENABLE_QUADROCOPTER -msmart-io=1 -Wall -msfr-warn=off
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/datalogger_records.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
 ${OBJECTDIR}/_ext/1472/task_sensors_analog.o: ../task_sensors_analog.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} ${OBJECTDIR}/_ext/1472 
 	@${RM} ${OBJECTDIR}/_ext/1472/task_sensors_analog.o.d 
@@ -315,6 +375,12 @@ ${OBJECTDIR}/_ext/1472/task_sensors_mpu6000.o: ../task_sensors_mpu6000.c  nbproj
 	${MP_CC} $(MP_EXTRA_CC_PRE)  ../task_sensors_mpu6000.c  -o ${OBJECTDIR}/_ext/1472/task_sensors_mpu6000.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/1472/task_sensors_mpu6000.o.d"        -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1  -omf=elf -mlarge-code -mlarge-data -O1 -I"..\..\lib\FreeRTOS" -I"..\..\lib" -I"..\..\lib\button" -I"..\..\lib\adc" -I".." -I"..\..\lib\i2c" -I"..\..\lib\bmp085" -I"..\..\lib\hmc5843" -I"..\..\lib\max7456" -I"..\..\lib\matrix" -I"..\..\lib\quaternion" -I"..\..\lib\pid" -I"..\..\lib\pwm_in" -I"..\..\lib\led" -I"..\..\lib\ppm_in" -I"..\..\lib\uart2" -I"..\..\lib\uart1_queue" -I"..\..\lib\servo" -I"..\..\lib\scp1000" -I"..\..\lib\microcontroller" -I"..\..\lib\gps" -I"..\..\lib\dataflash" -DMPLAB_DSPIC_PORT -DENABLE_QUADROCOPTER -msmart-io=1 -Wall -msfr-warn=off
 	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/task_sensors_mpu6000.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
 	
+${OBJECTDIR}/_ext/1472/telemetry_scheduler.o: ../telemetry_scheduler.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/_ext/1472 
+	@${RM} ${OBJECTDIR}/_ext/1472/telemetry_scheduler.o.d 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  ../telemetry_scheduler.c  -o ${OBJECTDIR}/_ext/1472/telemetry_scheduler.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/1472/telemetry_scheduler.o.d"        -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1  -omf=elf -mlarge-code -mlarge-data -O1 -I"..\..\lib\FreeRTOS" -I"..\..\lib" -I"..\..\lib\button" -I"..\..\lib\adc" -I".." -I"..\..\lib\i2c" -I"..\..\lib\bmp085" -I"..\..\lib\hmc5843" -I"..\..\lib\max7456" -I"..\..\lib\matrix" -I"..\..\lib\quaternion" -I"..\..\lib\pid" -I"..\..\lib\pwm_in" -I"..\..\lib\led" -I"..\..\lib\ppm_in" -I"..\..\lib\uart2" -I"..\..\lib\uart1_queue" -I"..\..\lib\servo" -I"..\..\lib\scp1000" -I"..\..\lib\microcontroller" -I"..\..\lib\gps" -I"..\..\lib\dataflash" -DMPLAB_DSPIC_PORT -DENABLE_QUADROCOPTER -msmart-io=1 -Wall -msfr-warn=off
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/telemetry_scheduler.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
 ${OBJECTDIR}/_ext/1472/handler_maximum_range.o: ../handler_maximum_range.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} ${OBJECTDIR}/_ext/1472 
 	@${RM} ${OBJECTDIR}/_ext/1472/handler_maximum_range.o.d 
@@ -333,6 +399,12 @@ ${OBJECTDIR}/_ext/1472/ahrs_kalman_2x3.o: ../ahrs_kalman_2x3.c  nbproject/Makefi
 	${MP_CC} $(MP_EXTRA_CC_PRE)  ../ahrs_kalman_2x3.c  -o ${OBJECTDIR}/_ext/1472/ahrs_kalman_2x3.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/1472/ahrs_kalman_2x3.o.d"        -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1  -omf=elf -mlarge-code -mlarge-data -O1 -I"..\..\lib\FreeRTOS" -I"..\..\lib" -I"..\..\lib\button" -I"..\..\lib\adc" -I".." -I"..\..\lib\i2c" -I"..\..\lib\bmp085" -I"..\..\lib\hmc5843" -I"..\..\lib\max7456" -I"..\..\lib\matrix" -I"..\..\lib\quaternion" -I"..\..\lib\pid" -I"..\..\lib\pwm_in" -I"..\..\lib\led" -I"..\..\lib\ppm_in" -I"..\..\lib\uart2" -I"..\..\lib\uart1_queue" -I"..\..\lib\servo" -I"..\..\lib\scp1000" -I"..\..\lib\microcontroller" -I"..\..\lib\gps" -I"..\..\lib\dataflash" -DMPLAB_DSPIC_PORT -DENABLE_QUADROCOPTER -msmart-io=1 -Wall -msfr-warn=off
 	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/ahrs_kalman_2x3.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
 	
+${OBJECTDIR}/_ext/1472/ahrs_kalman_2x3_q16.o: ../ahrs_kalman_2x3_q16.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/_ext/1472 
+	@${RM} ${OBJECTDIR}/_ext/1472/ahrs_kalman_2x3_q16.o.d 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  ../ahrs_kalman_2x3_q16.c  -o ${OBJECTDIR}/_ext/1472/ahrs_kalman_2x3_q16.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/1472/ahrs_kalman_2x3_q16.o.d"        -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1  -omf=elf -mlarge-code -mlarge-data -O1 -I"..\..\lib\FreeRTOS" -I"..\..\lib" -I"..\..\lib\button" -I"..\..\lib\adc" -I".." -I"..\..\lib\i2c" -I"..\..\lib\bmp085" -I"..\..\lib\hmc5843" -I"..\..\lib\max7456" -I"..\..\lib\matrix" -I"..\..\lib\quaternion" -I"..\..\lib\pid" -I"..\..\lib\pwm_in" -I"..\..\lib\led" -I"..\..\lib\ppm_in" -I"..\..\lib\uart2" -I"..\..\lib\uart1_queue" -I"..\..\lib\servo" -I"..\..\lib\scp1000" -I"..\..\lib\microcontroller" -I"..\..\lib\gps" -I"..\..\lib\dataflash" -DMPLAB_DSPIC_PORT -DENABLE_QUADROCOPTER -msmart-io=1 -Wall -msfr-warn=off
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/ahrs_kalman_2x3_q16.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
 else
 ${OBJECTDIR}/_ext/1970174492/croutine.o: ../../lib/FreeRTOS/croutine.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} ${OBJECTDIR}/_ext/1970174492 
@@ -448,6 +520,48 @@ ${OBJECTDIR}/_ext/957554017/pid.o: ../../lib/pid/pid.c  nbproject/Makefile-${CND
 	${MP_CC} $(MP_EXTRA_CC_PRE)  ../../lib/pid/pid.c  -o ${OBJECTDIR}/_ext/957554017/pid.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/957554017/pid.o.d"        -g -omf=elf -mlarge-code -mlarge-data -O1 -I"..\..\lib\FreeRTOS" -I"..\..\lib" -I"..\..\lib\button" -I"..\..\lib\adc" -I".." -I"..\..\lib\i2c" -I"..\..\lib\bmp085" -I"..\..\lib\hmc5843" -I"..\..\lib\max7456" -I"..\..\lib\matrix" -I"..\..\lib\quaternion" -I"..\..\lib\pid" -I"..\..\lib\pwm_in" -I"..\..\lib\led" -I"..\..\lib\ppm_in" -I"..\..\lib\uart2" -I"..\..\lib\uart1_queue" -I"..\..\lib\servo" -I"..\..\lib\scp1000" -I"..\..\lib\microcontroller" -I"..\..\lib\gps" -I"..\..\lib\dataflash" -DMPLAB_DSPIC_PORT -DENABLE_QUADROCOPTER -msmart-io=1 -Wall -msfr-warn=off
 	@${FIXDEPS} "${OBJECTDIR}/_ext/957554017/pid.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
 	
+${OBJECTDIR}/_ext/957554017/pid_q16.o: ../../lib/pid/pid_q16.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/_ext/957554017 
+	@${RM} ${OBJECTDIR}/_ext/957554017/pid_q16.o.d 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  ../../lib/pid/pid_q16.c  -o ${OBJECTDIR}/_ext/957554017/pid_q16.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/957554017/pid_q16.o.d"        -g -omf=elf -mlarge-code -mlarge-data -O1 -I"..\..\lib\FreeRTOS" -I"..\..\lib" -I"..\..\lib\button" -I"..\..\lib\adc" -I".." -I"..\..\lib\i2c" -I"..\..\lib\bmp085" -I"..\..\lib\hmc5843" -I"..\..\lib\max7456" -I"..\..\lib\matrix" -I"..\..\lib\quaternion" -I"..\..\lib\pid" -I"..\..\lib\pwm_in" -I"..\..\lib\led" -I"..\..\lib\ppm_in" -I"..\..\lib\uart2" -I"..\..\lib\uart1_queue" -I"..\..\lib\servo" -I"..\..\lib\scp1000" -I"..\..\lib\microcontroller" -I"..\..\lib\gps" -I"..\..\lib\dataflash" -DMPLAB_DSPIC_PORT -DENABLE_QUADROCOPTER -msmart-io=1 -Wall -msfr-warn=off
+	@${FIXDEPS} "${OBJECTDIR}/_ext/957554017/pid_q16.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/_ext/118348622/fastmath.o: ../../lib/fastmath/fastmath.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/_ext/118348622 
+	@${RM} ${OBJECTDIR}/_ext/118348622/fastmath.o.d 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  ../../lib/fastmath/fastmath.c  -o ${OBJECTDIR}/_ext/118348622/fastmath.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/118348622/fastmath.o.d"        -g -omf=elf -mlarge-code -mlarge-data -O1 -I"..\..\lib\FreeRTOS" -I"..\..\lib" -I"..\..\lib\button" -I"..\..\lib\adc" -I".." -I"..\..\lib\i2c" -I"..\..\lib\bmp085" -I"..\..\lib\hmc5843" -I"..\..\lib\max7456" -I"..\..\lib\matrix" -I"..\..\lib\quaternion" -I"..\..\lib\pid" -I"..\..\lib\pwm_in" -I"..\..\lib\led" -I"..\..\lib\ppm_in" -I"..\..\lib\uart2" -I"..\..\lib\uart1_queue" -I"..\..\lib\servo" -I"..\..\lib\scp1000" -I"..\..\lib\microcontroller" -I"..\..\lib\gps" -I"..\..\lib\dataflash" -DMPLAB_DSPIC_PORT -DENABLE_QUADROCOPTER -msmart-io=1 -Wall -msfr-warn=off
+	@${FIXDEPS} "${OBJECTDIR}/_ext/118348622/fastmath.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/_ext/1074671951/crc16.o: ../../lib/crc16/crc16.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/_ext/1074671951 
+	@${RM} ${OBJECTDIR}/_ext/1074671951/crc16.o.d 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  ../../lib/crc16/crc16.c  -o ${OBJECTDIR}/_ext/1074671951/crc16.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/1074671951/crc16.o.d"        -g -omf=elf -mlarge-code -mlarge-data -O1 -I"..\..\lib\FreeRTOS" -I"..\..\lib" -I"..\..\lib\button" -I"..\..\lib\adc" -I".." -I"..\..\lib\i2c" -I"..\..\lib\bmp085" -I"..\..\lib\hmc5843" -I"..\..\lib\max7456" -I"..\..\lib\matrix" -I"..\..\lib\quaternion" -I"..\..\lib\pid" -I"..\..\lib\pwm_in" -I"..\..\lib\led" -I"..\..\lib\ppm_in" -I"..\..\lib\uart2" -I"..\..\lib\uart1_queue" -I"..\..\lib\servo" -I"..\..\lib\scp1000" -I"..\..\lib\microcontroller" -I"..\..\lib\gps" -I"..\..\lib\dataflash" -DMPLAB_DSPIC_PORT -DENABLE_QUADROCOPTER -msmart-io=1 -Wall -msfr-warn=off
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1074671951/crc16.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/_ext/1284920371/logpack.o: ../../lib/logpack/logpack.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/_ext/1284920371 
+	@${RM} ${OBJECTDIR}/_ext/1284920371/logpack.o.d 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  ../../lib/logpack/logpack.c  -o ${OBJECTDIR}/_ext/1284920371/logpack.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/1284920371/logpack.o.d"        -g -omf=elf -mlarge-code -mlarge-data -O1 -I"..\..\lib\FreeRTOS" -I"..\..\lib" -I"..\..\lib\button" -I"..\..\lib\adc" -I".." -I"..\..\lib\i2c" -I"..\..\lib\bmp085" -I"..\..\lib\hmc5843" -I"..\..\lib\max7456" -I"..\..\lib\matrix" -I"..\..\lib\quaternion" -I"..\..\lib\pid" -I"..\..\lib\pwm_in" -I"..\..\lib\led" -I"..\..\lib\ppm_in" -I"..\..\lib\uart2" -I"..\..\lib\uart1_queue" -I"..\..\lib\servo" -I"..\..\lib\scp1000" -I"..\..\lib\microcontroller" -I"..\..\lib\gps" -I"..\..\lib\dataflash" -DMPLAB_DSPIC_PORT -DENABLE_QUADROCOPTER -msmart-io=1 -Wall -msfr-warn=off
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1284920371/logpack.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/_ext/1284920371/logschema.o: ../../lib/logpack/logschema.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/_ext/1284920371 
+	@${RM} ${OBJECTDIR}/_ext/1284920371/logschema.o.d 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  ../../lib/logpack/logschema.c  -o ${OBJECTDIR}/_ext/1284920371/logschema.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/1284920371/logschema.o.d"        -g -omf=elf -mlarge-code -mlarge-data -O1 -I"..\..\lib\FreeRTOS" -I"..\..\lib" -I"..\..\lib\button" -I"..\..\lib\adc" -I".." -I"..\..\lib\i2c" -I"..\..\lib\bmp085" -I"..\..\lib\hmc5843" -I"..\..\lib\max7456" -I"..\..\lib\matrix" -I"..\..\lib\quaternion" -I"..\..\lib\pid" -I"..\..\lib\pwm_in" -I"..\..\lib\led" -I"..\..\lib\ppm_in" -I"..\..\lib\uart2" -I"..\..\lib\uart1_queue" -I"..\..\lib\servo" -I"..\..\lib\scp1000" -I"..\..\lib\microcontroller" -I"..\..\lib\gps" -I"..\..\lib\dataflash" -DMPLAB_DSPIC_PORT -DENABLE_QUADROCOPTER -msmart-io=1 -Wall -msfr-warn=off
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1284920371/logschema.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/_ext/726865999/numfmt.o: ../../lib/numfmt/numfmt.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/_ext/726865999 
+	@${RM} ${OBJECTDIR}/_ext/726865999/numfmt.o.d 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  ../../lib/numfmt/numfmt.c  -o ${OBJECTDIR}/_ext/726865999/numfmt.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/726865999/numfmt.o.d"        -g -omf=elf -mlarge-code -mlarge-data -O1 -I"..\..\lib\FreeRTOS" -I"..\..\lib" -I"..\..\lib\button" -I"..\..\lib\adc" -I".." -I"..\..\lib\i2c" -I"..\..\lib\bmp085" -I"..\..\lib\hmc5843" -I"..\..\lib\max7456" -I"..\..\lib\matrix" -I"..\..\lib\quaternion" -I"..\..\lib\pid" -I"..\..\lib\pwm_in" -I"..\..\lib\led" -I"..\..\lib\ppm_in" -I"..\..\lib\uart2" -I"..\..\lib\uart1_queue" -I"..\..\lib\servo" -I"..\..\lib\scp1000" -I"..\..\lib\microcontroller" -I"..\..\lib\gps" -I"..\..\lib\dataflash" -DMPLAB_DSPIC_PORT -DENABLE_QUADROCOPTER -msmart-io=1 -Wall -msfr-warn=off
+	@${FIXDEPS} "${OBJECTDIR}/_ext/726865999/numfmt.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/_ext/815200446/cmdtable.o: ../../lib/cmdtable/cmdtable.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/_ext/815200446 
+	@${RM} ${OBJECTDIR}/_ext/815200446/cmdtable.o.d 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  ../../lib/cmdtable/cmdtable.c  -o ${OBJECTDIR}/_ext/815200446/cmdtable.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/815200446/cmdtable.o.d"        -g -omf=elf -mlarge-code -mlarge-data -O1 -I"..\..\lib\FreeRTOS" -I"..\..\lib" -I"..\..\lib\button" -I"..\..\lib\adc" -I".." -I"..\..\lib\i2c" -I"..\..\lib\bmp085" -I"..\..\lib\hmc5843" -I"..\..\lib\max7456" -I"..\..\lib\matrix" -I"..\..\lib\quaternion" -I"..\..\lib\pid" -I"..\..\lib\pwm_in" -I"..\..\lib\led" -I"..\..\lib\ppm_in" -I"..\..\lib\uart2" -I"..\..\lib\uart1_queue" -I"..\..\lib\servo" -I"..\..\lib\scp1000" -I"..\..\lib\microcontroller" -I"..\..\lib\gps" -I"..\..\lib\dataflash" -DMPLAB_DSPIC_PORT -DENABLE_QUADROCOPTER -msmart-io=1 -Wall -msfr-warn=off
+	@${FIXDEPS} "${OBJECTDIR}/_ext/815200446/cmdtable.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
 ${OBJECTDIR}/_ext/674232159/ppm_in.o: ../../lib/ppm_in/ppm_in.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} ${OBJECTDIR}/_ext/674232159 
 	@${RM} ${OBJECTDIR}/_ext/674232159/ppm_in.o.d 
@@ -502,6 +616,12 @@ ${OBJECTDIR}/_ext/1472/communication_csv.o: ../communication_csv.c  nbproject/Ma
 	${MP_CC} $(MP_EXTRA_CC_PRE)  ../communication_csv.c  -o ${OBJECTDIR}/_ext/1472/communication_csv.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/1472/communication_csv.o.d"        -g -omf=elf -mlarge-code -mlarge-data -O1 -I"..\..\lib\FreeRTOS" -I"..\..\lib" -I"..\..\lib\button" -I"..\..\lib\adc" -I".." -I"..\..\lib\i2c" -I"..\..\lib\bmp085" -I"..\..\lib\hmc5843" -I"..\..\lib\max7456" -I"..\..\lib\matrix" -I"..\..\lib\quaternion" -I"..\..\lib\pid" -I"..\..\lib\pwm_in" -I"..\..\lib\led" -I"..\..\lib\ppm_in" -I"..\..\lib\uart2" -I"..\..\lib\uart1_queue" -I"..\..\lib\servo" -I"..\..\lib\scp1000" -I"..\..\lib\microcontroller" -I"..\..\lib\gps" -I"..\..\lib\dataflash" -DMPLAB_DSPIC_PORT -DENABLE_QUADROCOPTER -msmart-io=1 -Wall -msfr-warn=off
 	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/communication_csv.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
 	
+${OBJECTDIR}/_ext/1472/communication_binary.o: ../communication_binary.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/_ext/1472 
+	@${RM} ${OBJECTDIR}/_ext/1472/communication_binary.o.d 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  ../communication_binary.c  -o ${OBJECTDIR}/_ext/1472/communication_binary.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/1472/communication_binary.o.d"        -g -omf=elf -mlarge-code -mlarge-data -O1 -I"..\..\lib\FreeRTOS" -I"..\..\lib" -I"..\..\lib\button" -I"..\..\lib\adc" -I".." -I"..\..\lib\i2c" -I"..\..\lib\bmp085" -I"..\..\lib\hmc5843" -I"..\..\lib\max7456" -I"..\..\lib\matrix" -I"..\..\lib\quaternion" -I"..\..\lib\pid" -I"..\..\lib\pwm_in" -I"..\..\lib\led" -I"..\..\lib\ppm_in" -I"..\..\lib\uart2" -I"..\..\lib\uart1_queue" -I"..\..\lib\servo" -I"..\..\lib\scp1000" -I"..\..\lib\microcontroller" -I"..\..\lib\gps" -I"..\..\lib\dataflash" -DMPLAB_DSPIC_PORT -DENABLE_QUADROCOPTER -msmart-io=1 -Wall -msfr-warn=off
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/communication_binary.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
 ${OBJECTDIR}/_ext/1472/configuration.o: ../configuration.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} ${OBJECTDIR}/_ext/1472 
 	@${RM} ${OBJECTDIR}/_ext/1472/configuration.o.d 
@@ -562,6 +682,18 @@ ${OBJECTDIR}/_ext/1472/task_control.o: ../task_control.c  nbproject/Makefile-${C
 	${MP_CC} $(MP_EXTRA_CC_PRE)  ../task_control.c  -o ${OBJECTDIR}/_ext/1472/task_control.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/1472/task_control.o.d"        -g -omf=elf -mlarge-code -mlarge-data -O1 -I"..\..\lib\FreeRTOS" -I"..\..\lib" -I"..\..\lib\button" -I"..\..\lib\adc" -I".." -I"..\..\lib\i2c" -I"..\..\lib\bmp085" -I"..\..\lib\hmc5843" -I"..\..\lib\max7456" -I"..\..\lib\matrix" -I"..\..\lib\quaternion" -I"..\..\lib\pid" -I"..\..\lib\pwm_in" -I"..\..\lib\led" -I"..\..\lib\ppm_in" -I"..\..\lib\uart2" -I"..\..\lib\uart1_queue" -I"..\..\lib\servo" -I"..\..\lib\scp1000" -I"..\..\lib\microcontroller" -I"..\..\lib\gps" -I"..\..\lib\dataflash" -DMPLAB_DSPIC_PORT -DENABLE_QUADROCOPTER -msmart-io=1 -Wall -msfr-warn=off
 	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/task_control.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
 	
+${OBJECTDIR}/_ext/1472/control_mix.o: ../control_mix.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/_ext/1472 
+	@${RM} ${OBJECTDIR}/_ext/1472/control_mix.o.d 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  ../control_mix.c  -o ${OBJECTDIR}/_ext/1472/control_mix.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/1472/control_mix.o.d"        -g -omf=elf -mlarge-code -mlarge-data -O1 -I"..\..\lib\FreeRTOS" -I"..\..\lib" -I"..\..\lib\button" -I"..\..\lib\adc" -I".." -I"..\..\lib\i2c" -I"..\..\lib\bmp085" -I"..\..\lib\hmc5843" -I"..\..\lib\max7456" -I"..\..\lib\matrix" -I"..\..\lib\quaternion" -I"..\..\lib\pid" -I"..\..\lib\pwm_in" -I"..\..\lib\led" -I"..\..\lib\ppm_in" -I"..\..\lib\uart2" -I"..\..\lib\uart1_queue" -I"..\..\lib\servo" -I"..\..\lib\scp1000" -I"..\..\lib\microcontroller" -I"..\..\lib\gps" -I"..\..\lib\dataflash" -DMPLAB_DSPIC_PORT -DENABLE_QUADROCOPTER -msmart-io=1 -Wall -msfr-warn=off
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/control_mix.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/_ext/1472/datalogger_records.o: ../datalogger_records.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/_ext/1472 
+	@${RM} ${OBJECTDIR}/_ext/1472/datalogger_records.o.d 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  ../datalogger_records.c  -o ${OBJECTDIR}/_ext/1472/datalogger_records.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/1472/datalogger_records.o.d"        -g -omf=elf -mlarge-code -mlarge-data -O1 -I"..\..\lib\FreeRTOS" -I"..\..\lib" -I"..\..\lib\button" -I"..\..\lib\adc" -I".." -I"..\..\lib\i2c" -I"..\..\lib\bmp085" -I"..\..\lib\hmc5843" -I"..\..\lib\max7456" -I"..\..\lib\matrix" -I"..\..\lib\quaternion" -I"..\..\lib\pid" -I"..\..\lib\pwm_in" -I"..\..\lib\led" -I"..\..\lib\ppm_in" -I"..\..\lib\uart2" -I"..\..\lib\uart1_queue" -I"..\..\lib\servo" -I"..\..\lib\scp1000" -I"..\..\lib\microcontroller" -I"..\..\lib\gps" -I"..\..\lib\dataflash" -DMPLAB_DSPIC_PORT -DENABLE_QUADROCOPTER -msmart-io=1 -Wall -msfr-warn=off
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/datalogger_records.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
 ${OBJECTDIR}/_ext/1472/task_sensors_analog.o: ../task_sensors_analog.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} ${OBJECTDIR}/_ext/1472 
 	@${RM} ${OBJECTDIR}/_ext/1472/task_sensors_analog.o.d 
@@ -580,6 +712,12 @@ ${OBJECTDIR}/_ext/1472/task_sensors_mpu6000.o: ../task_sensors_mpu6000.c  nbproj
 	${MP_CC} $(MP_EXTRA_CC_PRE)  ../task_sensors_mpu6000.c  -o ${OBJECTDIR}/_ext/1472/task_sensors_mpu6000.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/1472/task_sensors_mpu6000.o.d"        -g -omf=elf -mlarge-code -mlarge-data -O1 -I"..\..\lib\FreeRTOS" -I"..\..\lib" -I"..\..\lib\button" -I"..\..\lib\adc" -I".." -I"..\..\lib\i2c" -I"..\..\lib\bmp085" -I"..\..\lib\hmc5843" -I"..\..\lib\max7456" -I"..\..\lib\matrix" -I"..\..\lib\quaternion" -I"..\..\lib\pid" -I"..\..\lib\pwm_in" -I"..\..\lib\led" -I"..\..\lib\ppm_in" -I"..\..\lib\uart2" -I"..\..\lib\uart1_queue" -I"..\..\lib\servo" -I"..\..\lib\scp1000" -I"..\..\lib\microcontroller" -I"..\..\lib\gps" -I"..\..\lib\dataflash" -DMPLAB_DSPIC_PORT -DENABLE_QUADROCOPTER -msmart-io=1 -Wall -msfr-warn=off
 	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/task_sensors_mpu6000.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
 	
+${OBJECTDIR}/_ext/1472/telemetry_scheduler.o: ../telemetry_scheduler.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/_ext/1472 
+	@${RM} ${OBJECTDIR}/_ext/1472/telemetry_scheduler.o.d 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  ../telemetry_scheduler.c  -o ${OBJECTDIR}/_ext/1472/telemetry_scheduler.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/1472/telemetry_scheduler.o.d"        -g -omf=elf -mlarge-code -mlarge-data -O1 -I"..\..\lib\FreeRTOS" -I"..\..\lib" -I"..\..\lib\button" -I"..\..\lib\adc" -I".." -I"..\..\lib\i2c" -I"..\..\lib\bmp085" -I"..\..\lib\hmc5843" -I"..\..\lib\max7456" -I"..\..\lib\matrix" -I"..\..\lib\quaternion" -I"..\..\lib\pid" -I"..\..\lib\pwm_in" -I"..\..\lib\led" -I"..\..\lib\ppm_in" -I"..\..\lib\uart2" -I"..\..\lib\uart1_queue" -I"..\..\lib\servo" -I"..\..\lib\scp1000" -I"..\..\lib\microcontroller" -I"..\..\lib\gps" -I"..\..\lib\dataflash" -DMPLAB_DSPIC_PORT -DENABLE_QUADROCOPTER -msmart-io=1 -Wall -msfr-warn=off
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/telemetry_scheduler.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
 ${OBJECTDIR}/_ext/1472/handler_maximum_range.o: ../handler_maximum_range.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} ${OBJECTDIR}/_ext/1472 
 	@${RM} ${OBJECTDIR}/_ext/1472/handler_maximum_range.o.d 
@@ -598,6 +736,12 @@ ${OBJECTDIR}/_ext/1472/ahrs_kalman_2x3.o: ../ahrs_kalman_2x3.c  nbproject/Makefi
 	${MP_CC} $(MP_EXTRA_CC_PRE)  ../ahrs_kalman_2x3.c  -o ${OBJECTDIR}/_ext/1472/ahrs_kalman_2x3.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/1472/ahrs_kalman_2x3.o.d"        -g -omf=elf -mlarge-code -mlarge-data -O1 -I"..\..\lib\FreeRTOS" -I"..\..\lib" -I"..\..\lib\button" -I"..\..\lib\adc" -I".." -I"..\..\lib\i2c" -I"..\..\lib\bmp085" -I"..\..\lib\hmc5843" -I"..\..\lib\max7456" -I"..\..\lib\matrix" -I"..\..\lib\quaternion" -I"..\..\lib\pid" -I"..\..\lib\pwm_in" -I"..\..\lib\led" -I"..\..\lib\ppm_in" -I"..\..\lib\uart2" -I"..\..\lib\uart1_queue" -I"..\..\lib\servo" -I"..\..\lib\scp1000" -I"..\..\lib\microcontroller" -I"..\..\lib\gps" -I"..\..\lib\dataflash" -DMPLAB_DSPIC_PORT -DENABLE_QUADROCOPTER -msmart-io=1 -Wall -msfr-warn=off
 	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/ahrs_kalman_2x3.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
 	
+${OBJECTDIR}/_ext/1472/ahrs_kalman_2x3_q16.o: ../ahrs_kalman_2x3_q16.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/_ext/1472 
+	@${RM} ${OBJECTDIR}/_ext/1472/ahrs_kalman_2x3_q16.o.d 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  ../ahrs_kalman_2x3_q16.c  -o ${OBJECTDIR}/_ext/1472/ahrs_kalman_2x3_q16.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/1472/ahrs_kalman_2x3_q16.o.d"        -g -omf=elf -mlarge-code -mlarge-data -O1 -I"..\..\lib\FreeRTOS" -I"..\..\lib" -I"..\..\lib\button" -I"..\..\lib\adc" -I".." -I"..\..\lib\i2c" -I"..\..\lib\bmp085" -I"..\..\lib\hmc5843" -I"..\..\lib\max7456" -I"..\..\lib\matrix" -I"..\..\lib\quaternion" -I"..\..\lib\pid" -I"..\..\lib\pwm_in" -I"..\..\lib\led" -I"..\..\lib\ppm_in" -I"..\..\lib\uart2" -I"..\..\lib\uart1_queue" -I"..\..\lib\servo" -I"..\..\lib\scp1000" -I"..\..\lib\microcontroller" -I"..\..\lib\gps" -I"..\..\lib\dataflash" -DMPLAB_DSPIC_PORT -DENABLE_QUADROCOPTER -msmart-io=1 -Wall -msfr-warn=off
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/ahrs_kalman_2x3_q16.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
 endif
 
 # ------------------------------------------------------------------------------------
@@ -33,6 +33,7 @@
 
 // rtos_pilot includes
 #include "task_control.h"
+#include "control_mix.h"
 #include "task_sensors_analog.h"
 #include "task_sensors_mpu6000.h"
 #include "communication.h"
@@ -66,8 +67,8 @@ int main()
 	printf("Limited version");
 #endif
 	
-	printf(" [%s %s, config: %dB, logline: %dB, navigation: %dB, double: %dB]\r\n\r\n",
-                __DATE__, __TIME__, sizeof(struct Configuration), sizeof(struct LogLine), sizeof(gluonscript_data.codes), sizeof(double));
+	printf(" [%s %s, config: %dB, record: %dB, navigation: %dB, double: %dB]\r\n\r\n",
+                __DATE__, __TIME__, sizeof(struct Configuration), sizeof(union LogRecord), sizeof(gluonscript_data.codes), sizeof(double));
 	
 	microcontroller_reset_type();  // printf out reason of reset; for debugging
 	led_init();
@@ -116,7 +117,7 @@ int main()
 	
 
 	// Create our tasks. 
-	if (config.control.servo_mix == QUADROCOPTER)
+	if (control_mix_is_copter(config.control.servo_mix))
 		xTaskCreate( control_copter_task,            ( signed portCHAR * ) "CControl",      ( configMINIMAL_STACK_SIZE * 3 ), NULL, tskIDLE_PRIORITY + 7, NULL );
 	else
 		xTaskCreate( control_wing_task,            ( signed portCHAR * ) "WControl",      ( configMINIMAL_STACK_SIZE * 3 ), NULL, tskIDLE_PRIORITY + 7, NULL );
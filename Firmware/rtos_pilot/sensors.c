@@ -1,5 +1,68 @@
 
 #include "sensors.h"
+#include "configuration.h"
 
 //! Contains all usefull (processed) sensor data
 struct SensorData sensor_data;
+
+
+/*!
+ *   Converts the raw MPU-6000 readings in sensor_data (acc_x_raw ... gyro_z_raw,
+ *   offset by 32768) to g and rad/s in the aircraft's frame, using the neutral
+ *   values and the board rotation from the configuration.
+ *
+ *   Used by the sensor task and when replaying raw logs.
+ */
+void sensors_mpu6000_scale()
+{
+    if (config.sensors.imu_rotated == 1)  // 90 CCW
+    {
+        sensor_data.acc_y = -((float)config.sensors.acc_x_neutral - (float)sensor_data.acc_x_raw) / 4096.0;
+        sensor_data.acc_x = ((float)sensor_data.acc_y_raw - (float)config.sensors.acc_y_neutral) / 4096.0;
+        sensor_data.acc_z = ((float)config.sensors.acc_z_neutral - (float)sensor_data.acc_z_raw) / 4096.0;
+
+        sensor_data.q = -((float)config.sensors.gyro_x_neutral - (float)sensor_data.gyro_x_raw) * (3.14159 / 180.0 / 32.8);
+        sensor_data.p = ((float)sensor_data.gyro_y_raw - (float)config.sensors.gyro_y_neutral) * (3.14159 / 180.0 / 32.8);
+        sensor_data.r = ((float)config.sensors.gyro_z_neutral - (float)sensor_data.gyro_z_raw) * (3.14159 / 180.0 / 32.8);
+    }
+    else if (config.sensors.imu_rotated == 3)  // 270 CCW
+    {
+        sensor_data.acc_y = ((float)config.sensors.acc_x_neutral - (float)sensor_data.acc_x_raw) / 4096.0;
+        sensor_data.acc_x = -((float)sensor_data.acc_y_raw - (float)config.sensors.acc_y_neutral) / 4096.0;
+        sensor_data.acc_z = ((float)config.sensors.acc_z_neutral - (float)sensor_data.acc_z_raw) / 4096.0;
+
+        sensor_data.q = ((float)config.sensors.gyro_x_neutral - (float)sensor_data.gyro_x_raw) * (3.14159 / 180.0 / 32.8);
+        sensor_data.p = -((float)sensor_data.gyro_y_raw - (float)config.sensors.gyro_y_neutral) * (3.14159 / 180.0 / 32.8);
+        sensor_data.r = ((float)config.sensors.gyro_z_neutral - (float)sensor_data.gyro_z_raw) * (3.14159 / 180.0 / 32.8);
+    }
+    else if (config.sensors.imu_rotated == 2)  // 180
+    {
+        sensor_data.acc_x = ((float)sensor_data.acc_x_raw - (float)config.sensors.acc_x_neutral) / 4096.0;
+        sensor_data.acc_y = ((float)config.sensors.acc_y_neutral - (float)sensor_data.acc_y_raw) / 4096.0;
+        sensor_data.acc_z = ((float)config.sensors.acc_z_neutral - (float)sensor_data.acc_z_raw) / 4096.0;
+
+        sensor_data.p = ((float)sensor_data.gyro_x_raw - (float)config.sensors.gyro_x_neutral) * (3.14159 / 180.0 / 32.8);
+        sensor_data.q = ((float)config.sensors.gyro_y_neutral - (float)sensor_data.gyro_y_raw) * (3.14159 / 180.0 / 32.8);
+        sensor_data.r = ((float)config.sensors.gyro_z_neutral - (float)sensor_data.gyro_z_raw) * (3.14159 / 180.0 / 32.8);
+    }
+    else if (config.sensors.imu_rotated == 0)
+    {
+        sensor_data.acc_x = ((float)config.sensors.acc_x_neutral - (float)sensor_data.acc_x_raw) / 4096.0;
+        sensor_data.acc_y = ((float)sensor_data.acc_y_raw - (float)config.sensors.acc_y_neutral) / 4096.0;
+        sensor_data.acc_z = ((float)config.sensors.acc_z_neutral - (float)sensor_data.acc_z_raw) / 4096.0;
+
+        sensor_data.p = ((float)config.sensors.gyro_x_neutral - (float)sensor_data.gyro_x_raw) * (3.14159 / 180.0 / 32.8);
+        sensor_data.q = ((float)sensor_data.gyro_y_raw - (float)config.sensors.gyro_y_neutral) * (3.14159 / 180.0 / 32.8);
+        sensor_data.r = ((float)config.sensors.gyro_z_neutral - (float)sensor_data.gyro_z_raw) * (3.14159 / 180.0 / 32.8);
+    }
+    else if (config.sensors.imu_rotated == 4)  // sideways with top on the left
+    {
+        sensor_data.acc_x = ((float)config.sensors.acc_x_neutral - (float)sensor_data.acc_x_raw) / 4096.0;
+        sensor_data.acc_z = ((float)sensor_data.acc_y_raw - (float)config.sensors.acc_y_neutral) / 4096.0;
+        sensor_data.acc_y = ((float)config.sensors.acc_z_neutral - (float)sensor_data.acc_z_raw) / 4096.0;
+
+        sensor_data.p = ((float)sensor_data.gyro_x_raw - (float)config.sensors.gyro_x_neutral) * (3.14159 / 180.0 / 32.8);
+        sensor_data.r = ((float)sensor_data.gyro_y_raw - (float)config.sensors.gyro_y_neutral) * (3.14159 / 180.0 / 32.8);
+        sensor_data.q = ((float)sensor_data.gyro_z_raw - (float)config.sensors.gyro_z_neutral) * (3.14159 / 180.0 / 32.8);
+    }
+}
@@ -48,4 +48,6 @@ struct SensorConfig
 
 extern struct SensorData sensor_data;
 
+void sensors_mpu6000_scale();
+
 #endif // SENSORS_ANALOG_H
@@ -29,11 +29,15 @@
 #include "ppm_in/ppm_in.h"
 #include "servo/servo.h"
 #include "pid/pid.h"
+#ifdef CONTROL_FIXED_POINT
+#include "pid/pid_q16.h"
+#endif
 #include "button/button.h"
 #include "uart1_queue/uart1_queue.h"
 
 // rtos_pilot includes
 #include "task_control.h"
+#include "control_mix.h"
 #include "configuration.h"
 #include "sensors.h"
 #include "handler_navigation.h"
@@ -52,11 +56,14 @@ int servo_out[6];
 //! Different outputs before mixing. Set by any of the 3 control methods, and used by the servo mixing type.
 int elevator_out = 0, aileron_out = 0, yaw_out = 0, motor_out = 0;
 
-//! Mix xyz_out to servo_out
-void control_mix_out();
-
 //! Contains the currect state of the control loop
 struct ControlState control_state;
+
+#ifdef CONTROL_FIXED_POINT
+//! The pitch2elevator and roll2aileron loops of control_wing_desired_to_servos()
+static struct pid_q16_bank attitude_pid;
+static int attitude_pid_valid = 0;
+#endif
       
 	          
 
@@ -79,6 +86,7 @@ void control_init()
 			config.control.servo_max[i] = 2000;
 			config.control.servo_min[i] = 1000;
 		}	
+		control_mix_compile();
 		
 		// The current position of the sticks on the RC-transmitter are 
 		// saved as the neutral values
@@ -108,12 +116,26 @@ void control_init()
         // servo settings & channel neutral settings are now loaded from flash and not determined at startup!
     }
 	
+	control_mix_compile();
+	
 	if (config.control.cruising_speed_ms < 0.5)  // not valid? change to 18 to avoid /0
 		config.control.cruising_speed_ms = 18.0;  
 }
 
 
 
+/*!
+ *   To be called after the gains of a pid of the configuration changed. The
+ *   next control_wing_desired_to_servos() loads them again.
+ */
+void control_pid_changed()
+{
+#ifdef CONTROL_FIXED_POINT
+	attitude_pid_valid = 0;
+#endif
+}
+
+
 /******************************************************************************
  *                                                                            *
  *                       Part for fixed-wing aircraft                         *
@@ -386,10 +408,36 @@ void control_wing_desired_to_servos(float dt)
 	// compensate the loss in lift
 	//control_state.desired_pitch += (1.0/cosf(sensor_data.roll) - 1.0)*0.25; // (0.5: 12� up at 45� roll)
 	
+#ifdef CONTROL_FIXED_POINT
+	{
+		q16 error[2], out[2];
+
+		if (attitude_pid.loops == 0)
+		{
+			// the outputs are limited so elevator_out and aileron_out fit in an int
+			pid_q16_init(&attitude_pid, dt);
+			pid_q16_add(&attitude_pid, &config.control.pid_pitch2elevator, -50.0f, 50.0f);
+			pid_q16_add(&attitude_pid, &config.control.pid_roll2aileron, -50.0f, 50.0f);
+		}
+		else if (! attitude_pid_valid)
+		{
+			pid_q16_set_gains(&attitude_pid, 0, &config.control.pid_pitch2elevator);
+			pid_q16_set_gains(&attitude_pid, 1, &config.control.pid_roll2aileron);
+		}
+		attitude_pid_valid = 1;
+
+		error[0] = q16_from_float(control_state.desired_pitch - sensor_data.pitch);
+		error[1] = q16_from_float(control_state.desired_roll - sensor_data.roll);
+		pid_q16_update_all(&attitude_pid, error, out);
+		elevator_out_radians = q16_to_float(out[0]);
+		aileron_out_radians = q16_to_float(out[1]);
+	}
+#else
 	elevator_out_radians = pid_update(&config.control.pid_pitch2elevator, 
 	                                         control_state.desired_pitch - sensor_data.pitch, dt);
 	aileron_out_radians = pid_update(&config.control.pid_roll2aileron, 
 	                                        control_state.desired_roll - sensor_data.roll, dt);
+#endif
 	yaw_out = ppm.channel[config.control.channel_yaw] - config.control.channel_neutral[config.control.channel_yaw];
 
 	
@@ -554,212 +602,3 @@ void control_copter_desired_to_servos(float dt)
 
 	control_mix_out();
 }	
-
-
-
-
-
-
-
-/*!
- *   Mixes variables aileron_out and elevator_out into correct servo positions, according to the configured mixing type.
- * 
- *   Input: 
- *      aileron_out: > 0 means right [-500..500]
- *      elevator_out: > 0 means up   [-500..500]
- *      motor_out: > 0 means on/more gas [0..1000]
- *
- */
-void control_mix_out()
-{
-	int i;
-	int aileron_out_left, aileron_out_right;
-	int number_of_controlled_channels = 4;
-	
-	// aileron differential
-	if (aileron_out > 0)
-	{
-		aileron_out_right = aileron_out + (aileron_out / 10) * config.control.aileron_differential;
-		aileron_out_left = aileron_out - (aileron_out / 10) * config.control.aileron_differential;
-	} 
-	else
-	{
-		aileron_out_right = aileron_out - (aileron_out / 10) * config.control.aileron_differential;
-		aileron_out_left = aileron_out + (aileron_out / 10) * config.control.aileron_differential;		
-	}
-	
-	// no differential
-	//aileron_out_right = aileron_out;
-	//aileron_out_left = aileron_out;
-		
-	
-	switch(config.control.servo_mix)
-	{
-		case DELTA_PLUS:
-			number_of_controlled_channels = 5;
-            if (config.control.reverse_servo5)
-				servo_out[4] = (int)(-sensor_data.roll*636.0) + 1500;//config.control.servo_neutral[6];
-			else
-				servo_out[4] = +(int)(sensor_data.roll*636.0) + 1500;//config.control.servo_neutral[6];
-				
-			if (config.control.reverse_servo1)
-				servo_out[0] = +aileron_out_right + elevator_out + config.control.servo_neutral[0];
-			else
-				servo_out[0] = -aileron_out_right - elevator_out + config.control.servo_neutral[0];
-				
-			if (config.control.reverse_servo2)
-				servo_out[1] = +aileron_out_left - elevator_out + config.control.servo_neutral[1];
-			else
-				servo_out[1] = -aileron_out_left + elevator_out + config.control.servo_neutral[1];
-				
-			if (config.control.reverse_servo4)
-				servo_out[3] = -motor_out + config.control.servo_neutral[3];
-			else 
-				servo_out[3] = motor_out + config.control.servo_neutral[3];
-
-			break;
-		case DELTA_MIN:
-			number_of_controlled_channels = 5;
-            if (config.control.reverse_servo5)
-				servo_out[4] = (int)(-sensor_data.roll*636.0) + 1500;//config.control.servo_neutral[6];
-			else
-				servo_out[4] = +(int)(sensor_data.roll*636.0) + 1500;//config.control.servo_neutral[6];
-				
-			if (config.control.reverse_servo1)
-				servo_out[0] = +aileron_out_right - elevator_out + config.control.servo_neutral[0];
-			else
-				servo_out[0] = -aileron_out_right + elevator_out + config.control.servo_neutral[0];
-				
-			if (config.control.reverse_servo2)
-				servo_out[1] = +aileron_out_left + elevator_out + config.control.servo_neutral[1];
-			else
-				servo_out[1] = -aileron_out_left - elevator_out + config.control.servo_neutral[1];
-			
-			if (config.control.reverse_servo4)
-				servo_out[3] = -motor_out + config.control.servo_neutral[3];
-			else 
-				servo_out[3] = motor_out + config.control.servo_neutral[3];
-
-			break;
-		case QUADROCOPTER:
-		{
-			number_of_controlled_channels = 4;
-			/*          >
-			 *          0
-			 *      < /   \ <
-			 *      3       1        FRONT
-			 *        \ > /
-			 *          2
-			 *    
-			 */
-			
-			/*if (motor_out < 100) // about zero throttle
-			{
-				servo_out[0] = config.control.servo_neutral[3];
-				servo_out[1] = config.control.servo_neutral[3];
-				servo_out[2] = config.control.servo_neutral[3];
-				servo_out[3] = config.control.servo_neutral[3];
-			} 
-			else*/
-			{	
-				// channel[motor] neutral = 1200
-				// servo_neutral(init) = 1500
-				// motor_out(init) = 1200 - 1500 = -300 -> in mix -> 
-				// servo_neutral(mix) = 1200
-				
-				// P:0.4 (convergeert traag), D: 0.45 (0.6 oscilleert)
-
-				servo_out[0] = motor_out + aileron_out/5 + yaw_out/5 + config.control.servo_neutral[0];
-				servo_out[1] = motor_out + elevator_out/5 - yaw_out/5 + config.control.servo_neutral[1];
-				servo_out[2] = motor_out - aileron_out/5  + yaw_out/5 + config.control.servo_neutral[2];
-				servo_out[3] = motor_out - elevator_out/5 - yaw_out/5 + config.control.servo_neutral[3];
-				//safety:
-				if (motor_out < 100)
-				{
-					servo_out[0] = 0;
-					servo_out[1] = 0;
-					servo_out[2] = 0;
-					servo_out[3] = 0;
-				}	
-			}
-			break;
-		}	
-		case AILERONS_FLAPERONS:
-			number_of_controlled_channels = 6;
-            if (config.control.reverse_servo6)
-				servo_out[5] = (int)(-sensor_data.roll*636.0) + 1500;//config.control.servo_neutral[6];
-			else
-				servo_out[5] = +(int)(sensor_data.roll*636.0) + 1500;//config.control.servo_neutral[6];
-
-			if (config.control.reverse_servo1)
-				servo_out[0] = -aileron_out_right + config.control.servo_neutral[0] + ppm.channel[config.control.channel_yaw] - config.control.channel_neutral[config.control.channel_yaw];
-			else
-				servo_out[0] = +aileron_out_right + config.control.servo_neutral[0] - ppm.channel[config.control.channel_yaw] + config.control.channel_neutral[config.control.channel_yaw];
-
-			if (config.control.reverse_servo2)
-				servo_out[1] = +aileron_out_left + config.control.servo_neutral[1] + ppm.channel[config.control.channel_yaw] - config.control.channel_neutral[config.control.channel_yaw];
-			else
-				servo_out[1] = -aileron_out_left + config.control.servo_neutral[1] - ppm.channel[config.control.channel_yaw] + config.control.channel_neutral[config.control.channel_yaw];
-				
-			if (config.control.reverse_servo3)
-				servo_out[2] = -elevator_out + config.control.servo_neutral[2];
-			else
-				servo_out[2] = elevator_out + config.control.servo_neutral[2];
-				
-			if (config.control.reverse_servo4)
-				servo_out[3] = -motor_out + config.control.servo_neutral[3];
-			else
-				servo_out[3] = motor_out + config.control.servo_neutral[3];
-			
-			if (config.control.reverse_servo5)
-				servo_out[4] = +yaw_out + config.control.servo_neutral[4];
-			else 
-				servo_out[4] = -yaw_out + config.control.servo_neutral[4];
-
-			break;
-		default:  // aileron
-			number_of_controlled_channels = 6;
-            if (config.control.reverse_servo6)
-				servo_out[5] = (int)(-sensor_data.roll*636.0) + 1500;//config.control.servo_neutral[6];
-			else
-				servo_out[5] = +(int)(sensor_data.roll*636.0) + 1500;//config.control.servo_neutral[6];
-
-			if (config.control.reverse_servo1)
-				servo_out[0] = -aileron_out_right + config.control.servo_neutral[0];
-			else
-				servo_out[0] = +aileron_out_right + config.control.servo_neutral[0];
-				
-			if (config.control.reverse_servo2)
-				servo_out[1] = +aileron_out_left + config.control.servo_neutral[1];
-			else
-				servo_out[1] = -aileron_out_left + config.control.servo_neutral[1];
-				
-			if (config.control.reverse_servo3)
-				servo_out[2] = -elevator_out + config.control.servo_neutral[2];
-			else
-				servo_out[2] = elevator_out + config.control.servo_neutral[2];
-				
-			if (config.control.reverse_servo4)
-				servo_out[3] = -motor_out + config.control.servo_neutral[3];
-			else
-				servo_out[3] = motor_out + config.control.servo_neutral[3];
-			
-			if (config.control.reverse_servo5)
-				servo_out[4] = +yaw_out + config.control.servo_neutral[4];
-			else 
-				servo_out[4] = -yaw_out + config.control.servo_neutral[4];
-
-			break;
-	}
-
-	
-	for(i = 0; i < number_of_controlled_channels; i++)
-	{	
-		if (servo_out[i] > config.control.servo_max[i])
-			servo_out[i] = config.control.servo_max[i];
-		if (servo_out[i] < config.control.servo_min[i])
-			servo_out[i] = config.control.servo_min[i];
-
-		servo_set_us(i, servo_out[i]);
-	}
-}
@@ -3,8 +3,38 @@
 
 #include "pid/pid.h"
 
+// Fixed point pitch and roll loops (lib/pid/pid_q16.c) instead of pid_update()
+//#define CONTROL_FIXED_POINT 1
 
-enum MixTypes { AILERON = 0, DELTA_PLUS = 1, DELTA_MIN = 2, QUADROCOPTER  = 3, AILERONS_FLAPERONS = 4};
+enum MixTypes { AILERON = 0, DELTA_PLUS = 1, DELTA_MIN = 2, QUADROCOPTER  = 3, AILERONS_FLAPERONS = 4,
+                V_TAIL = 5, DELTA_RUDDER = 6, HEXACOPTER = 7, CUSTOM = 8 };
+
+#define MIX_OUTPUTS 6        //!< Servo/motor outputs
+
+//! The mixer's input vector
+enum MixInputs
+{
+	MIX_AILERON = 0,        //!< aileron_out
+	MIX_AILERON_DIFF,       //!< |aileron_out / 10|, scaled with the aileron differential
+	MIX_ELEVATOR,           //!< elevator_out
+	MIX_YAW,                //!< yaw_out
+	MIX_MOTOR,              //!< motor_out
+	MIX_ROLL,               //!< Roll angle for a roll stabilized (camera) servo, 636us/rad
+	MIX_RUDDER_STICK,       //!< Yaw stick deflection, straight from the RC receiver
+	MIX_INPUTS
+};
+
+/*!
+ *   The mix of servo_mix CUSTOM, defined by the user (commands ML, MC and
+ *   MX). The coefficients are in percent: 100 is MIX_ONE (see control_mix.h).
+ */
+struct MixCustom
+{
+	signed char coefficient[MIX_OUTPUTS][MIX_INPUTS];
+	unsigned char outputs;
+	unsigned char copter;          //!< See struct MixPreset
+	unsigned char fixed_neutral;   //!< Bit i: output i is centered on 1500us
+};
 
 enum FlightModes { MANUAL = 0, STABILIZED = 1, AUTOPILOT = 2, LOITER = 3, RTL = 4};
 
@@ -71,10 +101,13 @@ struct ControlConfig
     int auto_throttle_p_gain; // pct/m
 
     enum AltitudeModes altitude_mode;
+
+    struct MixCustom custom_mix;   //! Since 0.9
 };	
 
 
 void control_init();
+void control_pid_changed();
 
 void control_copter_task( void *pvParameters );
 void control_wing_task( void *pvParameters );
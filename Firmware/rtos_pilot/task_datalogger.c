@@ -1,16 +1,39 @@
 /*
  *
  *    Dataflash:
- *    [ Page 0 | Page 1 | Page 2 | Page 3 | ... | Page 4096 ]
- *    |  Configuration  | Index+1| Logging .................|
+ *    [ Page 0 | Page 1 | Page 2 | Page 3 | ... | Page 4080 ... Page 4095 ]
+ *    |  Configuration  | Index+1| Logging .....| Journal                 |
  *     
- *     Logging page=    
- *    [ 2Bytes: index number (0 = unused) | Bytes 3...528: Array of LogLines.... ]
+ *     Logging page (LOG_PAGE_PACKED set in the index number)=
+ *    [ 2Bytes: index number | 2Bytes: number of records | Bytes 5...528: records ]
+ *    A record is the id of its type (see datalogger_records.c) followed by
+ *    its fields, packed with lib/logpack: every field as a varint of the
+ *    difference with the previous record of the same type. The first record
+ *    of each type on a page is packed against zeros (a keyframe). A session
+ *    starts with the schema records of all types (lib/logpack/logschema.h), so
+ *    a log can be read without knowing the firmware that wrote it.
  *
+ *     Logging page of older firmware=
+ *    [ 2Bytes: index number (0 = unused) | Bytes 3...528: Array of LogLegacy.... ]
+ *
+ *    Journal: a ring of LogJournal records, each holding the session table and
+ *    the write head. The newest valid one tells datalogger_init() where to
+ *    continue logging, so only a few pages are read at boot instead of every
+ *    log page. The index page is only read when there is no journal yet, to
+ *    take over the sessions logged by older firmware.
+ *
+ *    Writing is double buffered: while one page in RAM fills up, the previous
+ *    one is copied to one of the two SRAM buffers of the AT45DB161D (alternately)
+ *    and programmed into the flash in the background.
+ *
+ *    A format erases the pages instead of writing zeros: an erased page (index
+ *    number 0xFFFF) is unused, just like a page of zeros.
  */
  
  
 #include <stdio.h>
+#include <stddef.h>
+#include <string.h>
 
 // Include all FreeRTOS header files
 #include "FreeRTOS/FreeRTOS.h"
@@ -22,6 +45,7 @@
 #include "microcontroller/microcontroller.h"
 #include "dataflash/dataflash.h"
 #include "uart1_queue/uart1_queue.h"
+#include "logpack/logschema.h"
 
 #include "task_datalogger.h"
 #include "sensors.h"
@@ -32,55 +56,263 @@
 #include "common.h"
 
 
-struct LogIndex datalogger_index_table[MAX_INDEX];
+struct LogJournal datalogger_journal;
+
+#define LOG_JOURNAL_MAGIC  0x4A4C
+#define JOURNAL_PAGES      16   // LOG_JOURNAL_PAGE...LOG_JOURNAL_PAGE+15
+#define JOURNAL_INTERVAL   16   // log pages between two journal records
+
+#define LOG_PAGE_PACKED     0x4000   // flag in the index number of a page
+#define LOG_PAGE_INDEX      0x00FF
+#define PACKED_HEADER_SIZE  4
+#define LOG_PAGE_ERASED     0xFFFF   // index number of an erased page
+
+static union LogRecord last_record[LOG_RECORD_TYPES];   // last record of each type written
+static unsigned char on_page[LOG_RECORD_TYPES];         // 1 when last_record[] is on the page in buffer
+static unsigned char period[LOG_RECORD_TYPES];          // see datalogger_set_period()
+static unsigned char countdown[LOG_RECORD_TYPES];
+static const union LogRecord zero_record;
+static int page_used = PACKED_HEADER_SIZE;              // bytes of buffer in use
+
+static struct LogSchema schema;    // of the session being read out
+static int header_fields = 0;      // fields in the last header printed
+
+static int format_page = 0;         // next page to erase, 0 when not formatting
+
+static int journal_slot = 0;        // slot the next journal record goes to
+static int journal_due = 0;         // 1 when a journal record is to be written
+static int pages_since_journal = 0;
 
-unsigned char buffer[528];  // WARNING: won't work with AT45DB321
+static unsigned char page_buffer[2][528];  // WARNING: won't work with AT45DB321
+unsigned char *buffer = page_buffer[0];    // page being filled, also used to read out pages
+
+static unsigned char *pending_buffer = NULL;  // full page still to be written, NULL if none
+static int pending_page;
+static int pending_size;
+static int pending_loaded = 0;   // 1 when pending_buffer already sits in SRAM buffer "flash_buffer"
+static int flash_buffer = 1;     // SRAM buffer of the AT45DB161D for the next page: 1 or 2
+
+// Pages outside the log that datalogger_write() handed over: the configuration
+// and the flight plan. Shared with the task calling datalogger_write(), only
+// used with xSpiSemaphore taken. Everything else above is only used by
+// datalogger_task().
+#define WRITE_REQUESTS  2
+struct WriteRequest
+{
+	int page;
+	int size;
+	unsigned char *buffer;
+	int due;                     // 1 until datalogger_flush() picks it up
+};
+static struct WriteRequest write_request[WRITE_REQUESTS];
+
+#define SPI_WAIT_TICKS  ( ( portTickType ) 100 / portTICK_RATE_MS )
+#define FORMAT_POLL_TICKS  ( ( portTickType ) 2 / portTICK_RATE_MS )   // a block erase takes 45ms
 
 
 int current_page;
 int current_index = 0;
+int current_line = 0;    // records on the page in buffer
 
 int disable_logging = 0; // used when reading out data
 
 
 xSemaphoreHandle xSpiSemaphore;
 void datalogger_read(int page, int size, unsigned char *buffer);
-void datalogger_write(int page, int size, unsigned char *buffer);
+static int datalogger_flush(portTickType ticks_to_wait);
+static void datalogger_write_schema(int type);
+
+/*!
+ *   The first 2 bytes of a page, little endian like the dsPIC
+ */
+static int get_page_word(const unsigned char *b)
+{
+	return b[0] | (b[1] << 8);
+}
+
+
+static void set_page_word(unsigned char *b, int value)
+{
+	b[0] = value & 0xFF;
+	b[1] = (value >> 8) & 0xFF;
+}
+
+
+/*!
+ *   @return The session of a page, 0 when unused (erased, or zeros from the
+ *           format of older firmware)
+ */
+static int page_index(const unsigned char *page)
+{
+	if (get_page_word(page) == LOG_PAGE_ERASED)
+		return 0;
+	return get_page_word(page) & LOG_PAGE_INDEX;
+}
+
+
+/*!
+ *   Number of pages one journal record takes: 1 with the 528 byte pages of the
+ *   AT45DB161D, more for the bigger struct of the SITL build.
+ */
+static int journal_slot_pages()
+{
+	return (sizeof(struct LogJournal) + PAGE_SIZE - 1) / PAGE_SIZE;
+}
+
+
+static unsigned int journal_checksum()
+{
+	unsigned char *b = (unsigned char*) &datalogger_journal.sequence;
+	unsigned char *end = (unsigned char*) (&datalogger_journal + 1);
+	unsigned int sum = 0;
+
+	while (b < end)
+		sum += *b++;
+	return sum;
+}
+
 
 /*!
- *   Initializes the datalogging (to dataflash) functionality.
+ *   Loads the newest valid journal record: first the header of every slot is
+ *   read, then the complete newest record. A record that was torn by a power
+ *   loss fails the checksum, then the one before it is used.
+ *
+ *   @return 1 when datalogger_journal was loaded
+ */
+static int datalogger_journal_load()
+{
+	int slots = JOURNAL_PAGES / journal_slot_pages();
+	unsigned long below = 0xFFFFFFFF;
+	int attempt, slot;
+
+	for (attempt = 0; attempt < slots; attempt++)
+	{
+		int best = -1;
+		unsigned long best_sequence = 0;
+
+		for (slot = 0; slot < slots; slot++)
+		{
+			datalogger_read(LOG_JOURNAL_PAGE + slot * journal_slot_pages(), offsetof(struct LogJournal, head_index),
+			                (unsigned char*) &datalogger_journal);
+			if (datalogger_journal.magic == LOG_JOURNAL_MAGIC &&
+			    datalogger_journal.sequence < below && datalogger_journal.sequence >= best_sequence)
+			{
+				best = slot;
+				best_sequence = datalogger_journal.sequence;
+			}
+		}
+		if (best < 0)
+			break;
+
+		datalogger_read(LOG_JOURNAL_PAGE + best * journal_slot_pages(), sizeof(struct LogJournal),
+		                (unsigned char*) &datalogger_journal);
+		if (datalogger_journal.checksum == journal_checksum() &&
+		    datalogger_journal.head_index > 0 && datalogger_journal.head_index <= MAX_INDEX &&
+		    datalogger_journal.head_page >= START_LOG_PAGE && datalogger_journal.head_page < LOG_JOURNAL_PAGE)
+		{
+			journal_slot = (best + 1) % slots;
+			return 1;
+		}
+		below = best_sequence;
+	}
+
+	memset(&datalogger_journal, 0, sizeof(struct LogJournal));
+	journal_slot = 0;
+	return 0;
+}
+
+
+/*!
+ *   Prepares a journal record with the current write head, for
+ *   datalogger_flush(). Only called when no log page is pending, so all pages
+ *   before current_page have been handed to the dataflash.
+ */
+static void datalogger_journal_stage()
+{
+	int last = current_page - 1;
+
+	if (last < START_LOG_PAGE)
+		last = LOG_JOURNAL_PAGE - 1;
+
+	datalogger_journal.magic = LOG_JOURNAL_MAGIC;
+	datalogger_journal.sequence++;
+	datalogger_journal.head_index = current_index;
+	datalogger_journal.head_page = current_page;
+	if (datalogger_journal.index[current_index - 1].page_num != current_page)   // at least one page logged
+		datalogger_journal.last_page[current_index - 1] = last;
+	datalogger_journal.checksum = journal_checksum();
+
+	pending_buffer = (unsigned char*) &datalogger_journal;
+	pending_size = sizeof(struct LogJournal);
+	pending_page = LOG_JOURNAL_PAGE + journal_slot * journal_slot_pages();
+	journal_slot = (journal_slot + 1) % (JOURNAL_PAGES / journal_slot_pages());
+	journal_due = 0;
+	pages_since_journal = 0;
+}
+
+
+/*!
+ *   Continues after the session of the journal. The sessions are used round
+ *   robin, so the next one is the oldest. The record can be up to
+ *   JOURNAL_INTERVAL pages behind: the pages logged after it are skipped.
+ */
+static void datalogger_init_from_journal()
+{
+	int last_index = datalogger_journal.head_index;
+	int page = datalogger_journal.head_page;
+	int i;
+
+	current_index = last_index % MAX_INDEX + 1;
+
+	for (i = 0; i <= JOURNAL_INTERVAL + 1; i++)
+	{
+		datalogger_read(page, 2, buffer);
+		if (page_index(buffer) != last_index)
+			break;
+		datalogger_journal.last_page[last_index - 1] = page;
+		if (++page >= LOG_JOURNAL_PAGE)
+			page = START_LOG_PAGE;
+	}
+	current_page = page;
+}
+
+
+/*!
+ *   Without a journal (after a format or an upgrade from older firmware) the
+ *   sessions are taken from the index page:
  *
  *   First the current index page is read out.
  *   Then we look for the oldest index. 
  *   Then we look for the youngest page
  *   Then we take the first page after the youngest page, that is not from the youngest index
  */
-void datalogger_init()
+static void datalogger_init_legacy()
 {
 	int i, start_page = START_LOG_PAGE, last_index = -1;
 	unsigned long date2 = 0xFFFFFFFF;
 	unsigned long date;
 	
-	current_page = START_LOG_PAGE;
-	
 	//printf("formatting...");
 	//datalogger_format();
 	//printf("done");
 	
 	// read index page
-	datalogger_read(LOG_INDEX_PAGE, sizeof(struct LogIndex) * MAX_INDEX, (unsigned char*)datalogger_index_table);
+	datalogger_read(LOG_INDEX_PAGE, sizeof(struct LogIndex) * LEGACY_MAX_INDEX, (unsigned char*)datalogger_journal.index);
+	for (i = 0; i < LEGACY_MAX_INDEX; i++)
+		if (datalogger_journal.index[i].page_num == -1)   // erased
+			memset(&datalogger_journal.index[i], 0, sizeof(struct LogIndex));
 	
 	// find the index with the oldest date: date
 	for (i = 0; i < MAX_INDEX; i++)
 	{
-		date = (datalogger_index_table[i].date % 100) * 100000000 + 
-		       ((datalogger_index_table[i].date % 10000) / 100) * 1000000 + 
-		       ((datalogger_index_table[i].date / 10000) * 10000) +
-		       datalogger_index_table[i].time / 100;
+		date = (datalogger_journal.index[i].date % 100) * 100000000 + 
+		       ((datalogger_journal.index[i].date % 10000) / 100) * 1000000 + 
+		       ((datalogger_journal.index[i].date / 10000) * 10000) +
+		       datalogger_journal.index[i].time / 100;
 		if (date < date2)
 		{
 			date2 = date;
-			//start_page = datalogger_index_table[i].page_num + 1;
+			//start_page = datalogger_journal.index[i].page_num + 1;
 			current_index = (i)%MAX_INDEX + 1;
 		}
 	}
@@ -89,14 +321,14 @@ void datalogger_init()
 	date2 = 0;
 	for (i = 0; i < MAX_INDEX; i++)
 	{
-		date = (datalogger_index_table[i].date % 100) * 100000000 + 
-		       ((datalogger_index_table[i].date % 10000) / 100) * 1000000 + 
-		       ((datalogger_index_table[i].date / 10000) * 10000) +
-		       datalogger_index_table[i].time / 100;
+		date = (datalogger_journal.index[i].date % 100) * 100000000 + 
+		       ((datalogger_journal.index[i].date % 10000) / 100) * 1000000 + 
+		       ((datalogger_journal.index[i].date / 10000) * 10000) +
+		       datalogger_journal.index[i].time / 100;
 		if (date > date2)
 		{
 			date2 = date;
-			start_page = datalogger_index_table[i].page_num + 1;
+			start_page = datalogger_journal.index[i].page_num + 1;
 		}
 	}	
 	
@@ -107,18 +339,17 @@ void datalogger_init()
 	//    - 0: not been written yet: OK
 	//    - (current index) = page written by this index: the previous index didn't overwrite it: OK
 	//    - A change in index: this is the one we will need to sacrifice...
-	for (i = start_page; i < MAX_PAGE; i++)
+	for (i = start_page; i < LOG_JOURNAL_PAGE; i++)
 	{
-		int *index;
+		int index;
 		datalogger_read(i, 4, buffer);
-		index = (int*) &(buffer[0]);
-		if (*index == 0 || *index == (current_index) || (*index != last_index && last_index > 0))
+		index = page_index(buffer);
+		if (index == 0 || index == (current_index) || (index != last_index && last_index > 0))
 		{
 			current_page = i;
-			*index = (current_index); // buffer[0] + [1] contains current_index + 1
 			break;
 		}
-		last_index = *index;
+		last_index = index;
 	}
 
     
@@ -126,32 +357,67 @@ void datalogger_init()
 }
 
 
+/*!
+ *   Initializes the datalogging (to dataflash) functionality: finds the
+ *   session and the page to log to.
+ */
+void datalogger_init()
+{
+	int i;
+
+	current_page = START_LOG_PAGE;
+
+	if (datalogger_journal_load())
+		datalogger_init_from_journal();
+	else
+		datalogger_init_legacy();
+
+	set_page_word(buffer, current_index | LOG_PAGE_PACKED);
+	set_page_word(&buffer[2], 0);
+	current_line = 0;
+	page_used = PACKED_HEADER_SIZE;
+	memset(on_page, 0, sizeof(on_page));
+	for (i = 0; i < LOG_RECORD_TYPES; i++)
+		period[i] = log_record_types[i].period;
+}
+
+
 /*!
  *    This function is called when the GPS (date & time!) is available and the index page can be written.
  */ 
 void datalogger_start_session()
 {	
+	int i;
+
+	while (! datalogger_flush(SPI_WAIT_TICKS))
+		vTaskDelay(1);
+
 	// update the index
-	datalogger_index_table[current_index - 1].page_num = current_page;
+	datalogger_journal.index[current_index - 1].page_num = current_page;
+	datalogger_journal.last_page[current_index - 1] = 0;
 	if (control_state.simulation_mode)
 	{
 		// set using Enable Simulation command
-		datalogger_index_table[current_index - 1].time = sensor_data.gps.time;
-		datalogger_index_table[current_index - 1].date = sensor_data.gps.date;
+		datalogger_journal.index[current_index - 1].time = sensor_data.gps.time;
+		datalogger_journal.index[current_index - 1].date = sensor_data.gps.date;
 	}
 	else
 	{
-		datalogger_index_table[current_index - 1].time = sensor_data.gps.time;
-		datalogger_index_table[current_index - 1].date = sensor_data.gps.date;
+		datalogger_journal.index[current_index - 1].time = sensor_data.gps.time;
+		datalogger_journal.index[current_index - 1].date = sensor_data.gps.date;
 	}
-	datalogger_write(LOG_INDEX_PAGE, sizeof(struct LogIndex) * MAX_INDEX, (unsigned char*)datalogger_index_table);
+	journal_due = 1;
+	datalogger_flush(0);
+
+	for (i = 0; i < LOG_RECORD_TYPES; i++)
+		datalogger_write_schema(i);
 	//printf("Starting to datalog to page %d, index %d\r\n", current_page, current_index);
 }	
 
 
 void datalogger_read(int page, int size, unsigned char *buffer)
 {
-	if (xSemaphoreTake( xSpiSemaphore, ( portTickType ) 0 ) == pdTRUE )   // Spi1 is shared with SCP1000 and Dataflash
+	if (xSemaphoreTake( xSpiSemaphore, SPI_WAIT_TICKS ) == pdTRUE )   // Spi1 is shared with SCP1000 and Dataflash
 	{
 		dataflash.read(page, size, buffer);
 		xSemaphoreGive( xSpiSemaphore );
@@ -159,43 +425,312 @@ void datalogger_read(int page, int size, unsigned char *buffer)
         printf("\r\nSPI Flash not available\r\n");
 }	
 
+/*!
+ *    Reads a page of the dataflash for the log download (DB command), in the
+ *    buffer of the logger: logging must be disabled.
+ *    @return The page, NULL when the SPI bus isn't available
+ */
+unsigned char *datalogger_read_page(int page)
+{
+	if (xSemaphoreTake( xSpiSemaphore, SPI_WAIT_TICKS ) != pdTRUE )
+		return NULL;
+	dataflash.read(page, PAGE_SIZE, buffer);
+	xSemaphoreGive( xSpiSemaphore );
+	return buffer;
+}
+
+/*!
+ *    Writes pages outside the log (configuration, flight plan) while the
+ *    logger may be running: every write of the flash must go through here.
+ *    The pages are only handed to datalogger_task(), which programs them
+ *    after the pending log page, the same way (see datalogger_flush()). So
+ *    the calling task doesn't wait for the chip, and doesn't miss the
+ *    commands that arrive in the meantime. buffer is read when its pages are
+ *    programmed: writing the same page again before that is one write.
+ */
 void datalogger_write(int page, int size, unsigned char *buffer)
 {
-	if (xSemaphoreTake( xSpiSemaphore, ( portTickType ) 0 ) == pdTRUE )   // Spi1 is shared with SCP1000 and Dataflash
+	struct WriteRequest *request = NULL;
+	int i;
+
+	if (xSemaphoreTake( xSpiSemaphore, SPI_WAIT_TICKS ) != pdTRUE )   // Spi1 is shared with SCP1000 and Dataflash
 	{
-		dataflash.write(page, size, buffer);
-		xSemaphoreGive( xSpiSemaphore );
-        //printf("\r\nSPI Flash available\r\n");
-    } else
-        printf("\r\nSPI Flash not available\r\n");
+		printf("\r\nSPI Flash not available\r\n");
+		return;
+	}
+	for (i = 0; i < WRITE_REQUESTS; i++)
+		if (write_request[i].due && write_request[i].page == page)
+			request = &write_request[i];
+	for (i = 0; i < WRITE_REQUESTS && request == NULL; i++)
+		if (! write_request[i].due)
+			request = &write_request[i];
+	if (request != NULL)
+	{
+		request->page = page;
+		request->size = size;
+		request->buffer = buffer;
+		request->due = 1;
+	}
+	xSemaphoreGive( xSpiSemaphore );
+	if (request == NULL)
+		printf("\r\nSPI Flash busy\r\n");
 }	
 
 
-int current_line = 0;
 /*!
- *    Save the LogLine line to a buffer. Write the buffer when full.
+ *    Makes the next write request or the due journal record the pending
+ *    page, with xSpiSemaphore taken.
+ *    @return 0 when nothing is left to write
  */
-void datalogger_writeline(struct LogLine *line)
+static int datalogger_stage()
 {
-	unsigned char *a, *b;
 	int i;
-	struct LogLine *lines = (struct LogLine*) &(buffer[2]);   // buffer[0-1] set in datalogger_init()
-	
-	if (2+(current_line+1)*sizeof(struct LogLine) >= PAGE_SIZE)
+
+	for (i = 0; i < WRITE_REQUESTS; i++)
+		if (write_request[i].due)
+		{
+			pending_buffer = write_request[i].buffer;
+			pending_size = write_request[i].size;
+			pending_page = write_request[i].page;
+			write_request[i].due = 0;
+			return 1;
+		}
+	if (! journal_due)
+		return 0;
+	datalogger_journal_stage();
+	return 1;
+}
+
+
+/*!
+ *    Moves the pending page one step closer to the flash, without ever waiting
+ *    for the chip to finish programming:
+ *      - copy it to SRAM buffer 1 or 2. This is allowed while the chip is still
+ *        programming the other buffer.
+ *      - when the chip is ready, start programming that buffer into the page.
+ *    Nothing is lost when the SPI bus is in use by the OSD or a sensor: the
+ *    page stays pending and is retried on the next call.
+ *
+ *    The pages of datalogger_write() and a due journal record are written the
+ *    same way, after the log pages.
+ *
+ *    @return 1 when nothing is pending anymore
+ */
+static int datalogger_flush(portTickType ticks_to_wait)
+{
+	int done, i;
+
+	if (xSemaphoreTake( xSpiSemaphore, ticks_to_wait ) != pdTRUE )   // Spi1 is shared with SCP1000 and Dataflash
+		return 0;
+
+	if (pending_buffer == NULL && ! datalogger_stage())
 	{
-		datalogger_write(current_page, sizeof(buffer), buffer);
-		current_page++;
-		if (current_page >= MAX_PAGE)
-			current_page = START_LOG_PAGE;
-		current_line = 0;
-		//printf("write page!\n\r");
-	}	
-	
-	a = (unsigned char*) line;
-	b = (unsigned char*) &(lines[current_line++]);
-	
-	for (i = 0; i < sizeof(struct LogLine); i++)
-		b[i] = a[i];
+		xSemaphoreGive( xSpiSemaphore );
+		return 1;
+	}
+	if (! pending_loaded)
+	{
+		dataflash.write_buffer(flash_buffer, MIN(pending_size, PAGE_SIZE), pending_buffer);
+		pending_loaded = 1;
+	}
+	if (dataflash.is_ready())
+	{
+		dataflash.program_buffer(flash_buffer, pending_page);
+		flash_buffer = flash_buffer == 1 ? 2 : 1;
+		pending_loaded = 0;
+		if (pending_size > PAGE_SIZE)   // a journal record can take more than one page
+		{
+			pending_buffer += PAGE_SIZE;
+			pending_size -= PAGE_SIZE;
+			pending_page++;
+		}
+		else
+			pending_buffer = NULL;
+	}
+	done = pending_buffer == NULL && ! journal_due;
+	for (i = 0; i < WRITE_REQUESTS; i++)
+		if (write_request[i].due)
+			done = 0;
+	xSemaphoreGive( xSpiSemaphore );
+
+	return done;
+}
+
+
+/*!
+ *    Hands the full page in buffer to datalogger_flush(), the next records
+ *    go to the other buffer.
+ */
+static void datalogger_next_page()
+{
+	// The previous page has been waiting for the SPI bus for a whole page:
+	// rather wait for it than lose it.
+	while (! datalogger_flush(SPI_WAIT_TICKS))
+		vTaskDelay(1);
+
+	pending_buffer = buffer;
+	pending_size = PAGE_SIZE;
+	pending_page = current_page;
+	buffer = buffer == page_buffer[0] ? page_buffer[1] : page_buffer[0];
+	set_page_word(buffer, get_page_word(pending_buffer));   // set in datalogger_init()
+
+	current_page++;
+	if (current_page >= LOG_JOURNAL_PAGE)
+		current_page = START_LOG_PAGE;
+	if (++pages_since_journal >= JOURNAL_INTERVAL)
+		journal_due = 1;
+	datalogger_flush(0);
+	current_line = 0;
+	//printf("write page!\n\r");
+
+	memset(on_page, 0, sizeof(on_page));   // keyframes
+	page_used = PACKED_HEADER_SIZE;
+}
+
+
+/*!
+ *    Writes the schema record of log_record_types[type].
+ */
+static void datalogger_write_schema(int type)
+{
+	int size = logschema_encode(&log_record_types[type], period[type], &buffer[page_used + 2],
+	                            MIN(PAGE_SIZE - page_used - 2, 255));
+
+	if (size == 0)   // page full
+	{
+		datalogger_next_page();
+		size = logschema_encode(&log_record_types[type], period[type], &buffer[page_used + 2], 255);
+	}
+	buffer[page_used] = LOGSCHEMA_ID;
+	buffer[page_used + 1] = size;
+	page_used += size + 2;
+	set_page_word(&buffer[2], ++current_line);
+}
+
+
+/*!
+ *    Packs a record of log_record_types[type] in a buffer. When full, the
+ *    buffer is handed to datalogger_flush() and the record goes to the other
+ *    buffer.
+ */
+void datalogger_write_record(int type, const union LogRecord *record)
+{
+	const struct LogRecordType *t = &log_record_types[type];
+	int size = 0;
+
+	if (page_used < PAGE_SIZE)
+		size = logpack_encode(t->fields, t->count, record, on_page[type] ? &last_record[type] : &zero_record,
+		                      &buffer[page_used + 1], PAGE_SIZE - page_used - 1);
+	if (size == 0)   // page full
+	{
+		datalogger_next_page();
+		size = logpack_encode(t->fields, t->count, record, &zero_record,
+		                      &buffer[page_used + 1], PAGE_SIZE - page_used - 1);
+	}
+
+	buffer[page_used] = t->id;
+	page_used += size + 1;
+	set_page_word(&buffer[2], ++current_line);
+	last_record[type] = *record;
+	on_page[type] = 1;
+}
+
+
+/*!
+ *    Changes how often a record type is written, until the next reboot.
+ *    @param ticks  In ticks of datalogger_task() (50Hz), LOG_ON_CHANGE or 0 (off)
+ *    @return 0 for an unknown record type
+ */
+int datalogger_set_period(int id, int ticks)
+{
+	int i;
+
+	for (i = 0; i < LOG_RECORD_TYPES; i++)
+		if (log_record_types[i].id == id)
+		{
+			period[i] = ticks;
+			countdown[i] = 0;
+			return 1;
+		}
+	return 0;
+}
+
+
+/*!
+ *    Calls printer for a record, after the names of the fields whenever a
+ *    record type was added to the schema.
+ */
+static void datalogger_print_record(void(*printer)(struct LogSchema*, int), int record)
+{
+	if (header_fields != schema.fields)
+	{
+		printer(&schema, -1);
+		header_fields = schema.fields;
+	}
+	printer(&schema, record);
+}
+
+
+/*!
+ *    Calls printer for every record of the page in buffer, packed or not.
+ *    @return 0 when the page can't be read, or an unpacked page ends before
+ *            it is full
+ */
+static int datalogger_print_page(void(*printer)(struct LogSchema*, int))
+{
+	int j, r;
+
+	if (get_page_word(buffer) & LOG_PAGE_PACKED)
+	{
+		int records = get_page_word(&buffer[2]), used = PACKED_HEADER_SIZE, size;
+
+		logschema_new_page(&schema);
+		for (j = 0; j < records && used < PAGE_SIZE - 1; j++)
+		{
+			int id = buffer[used++];
+
+			if (id == LOGSCHEMA_ID)
+			{
+				size = buffer[used++];
+				if (used + size > PAGE_SIZE || ! logschema_add(&schema, &buffer[used], size))
+					return 0;
+				used += size;
+				continue;
+			}
+
+			r = logschema_find(&schema, id);
+			if (r < 0 && schema.records == 0)   // the start of the session was overwritten
+			{
+				for (r = 0; r < LOG_RECORD_TYPES; r++)
+					logschema_add_type(&schema, &log_record_types[r]);
+				r = logschema_find(&schema, id);
+			}
+			if (r < 0)
+				return 0;
+			size = logschema_decode(&schema, r, &buffer[used], PAGE_SIZE - used);
+			if (size == 0)
+				return 0;
+			used += size;
+			datalogger_print_record(printer, r);
+		}
+		return 1;
+	}
+
+	r = logschema_find(&schema, LOG_LEGACY);
+	if (r < 0 && logschema_add_type(&schema, &log_legacy_type))
+		r = logschema_find(&schema, LOG_LEGACY);
+	if (r < 0)
+		return 0;
+	for (j = 0; j < (int)((PAGE_SIZE - 2) / sizeof(struct LogLegacy)); j++)
+    {
+		const struct LogLegacy *line = (const struct LogLegacy*) &(buffer[2 + j * sizeof(struct LogLegacy)]);
+
+        if (! (line->gps_latitude_rad < DEG2RAD(360.0) && line->gps_longitude_rad < DEG2RAD(360.0)))
+            return 0;
+		logschema_load(&schema, r, log_legacy_type.fields, line);
+		datalogger_print_record(printer, r);
+    }
+	return 1;
 }
 
 
@@ -205,125 +740,144 @@ void datalogger_writeline(struct LogLine *line)
  *    "printer" function.
  *    
  *    @index   The index (see dataflash page 3) we want to read.
- *    @printer The function used to format the LogLine according to the current
- *             used communication protocol.
+ *    @printer The function used to format the records according to the current
+ *             used communication protocol: called with record -1 for the
+ *             names of the fields, see datalogger_print_record().
  */
-int datalogger_print_next_page(int index, void(*printer)(struct LogLine*))
+int datalogger_print_next_page(int index, void(*printer)(struct LogSchema*, int))
 {
 	static int last_index = -1;
 	static int last_page = -1;
-	static struct LogLine *lines = (struct LogLine*) &(buffer[2]);
-	
-	int *i = (int*) &(buffer[0]);
-	int j;
 	
 	if (index != last_index)
 	{
-		last_page = datalogger_index_table[index].page_num;
+		last_page = datalogger_journal.index[index].page_num;
 		last_index = index;
+		logschema_clear(&schema);
+		header_fields = 0;
 	}
 
-	datalogger_read(last_page++, sizeof(buffer), buffer);
-	if (last_page >= MAX_PAGE)
+	datalogger_read(last_page++, PAGE_SIZE, buffer);
+	if (last_page >= LOG_JOURNAL_PAGE)
 			last_page = START_LOG_PAGE;
 
-#ifdef DETAILED_LOG //|| RAW_50HZ_LOG
-    if (*i != index+1)
+    if (page_index(buffer) != index+1)
 	{
-		printf ("%d != %d\r\n", *i, index+1);
+		printf ("%d != %d\r\n", page_index(buffer), index+1);
 		return 0;
 	}
-#else
-    /*long hours = (lines[0].time / 10000);
-    long minutes = (lines[0].time % 10000) / 100;
-    long seconds = (lines[0].time) % 100;
-	long totalseconds =  seconds + minutes * 60 + hours * 3600;
-    if (abs(totalseconds  - last_totalseconds) > 2 && last_totalseconds != -1)
-    {
-        printf("\r\n Stop: new line: %lu  %lu \r\n", lines[0].date, lines[0].time);
-        return 0;
-    }
-    hours = (lines[PAGE_SIZE / sizeof(struct LogLine) - 2].time / 10000);
-    minutes = (lines[PAGE_SIZE / sizeof(struct LogLine) - 2].time % 10000) / 100;
-    seconds = (lines[PAGE_SIZE / sizeof(struct LogLine) - 2].time) % 100;
-	totalseconds =  seconds + minutes * 60 + hours * 3600;
-    last_totalseconds = totalseconds;*/
-    if (*i != index+1)
-	{
-		printf ("%d != %d\r\n", *i, index+1);
-		return 0;
-	}
-#endif
 
-	for (j = 0; j < (PAGE_SIZE - 2) / sizeof(struct LogLine); j++)
-    {
-        if (lines[j].gps_latitude_rad < DEG2RAD(360.0) && lines[j].gps_longitude_rad < DEG2RAD(360.0) )
-            printer(&lines[j]);
-        else
-            return 0;
-    }
-		
-	return 1;
+	return datalogger_print_page(printer);
 }
 
-int datalogger_print_next_page_of_all(int index, void(*printer)(struct LogLine*))
+int datalogger_print_next_page_of_all(int index, void(*printer)(struct LogSchema*, int))
 {
 	static int last_page = -1;
-	static struct LogLine *lines = (struct LogLine*) &(buffer[2]);
 	static int processed_lines = 0;
 
-	int *current_i = (int*) &(buffer[0]);
-	int j;
-
 	if (last_page == -1)
-		last_page = datalogger_index_table[index].page_num; // start to read at the current page (oldest entry to be overwritten)
+	{
+		last_page = datalogger_journal.index[index].page_num; // start to read at the current page (oldest entry to be overwritten)
+		logschema_clear(&schema);
+		header_fields = 0;
+	}
 
-	datalogger_read(last_page++, sizeof(buffer), buffer);
+	datalogger_read(last_page++, PAGE_SIZE, buffer);
 	processed_lines++;
 
-	if (last_page == datalogger_index_table[index].page_num || processed_lines > 4095 - START_LOG_PAGE)
+	if (last_page == datalogger_journal.index[index].page_num || processed_lines > LOG_JOURNAL_PAGE - START_LOG_PAGE)
 	{
 		printf("\r\nAll log-pages have been processed\r\n");
 		processed_lines = 0;
 		last_page = -1;
 		return 0;
 	}
-	if (last_page >= MAX_PAGE)
+	if (last_page >= LOG_JOURNAL_PAGE)
 			last_page = START_LOG_PAGE;
 
-	/*if (*current_i != index+1)
-	{
-		printf ("%d != %d\r\n", *current_i, index+1);
-		return 0;
-	}*/
-
-	for (j = 0; j < (PAGE_SIZE - 2) / sizeof(struct LogLine); j++)
-	{
-		if (*current_i == index)
-			printer(&lines[j]);
-	}
-	printf("\r\n processed page %d having index %d\r\n", last_page, *current_i);
+	if (page_index(buffer) == index)
+		datalogger_print_page(printer);
+	printf("\r\n processed page %d having index %d\r\n", last_page, page_index(buffer));
 	return 1;
 }
 	
 
 /*!
- *   Formats all dataflash pages except the first 2 (used for configuration)
+ *   Formats all dataflash pages from LOG_INDEX_PAGE on (the ones before hold
+ *   the configuration and the flight plan). Only starts the format:
+ *   datalogger_task() erases the pages in the background, see
+ *   datalogger_format_progress().
  */
 void datalogger_format()
 {
-	int i;
-	for (i = 0; i < PAGE_SIZE; i++)
-		buffer[i] = 0;
-		
-	for (i = LOG_INDEX_PAGE; i <= MAX_PAGE; i++)
+	format_page = LOG_INDEX_PAGE;
+}
+
+
+/*!
+ *   @return The progress of the format in %, -1 when not formatting
+ */
+int datalogger_format_progress()
+{
+	int page = format_page;   // changed by datalogger_task()
+
+	if (page == 0)
+		return -1;
+	return (int)((long)(MIN(page, MAX_PAGE + 1) - LOG_INDEX_PAGE) * 100 / (MAX_PAGE + 1 - LOG_INDEX_PAGE));
+}
+
+
+/*!
+ *   Starts erasing the next pages of the format, when the chip is ready.
+ *   The pages before the second block share their block with the
+ *   configuration: they are programmed with 0xFF one by one instead.
+ */
+static void datalogger_format_step()
+{
+	if (xSemaphoreTake( xSpiSemaphore, SPI_WAIT_TICKS ) != pdTRUE )   // Spi1 is shared with SCP1000 and Dataflash
+		return;
+
+	if (dataflash.is_ready())
 	{
-		printf("page %d\r\n", i);
-		datalogger_write(i, PAGE_SIZE, buffer);
-	}	
-	
+		if (format_page > MAX_PAGE)
+			format_page = 0;   // done
+		else if (format_page < DATAFLASH_BLOCK_PAGES)
+		{
+			memset(buffer, 0xFF, PAGE_SIZE);
+			dataflash.write(format_page++, PAGE_SIZE, buffer);
+		}
+		else
+		{
+			dataflash.erase_block(format_page);
+			format_page += DATAFLASH_BLOCK_PAGES;
+		}
+	}
+	xSemaphoreGive( xSpiSemaphore );
+}
+
+
+/*!
+ *   Runs a format started by datalogger_format(): only this task waits for
+ *   the erases, the SPI bus is free in between. Logging continues in a new
+ *   session afterwards (when one was started), also after a read out: there
+ *   is nothing left to read.
+ */
+static void datalogger_format_run(int session)
+{
+	while (! datalogger_flush(SPI_WAIT_TICKS))   // not into an erased block
+		vTaskDelay(1);
+
+	while (format_page != 0)
+	{
+		datalogger_format_step();
+		vTaskDelay(FORMAT_POLL_TICKS);
+	}
+
 	datalogger_init();
-}	
+	disable_logging = 0;
+	if (session)
+		datalogger_start_session();
+}
 
 
 void datalogger_disable()
@@ -338,17 +892,70 @@ void datalogger_enable()
 }
 
 
+/*!
+ *    Fills a record of log_record_types[type] from the current state.
+ */
+static void datalogger_fill_record(int type, union LogRecord *r)
+{
+	switch (log_record_types[type].id)
+	{
+		case LOG_GPS:
+			r->gps.latitude_rad = sensor_data.gps.latitude_rad;
+			r->gps.longitude_rad = sensor_data.gps.longitude_rad;
+			r->gps.date = sensor_data.gps.date;
+			r->gps.time = sensor_data.gps.time;
+			r->gps.height_m = sensor_data.gps.height_m;
+			r->gps.speed_cm_s = (unsigned int)(sensor_data.gps.speed_ms*100.0);
+			r->gps.heading_deg = (int)(sensor_data.gps.heading_rad * (180.0/3.14159));
+			r->gps.satellites = (unsigned char)sensor_data.gps.satellites_in_view;
+			r->gps.temperature_c = (char)sensor_data.temperature; // -128C...+128C
+			break;
+		case LOG_CONTROL:
+			r->control.roll_deg = (int)(sensor_data.roll * (180.0/3.14159));
+			r->control.pitch_deg = (int)(sensor_data.pitch * (180.0/3.14159));
+			r->control.yaw_deg = (int)(sensor_data.yaw * (180.0/3.14159));
+			r->control.p_deg_s = (int)(sensor_data.p * (180.0/3.14159));
+			r->control.q_deg_s = (int)(sensor_data.q * (180.0/3.14159));
+			r->control.r_deg_s = (int)(sensor_data.r * (180.0/3.14159));
+			r->control.height_dm = (int)(sensor_data.pressure_height * 10.0);
+			r->control.desired_roll_deg = (int)(control_state.desired_roll * (180.0/3.14159));
+			r->control.desired_pitch_deg = (int)(control_state.desired_pitch * (180.0/3.14159));
+			r->control.desired_heading_deg = (int)(navigation_data.desired_heading_rad * (180.0/3.14159));
+			r->control.desired_height_m = control_state.desired_altitude;
+			break;
+		case LOG_IMU:
+			r->imu.acc_x = sensor_data.acc_x_raw;
+			r->imu.acc_y = sensor_data.acc_y_raw;
+			r->imu.acc_z = sensor_data.acc_z_raw;
+			r->imu.gyro_x = sensor_data.gyro_x_raw;
+			r->imu.gyro_y = sensor_data.gyro_y_raw;
+			r->imu.gyro_z = sensor_data.gyro_z_raw;
+			break;
+		case LOG_EVENT:
+			r->event.flight_mode = control_state.flight_mode;
+			r->event.navigation_line = gluonscript_data.current_codeline + 1;
+			r->event.servo_trigger = trigger.trigger_counter;
+			break;
+	}
+}
+
+
 /*!
  *    This task takes care of the logging, both initialization and actual logging.
  * 
  *    The initialization of the logging index (page 3) starts when a valid GPS frame
  *    is available. This is needed because the date & time are stored in the index.
  *
+ *    Every record type is written at its own rate, in ticks of this task (50Hz).
+ *    Records written on change are also written once per page, so every page
+ *    can be read on its own.
+ *
  *    Measured used stack space: 274 / 1290 bytes
  */
 void datalogger_task( void *parameters )
 {
-	static struct LogLine l;
+	static union LogRecord record;
+	int i;
 	
 	/* Used to wake the task at the correct frequency. */
 	portTickType xLastExecutionTime; 
@@ -365,100 +972,61 @@ void datalogger_task( void *parameters )
 	
 	// wait for GPS	(date & time!)
 	while(sensor_data.gps.status != ACTIVE)
-		vTaskDelayUntil( &xLastExecutionTime, ( ( portTickType ) 1000 / portTICK_RATE_MS ) );   // 1Hz
+	{
+		vTaskDelayUntil( &xLastExecutionTime, ( ( portTickType ) 20 / portTICK_RATE_MS ) );   // 50Hz, for datalogger_write()
+		if (format_page != 0)
+		{
+			datalogger_format_run(0);
+			xLastExecutionTime = xTaskGetTickCount();
+		}
+		else
+			datalogger_flush(0);
+	}
 	
 	// ok, now we've got the current date and time, we can find an available page and write the index	
 	datalogger_start_session();
 	
 	for( ;; )
 	{	
-#ifndef RAW_50HZ_LOG
-		vTaskDelayUntil( &xLastExecutionTime, ( ( portTickType ) 250 / portTICK_RATE_MS ) );   // 4Hz
-#else
 		vTaskDelayUntil( &xLastExecutionTime, ( ( portTickType ) 20 / portTICK_RATE_MS ) );   // 50Hz
-#endif		
 
-		if (! disable_logging)   // logging is disabled when the config tool reads out logging.
+		if (format_page == 0)
+			datalogger_flush(0);   // retry a page that found the SPI bus busy, and the pages of datalogger_write()
+
+		if (format_page != 0)
+		{
+			datalogger_format_run(1);
+			xLastExecutionTime = xTaskGetTickCount();
+		}
+		else if (! disable_logging)   // logging is disabled when the config tool reads out logging.
 		{
-#ifdef DETAILED_LOG
-			// Normal logging
-			l.temperature_c = (char)sensor_data.temperature; // -128C...+128C
-			l.height_m = (int)sensor_data.pressure_height;
-			l.gps_latitude_rad = sensor_data.gps.latitude_rad;
-			l.gps_longitude_rad = sensor_data.gps.longitude_rad;
-			l.gps_height_m = sensor_data.gps.height_m;
-			l.gps_heading = (int)(sensor_data.gps.heading_rad * (180.0/3.14159));
-			l.gps_speed_m_s = (int)(sensor_data.gps.speed_ms*100.0);
-			l.gps_satellites = (char)sensor_data.gps.satellites_in_view;
-			//l.acc_x = sensor_data.acc_x_raw;
-			//l.acc_y = sensor_data.acc_y_raw;
-			//l.acc_z = sensor_data.acc_z_raw;
-			l.acc_x_g = sensor_data.acc_x;
-			l.acc_y_g = sensor_data.acc_y;
-			l.acc_z_g = sensor_data.acc_z;
-
-			//l.gyro_x = sensor_data.gyro_x_raw;
-			//l.gyro_y = sensor_data.gyro_y_raw;
-			//l.gyro_z = sensor_data.gyro_z_raw;
-			l.p = (int)(sensor_data.p * (180.0/3.14159));
-			l.q = (int)(sensor_data.q * (180.0/3.14159));
-			l.r = (int)(sensor_data.r * (180.0/3.14159));
-			l.pitch = (int)(sensor_data.pitch * (180.0/3.14159));
-			l.roll = (int)(sensor_data.roll * (180.0/3.14159));
-			l.desired_pitch = (int)(control_state.desired_pitch * (180.0/3.14159));
-			l.desired_roll = (int)(control_state.desired_roll * (180.0/3.14159));
-			//l.pitch_acc = (int)(sensor_data.pitch_acc * (180.0/3.14159));
-			//l.roll_acc = (int)(sensor_data.roll_acc * (180.0/3.14159));
-			l.control_state = control_state.flight_mode;
-			l.desired_heading = ((int)(navigation_data.desired_heading_rad * 180.0/3.14159));
-			l.navigation_code_line = gluonscript_data.current_codeline;
-			l.desired_height = control_state.desired_altitude;
-#elif RAW_50HZ_LOG
-			// Raw sensor logging at 50Hz
-			l.height_m_5 = (int)(sensor_data.pressure_height*5);
-			l.gps_latitude_rad = sensor_data.gps.latitude_rad;
-			l.gps_longitude_rad = sensor_data.gps.longitude_rad;
-			l.gps_heading_2 = (unsigned char)(sensor_data.gps.heading_rad * (180.0/3.14159) / 2.0);
-			l.gps_speed_m_s_10 = (unsigned char)(sensor_data.gps.speed_ms * 10.0);
-			l.gps_time = sensor_data.gps.time;
-			l.acc_x = sensor_data.acc_x_raw;
-			l.acc_y = sensor_data.acc_y_raw;
-			l.acc_z = sensor_data.acc_z_raw;
-			l.gyro_x = sensor_data.gyro_x_raw;
-			l.gyro_y = sensor_data.gyro_y_raw;
-			l.gyro_z = sensor_data.gyro_z_raw;
-			//l.idg500_vref = sensor_data.idg500_vref;
-			l.pitch = (int)(sensor_data.pitch * (180.0/3.14159));
-			l.pitch_acc = (int)(sensor_data.pitch_acc * (180.0/3.14159));
-			l.roll = (int)(sensor_data.roll * (180.0/3.14159));
-			//l.control_state = control_state.flight_mode;
-
-#else
-            // Simple logging
-			l.temperature_c = (char)sensor_data.temperature; // -128C...+128C
-			l.height_m = (int)sensor_data.pressure_height;
-			l.gps_latitude_rad = sensor_data.gps.latitude_rad;
-			l.gps_longitude_rad = sensor_data.gps.longitude_rad;
-			l.gps_height_m = sensor_data.gps.height_m;
-			l.gps_heading = (int)(sensor_data.gps.heading_rad * (180.0/3.14159));
-			l.gps_speed_m_s = (unsigned char)(sensor_data.gps.speed_ms*3.0);
-
-			l.pitch = (int)(sensor_data.pitch * (180.0/3.14159));
-			l.roll = (int)(sensor_data.roll * (180.0/3.14159));
-            l.yaw = (int)(sensor_data.yaw * (180.0/3.14159));
-			l.control_state = control_state.flight_mode;
-			l.navigation_code_line = gluonscript_data.current_codeline;
-            l.date = sensor_data.gps.date;
-            l.time = sensor_data.gps.time;
-            l.servo_trigger = trigger.trigger_counter;
-#endif
-			datalogger_writeline(&l);
 
+			for (i = 0; i < LOG_RECORD_TYPES; i++)
+			{
+				if (period[i] == 0)
+					continue;
+				if (period[i] != LOG_ON_CHANGE)
+				{
+					if (countdown[i] > 0)
+					{
+						countdown[i]--;
+						continue;
+					}
+					countdown[i] = period[i] - 1;
+				}
+
+				memset(&record, 0, sizeof(record));   // memcmp() below
+				datalogger_fill_record(i, &record);
+				if (period[i] == LOG_ON_CHANGE && on_page[i] &&
+				    memcmp(&record, &last_record[i], sizeof(record)) == 0)
+					continue;
+				datalogger_write_record(i, &record);
+			}
 		}
-        else // logging disabled:
+        else if (disable_logging == 1) // logging disabled: wait for a format
         {
             printf("\r\nLogging task stopped\r\n");
-            vTaskDelete(NULL);
+            disable_logging = 2;
         }
 	}
 }
@@ -1,10 +1,10 @@
 #ifndef DATALOGGER_H
 #define DATALOGGER_H
 
-#define MAX_INDEX 16 
+#include "logpack/logschema.h"
 
-// Uncomment this define if you want to use 50Hz raw data logging
-//#define RAW_50HZ_LOG 1
+#define MAX_INDEX 32
+#define LEGACY_MAX_INDEX 16  // sessions in LOG_INDEX_PAGE, written by firmware without the journal
 
 struct LogIndex
 {
@@ -14,104 +14,128 @@ struct LogIndex
 	long boot_sequence; // Gps OK, Ppm OK, Reboot
 };
 
-extern struct LogIndex datalogger_index_table[MAX_INDEX];
+/*!
+ *   One record of the log journal. Stored in the LOG_JOURNAL_PAGE pages at the
+ *   start of every session and every JOURNAL_INTERVAL log pages.
+ */
+struct LogJournal
+{
+	int  magic;                  // LOG_JOURNAL_MAGIC
+	unsigned int checksum;       // sum of all bytes after this field
+	unsigned long sequence;      // incremented for every record: the highest one is the current
+	int  head_index;             // session being logged, 1...MAX_INDEX (0 = none yet)
+	int  head_page;              // first page this session hadn't written yet
+	int  last_page[MAX_INDEX];   // last page written by each session
+	struct LogIndex index[MAX_INDEX];
+};
 
-#ifdef DETAILED_LOG
+extern struct LogJournal datalogger_journal;
 
-struct LogLine
+/*
+ *   The record types of the log (see datalogger_records.c). Each one is
+ *   written at its own rate, in ticks of datalogger_task() (50Hz), or when its
+ *   contents change (LOG_ON_CHANGE). A period of 0 turns it off.
+ */
+#define LOG_RECORD_TYPES  4
+#define LOG_ON_CHANGE     0xFF
+
+enum LogRecordId
 {
-	float gps_latitude_rad;
-	float gps_longitude_rad;
-	int gps_height_m;
-	int gps_speed_m_s;
-	int gps_heading;
-	char gps_satellites;
-	int desired_roll;
-	int desired_pitch;
-	int desired_heading;
-	int desired_height;
-	int pitch;
-	//int pitch_acc;
-	int roll;
-	//int roll_acc;
-	int yaw;
-	//unsigned int acc_x;
-	//unsigned int acc_y;
-	//unsigned int acc_z;
-	float acc_x_g;
-	float acc_y_g;
-	float acc_z_g;
-	//unsigned int gyro_x;
-	//unsigned int gyro_y;
-	//unsigned int gyro_z;
-	int p;
-	int q;
-	int r;
-	int control_state;
-	
+	LOG_GPS = 1,
+	LOG_CONTROL = 2,
+	LOG_IMU = 3,
+	LOG_EVENT = 4,
+	LOG_LEGACY = 255   // a LogLine of the firmware before the record types
+};
+
+struct LogGps
+{
+	double latitude_rad;
+	double longitude_rad;
+	unsigned long date;
+	unsigned long time;
+	int height_m;
+	unsigned int speed_cm_s;
+	int heading_deg;
+	unsigned char satellites;
 	char temperature_c;
-	int  height_m;
-	int  navigation_code_line;
 };
 
-#elif defined RAW_50HZ_LOG
+struct LogControl
+{
+	int roll_deg;
+	int pitch_deg;
+	int yaw_deg;
+	int p_deg_s;
+	int q_deg_s;
+	int r_deg_s;
+	int height_dm;              // pressure height
+	int desired_roll_deg;
+	int desired_pitch_deg;
+	int desired_heading_deg;
+	int desired_height_m;
+};
 
-struct LogLine
+struct LogImu
 {
-	float gps_latitude_rad;
-	float gps_longitude_rad;
-	long  gps_time;
-	//int gps_height_m;
-	unsigned char gps_speed_m_s_10;
-	unsigned char gps_heading_2;
-	
-	unsigned int acc_x;
+	unsigned int acc_x;         // raw sensor readings
 	unsigned int acc_y;
 	unsigned int acc_z;
 	unsigned int gyro_x;
 	unsigned int gyro_y;
 	unsigned int gyro_z;
-	//unsigned int idg500_vref;
-	//int control_state;
-	int roll;
-	int pitch;
-	int pitch_acc;
-	
-	int  height_m_5;
 };
 
-#else
+struct LogEvent
+{
+	char flight_mode;
+	int navigation_line;        // 1...
+	unsigned int servo_trigger;
+};
 
-struct LogLine
+// The LogLine of older firmware (built without DETAILED_LOG or RAW_50HZ_LOG)
+struct LogLegacy
 {
-	double gps_latitude_rad;    // 8
-	double gps_longitude_rad;   // 8
-    unsigned long date;                  // 4
-    unsigned long time;                  // 4
-	int gps_height_m;           // 2
-	unsigned char gps_speed_m_s;// 1
-	int gps_heading;            // 2
-	int pitch;                  // 2
-	int roll;                   // 2
-	int yaw;                    // 2
-
-	char  control_state;        // 1
-	char temperature_c;         // 1
-	int  height_m;              // 2
-	int  navigation_code_line;  // 2 
-    unsigned int servo_trigger; // 2 = 44
+	double gps_latitude_rad;
+	double gps_longitude_rad;
+	unsigned long date;
+	unsigned long time;
+	int gps_height_m;
+	unsigned char gps_speed_m_s;   // * 3
+	int gps_heading;
+	int pitch;
+	int roll;
+	int yaw;
+	char control_state;
+	char temperature_c;
+	int height_m;
+	int navigation_code_line;
+	unsigned int servo_trigger;
 };
 
-#endif
+union LogRecord
+{
+	struct LogGps gps;
+	struct LogControl control;
+	struct LogImu imu;
+	struct LogEvent event;
+};
 
+// datalogger_records.c
+extern const struct LogRecordType log_record_types[LOG_RECORD_TYPES];
+extern const struct LogRecordType log_legacy_type;
 
 
 void datalogger_init();
-void datalogger_writeline(struct LogLine *line);
+void datalogger_write_record(int type, const union LogRecord *record);
+int datalogger_set_period(int id, int ticks);
 void datalogger_task( void *parameters );
 void datalogger_format();
-int datalogger_print_next_page(int index, void(*printer)(struct LogLine*));
-int datalogger_print_next_page_of_all(int index, void(*printer)(struct LogLine*));
+int datalogger_format_progress();
+int datalogger_print_next_page(int index, void(*printer)(struct LogSchema*, int));
+int datalogger_print_next_page_of_all(int index, void(*printer)(struct LogSchema*, int));
+unsigned char *datalogger_read_page(int page);
+void datalogger_write(int page, int size, unsigned char *buffer);
 
 void datalogger_enable();
 void datalogger_disable();
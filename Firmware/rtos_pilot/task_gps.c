@@ -63,7 +63,7 @@ void sensors_gps_task( void *parameters )
 	}
 
 
-	gps_config_output();  // configure sentences and switch to 115200 baud
+	gps_config_output(&(config.gps));  // configure sentences and switch to 115200 baud
 
 
 	vTaskDelay(( ( portTickType ) 100 / portTICK_RATE_MS ) );
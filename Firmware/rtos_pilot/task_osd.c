@@ -13,6 +13,7 @@
 #include "ppm_in/ppm_in.h"
 #include "adc/adc.h"
 #include "uart1_queue/uart1_queue.h"
+#include "fastmath/fastmath.h"
 #include "ppm_in/ppm_in.h"
 
 #include "common.h"
@@ -866,7 +867,7 @@ void osd_print_static_data()
 
 float gravity_to_roll2(float a_y, float a_z)
 {
-	float roll_acc = atan(a_y / a_z);
+	float roll_acc = fastmath_atan(a_y / a_z);
 	if (a_z > 0.0)
 	{
 		if (a_y < 0.0)	
@@ -878,7 +879,7 @@ float gravity_to_roll2(float a_y, float a_z)
 }	
 float gravity_to_pitch2(float a_x, float a_z)
 {
-	float pitch_acc = -atan(a_x / a_z); // replace with asin?
+	float pitch_acc = -fastmath_atan(a_x / a_z); // replace with asin?
 
 	if (a_z > 0.0)
 		pitch_acc =  -pitch_acc;
@@ -902,7 +903,7 @@ void osd_print_artificial_horizon2()
     int pitch_increment = (int)(sensor_data.pitch*(180.0/3.14/FOV_V*18.0)) + 3;
 
     //double FOV_H =
-    float tanroll = tanf(sensor_data.roll);
+    float tanroll = fastmath_tan(sensor_data.roll);
     for (i = -7; i < 8; i++) // -0.7..0.7 -> -18..18
     {
         if (i == 0)
@@ -935,22 +936,22 @@ void osd_print_artificial_horizon()
 
 	int pitch_increment = (int)(sensor_data.pitch*(180.0/3.14/22.0*7.0));   // > 22 = out of screen
 	// hor: 7..14..21    ver: 3.3 .. 7.1 (15 stappen) -> 1..8..15
-	//// optimize me: precalculated tanf
-	int y7 = 8 - (int)(tanf(sensor_data.roll)*-10.8) + pitch_increment;
-	int y8 = 8 - (int)(tanf(sensor_data.roll)*-9.26) + pitch_increment;
-	int y9 = 8 - (int)(tanf(sensor_data.roll)*-7.71) + pitch_increment;
-	int y10 = 8 - (int)(tanf(sensor_data.roll)*-6.17) + pitch_increment;
-	int y11 = 8 - (int)(tanf(sensor_data.roll)*-4.63) + pitch_increment;
-	int y12 = 8 - (int)(tanf(sensor_data.roll)*-3.09) + pitch_increment;
-	int y13 = 8 - (int)(tanf(sensor_data.roll)*-1.54) + pitch_increment;
+	float tanroll = fastmath_tan(sensor_data.roll);
+	int y7 = 8 - (int)(tanroll*-10.8) + pitch_increment;
+	int y8 = 8 - (int)(tanroll*-9.26) + pitch_increment;
+	int y9 = 8 - (int)(tanroll*-7.71) + pitch_increment;
+	int y10 = 8 - (int)(tanroll*-6.17) + pitch_increment;
+	int y11 = 8 - (int)(tanroll*-4.63) + pitch_increment;
+	int y12 = 8 - (int)(tanroll*-3.09) + pitch_increment;
+	int y13 = 8 - (int)(tanroll*-1.54) + pitch_increment;
 	int y14 = 8 + pitch_increment;
-	int y15 = 8 - (int)(tanf(sensor_data.roll)*1.54) + pitch_increment;
-	int y16 = 8 - (int)(tanf(sensor_data.roll)*3.09) + pitch_increment;
-	int y17 = 8 - (int)(tanf(sensor_data.roll)*4.63) + pitch_increment;
-	int y18 = 8 - (int)(tanf(sensor_data.roll)*6.17) + pitch_increment;
-	int y19 = 8 - (int)(tanf(sensor_data.roll)*7.71) + pitch_increment;
-	int y20 = 8 - (int)(tanf(sensor_data.roll)*9.26) + pitch_increment;
-	int y21 = 8 - (int)(tanf(sensor_data.roll)*10.8) + pitch_increment;
+	int y15 = 8 - (int)(tanroll*1.54) + pitch_increment;
+	int y16 = 8 - (int)(tanroll*3.09) + pitch_increment;
+	int y17 = 8 - (int)(tanroll*4.63) + pitch_increment;
+	int y18 = 8 - (int)(tanroll*6.17) + pitch_increment;
+	int y19 = 8 - (int)(tanroll*7.71) + pitch_increment;
+	int y20 = 8 - (int)(tanroll*9.26) + pitch_increment;
+	int y21 = 8 - (int)(tanroll*10.8) + pitch_increment;
 	
 	if ((y7) < 16 && y7 >= 0) {
         previous_positions[0] = y7/3;
@@ -0,0 +1,90 @@
+/*!
+ *  Bandwidth-budgeted telemetry, see telemetry_scheduler.h.
+ *
+ *  Integer only: the credit is counted in bytes times ticks per second, so
+ *  a tick earns bytes_per_second and a sample costs size * ticks_per_second.
+ *
+ *  @file     telemetry_scheduler.c
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include <stddef.h>
+
+#include "telemetry_scheduler.h"
+
+
+void telemetry_scheduler_init(struct TelemetryLink *link, long baudrate, int ticks_per_second)
+{
+	link->bytes_per_second = baudrate / 10 * TELEMETRY_LINK_SHARE / 100;   // 8N1: 10 bits per byte
+	link->ticks_per_second = ticks_per_second;
+	link->credit = 0;
+}
+
+
+/*!
+ *   Sends the streams that are due, as long as the credit of the link lasts.
+ */
+void telemetry_scheduler_tick(struct TelemetryLink *link, struct TelemetryStream *streams, int count)
+{
+	long most_credit = 2 * link->bytes_per_second;   // no bursts after a quiet period
+	int i;
+
+	for (i = 0; i < count; i++)
+	{
+		long cost = (long)streams[i].size * link->ticks_per_second;
+
+		if (streams[i].period == 0)
+			streams[i].age = 0;
+		else
+			streams[i].age++;
+		if (cost > most_credit)
+			most_credit = cost;   // a big sample must fit once
+	}
+	link->credit += link->bytes_per_second;
+	if (link->credit > most_credit)
+		link->credit = most_credit;
+
+	for (;;)
+	{
+		struct TelemetryStream *best = NULL;
+		long best_value = 0;
+
+		// The most valuable due stream that fits in the credit
+		for (i = 0; i < count; i++)
+		{
+			struct TelemetryStream *s = &streams[i];
+			long value;
+
+			if (s->period == 0 || s->age < s->period ||
+			    (long)s->size * link->ticks_per_second > link->credit)
+				continue;
+			value = (long)s->priority * s->age * 256 / s->period;
+			if (value > best_value || best == NULL)
+			{
+				best = s;
+				best_value = value;
+			}
+		}
+		if (best == NULL || ! best->send())
+			break;   // nothing fits, or the uart is busy: the rest waits
+		link->credit -= (long)best->size * link->ticks_per_second;
+		best->sent++;
+		best->age = 0;
+	}
+
+	for (i = 0; i < count; i++)
+	{
+		struct TelemetryStream *s = &streams[i];
+
+		if (s->period == 0 || s->age < s->period)
+			continue;
+		if (s->age == s->period)
+			s->deferred++;
+		else if (s->age >= 2 * s->period)
+		{
+			s->dropped++;   // the next sample is due: only send the newest
+			s->age -= s->period;
+		}
+	}
+}
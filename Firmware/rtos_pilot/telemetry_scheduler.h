@@ -0,0 +1,46 @@
+#ifndef TELEMETRY_SCHEDULER_H
+#define TELEMETRY_SCHEDULER_H
+
+/*!
+ *  Decides which telemetry streams are sent every tick of the telemetry task,
+ *  within the capacity of the link.
+ *
+ *  Every stream has a target period (in ticks), a priority and the number of
+ *  bytes a sample takes on the link. The link earns the bytes per second it
+ *  may use every second, spread over the ticks. Every tick the due streams
+ *  are sent most valuable first: priority times how late they are. A stream
+ *  that doesn't fit anymore waits for the next tick (deferred), a sample
+ *  that is a whole period late is skipped (dropped): a slow link lowers the
+ *  rate of the least valuable streams first, and of all streams when even
+ *  the most valuable don't fit.
+ *
+ *  @file     telemetry_scheduler.h
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#define TELEMETRY_LINK_SHARE  80   //!< % of the baudrate for the streams, the rest for replies and messages
+
+struct TelemetryStream
+{
+	int (*send)();               //!< Sends a sample. Returns 0 when the uart is busy.
+	unsigned char priority;      //!< Higher is more valuable
+	unsigned char size;          //!< Bytes of a sample on the link
+	unsigned char period;        //!< Target: a sample every "period" ticks, 0 is off
+	unsigned int age;            //!< Ticks since the last sample
+	unsigned int sent;
+	unsigned int deferred;       //!< Samples that had to wait for a later tick
+	unsigned int dropped;        //!< Samples skipped, a period late
+};
+
+struct TelemetryLink
+{
+	long bytes_per_second;       //!< The share of the link for the streams
+	int ticks_per_second;
+	long credit;                 //!< Bytes that may be sent, times ticks_per_second
+};
+
+void telemetry_scheduler_init(struct TelemetryLink *link, long baudrate, int ticks_per_second);
+void telemetry_scheduler_tick(struct TelemetryLink *link, struct TelemetryStream *streams, int count);
+
+#endif // TELEMETRY_SCHEDULER_H
@@ -0,0 +1,690 @@
+/*!
+ *  Offline replay of raw sensor logs through the attitude filter.
+ *
+ *  Reads the raw sensor records of a dataflash image (as saved by "sitl -f" or
+ *  read out of the aircraft, with log_image.c) or of a log export (the "DD;..." lines printed by
+ *  the DR command) and runs them through ahrs_filter() as fast as the host can.
+ *  Both the "Imu" records of the current logs (logged at 50Hz with "DP;3;1")
+ *  and the LogLines of firmware built with RAW_50HZ_LOG are read. The filter is the real one from rtos_pilot: this file
+ *  is linked with ahrs_kalman_2x3.c (build/ahrs_replay) or with
+ *  ahrs_simple_quaternion.c (build/ahrs_replay_quaternion).
+ *
+ *  Usage: ahrs_replay [-n session] [-o trace.csv] [-d decimation] [-r rotation]
+ *                     [-a acc_x,acc_y,acc_z] [-g gyro_x,gyro_y,gyro_z] [-t tolerance] log
+ *
+ *  The neutral values, the board rotation and the neutral pitch are read from
+ *  the configuration page of an image. They default to the ones of the SITL
+ *  sensor model (see sim_sensors.c) for a log export or an image without a
+ *  configuration, and -a, -g and -r override them. For every session the
+ *  RMS difference between the replayed attitude and the attitude that was
+ *  logged in flight is printed, so a filter change can be checked against a
+ *  whole archive of flights.
+ *
+ *  build/ahrs_replay_q16 (compiled with AHRS_COMPARE) runs every session
+ *  through both ahrs_kalman_2x3.c and its fixed point version
+ *  ahrs_kalman_2x3_q16.c, and prints the difference between the two instead.
+ *  It exits with 1 when they differ more than -t degrees (default 1). The
+ *  checksum of the fixed point output is the same on every platform, so it
+ *  can be compared with what the dsPIC computes from the same log.
+ *
+ *  @file     ahrs_replay.c
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "uart1_queue/uart1_queue.h"
+#include "button/button.h"
+#include "hmc5843/hmc5843.h"
+
+#include "ahrs.h"
+#include "sensors.h"
+#include "configuration.h"
+#include "task_datalogger.h"
+#include "common.h"
+
+#include "log_image.h"
+
+#define LOGLINE_SIZE       34     //!< sizeof(struct LogLine) with RAW_50HZ_LOG on the dsPIC
+#define DT                 0.02f  //!< 50Hz
+
+//! One raw log record, decoded
+struct ReplaySample
+{
+	unsigned int acc_x_raw, acc_y_raw, acc_z_raw;
+	unsigned int gyro_x_raw, gyro_y_raw, gyro_z_raw;
+	float speed_ms;
+	float heading_rad;
+	float pressure_height;
+	float logged_roll_deg, logged_pitch_deg;
+	char gps_valid;
+	char session;
+};
+
+struct ReplayAttitude
+{
+	float roll, pitch, yaw;
+};
+
+struct Configuration config;
+
+#ifdef AHRS_COMPARE
+// ahrs_kalman_2x3_q16.c, compiled with these names (see Makefile)
+void ahrs_q16_init();
+void ahrs_q16_filter(float dt);
+#endif
+
+static void (*filter_init)() = ahrs_init;
+static void (*filter_run)(float dt) = ahrs_filter;
+
+static struct ReplaySample *samples = NULL;
+static int samples_count = 0, samples_size = 0;
+
+
+// The firmware's filters use these
+void uart1_puts(char *str)
+{
+	fputs(str, stderr);
+}
+
+int button_down()
+{
+	return 0;
+}
+
+void hmc5843_read(struct intvector *magdata)
+{
+	memset(magdata, 0, sizeof(struct intvector));
+}
+
+
+/*!
+ *   Runs n samples through ahrs_filter(), like sensors_mpu6000_task() does.
+ *   The first sample of a session (re)initializes the filter.
+ */
+void ahrs_replay_batch(const struct ReplaySample *s, struct ReplayAttitude *attitude, int n)
+{
+	static float last_height = 0.0f;
+	static int counter = 0;
+	int i;
+
+	for (i = 0; i < n; i++, s++)
+	{
+		sensor_data.acc_x_raw = s->acc_x_raw;
+		sensor_data.acc_y_raw = s->acc_y_raw;
+		sensor_data.acc_z_raw = s->acc_z_raw;
+		sensor_data.gyro_x_raw = s->gyro_x_raw;
+		sensor_data.gyro_y_raw = s->gyro_y_raw;
+		sensor_data.gyro_z_raw = s->gyro_z_raw;
+		sensor_data.gps.speed_ms = s->speed_ms;
+		sensor_data.gps.heading_rad = s->heading_rad;
+		sensor_data.gps.satellites_in_view = s->gps_valid ? 6 : 0;
+		sensor_data.pressure_height = s->pressure_height;
+		sensors_mpu6000_scale();
+
+		if (i == 0 || s->session != s[-1].session)
+		{
+			sensor_data.yaw = s->heading_rad;
+			sensor_data.vertical_speed = 0.0f;
+			last_height = s->pressure_height;
+			counter = 0;
+			filter_init();
+		}
+
+		if (++counter == 25)  // 2Hz
+		{
+			sensor_data.vertical_speed = sensor_data.vertical_speed * 0.9f + (sensor_data.pressure_height - last_height) / 0.5f * 0.1f;
+			last_height = sensor_data.pressure_height;
+			counter = 0;
+		}
+
+		filter_run(DT);
+
+		attitude[i].roll = sensor_data.roll;
+		attitude[i].pitch = sensor_data.pitch;
+		attitude[i].yaw = sensor_data.yaw;
+	}
+}
+
+
+static void add_sample(struct ReplaySample *s)
+{
+	if (samples_count == samples_size)
+	{
+		samples_size = samples_size ? samples_size * 2 : 65536;
+		samples = realloc(samples, samples_size * sizeof(struct ReplaySample));
+		if (samples == NULL)
+		{
+			fprintf(stderr, "Out of memory\n");
+			exit(1);
+		}
+	}
+	samples[samples_count++] = *s;
+}
+
+
+// The dsPIC is little endian, with 16 bit ints and IEEE 754 floats
+static unsigned int get_u16(const unsigned char *b)
+{
+	return b[0] | (b[1] << 8);
+}
+
+static int get_s16(const unsigned char *b)
+{
+	return (short)get_u16(b);
+}
+
+static unsigned long get_u32(const unsigned char *b)
+{
+	return b[0] | (b[1] << 8) | ((unsigned long)b[2] << 16) | ((unsigned long)b[3] << 24);
+}
+
+static float get_float(const unsigned char *b)
+{
+	union { unsigned int u; float f; } v;
+	v.u = (unsigned int)get_u32(b);
+	return v.f;
+}
+
+
+/*!
+ *   Decodes a RAW_50HZ_LOG LogLine.
+ *   @return 0 for an empty or invalid record (the end of the log)
+ */
+static int decode_logline(const unsigned char *b, struct ReplaySample *s)
+{
+	float latitude = get_float(b), longitude = get_float(b + 4);
+
+	if (! (latitude < DEG2RAD(360.0) && longitude < DEG2RAD(360.0)))   // also catches NaN (erased flash)
+		return 0;
+
+	s->gps_valid = latitude != 0.0f || longitude != 0.0f;
+	s->speed_ms = b[12] / 10.0f;
+	s->heading_rad = DEG2RAD(b[13] * 2.0f);
+	s->acc_x_raw = get_u16(b + 14);
+	s->acc_y_raw = get_u16(b + 16);
+	s->acc_z_raw = get_u16(b + 18);
+	s->gyro_x_raw = get_u16(b + 20);
+	s->gyro_y_raw = get_u16(b + 22);
+	s->gyro_z_raw = get_u16(b + 24);
+	s->logged_roll_deg = get_s16(b + 26);
+	s->logged_pitch_deg = get_s16(b + 28);
+	s->pressure_height = get_s16(b + 32) / 5.0f;
+	return 1;
+}
+
+
+//! The latest value of the fields of a log a ReplaySample is made of
+struct ReplayHold
+{
+	struct ReplaySample s;
+	double latitude, longitude;
+};
+
+/*!
+ *   Keeps the value of a field of the log (see datalogger_records.c) when
+ *   a ReplaySample is made of it.
+ */
+static void hold_field(struct ReplayHold *h, const char *name, double v)
+{
+	if (strcmp(name, "AccX") == 0)
+		h->s.acc_x_raw = (unsigned int)v;
+	else if (strcmp(name, "AccY") == 0)
+		h->s.acc_y_raw = (unsigned int)v;
+	else if (strcmp(name, "AccZ") == 0)
+		h->s.acc_z_raw = (unsigned int)v;
+	else if (strcmp(name, "GyroX") == 0)
+		h->s.gyro_x_raw = (unsigned int)v;
+	else if (strcmp(name, "GyroY") == 0)
+		h->s.gyro_y_raw = (unsigned int)v;
+	else if (strcmp(name, "GyroZ") == 0)
+		h->s.gyro_z_raw = (unsigned int)v;
+	else if (strcmp(name, "SpeedGPS") == 0)
+		h->s.speed_ms = v;
+	else if (strcmp(name, "HeadingGPS") == 0)
+		h->s.heading_rad = DEG2RAD(v);
+	else if (strcmp(name, "HeightBaro") == 0)
+		h->s.pressure_height = v;
+	else if (strcmp(name, "Roll") == 0)
+		h->s.logged_roll_deg = v;
+	else if (strcmp(name, "Pitch") == 0)
+		h->s.logged_pitch_deg = v;
+	else if (strcmp(name, "Latitude") == 0)
+		h->latitude = v;
+	else if (strcmp(name, "Longitude") == 0)
+		h->longitude = v;
+	h->s.gps_valid = h->latitude != 0.0 || h->longitude != 0.0;
+}
+
+
+//! A session being read from an image, for the handlers of log_image_walk()
+struct ReplaySession
+{
+	const struct LogImage *image;
+	struct LogSchema schema;
+	struct ReplayHold h;
+	int session;
+};
+
+/*!
+ *   Keeps the fields of a record of a page with record types (see
+ *   task_datalogger.c). Every "Imu" record adds a sample.
+ */
+static void read_record(void *context, int record)
+{
+	struct ReplaySession *rs = context;
+	int i;
+
+	for (i = rs->schema.first[record]; i < rs->schema.first[record] + rs->schema.count[record]; i++)
+		hold_field(&rs->h, rs->schema.field[i].name, logschema_value(&rs->schema, i));
+	if (strcmp(rs->schema.name[record], "Imu") == 0)
+	{
+		rs->h.s.session = rs->session;
+		add_sample(&rs->h.s);
+	}
+}
+
+
+/*!
+ *   Reads a page of a session: records or, for firmware built with
+ *   RAW_50HZ_LOG, LogLines.
+ *   @return 0 at the end of the log
+ */
+static int read_page(void *context, const unsigned char *p)
+{
+	struct ReplaySession *rs = context;
+	struct ReplaySample s;
+	int j;
+
+	if (log_image_get(p, 2) & LOG_PAGE_PACKED)
+		return log_image_read_records(rs->image, p, &rs->schema, read_record, rs);
+	for (j = 0; j < (rs->image->page_size - 2) / LOGLINE_SIZE; j++)
+	{
+		if (! decode_logline(p + 2 + j * LOGLINE_SIZE, &s))
+			return 0;
+		s.session = rs->session;
+		add_sample(&s);
+	}
+	return 1;
+}
+
+
+/*!
+ *   Reads the struct SensorConfig at the start of the configuration page
+ *   (CONFIGURATION_PAGE, see configuration_write()). Its 6 floats are at the
+ *   same place for both compilers, the BoardRotation after them is an int.
+ *   @return 0 when the page holds no configuration
+ */
+static int read_sensor_config(const struct LogImage *image, struct SensorConfig *c)
+{
+	const unsigned char *b = image->flash;
+	int int_size = image->layout != NULL ? image->layout->int_size : 2;
+	float neutral[6];
+	int i;
+
+	for (i = 0; i < 6; i++)
+	{
+		neutral[i] = get_float(b + i * 4);
+		if (! (neutral[i] > 0.0f && neutral[i] < 65536.0f))   // also catches NaN (erased flash)
+			return 0;
+	}
+	c->acc_x_neutral = neutral[0];
+	c->acc_y_neutral = neutral[1];
+	c->acc_z_neutral = neutral[2];
+	c->gyro_x_neutral = neutral[3];
+	c->gyro_y_neutral = neutral[4];
+	c->gyro_z_neutral = neutral[5];
+	c->imu_rotated = log_image_get_signed(b + 24, int_size);
+	c->neutral_pitch = get_float(b + 24 + int_size);
+	return 1;
+}
+
+
+static void read_image(const struct LogImage *image, int session)
+{
+	static struct ReplaySession rs;
+	int i;
+
+	rs.image = image;
+	for (i = 1; i <= image->sessions; i++)
+		if (session == 0 || session == i)
+		{
+			logschema_clear(&rs.schema);
+			memset(&rs.h, 0, sizeof(rs.h));
+			rs.session = i;
+			log_image_walk(image, i, read_page, &rs);
+		}
+}
+
+
+/*!
+ *   Removes the "$" and "*xx" of a line with a checksum (see
+ *   print_logrecord()).
+ *   @return 0 when the checksum is wrong
+ */
+static int strip_checksum(char *line)
+{
+	char *star = strrchr(line, '*'), *c;
+	unsigned int checksum = 0, expected;
+
+	if (line[0] != '$')
+		return 1;
+	if (star == NULL || sscanf(star + 1, "%2x", &expected) != 1)
+		return 0;
+	*star = '\0';
+	for (c = line + 1; c < star; c++)
+		checksum ^= (unsigned char)*c;
+	memmove(line, line + 1, star - line);
+	return checksum == expected;
+}
+
+
+/*!
+ *   Reads a log export. Every header line (DH;...) starts a new session.
+ *   With a "Record" column (current firmware) the columns are found by name
+ *   and every "Imu" row is a sample. Otherwise the rows are the RAW_50HZ_LOG
+ *   LogLines: DD;lat;lon;time;speed;heading;accx;accy;accz;gyrox;gyroy;
+ *   gyroz;height;pitch;roll;pitch_acc.
+ */
+static void read_export(FILE *f, int session)
+{
+	static char line[2048], header[2048];
+	char *names[LOGSCHEMA_MAX_FIELDS + 1];
+	int current = 0, columns = 0;
+	struct ReplayHold h;
+	struct ReplaySample s;
+
+	while (fgets(line, sizeof(line), f) != NULL)
+	{
+		float latitude, longitude, roll, pitch;
+		unsigned long time;
+		float heading;
+
+		if (! strip_checksum(line))
+			continue;
+		if (strncmp(line, "DH;", 3) == 0)
+		{
+			char *name;
+
+			current++;
+			strcpy(header, line + 3);
+			columns = 0;
+			memset(&h, 0, sizeof(h));
+			for (name = strtok(header, ";\r\n"); name != NULL && columns <= LOGSCHEMA_MAX_FIELDS; name = strtok(NULL, ";\r\n"))
+				names[columns++] = name;
+			if (columns > 0 && strcmp(names[0], "Record") != 0)
+				columns = 0;   // RAW_50HZ_LOG
+		}
+		if (strncmp(line, "DD;", 3) != 0 || (session != 0 && session != current))
+			continue;
+
+		if (columns > 0)
+		{
+			char *value = strtok(line + 3, ";\r\n");
+			int i, imu = value != NULL && strcmp(value, "Imu") == 0;
+
+			for (i = 1; i < columns && (value = strtok(NULL, ";\r\n")) != NULL; i++)
+				hold_field(&h, names[i], atof(value));
+			if (imu)
+			{
+				h.s.session = current;
+				add_sample(&h.s);
+			}
+			continue;
+		}
+
+		if (sscanf(line + 3, "%f;%f;%lu;%f;%f;%u;%u;%u;%u;%u;%u;%f;%f;%f", &latitude, &longitude, &time,
+		           &s.speed_ms, &heading, &s.acc_x_raw, &s.acc_y_raw, &s.acc_z_raw,
+		           &s.gyro_x_raw, &s.gyro_y_raw, &s.gyro_z_raw, &s.pressure_height, &pitch, &roll) != 14)
+			continue;
+		s.gps_valid = latitude != 0.0f || longitude != 0.0f;
+		s.heading_rad = DEG2RAD(heading);
+		s.logged_roll_deg = roll;
+		s.logged_pitch_deg = pitch;
+		s.session = current;
+		add_sample(&s);
+	}
+}
+
+
+static double wrap_180(double e)
+{
+	if (e > 180.0)
+		e -= 360.0;
+	else if (e < -180.0)
+		e += 360.0;
+	return e;
+}
+
+
+static void replay_timed(const char *name, struct ReplayAttitude *attitude)
+{
+	struct timespec start, end;
+	double seconds;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	ahrs_replay_batch(samples, attitude, samples_count);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+	fprintf(stderr, "%s: %d samples (%.0f s of flight) in %.3f s: %.2f Msamples/s\n", name, samples_count,
+	        samples_count * DT, seconds, samples_count / seconds / 1e6);
+}
+
+
+#ifdef AHRS_COMPARE
+/*!
+ *   Prints the difference between the float (reference) and the fixed point
+ *   filter per session, and a checksum (FNV-1a) of the fixed point output.
+ *   @return 1 when a difference is larger than tolerance_deg
+ */
+static int compare(const struct ReplayAttitude *reference, const struct ReplayAttitude *attitude, double tolerance_deg)
+{
+	unsigned long checksum = 2166136261UL;
+	int i, first, failed = 0;
+
+	printf("session;samples;rms_roll_diff_deg;rms_pitch_diff_deg;max_roll_diff_deg;max_pitch_diff_deg;max_yaw_diff_deg\n");
+	for (first = 0; first < samples_count; first = i)
+	{
+		double roll2 = 0.0, pitch2 = 0.0, max_roll = 0.0, max_pitch = 0.0, max_yaw = 0.0;
+
+		for (i = first; i < samples_count && samples[i].session == samples[first].session; i++)
+		{
+			const unsigned char *b = (const unsigned char *)&attitude[i];
+			double e;
+			int j;
+
+			e = fabs(wrap_180(RAD2DEG(attitude[i].roll - reference[i].roll)));
+			roll2 += e * e;
+			max_roll = MAX(max_roll, e);
+			e = fabs(RAD2DEG(attitude[i].pitch - reference[i].pitch));
+			pitch2 += e * e;
+			max_pitch = MAX(max_pitch, e);
+			e = fabs(wrap_180(RAD2DEG(attitude[i].yaw - reference[i].yaw)));
+			max_yaw = MAX(max_yaw, e);
+
+			for (j = 0; j < (int)sizeof(struct ReplayAttitude); j++)
+				checksum = ((checksum ^ b[j]) * 16777619UL) & 0xFFFFFFFFUL;
+		}
+		printf("%d;%d;%.4f;%.4f;%.4f;%.4f;%.4f\n", samples[first].session, i - first, sqrt(roll2 / (i - first)),
+		       sqrt(pitch2 / (i - first)), max_roll, max_pitch, max_yaw);
+		if (max_roll > tolerance_deg || max_pitch > tolerance_deg)
+			failed = 1;
+	}
+	printf("fixed point checksum: %08lx\n", checksum);
+	if (failed)
+		fprintf(stderr, "Fixed point filter differs more than %.2f deg from the float filter\n", tolerance_deg);
+	return failed;
+}
+#endif
+
+
+static void usage()
+{
+	fprintf(stderr, "Usage: ahrs_replay [-n session] [-o trace.csv] [-d decimation] [-r rotation]\n"
+	                "                   [-a acc_x,acc_y,acc_z] [-g gyro_x,gyro_y,gyro_z] [-t tolerance] log\n");
+	exit(1);
+}
+
+
+int main(int argc, char *argv[])
+{
+	struct ReplayAttitude *attitude;
+	struct LogImage image;
+	struct SensorConfig image_config;
+	FILE *f, *trace = NULL;
+	int session = 0, decimation = 1, acc_set = 0, gyro_set = 0, rotation_set = 0;
+	int c, i, first, result = 0;
+#ifdef AHRS_COMPARE
+	double tolerance_deg = 1.0;
+#endif
+
+	config.sensors.acc_x_neutral = 32768;   // as sitl_main.c
+	config.sensors.acc_y_neutral = 32768;
+	config.sensors.acc_z_neutral = 32768;
+	config.sensors.gyro_x_neutral = 32768.0f;
+	config.sensors.gyro_y_neutral = 32768.0f;
+	config.sensors.gyro_z_neutral = 32768.0f;
+	config.sensors.imu_rotated = ROTATION_0;
+	config.sensors.neutral_pitch = 0.0f;
+
+	while ((c = getopt(argc, argv, "n:o:d:r:a:g:t:")) != -1)
+	{
+		switch (c)
+		{
+			case 'n': session = atoi(optarg); break;
+			case 'o':
+				trace = fopen(optarg, "w");
+				if (trace == NULL)
+				{
+					perror(optarg);
+					return 1;
+				}
+				break;
+			case 'd': decimation = atoi(optarg); break;
+			case 'r':
+				config.sensors.imu_rotated = atoi(optarg);
+				rotation_set = 1;
+				break;
+			case 'a':
+				if (sscanf(optarg, "%f,%f,%f", &config.sensors.acc_x_neutral, &config.sensors.acc_y_neutral,
+				           &config.sensors.acc_z_neutral) != 3)
+					usage();
+				acc_set = 1;
+				break;
+			case 'g':
+				if (sscanf(optarg, "%f,%f,%f", &config.sensors.gyro_x_neutral, &config.sensors.gyro_y_neutral,
+				           &config.sensors.gyro_z_neutral) != 3)
+					usage();
+				gyro_set = 1;
+				break;
+#ifdef AHRS_COMPARE
+			case 't': tolerance_deg = atof(optarg); break;
+#endif
+			default: usage();
+		}
+	}
+	if (optind != argc - 1 || decimation < 1)
+		usage();
+
+	if (log_image_open(argv[optind], &image))
+	{
+		if (read_sensor_config(&image, &image_config))
+		{
+			if (! acc_set)
+			{
+				config.sensors.acc_x_neutral = image_config.acc_x_neutral;
+				config.sensors.acc_y_neutral = image_config.acc_y_neutral;
+				config.sensors.acc_z_neutral = image_config.acc_z_neutral;
+			}
+			if (! gyro_set)
+			{
+				config.sensors.gyro_x_neutral = image_config.gyro_x_neutral;
+				config.sensors.gyro_y_neutral = image_config.gyro_y_neutral;
+				config.sensors.gyro_z_neutral = image_config.gyro_z_neutral;
+			}
+			if (! rotation_set)
+				config.sensors.imu_rotated = image_config.imu_rotated;
+			config.sensors.neutral_pitch = image_config.neutral_pitch;
+		}
+		read_image(&image, session);
+		log_image_close(&image);
+	}
+	else
+	{
+		f = fopen(argv[optind], "r");
+		if (f == NULL)
+		{
+			perror(argv[optind]);
+			return 1;
+		}
+		read_export(f, session);
+		fclose(f);
+	}
+
+	if (samples_count == 0)
+	{
+		fprintf(stderr, "No raw log records found\n");
+		return 1;
+	}
+	fprintf(stderr, "neutrals: acc %.0f,%.0f,%.0f gyro %.0f,%.0f,%.0f, rotation %d, neutral pitch %.3f\n",
+	        config.sensors.acc_x_neutral, config.sensors.acc_y_neutral, config.sensors.acc_z_neutral,
+	        config.sensors.gyro_x_neutral, config.sensors.gyro_y_neutral, config.sensors.gyro_z_neutral,
+	        (int)config.sensors.imu_rotated, config.sensors.neutral_pitch);
+
+	attitude = malloc(samples_count * sizeof(struct ReplayAttitude));
+#ifdef AHRS_COMPARE
+	{
+		struct ReplayAttitude *reference = malloc(samples_count * sizeof(struct ReplayAttitude));
+
+		replay_timed("float", reference);
+		filter_init = ahrs_q16_init;
+		filter_run = ahrs_q16_filter;
+		replay_timed("fixed point", attitude);
+		result = compare(reference, attitude, tolerance_deg);
+		free(reference);
+	}
+#else
+	replay_timed("ahrs_filter", attitude);
+#endif
+
+	if (trace != NULL)
+	{
+		fprintf(trace, "session;time_s;roll_deg;pitch_deg;yaw_deg;logged_roll_deg;logged_pitch_deg\n");
+		for (i = 0, first = 0; i < samples_count; i++)
+		{
+			if (samples[i].session != samples[first].session)
+				first = i;
+			if ((i - first) % decimation == 0)
+				fprintf(trace, "%d;%.2f;%.2f;%.2f;%.2f;%.0f;%.0f\n", samples[i].session, (i - first) * DT,
+				        RAD2DEG(attitude[i].roll), RAD2DEG(attitude[i].pitch), RAD2DEG(attitude[i].yaw),
+				        samples[i].logged_roll_deg, samples[i].logged_pitch_deg);
+		}
+		fclose(trace);
+	}
+
+#ifndef AHRS_COMPARE
+	// Difference with what the aircraft's filter logged, per session
+	printf("session;samples;rms_roll_diff_deg;rms_pitch_diff_deg\n");
+	for (first = 0; first < samples_count; first = i)
+	{
+		double roll2 = 0.0, pitch2 = 0.0;
+
+		for (i = first; i < samples_count && samples[i].session == samples[first].session; i++)
+		{
+			double e = wrap_180(RAD2DEG(attitude[i].roll) - samples[i].logged_roll_deg);
+			roll2 += e * e;
+			e = RAD2DEG(attitude[i].pitch) - samples[i].logged_pitch_deg;
+			pitch2 += e * e;
+		}
+		printf("%d;%d;%.3f;%.3f\n", samples[first].session, i - first, sqrt(roll2 / (i - first)), sqrt(pitch2 / (i - first)));
+	}
+#endif
+
+	return result;
+}
@@ -0,0 +1,602 @@
+/*!
+ *  Benchmarks of the firmware's hot paths on the host.
+ *
+ *  The firmware units are the ones of the SITL build (sensor_data, config and
+ *  navigation_data are the real globals), but no task is started: each
+ *  function is called directly, many times, with a table of inputs. The
+ *  tables are generated with a fixed seed before the timing starts, so every
+ *  run sees the same inputs:
+ *   - sensor readings of a plane rolling +-30 and pitching +-10 degrees, with
+ *     sensor noise
+ *   - positions along a 400m square around home, and the GPS sentences
+ *     describing them
+ *   - controller errors and servo outputs derived from those
+ *
+ *  A calibration loop (plain float and integer arithmetic, no firmware) and
+ *  every function are timed in turn, 40 rounds of runs of at least 10ms
+ *  each, so even the functions of a few ns are called about a million times
+ *  per run. The best run gives the ns per call, the calls per second and the
+ *  cost: the ns per call divided by the ns of the calibration loop. A clock
+ *  that changes speed between two runs of bench changes both, so the cost is
+ *  what is compared with the baseline. When a function is slower than the
+ *  baseline everything is measured again, up to 3 times, keeping the best
+ *  cost of each function.
+ *
+ *  Usage: bench [-n scale] [-b baseline.csv] [-t tolerance-pct] [-w baseline.csv]
+ *
+ *   -n  Multiply the duration of the runs (default 1)
+ *   -b  Compare with a baseline. Exits with 1 when the cost of a function got
+ *       higher than the tolerance (default 20%).
+ *   -w  Write the results as the new baseline.
+ *
+ *  A host is much faster than the 40 MIPS dsPIC, and the costs still depend
+ *  on the processor: a baseline is only meaningful on the host that wrote it.
+ *  "make bench" writes one in the build directory the first time.
+ *
+ *  @file     bench.c
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "FreeRTOS/FreeRTOS.h"
+#include "FreeRTOS/task.h"
+#include "FreeRTOS/semphr.h"
+
+#include "gps/gps.h"
+#include "pid/pid.h"
+#include "pid/pid_q16.h"
+
+#include "ahrs.h"
+#include "sensors.h"
+#include "configuration.h"
+#include "task_control.h"
+#include "control_mix.h"
+#include "handler_navigation.h"
+#include "gluonscript.h"
+#include "task_datalogger.h"
+#include "common.h"
+#include "sitl.h"
+
+#define SAMPLES      4096     //!< Length of the input tables (power of 2)
+#define RUNS         40
+#define RUN_S        0.01     //!< Shortest run, in seconds
+#define ATTEMPTS     3        //!< Measurements before a function is reported slower
+#define CALIBRATION_STEPS 16  //!< Of the calibration loop
+#define SIDE_M       400.0f   //!< Side of the square flown around home
+
+//! One recorded input
+struct BenchInput
+{
+	float acc_x, acc_y, acc_z;
+	float p, q, r;
+	float roll, pitch;
+	double latitude_rad, longitude_rad;
+	float speed_ms, heading_rad;
+};
+
+struct Benchmark
+{
+	const char *name;
+	void (*setup)();
+	void (*run)(int i);
+};
+
+struct BenchmarkResult
+{
+	long calls;                  //!< Per run
+	double ns_per_call;
+	double cost;                 //!< ns_per_call / ns of the calibration loop
+	double baseline_cost;        //!< 0 without baseline
+};
+
+// The SITL objects expect these from sitl_main.c
+unsigned long idle_counter = 0;
+unsigned long sitl_time_ms = 0;
+
+extern xSemaphoreHandle xGpsSemaphore;
+extern int rmc_sentence_number, gga_sentence_number;
+extern volatile char nmea_buffer_RMC[100];
+extern volatile char nmea_buffer_GGA[100];
+
+void navigation_do_circle(struct GluonscriptCode *current_code);
+
+static struct BenchInput input[SAMPLES];
+static char rmc[SAMPLES][100], gga[SAMPLES][100];   //!< Without "$GPxxx," and checksum: as buffered by gps_rx_char()
+static struct pid pid;
+static struct pid_q16_bank pid_bank;
+static q16 pid_position[SAMPLES], pid_out[PID_Q16_MAX_LOOPS];
+static struct GluonscriptCode circle;
+static union LogRecord log_records[SAMPLES][2];   // Gps, Control
+static unsigned char log_page[528];
+static volatile float sink;   // keeps results alive
+
+
+static void format_position(char *str, int size, double rad, int degree_digits)
+{
+	double deg = fabs(RAD2DEG(rad));
+	int whole = (int)deg;
+
+	if (snprintf(str, size, "%0*d%08.5f", degree_digits, whole, (deg - whole) * 60.0) >= size)
+		str[0] = '\0';   // no position rather than a wrong one
+}
+
+
+/*!
+ *   Generates the input tables.
+ */
+static void record_inputs()
+{
+	double home_latitude = DEG2RAD(50.83), home_longitude = DEG2RAD(4.35);
+	float along = 0.0f;
+	int i;
+
+	sitl_random_seed(1);
+	for (i = 0; i < SAMPLES; i++)
+	{
+		struct BenchInput *in = &input[i];
+		float t = i * 0.02f, north, east, heading_deg;
+		char lat[16], lon[16];
+		int side;
+
+		// Attitude and body rates, gravity in the accelerometers
+		in->roll = DEG2RAD(30.0f) * sinf(2.0f * PI * t / 8.0f);
+		in->pitch = DEG2RAD(10.0f) * sinf(2.0f * PI * t / 5.0f);
+		in->p = DEG2RAD(30.0f) * 2.0f * PI / 8.0f * cosf(2.0f * PI * t / 8.0f) + 0.005f * sitl_random_gauss();
+		in->q = DEG2RAD(10.0f) * 2.0f * PI / 5.0f * cosf(2.0f * PI * t / 5.0f) + 0.005f * sitl_random_gauss();
+		in->r = 0.005f * sitl_random_gauss();
+		in->acc_x = sinf(in->pitch) + 0.01f * sitl_random_gauss();
+		in->acc_y = -cosf(in->pitch) * sinf(in->roll) + 0.01f * sitl_random_gauss();
+		in->acc_z = -cosf(in->pitch) * cosf(in->roll) + 0.01f * sitl_random_gauss();
+
+		// Flying the square at 15m/s, 5 positions per second
+		along = fmodf(i * 3.0f, 4.0f * SIDE_M);
+		side = (int)(along / SIDE_M);
+		along -= side * SIDE_M;
+		north = side == 0 ? along : side == 1 ? SIDE_M : side == 2 ? SIDE_M - along : 0.0f;
+		east = side == 0 ? 0.0f : side == 1 ? along : side == 2 ? SIDE_M : SIDE_M - along;
+		in->latitude_rad = home_latitude + (north - SIDE_M / 2.0f) / 6363057.32484;
+		in->longitude_rad = home_longitude + (east - SIDE_M / 2.0f) / 4107840.76433121;
+		in->speed_ms = 15.0f;
+		in->heading_rad = DEG2RAD(side * 90.0f);
+
+		heading_deg = RAD2DEG(in->heading_rad);
+		format_position(lat, sizeof(lat), in->latitude_rad, 2);
+		format_position(lon, sizeof(lon), in->longitude_rad, 3);
+		snprintf(rmc[i], sizeof(rmc[i]), "%02d%02d%02d.%03d,A,%s,N,%s,E,%.3f,%.2f,010612,,,A",
+		         12 + i / 18000, (i / 300) % 60, (i / 5) % 60, (i % 5) * 200, lat, lon, in->speed_ms / 0.5144f, heading_deg);
+		snprintf(gga[i], sizeof(gga[i]), "%02d%02d%02d.%03d,%s,N,%s,E,1,9,1.00,%.1f,M,47.3,M,,",
+		         12 + i / 18000, (i / 300) % 60, (i / 5) % 60, (i % 5) * 200, lat, lon, 100.0f + 10.0f * sinf(t));
+	}
+}
+
+
+static void gps_position(const struct BenchInput *in)
+{
+	sensor_data.gps.latitude_rad = in->latitude_rad;
+	sensor_data.gps.longitude_rad = in->longitude_rad;
+	sensor_data.gps.speed_ms = in->speed_ms;
+	sensor_data.gps.heading_rad = in->heading_rad;
+	sensor_data.gps.satellites_in_view = 9;
+	sensor_data.gps.status = ACTIVE;
+}
+
+
+///////////////////////////////////////////////////////////////
+//                       THE BENCHMARKS                      //
+///////////////////////////////////////////////////////////////
+
+static void setup_ahrs()
+{
+	sensor_data.acc_x = input[0].acc_x;
+	sensor_data.acc_y = input[0].acc_y;
+	sensor_data.acc_z = input[0].acc_z;
+	sensor_data.gps.speed_ms = 15.0f;
+	ahrs_init();
+}
+
+static void run_ahrs(int i)
+{
+	const struct BenchInput *in = &input[i];
+
+	sensor_data.acc_x = in->acc_x;
+	sensor_data.acc_y = in->acc_y;
+	sensor_data.acc_z = in->acc_z;
+	sensor_data.p = in->p;
+	sensor_data.q = in->q;
+	sensor_data.r = in->r;
+	ahrs_filter(0.02f);
+}
+
+
+static void setup_pid()
+{
+	pid_init(&pid, 0.0f, 0.5f, 0.01f, -1.0f, 1.0f, 0.0f);
+}
+
+static void run_pid(int i)
+{
+	sink = pid_update(&pid, input[i].roll - input[(i + 7) & (SAMPLES - 1)].roll, 0.02f);
+}
+
+
+//! The four loops of a copter (pitch, roll, yaw, altitude), all with the gains of setup_pid()
+static void setup_pid_q16()
+{
+	int i;
+
+	setup_pid();
+	pid_q16_init(&pid_bank, 0.02f);
+	for (i = 0; i < PID_Q16_MAX_LOOPS; i++)
+		pid_q16_add(&pid_bank, &pid, -1.0f, 1.0f);
+	for (i = 0; i < SAMPLES; i++)
+		pid_position[i] = q16_from_float(input[i].roll - input[(i + 7) & (SAMPLES - 1)].roll);
+}
+
+static void run_pid_q16(int i)
+{
+	pid_q16_update_all(&pid_bank, &pid_position[i & (SAMPLES - PID_Q16_MAX_LOOPS)], pid_out);
+	sink = pid_out[0];
+}
+
+
+static void setup_mix()
+{
+	config.control.servo_mix = AILERON;
+	control_mix_changed();
+}
+
+static void run_mix(int i)
+{
+	aileron_out = (int)(input[i].roll * 630.0f);
+	elevator_out = (int)(input[i].pitch * 630.0f);
+	motor_out = (i * 7) % 1000;
+	control_mix_out();
+}
+
+
+static void setup_gps()
+{
+}
+
+static void run_gps(int i)
+{
+	// What gps_rx_char() leaves behind after a GGA and a RMC sentence
+	strcpy((char*)nmea_buffer_GGA, gga[i]);
+	gga_sentence_number++;
+	gps_update_info(&sensor_data.gps);
+	strcpy((char*)nmea_buffer_RMC, rmc[i]);
+	rmc_sentence_number++;
+	gps_update_info(&sensor_data.gps);
+}
+
+
+static void setup_circle()
+{
+	navigation_data.home_latitude_rad = DEG2RAD(50.83);
+	navigation_data.home_longitude_rad = DEG2RAD(4.35);
+	circle.opcode = CIRCLE_ABS;
+	circle.x = DEG2RAD(50.83);
+	circle.y = DEG2RAD(4.35);
+	circle.a = 150;
+	circle.b = 50;
+}
+
+static void run_circle(int i)
+{
+	gps_position(&input[i]);
+	navigation_do_circle(&circle);
+}
+
+
+/*!
+ *   A flight plan flying the same square as the recorded positions.
+ */
+static void setup_gluonscript()
+{
+	int i;
+
+	setup_circle();
+	navigation_data.airborne = 1;
+	navigation_data.relative_positions_calculated = 1;
+	for (i = 0; i < 4; i++)
+	{
+		float north = (i == 0 || i == 1) ? SIDE_M / 2.0f : -SIDE_M / 2.0f;
+		float east = (i == 1 || i == 2) ? SIDE_M / 2.0f : -SIDE_M / 2.0f;
+		gluonscript_data.codes[i].opcode = FLY_TO_ABS;
+		gluonscript_data.codes[i].x = DEG2RAD(50.83) + north / 6363057.32484;
+		gluonscript_data.codes[i].y = DEG2RAD(4.35) + east / 4107840.76433121;
+		gluonscript_data.codes[i].a = 50;
+		gluonscript_data.codes[i].b = 0;
+	}
+	gluonscript_data.codes[4].opcode = GOTO;
+	gluonscript_data.codes[4].a = 0;
+	gluonscript_data.current_codeline = 0;
+	gluonscript_data.last_code = 4;
+}
+
+static void run_gluonscript(int i)
+{
+	gps_position(&input[i]);
+	gluonscript_do();
+}
+
+
+/*!
+ *   The Gps and Control records datalogger_task() would write during the
+ *   recorded flight.
+ */
+static void setup_logpack()
+{
+	int i;
+
+	memset(log_records, 0, sizeof(log_records));
+	for (i = 0; i < SAMPLES; i++)
+	{
+		struct LogGps *g = &log_records[i][0].gps;
+		struct LogControl *c = &log_records[i][1].control;
+
+		g->latitude_rad = input[i].latitude_rad;
+		g->longitude_rad = input[i].longitude_rad;
+		g->date = 181026;
+		g->time = 120000 + i / 4;
+		g->speed_cm_s = (unsigned int)(input[i].speed_ms * 100.0f);
+		g->heading_deg = (int)RAD2DEG(input[i].heading_rad);
+		g->height_m = 100;
+		g->satellites = 8;
+		g->temperature_c = 20;
+		c->roll_deg = (int)RAD2DEG(input[i].roll);
+		c->pitch_deg = (int)RAD2DEG(input[i].pitch);
+		c->yaw_deg = g->heading_deg;
+		c->height_dm = 1000;
+		c->desired_height_m = 100;
+	}
+}
+
+static void run_logpack(int i)
+{
+	int j = (i - 1) & (SAMPLES - 1), n;
+
+	n = logpack_encode(log_record_types[0].fields, log_record_types[0].count, &log_records[i][0], &log_records[j][0],
+	                   log_page, sizeof(log_page));
+	sink = n + logpack_encode(log_record_types[1].fields, log_record_types[1].count, &log_records[i][1], &log_records[j][1],
+	                          log_page + n, sizeof(log_page) - n);
+}
+
+
+/*!
+ *   The yardstick: a fixed amount of float and integer work on the inputs,
+ *   the same on every version of the firmware.
+ */
+static void run_calibration(int i)
+{
+	float x = input[i].roll;
+	unsigned int n = (unsigned int)i;
+	int j;
+
+	for (j = 0; j < CALIBRATION_STEPS; j++)
+	{
+		x = x * 0.999f + input[(i + j) & (SAMPLES - 1)].pitch;
+		n = n * 1103515245u + 12345u;
+	}
+	sink = x + (float)(n & 255);
+}
+
+
+static struct Benchmark benchmarks[] =
+{
+	{ "ahrs_filter",          setup_ahrs,        run_ahrs },
+	{ "pid_update",           setup_pid,         run_pid },
+	{ "pid_q16_update_all",   setup_pid_q16,     run_pid_q16 },
+	{ "control_mix_out",      setup_mix,         run_mix },
+	{ "gps_update_info",      setup_gps,         run_gps },
+	{ "navigation_do_circle", setup_circle,      run_circle },
+	{ "gluonscript_do",       setup_gluonscript, run_gluonscript },
+	{ "logpack_encode",       setup_logpack,     run_logpack },
+};
+
+#define BENCHMARKS (int)(sizeof(benchmarks) / sizeof(benchmarks[0]))
+
+static struct BenchmarkResult results[BENCHMARKS];
+
+
+static double now_s()
+{
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+
+/*!
+ *   @return The ns per call of a run of calls
+ */
+static double time_run(void (*run)(int i), long calls)
+{
+	double start = now_s();
+	long i;
+
+	for (i = 0; i < calls; i++)
+		run((int)(i & (SAMPLES - 1)));
+	return (now_s() - start) * 1e9 / calls;
+}
+
+
+/*!
+ *   @return The calls that take at least run_s, in whole tables of inputs
+ */
+static long calls_per_run(void (*run)(int i), double run_s)
+{
+	double ns = time_run(run, SAMPLES);   // also warms up
+
+	return ((long)(run_s * 1e9 / ns / SAMPLES) + 1) * SAMPLES;
+}
+
+
+/*!
+ *   Times the calibration loop and every benchmark in turn, RUNS times: a
+ *   slow spell of the host hits a run of each, not all the runs of one.
+ *   The results keep the best of this and the earlier measurements.
+ */
+static void measure(double run_s)
+{
+	long calibration_calls = calls_per_run(run_calibration, run_s);
+	double calibration_ns = 1e99, ns_per_call[BENCHMARKS], ns;
+	int run, i;
+
+	for (i = 0; i < BENCHMARKS; i++)
+	{
+		benchmarks[i].setup();
+		results[i].calls = calls_per_run(benchmarks[i].run, run_s);
+		ns_per_call[i] = 1e99;
+	}
+	for (run = 0; run < RUNS; run++)
+	{
+		ns = time_run(run_calibration, calibration_calls);
+		if (ns < calibration_ns)
+			calibration_ns = ns;
+		for (i = 0; i < BENCHMARKS; i++)
+		{
+			benchmarks[i].setup();
+			ns = time_run(benchmarks[i].run, results[i].calls);
+			if (ns < ns_per_call[i])
+				ns_per_call[i] = ns;
+		}
+	}
+	for (i = 0; i < BENCHMARKS; i++)
+		if (ns_per_call[i] / calibration_ns < results[i].cost)
+		{
+			results[i].ns_per_call = ns_per_call[i];
+			results[i].cost = ns_per_call[i] / calibration_ns;
+		}
+}
+
+
+/*!
+ *   @return The number of functions with a cost above the tolerance
+ */
+static int slower(float tolerance_pct)
+{
+	int i, n = 0;
+
+	for (i = 0; i < BENCHMARKS; i++)
+		if (results[i].baseline_cost > 0.0 && results[i].cost > results[i].baseline_cost * (1.0 + tolerance_pct / 100.0))
+			n++;
+	return n;
+}
+
+
+/*!
+ *   @return The cost of the benchmark in the baseline, or 0
+ */
+static double baseline_cost(const char *filename, const char *name)
+{
+	FILE *f = fopen(filename, "r");
+	char line[128], n[64];
+	double cost, found = 0.0;
+
+	if (f == NULL)
+		return 0.0;
+	while (fgets(line, sizeof(line), f) != NULL)
+		if (sscanf(line, "%63[^;];%lf", n, &cost) == 2 && strcmp(n, name) == 0)
+			found = cost;
+	fclose(f);
+	return found;
+}
+
+
+static void usage()
+{
+	fprintf(stderr, "Usage: bench [-n scale] [-b baseline.csv] [-t tolerance-pct] [-w baseline.csv]\n");
+	exit(1);
+}
+
+
+int main(int argc, char *argv[])
+{
+	const char *baseline = NULL, *new_baseline = NULL;
+	float scale = 1.0f, tolerance_pct = 20.0f;
+	int c, i, attempt;
+	FILE *f;
+
+	while ((c = getopt(argc, argv, "n:b:t:w:")) != -1)
+	{
+		switch (c)
+		{
+			case 'n': scale = atof(optarg); break;
+			case 'b': baseline = optarg; break;
+			case 't': tolerance_pct = atof(optarg); break;
+			case 'w': new_baseline = optarg; break;
+			default: usage();
+		}
+	}
+	if (scale <= 0.0f)
+		usage();
+
+	vSemaphoreCreateBinary(xGpsSemaphore);
+	configuration_default();
+	navigation_init();
+	record_inputs();
+
+	for (i = 0; i < BENCHMARKS; i++)
+	{
+		results[i].cost = 1e99;
+		results[i].baseline_cost = baseline != NULL ? baseline_cost(baseline, benchmarks[i].name) : 0.0;
+	}
+
+	// A slower function is measured again: the host may have been busy
+	measure(RUN_S * scale);
+	for (attempt = 1; attempt < ATTEMPTS && slower(tolerance_pct) > 0; attempt++)
+		measure(RUN_S * scale);
+
+	printf("function;ns_per_call;calls_per_s;cost;baseline_cost;change_pct\n");
+	for (i = 0; i < BENCHMARKS; i++)
+	{
+		const struct BenchmarkResult *r = &results[i];
+
+		printf("%s;%.1f;%.0f;%.3f", benchmarks[i].name, r->ns_per_call, 1e9 / r->ns_per_call, r->cost);
+		if (r->baseline_cost > 0.0)
+		{
+			printf(";%.3f;%+.1f", r->baseline_cost, (r->cost - r->baseline_cost) / r->baseline_cost * 100.0);
+			if (r->cost > r->baseline_cost * (1.0 + tolerance_pct / 100.0))
+				printf(";SLOWER");
+		}
+		printf("\n");
+	}
+
+	if (new_baseline != NULL)
+	{
+		f = fopen(new_baseline, "w");
+		if (f == NULL)
+		{
+			perror(new_baseline);
+			return 1;
+		}
+		fprintf(f, "function;cost\n");
+		for (i = 0; i < BENCHMARKS; i++)
+			fprintf(f, "%s;%.3f\n", benchmarks[i].name, results[i].cost);
+		fclose(f);
+	}
+
+	if (slower(tolerance_pct) > 0)
+		fprintf(stderr, "%d function(s) more than %.0f%% slower than the baseline\n", slower(tolerance_pct), tolerance_pct);
+	return slower(tolerance_pct) > 0;
+}
+
+
+// FreeRTOS hooks, the scheduler is never started
+void vApplicationStackOverflowHook( xTaskHandle *pxTask, signed portCHAR *pcTaskName )
+{
+}
+
+
+void vApplicationIdleHook( void )
+{
+}
@@ -0,0 +1,355 @@
+/*!
+ *  Unit tests of lib/cmdtable and of the command table of communication_csv.c
+ *  on the host.
+ *
+ *   tokenize   cmdtable_tokenize on lines with and without checksum, empty
+ *              fields and too many separators
+ *   init       tables with a duplicate, a bad code or schema, too many fields
+ *              or too many commands are refused
+ *   parse      every schema letter, missing fields and the checksum field
+ *   commands   the table of communication_csv.c: every command of the
+ *              protocol is found in at most MAX_PROBES compares, every other
+ *              pair of printable characters isn't
+ *   dispatch   lines through cmdtable_dispatch to the real handlers, checked
+ *              in config (only handlers that don't send or wait)
+ *
+ *  The firmware units are the ones of the SITL build, as in bench.c, but no
+ *  task is started.
+ *
+ *  Usage: cmdtable_check
+ *
+ *  Prints the number of cases and failures of every check and exits with 1
+ *  when one failed. The time per lookup is only informative.
+ *
+ *  @file     cmdtable_check.c
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "FreeRTOS/FreeRTOS.h"
+#include "FreeRTOS/task.h"
+
+#include "cmdtable/cmdtable.h"
+
+#include "communication.h"
+#include "configuration.h"
+#include "sitl.h"
+
+#define MAX_PROBES  2     //!< What cmdtable.h promises for communication_csv.c
+#define LOOKUPS     10000000
+
+struct Result
+{
+	long cases, failures;
+};
+
+// The commands of the protocol
+static const char *protocol[] =
+{
+	"WN", "JN", "FN", "LN", "RN", "SC", "SG", "PP", "PR", "PH", "PA", "AT", "ST", "SA", "SY", "S6", "CG",
+	"CA", "SI", "SR", "SM", "SO", "ML", "MC", "MX", "FC", "LC", "LD", "RC", "SE", "SW", "FF", "FI", "DR", "DB", "DP", "TB", "ZZ"
+};
+#define PROTOCOL_COMMANDS  (int)(sizeof(protocol) / sizeof(protocol[0]))
+
+static union CommandField handled[CMDTABLE_MAX_FIELDS];
+static int handled_calls;
+
+static volatile long sink;
+
+// The SITL objects expect these from sitl_main.c
+unsigned long idle_counter = 0;
+unsigned long sitl_time_ms = 0;
+
+
+static double now_s()
+{
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+
+static void report(const char *name, const struct Result *r, double ns)
+{
+	if (ns > 0.0)
+		printf("%s;%ld;%ld;%.1f;%s\n", name, r->cases, r->failures, ns, r->failures == 0 ? "ok" : "FAIL");
+	else
+		printf("%s;%ld;%ld;;%s\n", name, r->cases, r->failures, r->failures == 0 ? "ok" : "FAIL");
+}
+
+
+static void expect(struct Result *r, int ok, const char *what, const char *detail)
+{
+	r->cases++;
+	if (! ok && r->failures++ < 10)
+		fprintf(stderr, "%s: %s\n", what, detail);
+}
+
+
+static void handler(const union CommandField *field)
+{
+	memcpy(handled, field, sizeof(handled));
+	handled_calls++;
+}
+
+
+static void check_tokenize(struct Result *r)
+{
+	static const struct { const char *line; int tokens; int token[4]; } cases[] =
+	{
+		{ "LC",              0, { 0 } },
+		{ "TB;1",            1, { 0, 3 } },
+		{ "PP;1.5;;-2",      3, { 0, 3, 7, 8 } },
+		{ "TBB;1*4e",        2, { 0, 4, 6 } },       // a line with checksum, as the input task leaves it
+		{ ";;;;;;;;;;",      10, { 0, 1, 2, 3 } },
+		{ ";;;;;;;;;;;",     CMDTABLE_MAX_TOKEN + 1, { 0 } },
+	};
+	int token[CMDTABLE_MAX_TOKEN + 1];
+	int i, j, tokens, ok;
+
+	for (i = 0; i < (int)(sizeof(cases) / sizeof(cases[0])); i++)
+	{
+		tokens = cmdtable_tokenize(cases[i].line, strlen(cases[i].line), token);
+		ok = tokens == cases[i].tokens;
+		if (ok && tokens <= CMDTABLE_MAX_TOKEN)   // the first 4, and the unused ones 0
+		{
+			ok = memcmp(token, cases[i].token, sizeof(cases[i].token)) == 0;
+			for (j = tokens + 1; j <= CMDTABLE_MAX_TOKEN; j++)
+				ok = ok && token[j] == 0;
+		}
+		expect(r, ok, "tokenize", cases[i].line);
+	}
+}
+
+
+static void check_init(struct Result *r)
+{
+	static const struct Command good[] = { { "AA", "ilfc", handler }, { "AB", "", handler } };
+	static const struct Command duplicate[] = { { "AA", "i", handler }, { "BB", "", handler }, { "AA", "", handler } };
+	static const struct Command short_code[] = { { "A", "i", handler } };
+	static const struct Command bad_schema[] = { { "AA", "ix", handler } };
+	static const struct Command too_many_fields[] = { { "AA", "iiiiiiiiiii", handler } };
+	static struct Command full[CMDTABLE_SLOTS];
+	struct CommandTable t;
+	int i;
+
+	expect(r, cmdtable_init(&t, good, 2) > 0 && t.count == 2, "init", "a good table");
+	expect(r, cmdtable_init(&t, duplicate, 3) == 0 && cmdtable_find(&t, 'A', 'A') == 0, "init", "a duplicate");
+	expect(r, cmdtable_init(&t, short_code, 1) == 0, "init", "a 1 letter code");
+	expect(r, cmdtable_init(&t, bad_schema, 1) == 0, "init", "an unknown field type");
+	expect(r, cmdtable_init(&t, too_many_fields, 1) == 0, "init", "too many fields");
+	for (i = 0; i < CMDTABLE_SLOTS; i++)
+	{
+		full[i].code[0] = 'A' + i / 26;
+		full[i].code[1] = 'A' + i % 26;
+		full[i].fields = "";
+		full[i].handler = handler;
+	}
+	expect(r, cmdtable_init(&t, full, CMDTABLE_SLOTS - 1) > 0, "init", "as many commands as fit");
+	expect(r, cmdtable_init(&t, full, CMDTABLE_SLOTS) == 0, "init", "too many commands");
+	for (i = 0; i < CMDTABLE_SLOTS - 1; i++)
+		if (cmdtable_find(&t, full[i].code[0], full[i].code[1]) != 0)
+			break;
+	expect(r, i == CMDTABLE_SLOTS - 1, "init", "a refused table is empty");
+}
+
+
+static void check_parse(struct Result *r)
+{
+	static const struct Command commands[] = { { "AA", "ilfc", handler }, { "AB", "ffffffffff", handler } };
+	struct CommandTable t;
+	int token[CMDTABLE_MAX_TOKEN + 1];
+	char line[80];
+	int i, tokens, ok;
+
+	cmdtable_init(&t, commands, 2);
+
+	strcpy(line, "AA;-1234;2000000;-0.125;x");
+	tokens = cmdtable_tokenize(line, strlen(line), token);
+	handled_calls = 0;
+	ok = cmdtable_dispatch(&t, line, token, tokens) && handled_calls == 1;
+	expect(r, ok && handled[0].i == -1234 && handled[1].l == 2000000L && handled[2].f == -0.125f &&
+	          handled[3].c == 'x', "parse", line);
+	expect(r, cmdtable_parse(&commands[0], line, token, tokens, handled) == 4, "parse", "field count");
+
+	strcpy(line, "AA;7");   // missing fields are 0
+	tokens = cmdtable_tokenize(line, strlen(line), token);
+	memset(handled, 0x55, sizeof(handled));
+	expect(r, cmdtable_parse(&commands[0], line, token, tokens, handled) == 1 &&
+	          handled[0].i == 7 && handled[1].l == 0 && handled[2].f == 0.0f && handled[3].c == '\0',
+	          "parse", line);
+
+	strcpy(line, "AAA;1;;3*5f");   // with checksum: it ends the last field, and is one itself
+	tokens = cmdtable_tokenize(line, strlen(line), token);
+	cmdtable_parse(&commands[0], line, token, tokens, handled);
+	expect(r, handled[0].i == 1 && handled[1].l == 0 && handled[2].f == 3.0f && handled[3].c == '5', "parse", line);
+
+	strcpy(line, "AB;1;2;3;4;5;6;7;8;9;10");
+	tokens = cmdtable_tokenize(line, strlen(line), token);
+	cmdtable_parse(&commands[1], line, token, tokens, handled);
+	for (ok = 1, i = 0; i < 10; i++)
+		ok = ok && handled[i].f == (float)(i + 1);
+	expect(r, ok, "parse", line);
+
+	strcpy(line, "AC;1");
+	tokens = cmdtable_tokenize(line, strlen(line), token);
+	handled_calls = 0;
+	expect(r, ! cmdtable_dispatch(&t, line, token, tokens) && handled_calls == 0, "parse", "an unknown command");
+}
+
+
+static void check_commands(struct Result *r, double *ns)
+{
+	struct CommandTable t;
+	const struct Command *command;
+	char detail[40];
+	int probes, i, c1, c2, known;
+	double start;
+
+	probes = communication_commands(&t);
+	snprintf(detail, sizeof(detail), "%d probes", probes);
+	expect(r, probes > 0 && probes <= MAX_PROBES, "commands", detail);
+
+	for (c1 = ' '; c1 <= '~'; c1++)
+		for (c2 = ' '; c2 <= '~'; c2++)
+		{
+			for (known = 0, i = 0; i < PROTOCOL_COMMANDS; i++)
+				known = known || (protocol[i][0] == c1 && protocol[i][1] == c2);
+			command = cmdtable_find(&t, c1, c2);
+			snprintf(detail, sizeof(detail), "%c%c", c1, c2);
+			expect(r, known ? command != 0 && command->code[0] == c1 && command->code[1] == c2 : command == 0,
+			       "commands", detail);
+		}
+	expect(r, t.count == PROTOCOL_COMMANDS, "commands", "a command that isn't in the protocol");
+
+	start = now_s();
+	for (i = 0; i < LOOKUPS; i++)
+		sink += (long)cmdtable_find(&t, protocol[i % PROTOCOL_COMMANDS][0], protocol[i % PROTOCOL_COMMANDS][1]);
+	*ns = (now_s() - start) * 1e9 / LOOKUPS;
+}
+
+
+static void dispatch(struct CommandTable *t, const char *text)
+{
+	char line[100];
+	int token[CMDTABLE_MAX_TOKEN + 1];
+	int tokens;
+
+	strcpy(line, text);
+	tokens = cmdtable_tokenize(line, strlen(line), token);
+	cmdtable_dispatch(t, line, token, tokens);
+}
+
+
+static void check_dispatch(struct Result *r)
+{
+	struct CommandTable t;
+
+	communication_commands(&t);
+
+	dispatch(&t, "PP;1.5;0.25;0.125;-2;2;0.5");
+	expect(r, config.control.pid_pitch2elevator.p_gain == 1.5f && config.control.pid_pitch2elevator.i_gain == 0.25f &&
+	          config.control.pid_pitch2elevator.d_gain == 0.125f && config.control.pid_pitch2elevator.i_min == -2.0f &&
+	          config.control.pid_pitch2elevator.i_max == 2.0f && config.control.pid_pitch2elevator.d_term_min_var == 0.5f,
+	          "dispatch", "PP");
+	dispatch(&t, "PR;2;0;0;-1;1;0");
+	dispatch(&t, "PH;3;0;0;-1;1;0");
+	dispatch(&t, "PA;4;0;0;-1;1;0*1f");
+	expect(r, config.control.pid_roll2aileron.p_gain == 2.0f && config.control.pid_heading2roll.p_gain == 3.0f &&
+	          config.control.pid_altitude2pitch.p_gain == 4.0f && config.control.pid_altitude2pitch.i_min == -1.0f,
+	          "dispatch", "PR, PH, PA");
+
+	dispatch(&t, "ST;1;2;3;4;5;6;7");
+	expect(r, config.telemetry.stream_GpsBasic == 1 && config.telemetry.stream_GyroAccRaw == 2 &&
+	          config.telemetry.stream_GyroAccProc == 3 && config.telemetry.stream_PPM == 4 &&
+	          config.telemetry.stream_PressureTemp == 5 && config.telemetry.stream_Attitude == 6 &&
+	          config.telemetry.stream_Control == 7, "dispatch", "ST");
+
+	dispatch(&t, "SI;1;c;b;a;e;d");
+	expect(r, config.control.use_pwm == 1 && config.control.channel_ap == 2 && config.control.channel_motor == 1 &&
+	          config.control.channel_pitch == 0 && config.control.channel_roll == 4 && config.control.channel_yaw == 3,
+	          "dispatch", "SI");
+
+	dispatch(&t, "SR;37;1");
+	expect(r, config.control.reverse_servo1 == 1 && config.control.reverse_servo2 == 0 &&
+	          config.control.reverse_servo3 == 1 && config.control.reverse_servo6 == 1 && config.control.manual_trim == 1,
+	          "dispatch", "SR");
+
+	dispatch(&t, "SM;2;1100;1500;1900");
+	expect(r, config.control.servo_min[2] == 1100 && config.control.servo_neutral[2] == 1500 &&
+	          config.control.servo_max[2] == 1900, "dispatch", "SM");
+
+	dispatch(&t, "ML;3");
+	expect(r, config.control.custom_mix.outputs == 4 && config.control.custom_mix.copter == 1 &&
+	          config.control.custom_mix.coefficient[0][MIX_AILERON] == 20 &&
+	          config.control.custom_mix.coefficient[3][MIX_ELEVATOR] == -20 &&
+	          config.control.custom_mix.coefficient[3][MIX_MOTOR] == 100, "dispatch", "ML");
+	dispatch(&t, "MX;5;0;0;50;-50;0;0;0;1");
+	dispatch(&t, "MC;5;0");
+	expect(r, config.control.custom_mix.outputs == 5 && config.control.custom_mix.copter == 0 &&
+	          config.control.custom_mix.coefficient[5][MIX_ELEVATOR] == 50 &&
+	          config.control.custom_mix.coefficient[5][MIX_YAW] == -50 &&
+	          config.control.custom_mix.fixed_neutral == 1 << 5, "dispatch", "MX, MC");
+
+	dispatch(&t, "SG;3840;1");
+	expect(r, config.gps.initial_baudrate == 38400L && config.gps.operational_baudrate == 0 && config.gps.enable_waas == 1,
+	       "dispatch", "SG");
+
+	dispatch(&t, "AT;10;90;50;5;1");
+	expect(r, config.control.auto_throttle_min_pct == 10 && config.control.auto_throttle_max_pct == 90 &&
+	          config.control.auto_throttle_cruise_pct == 50 && config.control.auto_throttle_p_gain == 5 &&
+	          config.control.autopilot_auto_throttle == 1, "dispatch", "AT");
+
+	dispatch(&t, "SA;-10.5;20;4096");
+	dispatch(&t, "SY;1;-2;3");
+	expect(r, config.sensors.acc_x_neutral == -10.5f && config.sensors.acc_z_neutral == 4096.0f &&
+	          config.sensors.gyro_y_neutral == -2.0f, "dispatch", "SA, SY");
+
+	dispatch(&t, "SC;2;30;45;5;50;20;1;-10;2");
+	expect(r, config.control.servo_mix == 2 && config.control.aileron_differential == 0 &&
+	          config.control.waypoint_radius_m == 50.0f && config.control.cruising_speed_ms == 20.0f &&
+	          config.control.stabilization_with_altitude_hold == 1 && config.control.altitude_mode == 2 &&
+	          fabsf(config.control.max_roll - 45.0f / 180.0f * 3.14f) < 1e-6f, "dispatch", "SC");
+	dispatch(&t, "SC;2;30;45;5;50;20;0;-10;7");
+	expect(r, config.control.stabilization_with_altitude_hold == 0 && config.control.altitude_mode == 1,
+	       "dispatch", "SC, out of range");
+}
+
+
+// FreeRTOS hooks, the scheduler is never started
+void vApplicationStackOverflowHook( xTaskHandle *pxTask, signed portCHAR *pcTaskName )
+{
+}
+
+
+void vApplicationIdleHook( void )
+{
+}
+
+
+int main(int argc, char *argv[])
+{
+	struct Result tokenize = { 0 }, init = { 0 }, parse = { 0 }, commands = { 0 }, dispatch = { 0 };
+	double lookup_ns;
+
+	check_tokenize(&tokenize);
+	check_init(&init);
+	check_parse(&parse);
+	check_commands(&commands, &lookup_ns);
+	check_dispatch(&dispatch);
+
+	printf("check;cases;failures;ns;result\n");
+	report("tokenize", &tokenize, 0.0);
+	report("init", &init, 0.0);
+	report("parse", &parse, 0.0);
+	report("commands", &commands, lookup_ns);
+	report("dispatch", &dispatch, 0.0);
+	return tokenize.failures + init.failures + parse.failures + commands.failures + dispatch.failures > 0;
+}
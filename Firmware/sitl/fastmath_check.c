@@ -0,0 +1,182 @@
+/*!
+ *  Accuracy and speed of lib/fastmath against libm, on the host.
+ *
+ *  Every function is evaluated at evenly spread and random arguments in its
+ *  documented range (see fastmath.h) and compared with the double precision
+ *  libm result. The error limits are the ones documented in fastmath.h.
+ *  Then both the fastmath function and the float libm function are timed on
+ *  the same table of arguments.
+ *
+ *  Usage: fastmath_check [-n samples]
+ *
+ *  Exits with 1 when a function is less accurate than documented. The speed
+ *  is only informative: a host's libm is not the dsPIC's, and some of these
+ *  (sqrt) are a single instruction on a host.
+ *
+ *  @file     fastmath_check.c
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "fastmath/fastmath.h"
+
+#define TABLE 4096     //!< Arguments in the timing table (power of 2)
+#define CALLS 4000000
+
+enum ErrorType { ABSOLUTE, RELATIVE };
+
+struct Check
+{
+	const char *name;
+	double min, max;             //!< Range of the argument
+	enum ErrorType type;
+	double limit;                //!< Documented maximum error
+	float (*fast)(float x);
+	float (*libm)(float x);
+	double (*reference)(double x);
+	double max_error;
+	double fast_ns, libm_ns;
+};
+
+static float sink_sum;
+
+static float atan2_fast_y1(float x) { return fastmath_atan2(1.0f, x); }
+static float atan2_libm_y1(float x) { return atan2f(1.0f, x); }
+static double atan2_ref_y1(double x) { return atan2(1.0, x); }
+static float atan2_fast_ym1(float x) { return fastmath_atan2(-1.0f, x); }
+static float atan2_libm_ym1(float x) { return atan2f(-1.0f, x); }
+static double atan2_ref_ym1(double x) { return atan2(-1.0, x); }
+static float invsqrt_libm(float x) { return 1.0f / sqrtf(x); }
+static double invsqrt_ref(double x) { return 1.0 / sqrt(x); }
+
+static struct Check checks[] =
+{
+	{ "sin",         -1000.0,          1000.0,         ABSOLUTE, 2e-7, fastmath_sin,     sinf,         sin,           0.0, 0.0, 0.0 },
+	{ "cos",         -1000.0,          1000.0,         ABSOLUTE, 2e-7, fastmath_cos,     cosf,         cos,           0.0, 0.0, 0.0 },
+	{ "tan",         -1.5607963268,    1.5607963268,   RELATIVE, 5e-7, fastmath_tan,     tanf,         tan,           0.0, 0.0, 0.0 },
+	{ "atan",        -1e6,             1e6,            ABSOLUTE, 2e-7, fastmath_atan,    atanf,        atan,          0.0, 0.0, 0.0 },
+	{ "atan2(1,x)",  -1e3,             1e3,            ABSOLUTE, 4e-7, atan2_fast_y1,    atan2_libm_y1, atan2_ref_y1,  0.0, 0.0, 0.0 },
+	{ "atan2(-1,x)", -1e3,             1e3,            ABSOLUTE, 4e-7, atan2_fast_ym1,   atan2_libm_ym1, atan2_ref_ym1, 0.0, 0.0, 0.0 },
+	{ "asin",        -1.0,             1.0,            ABSOLUTE, 5e-7, fastmath_asin,    asinf,        asin,          0.0, 0.0, 0.0 },
+	{ "sqrt",        0.0,              1e30,           RELATIVE, 3e-7, fastmath_sqrt,    sqrtf,        sqrt,          0.0, 0.0, 0.0 },
+	{ "invsqrt",     1e-30,            1e30,           RELATIVE, 3e-7, fastmath_invsqrt, invsqrt_libm, invsqrt_ref,   0.0, 0.0, 0.0 },
+};
+
+#define CHECKS (int)(sizeof(checks) / sizeof(checks[0]))
+
+
+static double now_s()
+{
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+
+//! Arguments in [min, max]. Wide ranges are spread logarithmically, so small arguments are covered too.
+static float argument(const struct Check *c, long i, long n, int random)
+{
+	double t = random ? (double)rand() / RAND_MAX : (double)i / (n - 1);
+
+	if (c->max / (fabs(c->min) + 1.0) > 1e4 && c->min >= 0.0)
+		return (float)(exp(log(c->max) * t + log(c->min > 0.0 ? c->min : 1e-30) * (1.0 - t)));
+	if (c->max > 1e4)
+	{
+		double m = exp(log(c->max) * fabs(2.0 * t - 1.0) + log(1e-6) * (1.0 - fabs(2.0 * t - 1.0)));
+		return (float)(t < 0.5 ? -m : m);
+	}
+	return (float)(c->min + (c->max - c->min) * t);
+}
+
+
+static void accuracy(struct Check *c, long samples)
+{
+	long i;
+
+	c->max_error = 0.0;
+	for (i = 0; i < 2 * samples; i++)
+	{
+		float x = argument(c, i % samples, samples, i >= samples);
+		double reference = c->reference(x);
+		double error = fabs(c->fast(x) - reference);
+
+		if (c->type == RELATIVE)
+			error = reference != 0.0 ? error / fabs(reference) : error;
+		if (error > c->max_error)
+			c->max_error = error;
+	}
+}
+
+
+static double timing(float (*f)(float), const float *table)
+{
+	double best = 1e99;
+	int run;
+	long i;
+
+	for (run = 0; run < 3; run++)
+	{
+		double start = now_s(), ns;
+		float sum = 0.0f;
+		for (i = 0; i < CALLS; i++)
+			sum += f(table[i & (TABLE - 1)]);
+		sink_sum += sum;
+		ns = (now_s() - start) * 1e9 / CALLS;
+		if (ns < best)
+			best = ns;
+	}
+	return best;
+}
+
+
+static void usage()
+{
+	fprintf(stderr, "Usage: fastmath_check [-n samples]\n");
+	exit(1);
+}
+
+
+int main(int argc, char *argv[])
+{
+	static float table[TABLE];
+	long samples = 1000000;
+	int c, i, failed = 0;
+
+	while ((c = getopt(argc, argv, "n:")) != -1)
+	{
+		switch (c)
+		{
+			case 'n': samples = atol(optarg); break;
+			default: usage();
+		}
+	}
+	if (samples < 2)
+		usage();
+
+	srand(1);
+	printf("function;max_error;limit;fastmath_ns;libm_ns;result\n");
+	for (i = 0; i < CHECKS; i++)
+	{
+		struct Check *ch = &checks[i];
+		int j;
+
+		accuracy(ch, samples);
+		for (j = 0; j < TABLE; j++)
+			table[j] = argument(ch, j, TABLE, 1);
+		ch->fast_ns = timing(ch->fast, table);
+		ch->libm_ns = timing(ch->libm, table);
+
+		printf("%s;%.2g;%.2g;%.1f;%.1f;%s\n", ch->name, ch->max_error, ch->limit, ch->fast_ns, ch->libm_ns,
+		       ch->max_error <= ch->limit ? "ok" : "FAIL");
+		if (ch->max_error > ch->limit)
+			failed = 1;
+	}
+	return failed;
+}
@@ -0,0 +1,78 @@
+/*! 
+ *  Host replacement for the dsPIC33FJ256MC710 register definitions.
+ *
+ *  Only the special function registers that are touched by the firmware
+ *  sources compiled into the software-in-the-loop build are declared. They
+ *  are plain variables (defined in sim_board.c) without any side effects;
+ *  the peripherals themselves are simulated by the sim_*.c stand-in drivers.
+ *
+ *  @file     p33FJ256MC710.h
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#ifndef __P33FJ256MC710_SITL_H__
+#define __P33FJ256MC710_SITL_H__
+
+typedef struct {
+	unsigned TRISE0 : 1;
+	unsigned TRISE1 : 1;
+	unsigned TRISE2 : 1;
+	unsigned : 13;
+} TRISEBITS;
+
+typedef struct {
+	unsigned RE0 : 1;
+	unsigned RE1 : 1;
+	unsigned RE2 : 1;
+	unsigned : 13;
+} PORTEBITS;
+
+typedef struct {
+	unsigned : 12;
+	unsigned TRISG12 : 1;
+	unsigned TRISG13 : 1;
+	unsigned TRISG14 : 1;
+	unsigned : 1;
+} TRISGBITS;
+
+typedef struct {
+	unsigned : 12;
+	unsigned RG12 : 1;
+	unsigned RG13 : 1;
+	unsigned RG14 : 1;
+	unsigned : 1;
+} PORTGBITS;
+
+typedef struct {
+	unsigned : 14;
+	unsigned U2RXIF : 1;
+	unsigned U2TXIF : 1;
+} IFS1BITS;
+
+typedef struct {
+	unsigned : 14;
+	unsigned U2RXIE : 1;
+	unsigned U2TXIE : 1;
+} IEC1BITS;
+
+typedef struct {
+	unsigned : 1;
+	unsigned TCS : 1;
+	unsigned : 2;
+	unsigned TCKPS : 2;
+	unsigned : 9;
+	unsigned TON : 1;
+} T5CONBITS;
+
+extern volatile TRISEBITS TRISEbits;
+extern volatile PORTEBITS PORTEbits;
+extern volatile TRISGBITS TRISGbits;
+extern volatile PORTGBITS PORTGbits;
+extern volatile IFS1BITS IFS1bits;
+extern volatile IEC1BITS IEC1bits;
+extern volatile unsigned int U2RXREG;
+extern volatile T5CONBITS T5CONbits;   // run time stats timer, see FreeRTOSConfig.h
+extern volatile unsigned int TMR5;
+
+#endif // __P33FJ256MC710_SITL_H__
@@ -0,0 +1,198 @@
+/*!
+ *  Prints the logs of a flash image as the DR command sends them.
+ *
+ *  The image (made with sitl -f, or read out of a module) is read through the
+ *  firmware's own datalogger: the sessions come from the log journal (or the
+ *  index page of older firmware) and every page is unpacked and printed with
+ *  print_logrecord(), so the output can be fed to the same converters as a log
+ *  read out with the config tool.
+ *
+ *  Usage: log_decode [-d] [-p page-size] [-w image.bin] [-s session] file
+ *
+ *   -d  The file is a capture of uart1 during a DB command (binary download,
+ *       see print_logpages()) instead of an image. Pages that didn't arrive
+ *       are reported with the DB command that asks for them again; the
+ *       captures of several DB commands can simply be concatenated.
+ *   -p  Page size of the chip of a capture: 528 (default) or 264. An image
+ *       has the page size that fits its size.
+ *   -w  Write the image (from the capture) to image.bin
+ *   -s  Only print this session (1...MAX_INDEX, as shown by the DT command)
+ *
+ *  The session table goes to stderr, the DH and DD lines to stdout.
+ *
+ *  @file     log_decode.c
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "FreeRTOS/FreeRTOS.h"
+#include "FreeRTOS/task.h"
+#include "FreeRTOS/semphr.h"
+
+#include "dataflash/dataflash.h"
+#include "crc16/crc16.h"
+
+#include "communication.h"
+#include "task_datalogger.h"
+#include "sitl.h"
+#include "common.h"
+
+// The SITL objects expect these from sitl_main.c
+unsigned long idle_counter = 0;
+unsigned long sitl_time_ms = 0;
+
+extern xSemaphoreHandle xSpiSemaphore;
+extern xSemaphoreHandle xUart1Semaphore;
+
+
+static void usage()
+{
+	fprintf(stderr, "Usage: log_decode [-d] [-p page-size] [-w image.bin] [-s session] file\n");
+	exit(2);
+}
+
+
+/*!
+ *   Writes the pages of a DB capture in the dataflash. Everything between
+ *   the frames (telemetry, messages) and frames with a bad crc are skipped.
+ *   @return 0 when the file can't be read
+ */
+static int load_capture(const char *filename)
+{
+	static unsigned char received[4096];
+	unsigned char frame[LOG_FRAME_HEADER + 528 + 2];
+	int c, n = 0, pages = 0, errors = 0, ended = 0, page, length, first, lowest = -1, highest = -1;
+	FILE *f = fopen(filename, "rb");
+
+	if (f == NULL)
+		return 0;
+	while ((c = getc(f)) != EOF)
+	{
+		frame[n++] = c;
+		if ((n == 1 && c != LOG_FRAME_SYNC1) || (n == 2 && c != LOG_FRAME_SYNC2))
+		{
+			n = c == LOG_FRAME_SYNC1;   // resynchronize
+			continue;
+		}
+		if (n < LOG_FRAME_HEADER)
+			continue;
+		page = frame[2] | (frame[3] << 8);
+		length = frame[4] | (frame[5] << 8);
+		if (length > PAGE_SIZE || (page > MAX_PAGE && page != LOG_FRAME_END))
+		{
+			errors++;
+			n = 0;
+			continue;
+		}
+		if (n < LOG_FRAME_HEADER + length + 2)
+			continue;
+
+		n = 0;
+		if (crc16_update(CRC16_INIT, &frame[2], 4 + length) !=
+		    (unsigned int)(frame[LOG_FRAME_HEADER + length] | (frame[LOG_FRAME_HEADER + length + 1] << 8)))
+			errors++;
+		else if (page == LOG_FRAME_END)
+			ended++;
+		else
+		{
+			unsigned char data[528];
+
+			if (length == 1)
+				memset(data, frame[LOG_FRAME_HEADER], PAGE_SIZE);
+			else
+				memcpy(data, &frame[LOG_FRAME_HEADER], PAGE_SIZE);
+			dataflash.write(page, PAGE_SIZE, data);
+			received[page] = 1;
+			pages++;
+			lowest = (lowest < 0 || page < lowest) ? page : lowest;
+			highest = MAX(page, highest);
+		}
+	}
+	fclose(f);
+
+	fprintf(stderr, "%d pages (%d...%d), %d bad frames, %d downloads ended\n", pages, lowest, highest, errors, ended);
+	for (page = lowest; page >= 0 && page < highest; )
+	{
+		if (received[page])
+		{
+			page++;
+			continue;
+		}
+		for (first = page; ! received[page]; page++)
+			;
+		fprintf(stderr, "missing: DB;%d;%d\n", first, page - 1);
+	}
+	if (ended == 0 && highest < MAX_PAGE)
+		fprintf(stderr, "interrupted, resume with: DB;%d;%d\n", highest + 1, MAX_PAGE);
+	return 1;
+}
+
+
+int main(int argc, char *argv[])
+{
+	int c, i, session = 0, printed = 0, capture = 0;
+	const char *image = NULL;
+
+	while ((c = getopt(argc, argv, "dp:w:s:")) != -1)
+	{
+		switch (c)
+		{
+			case 'd': capture = 1; break;
+			case 'p': sitl_dataflash_geometry(atoi(optarg)); break;
+			case 'w': image = optarg; break;
+			case 's': session = atoi(optarg); break;
+			default: usage();
+		}
+	}
+	if (optind != argc - 1 || session < 0 || session > MAX_INDEX)
+		usage();
+
+	vSemaphoreCreateBinary( xSpiSemaphore );
+	vSemaphoreCreateBinary( xUart1Semaphore );
+	dataflash_open();
+	if (! (capture ? load_capture(argv[optind]) : sitl_dataflash_load(argv[optind])))
+	{
+		fprintf(stderr, "%s: can't read the %s\n", argv[optind], capture ? "capture" : "image");
+		return 1;
+	}
+	if (image != NULL)
+		sitl_dataflash_save(image);
+	datalogger_init();
+
+	for (i = 0; i < MAX_INDEX; i++)
+	{
+		struct LogIndex *entry = &datalogger_journal.index[i];
+
+		if (entry->page_num == 0 || (session != 0 && session != i + 1))
+			continue;
+		fprintf(stderr, "session %d: page %d, date %ld, time %ld\n", i + 1, entry->page_num, entry->date, entry->time);
+
+		while (datalogger_print_next_page(i, &print_logrecord))
+			;
+		printed++;
+	}
+	fflush(stdout);
+
+	if (printed == 0)
+	{
+		fprintf(stderr, "no session found\n");
+		return 1;
+	}
+	return 0;
+}
+
+
+// FreeRTOS hooks, the scheduler is never started
+void vApplicationStackOverflowHook( xTaskHandle *pxTask, signed portCHAR *pcTaskName )
+{
+}
+
+
+void vApplicationIdleHook( void )
+{
+}
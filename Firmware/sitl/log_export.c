@@ -0,0 +1,368 @@
+/*!
+ *  Converts all the logs of a flash image in one pass, without the config tool.
+ *
+ *  The image (made with sitl -f, read out of a module, or written by
+ *  "log_decode -d -w" from a DB capture) is mapped in memory and every session
+ *  of the log journal (or of the index page of older firmware) is converted to:
+ *
+ *    session_NN.csv   the table of the DR command: a "Record" column and a
+ *                     column per field, sample and hold (see print_logrecord())
+ *    session_NN.kml   the track of the Gps records, with their time
+ *    session_NN/      a file per field of every record type ("Gps.Latitude"...):
+ *                     the values as little endian doubles, one per record of
+ *                     that type, scaled as in the CSV
+ *
+ *  The sessions are converted by several threads in parallel. The pages are
+ *  read with log_image.c, not with the firmware's datalogger (it keeps its
+ *  state in statics), and every session has its own struct LogSchema.
+ *
+ *  Usage: log_export [-o directory] [-j threads] [-s session] image
+ *
+ *   -o  Where the files go (default: the current directory)
+ *   -j  Threads (default: one per processor)
+ *   -s  Only convert this session (1...MAX_INDEX, as shown by the DT command)
+ *
+ *  The pages of firmware without record types (struct LogLegacy) are read as
+ *  the dsPIC writes them, with 32 bit doubles.
+ *
+ *  @file     log_export.c
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/stat.h>
+
+#include "task_datalogger.h"
+#include "common.h"
+
+#include "log_image.h"
+
+#define LEGACY_LINE_SIZE   36     //!< sizeof(struct LogLegacy) on the dsPIC
+
+// struct LogLegacy on the dsPIC (see datalogger_records.c)
+static const struct LogpackField legacy_fields[] =
+{
+	{ 0,  4, LOGPACK_F32, 6, 57.29578f,   "Latitude" },
+	{ 4,  4, LOGPACK_F32, 6, 57.29578f,   "Longitude" },
+	{ 8,  4, LOGPACK_U32, 0, 1.0f,        "Date" },
+	{ 12, 4, LOGPACK_U32, 0, 1.0f,        "Time" },
+	{ 16, 2, LOGPACK_S16, 0, 1.0f,        "HeightGPS" },
+	{ 18, 1, LOGPACK_U8,  1, 1.0f / 3.0f, "SpeedGPS" },
+	{ 20, 2, LOGPACK_S16, 0, 1.0f,        "HeadingGPS" },
+	{ 22, 2, LOGPACK_S16, 0, 1.0f,        "Pitch" },
+	{ 24, 2, LOGPACK_S16, 0, 1.0f,        "Roll" },
+	{ 26, 2, LOGPACK_S16, 0, 1.0f,        "Yaw" },
+	{ 28, 1, LOGPACK_S8,  0, 1.0f,        "FlightMode" },
+	{ 29, 1, LOGPACK_S8,  0, 1.0f,        "TempC" },
+	{ 30, 2, LOGPACK_S16, 0, 1.0f,        "HeightBaro" },
+	{ 32, 2, LOGPACK_S16, 0, 1.0f,        "NavigationLine" },
+	{ 34, 2, LOGPACK_U16, 0, 1.0f,        "ServoTrigger" },
+};
+
+static const struct LogRecordType legacy_type =
+	{ LOG_LEGACY, 0, "Legacy", legacy_fields, sizeof(legacy_fields) / sizeof(legacy_fields[0]) };
+
+//! A session being converted
+struct Export
+{
+	const struct LogImage *image;
+	int session;                //!< 1...
+	struct LogSchema schema;
+	int header_fields;          //!< fields in the last CSV header written
+	FILE *csv, *kml;
+	FILE *column[LOGSCHEMA_MAX_FIELDS];
+	int latitude, longitude, height, date, time;   //!< fields of the KML track, -1 when unknown
+	long pages, records, points;
+	int error;
+};
+
+static const char *directory = ".";
+
+static pthread_mutex_t next_mutex = PTHREAD_MUTEX_INITIALIZER;
+static struct Export *exports;
+static int export_count, next_export;
+
+
+static FILE *open_output(struct Export *e, const char *name, const char *extension)
+{
+	char path[1024];
+	FILE *f;
+
+	snprintf(path, sizeof(path), "%s/session_%02d%s%s", directory, e->session, name, extension);
+	f = fopen(path, "w");
+	if (f == NULL)
+	{
+		perror(path);
+		e->error = 1;
+	}
+	return f;
+}
+
+
+/*!
+ *   Opens the column files of the fields of a record type that was just
+ *   added to the schema, and notes the fields of the KML track.
+ */
+static void open_columns(struct Export *e)
+{
+	struct LogSchema *s = &e->schema;
+	char name[256];
+	int r, i;
+
+	for (r = 0; r < s->records; r++)
+		for (i = s->first[r]; i < s->first[r] + s->count[r]; i++)
+		{
+			if (e->column[i] != NULL)
+				continue;
+			snprintf(name, sizeof(name), "/%s.%s", s->name[r], s->field[i].name);
+			e->column[i] = open_output(e, name, "");
+			if (strcmp(s->name[r], "Gps") != 0 && strcmp(s->name[r], "Legacy") != 0)
+				continue;
+			if (strcmp(s->field[i].name, "Latitude") == 0)
+				e->latitude = i;
+			else if (strcmp(s->field[i].name, "Longitude") == 0)
+				e->longitude = i;
+			else if (strcmp(s->field[i].name, "HeightGPS") == 0)
+				e->height = i;
+			else if (strcmp(s->field[i].name, "Date") == 0)
+				e->date = i;
+			else if (strcmp(s->field[i].name, "Time") == 0)
+				e->time = i;
+		}
+}
+
+
+/*!
+ *   Writes a record that was just decoded: a row of the CSV (after a header
+ *   when the schema grew, as datalogger_print_record() does), its values in
+ *   the column files and a point of the track. The record handler of
+ *   log_image_read_records().
+ */
+static void export_record(void *context, int record)
+{
+	struct Export *e = context;
+	struct LogSchema *s = &e->schema;
+	char value[24];
+	int i;
+
+	if (e->header_fields != s->fields)
+	{
+		open_columns(e);
+		fprintf(e->csv, "Record");
+		for (i = 0; i < s->fields; i++)
+			fprintf(e->csv, ";%s", s->field[i].name);
+		fprintf(e->csv, "\n");
+		e->header_fields = s->fields;
+	}
+
+	fprintf(e->csv, "%s", s->name[record]);
+	for (i = 0; i < s->fields; i++)
+	{
+		logschema_format(s, i, value, sizeof(value));
+		fprintf(e->csv, ";%s", value);
+	}
+	fprintf(e->csv, "\n");
+
+	for (i = s->first[record]; i < s->first[record] + s->count[record]; i++)
+	{
+		double v = logschema_value(s, i);
+
+		if (e->column[i] != NULL)
+			fwrite(&v, sizeof(v), 1, e->column[i]);   // the host is little endian too
+	}
+
+	if (e->latitude >= s->first[record] && e->latitude < s->first[record] + s->count[record] &&
+	    e->longitude >= 0 && e->date >= 0 && e->time >= 0)
+	{
+		unsigned long date = (unsigned long)logschema_value(s, e->date), time = (unsigned long)logschema_value(s, e->time);
+
+		if (date == 0 || (s->value[e->latitude] == 0 && s->value[e->longitude] == 0))
+			return;   // no fix yet
+		fprintf(e->kml, "<when>20%02lu-%02lu-%02luT%02lu:%02lu:%02luZ</when>"
+		        "<gx:coord>%.6f %.6f %.0f</gx:coord>\n",
+		        date % 100, date / 100 % 100, date / 10000, time / 10000, time / 100 % 100, time % 100,
+		        logschema_value(s, e->longitude), logschema_value(s, e->latitude),
+		        e->height >= 0 ? logschema_value(s, e->height) : 0.0);
+		e->points++;
+	}
+	e->records++;
+}
+
+
+/*!
+ *   Exports the LogLegacy records of a page of older firmware.
+ *   @return 0 at the first empty record (the end of the log)
+ */
+static int export_legacy(struct Export *e, const unsigned char *p)
+{
+	struct LogSchema *s = &e->schema;
+	int j, r = logschema_find(s, LOG_LEGACY);
+
+	if (r < 0 && logschema_add_type(s, &legacy_type))
+		r = logschema_find(s, LOG_LEGACY);
+	if (r < 0)
+		return 0;
+	for (j = 0; j < (e->image->page_size - 2) / LEGACY_LINE_SIZE; j++)
+	{
+		const unsigned char *line = p + 2 + j * LEGACY_LINE_SIZE;
+		int i;
+
+		logschema_load(s, r, legacy_fields, line);
+		for (i = 0; i < 2; i++)   // also catches NaN (erased flash)
+			if (! (logschema_value(s, s->first[r] + i) < 360.0))
+				return 0;
+		export_record(e, r);
+	}
+	return 1;
+}
+
+
+//! The page handler of log_image_walk()
+static int export_page(void *context, const unsigned char *p)
+{
+	struct Export *e = context;
+
+	e->pages++;
+	if (log_image_get(p, 2) & LOG_PAGE_PACKED)
+		return log_image_read_records(e->image, p, &e->schema, export_record, e);
+	return export_legacy(e, p);
+}
+
+
+/*!
+ *   Converts a session, see log_image_walk().
+ */
+static void export_session(struct Export *e)
+{
+	const struct LogImage *image = e->image;
+	int page = log_image_first_page(image, e->session), i;
+	char name[1024];
+
+	logschema_clear(&e->schema);
+	e->latitude = e->longitude = e->height = e->date = e->time = -1;
+	if (page < 0 || log_image_page_session(&image->flash[(long)page * image->page_size]) != e->session)
+		return;   // overwritten by later sessions
+
+	snprintf(name, sizeof(name), "%s/session_%02d", directory, e->session);
+	if (mkdir(name, 0777) != 0 && access(name, W_OK) != 0)
+	{
+		perror(name);
+		e->error = 1;
+		return;
+	}
+	e->csv = open_output(e, "", ".csv");
+	e->kml = open_output(e, "", ".kml");
+	if (e->csv == NULL || e->kml == NULL)
+		goto done;
+
+	fprintf(e->kml, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+	        "<kml xmlns=\"http://www.opengis.net/kml/2.2\" xmlns:gx=\"http://www.google.com/kml/ext/2.2\">\n"
+	        "<Document><name>Gluonpilot session %d</name>\n"
+	        "<Style id=\"track\"><LineStyle><color>b32d47ff</color><width>5</width></LineStyle></Style>\n"
+	        "<Placemark><name>Session %d</name><styleUrl>#track</styleUrl>\n"
+	        "<gx:Track><altitudeMode>absolute</altitudeMode>\n", e->session, e->session);
+
+	log_image_walk(image, e->session, export_page, e);
+
+	fprintf(e->kml, "</gx:Track></Placemark>\n</Document>\n</kml>\n");
+
+done:
+	if (e->csv != NULL)
+		fclose(e->csv);
+	if (e->kml != NULL)
+		fclose(e->kml);
+	for (i = 0; i < LOGSCHEMA_MAX_FIELDS; i++)
+		if (e->column[i] != NULL && fclose(e->column[i]) != 0)
+			e->error = 1;
+}
+
+
+static void *export_thread(void *parameters)
+{
+	for (;;)
+	{
+		struct Export *e;
+
+		pthread_mutex_lock(&next_mutex);
+		e = next_export < export_count ? &exports[next_export++] : NULL;
+		pthread_mutex_unlock(&next_mutex);
+		if (e == NULL)
+			return NULL;
+		export_session(e);
+	}
+}
+
+
+static void usage()
+{
+	fprintf(stderr, "Usage: log_export [-o directory] [-j threads] [-s session] image\n");
+	exit(2);
+}
+
+
+int main(int argc, char *argv[])
+{
+	int c, i, session = 0, threads = sysconf(_SC_NPROCESSORS_ONLN), errors = 0;
+	struct LogImage image;
+	pthread_t *thread;
+
+	while ((c = getopt(argc, argv, "o:j:s:")) != -1)
+	{
+		switch (c)
+		{
+			case 'o': directory = optarg; break;
+			case 'j': threads = atoi(optarg); break;
+			case 's': session = atoi(optarg); break;
+			default: usage();
+		}
+	}
+	if (optind != argc - 1 || session < 0 || session > MAX_INDEX || threads < 1)
+		usage();
+
+	if (! log_image_open(argv[optind], &image))
+	{
+		fprintf(stderr, "%s: can't read the image\n", argv[optind]);
+		return 1;
+	}
+	fprintf(stderr, "%d byte pages, %s\n", image.page_size,
+	        image.layout != NULL ? image.layout->name : "index page of older firmware");
+
+	exports = calloc(image.sessions, sizeof(struct Export));
+	for (i = 0; i < image.sessions; i++)
+	{
+		if (log_image_first_page(&image, i + 1) < 0 || (session != 0 && session != i + 1))
+			continue;
+		exports[export_count].image = &image;
+		exports[export_count++].session = i + 1;
+	}
+	if (export_count == 0)
+	{
+		fprintf(stderr, "no session found\n");
+		return 1;
+	}
+
+	threads = MIN(threads, export_count);
+	thread = malloc(threads * sizeof(pthread_t));
+	for (i = 0; i < threads; i++)
+		pthread_create(&thread[i], NULL, export_thread, NULL);
+	for (i = 0; i < threads; i++)
+		pthread_join(thread[i], NULL);
+
+	for (i = 0; i < export_count; i++)
+	{
+		struct Export *e = &exports[i];
+
+		if (e->pages == 0 && ! e->error)
+			fprintf(stderr, "session %d: overwritten\n", e->session);
+		else
+			fprintf(stderr, "session %d: %ld pages, %ld records, %ld track points%s\n",
+			        e->session, e->pages, e->records, e->points, e->error ? ", write error" : "");
+		errors += e->error;
+	}
+	return errors != 0;
+}
@@ -0,0 +1,237 @@
+/*!
+ *  Implements the log image reader of log_image.h.
+ *
+ *  @file     log_image.c
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "task_datalogger.h"
+
+#include "log_image.h"
+
+#define MAX_PAGE           4095
+#define LOG_JOURNAL_PAGE   4080
+#define JOURNAL_PAGES      16
+#define JOURNAL_MAGIC      0x4A4C
+
+#define LEGACY_INDEX_SIZE  14     //!< sizeof(struct LogIndex) on the dsPIC
+
+static const struct LogJournalLayout journal_layouts[] =
+{
+	{ "dsPIC", 2, 4, 4, 76, LEGACY_INDEX_SIZE, 524 },
+	{ "SITL",  4, 8, 8, 152, 32, 1176 },
+};
+
+
+// The dsPIC is little endian
+unsigned long long log_image_get(const unsigned char *b, int size)
+{
+	unsigned long long v = 0;
+
+	while (size-- > 0)
+		v = (v << 8) | b[size];
+	return v;
+}
+
+long log_image_get_signed(const unsigned char *b, int size)
+{
+	unsigned long long v = log_image_get(b, size);
+
+	if (size < 8 && (v >> (size * 8 - 1)))
+		v |= ~0ULL << (size * 8);
+	return (long)(long long)v;
+}
+
+
+/*!
+ *   Finds the newest journal record with a valid checksum (see
+ *   datalogger_journal_load()), trying the layout of each compiler.
+ *   @return 0 for images of firmware without the journal
+ */
+static int find_journal(struct LogImage *image)
+{
+	unsigned long long best_sequence = 0;
+	int l, slot, i;
+
+	image->layout = NULL;
+	for (l = 0; l < (int)(sizeof(journal_layouts) / sizeof(journal_layouts[0])); l++)
+	{
+		const struct LogJournalLayout *layout = &journal_layouts[l];
+		int slot_pages = (layout->size + image->page_size - 1) / image->page_size;
+
+		for (slot = 0; slot < JOURNAL_PAGES / slot_pages; slot++)
+		{
+			const unsigned char *j = &image->flash[(long)(LOG_JOURNAL_PAGE + slot * slot_pages) * image->page_size];
+			unsigned long long checksum = 0, sequence = log_image_get(j + layout->sequence, layout->long_size);
+
+			if (log_image_get_signed(j, layout->int_size) != JOURNAL_MAGIC)
+				continue;
+			for (i = layout->sequence; i < layout->size; i++)
+				checksum += j[i];
+			checksum &= (1ULL << (layout->int_size * 8)) - 1;
+			if (checksum == log_image_get(j + layout->int_size, layout->int_size) &&
+			    (image->layout == NULL || sequence > best_sequence))
+			{
+				image->layout = layout;
+				image->index = j + layout->index;
+				best_sequence = sequence;
+			}
+		}
+	}
+	return image->layout != NULL;
+}
+
+
+/*!
+ *   Maps the image read-only and finds its geometry from its size and where
+ *   its sessions are.
+ *   @return 0 when it can't be read or isn't the size of an image
+ */
+int log_image_open(const char *filename, struct LogImage *image)
+{
+	struct stat st;
+	int fd = open(filename, O_RDONLY);
+	void *flash;
+
+	if (fd < 0)
+		return 0;
+	if (fstat(fd, &st) != 0 || (st.st_size != (off_t)LOG_IMAGE_PAGES * 528 && st.st_size != (off_t)LOG_IMAGE_PAGES * 264))
+	{
+		close(fd);
+		return 0;
+	}
+	flash = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (flash == MAP_FAILED)
+		return 0;
+	madvise(flash, st.st_size, MADV_WILLNEED);
+
+	image->flash = flash;
+	image->size = st.st_size;
+	image->page_size = st.st_size / LOG_IMAGE_PAGES;
+	image->start_page = image->page_size == 264 ? 9 : 5;   // see sitl_dataflash_geometry()
+	if (find_journal(image))
+	{
+		image->end_page = LOG_JOURNAL_PAGE;
+		image->sessions = MAX_INDEX;
+	}
+	else
+	{
+		image->index = &image->flash[(long)(image->start_page - 1) * image->page_size];   // LOG_INDEX_PAGE
+		image->end_page = MAX_PAGE;
+		image->sessions = LEGACY_MAX_INDEX;
+	}
+	return 1;
+}
+
+
+void log_image_close(struct LogImage *image)
+{
+	munmap((void *)image->flash, image->size);
+	image->flash = NULL;
+}
+
+
+/*!
+ *   @param session 1...sessions
+ *   @return The first page of the session in the index, -1 when it has none
+ */
+int log_image_first_page(const struct LogImage *image, int session)
+{
+	const struct LogJournalLayout *layout = image->layout;
+	int page = log_image_get_signed(image->index + (session - 1) * (layout != NULL ? layout->index_size : LEGACY_INDEX_SIZE),
+	                                layout != NULL ? layout->int_size : 2);
+
+	if (page < image->start_page || page >= image->end_page)
+		return -1;
+	return page;
+}
+
+
+/*!
+ *   @return The session of a page, 0 when unused (see page_index() in
+ *           task_datalogger.c)
+ */
+int log_image_page_session(const unsigned char *page)
+{
+	if (log_image_get(page, 2) == LOG_PAGE_ERASED)
+		return 0;
+	return log_image_get(page, 2) & LOG_PAGE_INDEX;
+}
+
+
+/*!
+ *   Calls page_handler with the pages of a session: from the first page in
+ *   the index, until a page of another session or until page_handler
+ *   returns 0. The log wraps around at end_page.
+ *   @return The number of pages of the session, 0 when it was overwritten
+ */
+long log_image_walk(const struct LogImage *image, int session,
+                    int (*page_handler)(void *context, const unsigned char *page), void *context)
+{
+	int page = log_image_first_page(image, session);
+	long pages;
+
+	if (page < 0)
+		return 0;
+	for (pages = 0; pages < image->end_page - image->start_page; )
+	{
+		const unsigned char *p = &image->flash[(long)page * image->page_size];
+
+		if (log_image_page_session(p) != session)
+			break;
+		pages++;
+		if (! page_handler(context, p))
+			break;
+		if (++page >= image->end_page)
+			page = image->start_page;
+	}
+	return pages;
+}
+
+
+/*!
+ *   Decodes the records of a page with record types (see
+ *   datalogger_print_page()) with the schema of the session, and calls
+ *   record_handler after each.
+ *   @return 0 when the page can't be read (the end of the log)
+ */
+int log_image_read_records(const struct LogImage *image, const unsigned char *page, struct LogSchema *schema,
+                           void (*record_handler)(void *context, int record), void *context)
+{
+	int page_size = image->page_size;
+	int records = log_image_get(page + 2, 2), used = PACKED_HEADER_SIZE, size, j, r;
+
+	logschema_new_page(schema);
+	for (j = 0; j < records && used < page_size - 1; j++)
+	{
+		int id = page[used++];
+
+		if (id == LOGSCHEMA_ID)
+		{
+			size = page[used++];
+			if (used + size > page_size || ! logschema_add(schema, page + used, size))
+				return 0;
+			used += size;
+			continue;
+		}
+		r = logschema_find(schema, id);
+		if (r < 0 && schema->records == 0)   // the start of the session was overwritten
+		{
+			for (r = 0; r < LOG_RECORD_TYPES; r++)
+				logschema_add_type(schema, &log_record_types[r]);
+			r = logschema_find(schema, id);
+		}
+		if (r < 0 || (size = logschema_decode(schema, r, page + used, page_size - used)) == 0)
+			return 0;
+		used += size;
+		record_handler(context, r);
+	}
+	return 1;
+}
@@ -0,0 +1,67 @@
+/*!
+ *  Reads the log of a flash image on the host, for the tools that don't use
+ *  the firmware's datalogger (ahrs_replay.c, log_export.c).
+ *
+ *  The image (made with sitl -f, read out of a module, or written by
+ *  "log_decode -d -w" from a DB capture) is mapped read-only and its page
+ *  size is found from its size, as sitl_dataflash_map() does. The sessions
+ *  come from the newest valid record of the log journal, looked for as the
+ *  dsPIC writes it and as the SITL build writes it (32 bit int, 64 bit
+ *  long), or from the index page of older firmware. The pages of a session
+ *  are walked the way datalogger_print_next_page() does.
+ *
+ *  @file     log_image.h
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#ifndef LOG_IMAGE_H
+#define LOG_IMAGE_H
+
+#define LOG_IMAGE_PAGES    4096
+
+#define LOG_PAGE_PACKED    0x4000 //!< Flag in the index number of a page
+#define LOG_PAGE_INDEX     0x00FF
+#define LOG_PAGE_ERASED    0xFFFF
+#define PACKED_HEADER_SIZE 4      //!< Index number and number of records of a page with record types
+
+struct LogSchema;
+
+//! Where the fields of a struct LogJournal are, for the compiler that wrote it
+struct LogJournalLayout
+{
+	const char *name;
+	int int_size;
+	int long_size;
+	int sequence;      //!< offsetof(struct LogJournal, sequence)
+	int index;         //!< offsetof(struct LogJournal, index)
+	int index_size;    //!< sizeof(struct LogIndex)
+	int size;          //!< sizeof(struct LogJournal)
+};
+
+//! The flash image and where the log is on it
+struct LogImage
+{
+	const unsigned char *flash;
+	long size;
+	int page_size;
+	int start_page;             //!< START_LOG_PAGE
+	int end_page;               //!< the log wraps around here
+	const struct LogJournalLayout *layout;   //!< NULL for the index page of older firmware
+	const unsigned char *index; //!< the session table
+	int sessions;
+};
+
+int  log_image_open(const char *filename, struct LogImage *image);
+void log_image_close(struct LogImage *image);
+int  log_image_first_page(const struct LogImage *image, int session);
+int  log_image_page_session(const unsigned char *page);
+long log_image_walk(const struct LogImage *image, int session,
+                    int (*page_handler)(void *context, const unsigned char *page), void *context);
+int  log_image_read_records(const struct LogImage *image, const unsigned char *page, struct LogSchema *schema,
+                            void (*record_handler)(void *context, int record), void *context);
+
+unsigned long long log_image_get(const unsigned char *b, int size);
+long log_image_get_signed(const unsigned char *b, int size);
+
+#endif // LOG_IMAGE_H
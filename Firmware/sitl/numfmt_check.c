@@ -0,0 +1,340 @@
+/*!
+ *  Checks lib/numfmt against the C library on the host.
+ *
+ *   int          numfmt_int, numfmt_uint and numfmt_hex against "%ld", "%lu"
+ *                and "%lx", for 32 bits values (the dsPIC's longs)
+ *   fixed        numfmt_fixed against "%.*f", for random float bit patterns
+ *                and 0 to 9 decimals: the same text, or "inf" out of range
+ *   format       numfmt_format against snprintf for the telemetry lines
+ *   parse_long   numfmt_parse_long against atol
+ *   parse_float  numfmt_parse_float against strtof, for random numbers
+ *                with up to 25 digits and exponents
+ *   round_trip   floats written with numfmt_fixed and read back with
+ *                numfmt_parse_float: enough decimals for 9 significant
+ *                digits give the same float back
+ *
+ *  Usage: numfmt_check [-n samples]
+ *
+ *  Prints the number of cases and differences of every check and exits with
+ *  1 when there was a difference. The times of numfmt and of the C library
+ *  are only informative: a host's printf is not the dsPIC's.
+ *
+ *  @file     numfmt_check.c
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#include "numfmt/numfmt.h"
+
+#define CALLS 1000000
+
+struct Result
+{
+	long cases, errors;
+	double numfmt_ns, libc_ns;
+};
+
+static volatile long sink;
+
+
+static double now_s()
+{
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+
+static uint32_t random32()
+{
+	return ((uint32_t)rand() << 16) ^ (uint32_t)rand() ^ ((uint32_t)rand() << 31);
+}
+
+
+static float float_from_bits(uint32_t l)
+{
+	union { float f; uint32_t l; } bits;
+
+	bits.l = l;
+	return bits.f;
+}
+
+
+//! The times are only measured for format and parse_float
+static void report(const char *name, const struct Result *r)
+{
+	if (r->numfmt_ns > 0.0)
+		printf("%s;%ld;%ld;%.1f;%.1f;%s\n", name, r->cases, r->errors, r->numfmt_ns, r->libc_ns,
+		       r->errors == 0 ? "ok" : "FAIL");
+	else
+		printf("%s;%ld;%ld;;;%s\n", name, r->cases, r->errors, r->errors == 0 ? "ok" : "FAIL");
+}
+
+
+static void difference(struct Result *r, const char *what, const char *got, const char *expected)
+{
+	if (r->errors++ < 5)
+		fprintf(stderr, "%s: \"%s\", expected \"%s\"\n", what, got, expected);
+}
+
+
+static void check_int(struct Result *r, long samples)
+{
+	static const long edges[] = { 0, 1, -1, 9, 10, 65535, 65536, -65536, 99999, 100000,
+	                              2147483647L, -2147483647L - 1 };
+	char got[NUMFMT_SIZE], expected[NUMFMT_SIZE];
+	long i, x;
+
+	for (i = 0; i < samples; i++)
+	{
+		x = i < (long)(sizeof(edges) / sizeof(edges[0])) ? edges[i] : (long)(int32_t)random32() >> (rand() % 32);
+		numfmt_int(got, x);
+		snprintf(expected, sizeof(expected), "%ld", x);
+		if (strcmp(got, expected) != 0)
+			difference(r, "int", got, expected);
+		numfmt_uint(got, (uint32_t)x);
+		snprintf(expected, sizeof(expected), "%lu", (unsigned long)(uint32_t)x);
+		if (strcmp(got, expected) != 0)
+			difference(r, "uint", got, expected);
+		numfmt_hex(got, (uint32_t)x);
+		snprintf(expected, sizeof(expected), "%lx", (unsigned long)(uint32_t)x);
+		if (strcmp(got, expected) != 0)
+			difference(r, "hex", got, expected);
+		r->cases += 3;
+	}
+}
+
+
+static void check_fixed(struct Result *r, long samples)
+{
+	char got[NUMFMT_SIZE], expected[400];
+	long i;
+	int decimals;
+
+	for (i = 0; i < samples; i++)
+	{
+		// half of the cases in the range of the protocol's numbers
+		float x = i % 2 ? float_from_bits(random32())
+		                : (float)((double)(int32_t)random32() / (1L << (rand() % 40)));
+
+		for (decimals = 0; decimals <= NUMFMT_MAX_DECIMALS; decimals++)
+		{
+			numfmt_fixed(got, x, decimals);
+			if (isfinite(x) && fabs(x) * pow(10.0, decimals) >= 9223372036854775808.0)
+				strcpy(expected, signbit(x) ? "-inf" : "inf");
+			else
+				snprintf(expected, sizeof(expected), "%.*f", decimals, (double)x);
+			if (strcmp(got, expected) != 0)
+				difference(r, "fixed", got, expected);
+			r->cases++;
+		}
+	}
+}
+
+
+static void check_format(struct Result *r, long samples)
+{
+	char got[100], expected[100];
+	long i;
+
+	for (i = 0; i < samples; i++)
+	{
+		float latitude = (float)((double)(int32_t)random32() / 2147483648.0 * 1.6);
+		float longitude = (float)((double)(int32_t)random32() / 2147483648.0 * 3.2);
+		float gain = (float)((double)(int32_t)random32() / 1e6);
+		int a = (int)(int16_t)random32(), b = (int)(int16_t)random32();
+		long l = (long)(int32_t)random32();
+
+		numfmt_format(got, sizeof(got), "TG;%c;%.9f;%.9f;%u;%u;%u;%u", '0' + a % 3, latitude, longitude,
+		              (unsigned int)(uint16_t)a, (unsigned int)(uint16_t)b, 9u, 123u);
+		snprintf(expected, sizeof(expected), "TG;%c;%.9f;%.9f;%u;%u;%u;%u", '0' + a % 3, latitude, longitude,
+		         (unsigned int)(uint16_t)a, (unsigned int)(uint16_t)b, 9u, 123u);
+		if (strcmp(got, expected) != 0)
+			difference(r, "format", got, expected);
+		numfmt_format(got, sizeof(got), "ND;%d;%d;%f;%f;%d;%d;%x;%ld;%lu;%s;100%%", a, b, gain, latitude, a, b,
+		              (unsigned int)(uint16_t)b, l, (unsigned long)(uint32_t)l, "end");
+		snprintf(expected, sizeof(expected), "ND;%d;%d;%f;%f;%d;%d;%x;%ld;%lu;%s;100%%", a, b, gain, latitude, a, b,
+		         (unsigned int)(uint16_t)b, l, (unsigned long)(uint32_t)l, "end");
+		if (strcmp(got, expected) != 0)
+			difference(r, "format", got, expected);
+		r->cases += 2;
+	}
+
+	// truncated like snprintf, but returns the length written
+	if (numfmt_format(got, 8, "TA;%d;%d", 12345, 678) != 7 || strcmp(got, "TA;1234") != 0)
+		difference(r, "format (truncated)", got, "TA;1234");
+	r->cases++;
+}
+
+
+static void check_parse_long(struct Result *r, long samples)
+{
+	static const char *edges[] = { "0", "-0", "+12", " 42", "123;456", "-2147483648", "2147483647", "", "abc", "7*1f" };
+	char text[NUMFMT_SIZE], got[NUMFMT_SIZE], expected[NUMFMT_SIZE];
+	long i;
+
+	for (i = 0; i < samples; i++)
+	{
+		if (i < (long)(sizeof(edges) / sizeof(edges[0])))
+			strcpy(text, edges[i]);
+		else
+			snprintf(text, sizeof(text), "%ld;", (long)(int32_t)random32() >> (rand() % 32));
+		snprintf(got, sizeof(got), "%ld", numfmt_parse_long(text));
+		snprintf(expected, sizeof(expected), "%ld", atol(text));
+		if (strcmp(got, expected) != 0)
+			difference(r, text, got, expected);
+		r->cases++;
+	}
+}
+
+
+//! A random decimal number: sign, up to 25 digits with a point somewhere, maybe an exponent
+static void random_number(char *text)
+{
+	int digits = 1 + rand() % 25, point = rand() % (digits + 1), i;
+
+	if (rand() % 3 == 0)
+		*text++ = '-';
+	for (i = 0; i < digits; i++)
+	{
+		if (i == point)
+			*text++ = '.';
+		// runs of 0s and 9s, near powers of 10 and halfway cases
+		*text++ = rand() % 4 == 0 ? '0' + 9 * (rand() % 2) : '0' + rand() % 10;
+	}
+	if (rand() % 3 == 0)
+		text += sprintf(text, "e%d", rand() % 100 - 55);
+	strcpy(text, ";");
+}
+
+
+static void check_parse_float(struct Result *r, long samples)
+{
+	static const char *edges[] = { "0", "-0.0", "1", "0.1", "3.14159265358979", "1e38", "3.4028235e38", "3.5e38",
+	                               "1e39", "1.17549435e-38", "1e-45", "7e-46", "1e-46", "16777217", "0.000000001",
+	                               "123456789012345678901234567890", "1.5e", "  -2.5", ".5", "5.", "100*2a" };
+	char text[64], got[64], expected[64];
+	long i;
+
+	for (i = 0; i < samples; i++)
+	{
+		if (i < (long)(sizeof(edges) / sizeof(edges[0])))
+			strcpy(text, edges[i]);
+		else
+			random_number(text);
+		snprintf(got, sizeof(got), "%a", numfmt_parse_float(text));
+		snprintf(expected, sizeof(expected), "%a", strtof(text, NULL));
+		if (strcmp(got, expected) != 0)
+			difference(r, text, got, expected);
+		r->cases++;
+	}
+}
+
+
+static void check_round_trip(struct Result *r, long samples)
+{
+	char text[NUMFMT_SIZE], got[64], expected[64];
+	long i;
+
+	for (i = 0; i < samples; i++)
+	{
+		// |x| in [0.1, 1e9]: 9 decimals are 9 significant digits or more
+		float x = (float)(exp(log(0.1) + (log(1e9) - log(0.1)) * rand() / RAND_MAX) * (rand() % 2 ? 1 : -1));
+		float y;
+
+		numfmt_fixed(text, x, NUMFMT_MAX_DECIMALS);
+		y = numfmt_parse_float(text);
+		if (y != x)
+		{
+			snprintf(got, sizeof(got), "%a", y);
+			snprintf(expected, sizeof(expected), "%a", x);
+			difference(r, text, got, expected);
+		}
+		r->cases++;
+	}
+}
+
+
+//! The TG line of the telemetry, and the floats of a PP command
+static void timing(struct Result *format, struct Result *parse)
+{
+	static const char *pid[] = { "0.0200", "1.5", "-0.25", "0.000", "20.5", "0.0500" };
+	char line[100];
+	float latitude = 0.8912345f, longitude = 0.0712345f, sum = 0.0f;
+	double start;
+	long i;
+
+	start = now_s();
+	for (i = 0; i < CALLS; i++)
+		sink += numfmt_format(line, sizeof(line), "TG;%c;%.9f;%.9f;%u;%u;%u;%u", '1', latitude, longitude, 123u, 314u, 9u, 55u);
+	format->numfmt_ns = (now_s() - start) * 1e9 / CALLS;
+	start = now_s();
+	for (i = 0; i < CALLS; i++)
+		sink += snprintf(line, sizeof(line), "TG;%c;%.9f;%.9f;%u;%u;%u;%u", '1', latitude, longitude, 123u, 314u, 9u, 55u);
+	format->libc_ns = (now_s() - start) * 1e9 / CALLS;
+
+	start = now_s();
+	for (i = 0; i < CALLS; i++)
+		sum += numfmt_parse_float(pid[i % 6]);
+	parse->numfmt_ns = (now_s() - start) * 1e9 / CALLS;
+	start = now_s();
+	for (i = 0; i < CALLS; i++)
+		sum += (float)atof(pid[i % 6]);
+	parse->libc_ns = (now_s() - start) * 1e9 / CALLS;
+	sink += (long)sum;
+}
+
+
+static void usage()
+{
+	fprintf(stderr, "Usage: numfmt_check [-n samples]\n");
+	exit(1);
+}
+
+
+int main(int argc, char *argv[])
+{
+	struct Result integer = { 0 }, fixed = { 0 }, format = { 0 }, parse_long = { 0 }, parse_float = { 0 },
+	              round_trip = { 0 };
+	long samples = 200000;
+	int c;
+
+	while ((c = getopt(argc, argv, "n:")) != -1)
+	{
+		switch (c)
+		{
+			case 'n': samples = atol(optarg); break;
+			default: usage();
+		}
+	}
+	if (samples < 100)
+		usage();
+
+	srand(1);
+	check_int(&integer, samples);
+	check_fixed(&fixed, samples);
+	check_format(&format, samples);
+	check_parse_long(&parse_long, samples);
+	check_parse_float(&parse_float, samples);
+	check_round_trip(&round_trip, samples);
+	timing(&format, &parse_float);
+
+	printf("check;cases;differences;numfmt_ns;libc_ns;result\n");
+	report("int", &integer);
+	report("fixed", &fixed);
+	report("format", &format);
+	report("parse_long", &parse_long);
+	report("parse_float", &parse_float);
+	report("round_trip", &round_trip);
+	return integer.errors + fixed.errors + format.errors + parse_long.errors + parse_float.errors +
+	       round_trip.errors > 0;
+}
@@ -0,0 +1,169 @@
+/*!
+ *  Checks the fixed point PID bank (lib/pid/pid_q16.c) against the float
+ *  pid_update() on the host.
+ *
+ *  Four wing loops (the P gains of configuration_default(), with I and D
+ *  terms as a tuned aircraft has them) and four with copter-like P, I and D
+ *  gains are fed the same error signals, a mix of slow sines, steps and
+ *  noise, large enough to hit the integrator and output limits. The float
+ *  output, limited to the same output range, is the reference. Samples where
+ *  the float derivative is within 1% of d_term_min_var are skipped: there
+ *  the rounding of the fixed point version may switch the D-term on or off.
+ *
+ *  Usage: pid_check [-n samples] [-t tolerance]
+ *
+ *  Prints the maximum difference per loop, as a fraction of its output range,
+ *  and exits with 1 when one is above the tolerance (default 0.0005).
+ *
+ *  @file     pid_check.c
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <unistd.h>
+
+#include "pid/pid.h"
+#include "pid/pid_q16.h"
+
+#define DT 0.02f
+
+struct LoopSetup
+{
+	const char *name;
+	float d_gain, p_gain, i_gain, i_min, i_max, d_term_min_var;
+	float out_min, out_max;
+	float amplitude;   //!< Of the error signal
+};
+
+static const struct LoopSetup wing[PID_Q16_MAX_LOOPS] =
+{
+	{ "heading2roll",   0.02f, 0.7f,  0.05f, -1.0f, 1.0f, 0.1f,  -1.0f,   1.0f,   3.0f },
+	{ "pitch2elevator", 0.02f, 0.7f,  0.2f,  -0.5f, 0.5f, 0.1f,  -1.0f,   1.0f,   0.5f },
+	{ "roll2aileron",   0.01f, 0.5f,  0.1f,  -0.5f, 0.5f, 0.1f,  -1.0f,   1.0f,   0.8f },
+	{ "altitude2pitch", 0.01f, 0.03f, 0.005f, -20.0f, 20.0f, 1.0f, -0.5f,  0.5f,   40.0f },
+};
+
+static const struct LoopSetup copter[PID_Q16_MAX_LOOPS] =
+{
+	{ "copter_pitch",   0.05f, 0.6f,  0.3f,  -0.5f, 0.5f, 0.2f,  -1.27f,  1.27f,  0.6f },
+	{ "copter_roll",    0.05f, 0.6f,  0.3f,  -0.5f, 0.5f, 0.2f,  -1.27f,  1.27f,  0.6f },
+	{ "copter_yaw",     0.02f, 1.5f,  0.1f,  -1.0f, 1.0f, 0.0f,  -1.27f,  1.27f,  1.5f },
+	{ "altitude_hold",  0.5f,  0.1f,  0.01f, -20.0f, 20.0f, 0.5f, -100.0f, 100.0f, 30.0f },
+};
+
+
+static float noise()
+{
+	return (float)rand() / RAND_MAX * 2.0f - 1.0f;
+}
+
+static float error_signal(const struct LoopSetup *s, long i, int loop)
+{
+	float t = i * DT;
+	float e = sinf(t * (0.3f + 0.2f * loop)) + 0.2f * noise();
+
+	if ((i / 400) % 3 == 1)   // steps
+		e += 1.5f;
+	return e * s->amplitude;
+}
+
+
+static float limit(float v, float min, float max)
+{
+	return v > max ? max : (v < min ? min : v);
+}
+
+
+static int check(const char *bank_name, const struct LoopSetup *setup, long samples, float tolerance)
+{
+	struct pid pid[PID_Q16_MAX_LOOPS];
+	struct pid_q16_bank bank;
+	q16 position[PID_Q16_MAX_LOOPS], out[PID_Q16_MAX_LOOPS];
+	float max_diff[PID_Q16_MAX_LOOPS] = { 0 };
+	long skipped[PID_Q16_MAX_LOOPS] = { 0 };
+	int loop, failed = 0;
+	long i;
+
+	srand(1);
+	pid_q16_init(&bank, DT);
+	for (loop = 0; loop < PID_Q16_MAX_LOOPS; loop++)
+	{
+		const struct LoopSetup *s = &setup[loop];
+		pid_init(&pid[loop], s->d_gain, s->p_gain, s->i_gain, s->i_min, s->i_max, s->d_term_min_var);
+		pid_q16_add(&bank, &pid[loop], s->out_min, s->out_max);
+	}
+
+	for (i = 0; i < samples; i++)
+	{
+		float reference[PID_Q16_MAX_LOOPS];
+		int near_threshold[PID_Q16_MAX_LOOPS];
+
+		for (loop = 0; loop < PID_Q16_MAX_LOOPS; loop++)
+		{
+			const struct LoopSetup *s = &setup[loop];
+			// Both versions see the same, already quantized, error
+			position[loop] = q16_from_float(error_signal(s, i, loop));
+			float e = q16_to_float(position[loop]);
+			float d = fabsf((e - pid[loop].d_state) / DT);
+
+			near_threshold[loop] = s->d_term_min_var > 0.0f && fabsf(d - s->d_term_min_var) < 0.01f * s->d_term_min_var;
+			reference[loop] = limit(pid_update(&pid[loop], e, DT), s->out_min, s->out_max);
+		}
+
+		pid_q16_update_all(&bank, position, out);
+
+		for (loop = 0; loop < PID_Q16_MAX_LOOPS; loop++)
+		{
+			const struct LoopSetup *s = &setup[loop];
+			float diff = fabsf(q16_to_float(out[loop]) - reference[loop]) / (s->out_max - s->out_min);
+			if (near_threshold[loop])
+				skipped[loop]++;
+			else if (diff > max_diff[loop])
+				max_diff[loop] = diff;
+		}
+	}
+
+	for (loop = 0; loop < PID_Q16_MAX_LOOPS; loop++)
+	{
+		int ok = max_diff[loop] <= tolerance;
+		printf("%s;%s;%.6f;%ld;%s\n", bank_name, setup[loop].name, max_diff[loop], skipped[loop], ok ? "ok" : "FAIL");
+		if (! ok)
+			failed = 1;
+	}
+	return failed;
+}
+
+
+static void usage()
+{
+	fprintf(stderr, "Usage: pid_check [-n samples] [-t tolerance]\n");
+	exit(1);
+}
+
+
+int main(int argc, char *argv[])
+{
+	long samples = 100000;
+	float tolerance = 0.0005f;
+	int c, failed = 0;
+
+	while ((c = getopt(argc, argv, "n:t:")) != -1)
+	{
+		switch (c)
+		{
+			case 'n': samples = atol(optarg); break;
+			case 't': tolerance = atof(optarg); break;
+			default: usage();
+		}
+	}
+	if (samples <= 0)
+		usage();
+
+	printf("bank;loop;max_diff_of_range;skipped;result\n");
+	failed |= check("wing", wing, samples, tolerance);
+	failed |= check("copter", copter, samples, tolerance);
+	return failed;
+}
@@ -0,0 +1,177 @@
+/*!
+ *  Stand-ins for the board level libraries that have no simulated
+ *  counterpart: lib/microcontroller, lib/led, lib/button, lib/i2c,
+ *  lib/hmc5843 and lib/max7456.
+ *
+ *  Also defines the special function registers declared in
+ *  include/p33FJ256MC710.h.
+ *
+ *  @file     sim_board.c
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include "microcontroller/microcontroller.h"
+#include "led/led.h"
+#include "button/button.h"
+#include "hmc5843/hmc5843.h"
+#include "max7456/max7456.h"
+
+volatile TRISEBITS TRISEbits;
+volatile PORTEBITS PORTEbits;
+volatile TRISGBITS TRISGbits;
+volatile PORTGBITS PORTGbits;
+volatile IFS1BITS IFS1bits;
+volatile IEC1BITS IEC1bits;
+volatile unsigned int U2RXREG;
+volatile T5CONBITS T5CONbits;
+volatile unsigned int TMR5;
+
+static unsigned char led1_state = 1, led2_state = 1;   // 1 = off, like the port pins
+
+
+void microcontroller_init()
+{
+}
+
+
+/*!
+ *  Busy waits don't take simulated time: the tick only advances when the
+ *  tasks block.
+ */
+void microcontroller_delay_ms(unsigned long ms)
+{
+}
+
+
+void microcontroller_delay_us(unsigned long us)
+{
+}
+
+
+int microcontroller_after_reboot()
+{
+	return 0;
+}
+
+
+void microcontroller_reset_type()
+{
+}
+
+
+void led_init()
+{
+}
+
+void led1_on()
+{
+	led1_state = 0;
+}
+
+void led1_off()
+{
+	led1_state = 1;
+}
+
+void led1_toggle()
+{
+	led1_state = !led1_state;
+}
+
+unsigned char led1_is_off()
+{
+	return led1_state;
+}
+
+void led2_on()
+{
+	led2_state = 0;
+}
+
+void led2_off()
+{
+	led2_state = 1;
+}
+
+void led2_toggle()
+{
+	led2_state = !led2_state;
+}
+
+unsigned char led2_is_off()
+{
+	return led2_state;
+}
+
+
+void button_init()
+{
+}
+
+int button_down()
+{
+	return 0;
+}
+
+int button_up()
+{
+	return 1;
+}
+
+
+/*
+ *  No magnetometer on the i2c bus.
+ */
+void i2c_init(void)
+{
+}
+
+void hmc5843_init(void)
+{
+}
+
+void hmc5843_read(struct intvector *magdata)
+{
+	magdata->x.i16 = 0;
+	magdata->y.i16 = 0;
+	magdata->z.i16 = 0;
+}
+
+
+/*
+ *  MAX7456 OSD chip: accepts everything, reads back what was written so the
+ *  OSD task finds a chip in PAL mode.
+ */
+static unsigned char max7456_registers[256];
+
+void max7456_init()
+{
+}
+
+void max7456_loadchars()
+{
+}
+
+void spiWriteReg(const unsigned char regAddr, const unsigned char regData)
+{
+	max7456_registers[regAddr & 0x7F] = regData;
+}
+
+unsigned char spiReadReg(const unsigned char regAddr)
+{
+	return max7456_registers[regAddr & 0x7F];
+}
+
+void spiWriteCM()
+{
+}
+
+void spiWriteFM()
+{
+}
+
+int max756_read_status()
+{
+	return 0;
+}
@@ -0,0 +1,413 @@
+/*!
+ *  Stand-in for lib/dataflash: an AT45DB161D (16Mbit, 4096 pages of 528 bytes)
+ *  or, with sitl_dataflash_geometry(264), the 264 bytes pages of the 8Mbit
+ *  AT45DB081 that gp1_dataflash_open() also supports, with the same layout
+ *  of the configuration, flight plan and log pages.
+ *
+ *  The contents live in memory, or in an image file mapped in memory
+ *  (sitl_dataflash_map()): every write goes straight to the file, so the
+ *  configuration, the flight plan and the logs survive between runs, even a
+ *  run that crashes. Without an image the chip starts formatted (all zeros).
+ *
+ *  The two SRAM buffers are emulated too, and the RDY/BUSY timing: programming
+ *  a page keeps the chip busy for 20 FreeRTOS ticks (20ms, the tEP of the
+ *  datasheet), a block erase for 45 and a sector erase for 1600 (the typical
+ *  tBE and tSE). The datalogger sees the same behaviour as on the hardware,
+ *  and sitl_dataflash_stats counts what would stall or fail there: reads and
+ *  writes waiting for the chip (the driver polls the status register) and
+ *  programs and erases started while busy.
+ *
+ *  @file     sim_dataflash.c
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "FreeRTOS/FreeRTOS.h"
+#include "FreeRTOS/task.h"
+
+#include "dataflash/dataflash.h"
+#include "sitl.h"
+
+struct Dataflash dataflash;
+struct SitlDataflashStats sitl_dataflash_stats;
+
+int MAX_PAGE = 4095;
+int PAGE_SIZE = 528;
+
+int START_LOG_PAGE = 5;
+int	LOG_INDEX_PAGE = 4;
+int	CONFIGURATION_PAGE = 0;
+int	NAVIGATION_PAGE = 2;
+int	LOG_JOURNAL_PAGE = 4080;  // the last 16 pages, see task_datalogger.c
+
+#define FLASH_SIZE ((long)(MAX_PAGE + 1) * PAGE_SIZE)
+#define PAGE_PROGRAM_TICKS 20
+#define BLOCK_ERASE_TICKS  45
+#define SECTOR_ERASE_TICKS 1600
+
+static int density = 6;                  // read_Mbit(): 6 = 16Mbit, 5 = 8Mbit
+static unsigned char *flash = NULL;
+static long flash_size = 0;              // of flash, 0 when not allocated
+static int mapped = 0;                   // 1 when flash is an image file mapped in memory
+static unsigned char sram_buffer[2][528];
+static unsigned long page_programs[4096];
+static portTickType program_start;
+static portTickType program_ticks;
+static int program_buffer_nr = 0;        // SRAM buffer being programmed, 0 for none
+static int busy = 0;
+
+
+static int sim_dataflash_is_ready()
+{
+	// 16 bit ticks: only the difference survives the wrap around
+	if (busy && (portTickType)(xTaskGetTickCount() - program_start) >= program_ticks)
+	{
+		busy = 0;
+		program_buffer_nr = 0;
+	}
+	return ! busy;
+}
+
+
+static int sim_dataflash_read_Mbit()
+{
+	return density;
+}
+
+
+/*!
+ *   The layout of the pages for the geometry of read_Mbit(), as
+ *   gp1_dataflash_open()
+ */
+static void sim_dataflash_layout()
+{
+	MAX_PAGE = 4095;
+	LOG_JOURNAL_PAGE = 4080;
+	CONFIGURATION_PAGE = 0;
+	if (sim_dataflash_read_Mbit() == 5)
+	{
+		PAGE_SIZE = 264;
+		START_LOG_PAGE = 9;
+		LOG_INDEX_PAGE = 8;
+		NAVIGATION_PAGE = 4;
+	}
+	else
+	{
+		PAGE_SIZE = 528;
+		START_LOG_PAGE = 5;
+		LOG_INDEX_PAGE = 4;
+		NAVIGATION_PAGE = 2;
+	}
+}
+
+
+/*!
+ *   Without an image the chip is allocated, formatted.
+ */
+static void sim_dataflash_open()
+{
+	sim_dataflash_layout();
+	if (mapped)
+		return;
+	if (flash != NULL && flash_size != FLASH_SIZE)
+	{
+		free(flash);
+		flash = NULL;
+	}
+	if (flash == NULL)
+	{
+		flash = calloc(FLASH_SIZE, 1);
+		flash_size = FLASH_SIZE;
+	}
+}
+
+
+/*!
+ *   An operation that needs the chip ready, see sitl_dataflash_stats
+ */
+static void sim_dataflash_check_ready()
+{
+	if (! sim_dataflash_is_ready())
+		sitl_dataflash_stats.busy_violations++;
+}
+
+
+/*!
+ *   An operation the driver starts when the chip is ready
+ */
+static void sim_dataflash_wait_ready()
+{
+	if (! sim_dataflash_is_ready())
+		sitl_dataflash_stats.stall_ticks += program_ticks - (portTickType)(xTaskGetTickCount() - program_start);
+}
+
+
+static void sim_dataflash_start(portTickType ticks)
+{
+	program_start = xTaskGetTickCount();
+	program_ticks = ticks;
+	busy = 1;
+	sitl_dataflash_stats.busy_ticks += ticks;
+}
+
+
+static void sim_dataflash_programmed(int page)
+{
+	page_programs[page]++;
+	sitl_dataflash_stats.pages_programmed++;
+	if (page_programs[page] > sitl_dataflash_stats.max_page_programs)
+		sitl_dataflash_stats.max_page_programs = page_programs[page];
+}
+
+
+/*!
+ *   Continuous read: crosses page boundaries, like command 0xE8.
+ */
+static void sim_dataflash_read_array(int page, int offset, int size, unsigned char *buffer)
+{
+	long address = (long)page * PAGE_SIZE + offset;
+
+	sim_dataflash_wait_ready();
+	if (address + size > FLASH_SIZE)
+		size = FLASH_SIZE - address;
+	memcpy(buffer, &flash[address], size);
+	sitl_dataflash_stats.bytes_read += size;
+}
+
+
+static void sim_dataflash_read(int page, int size, unsigned char *buffer)
+{
+	sim_dataflash_read_array(page, 0, size, buffer);
+}
+
+
+static void sim_dataflash_copy(int page, int size, unsigned char *buffer)
+{
+	long address = (long)page * PAGE_SIZE;
+
+	if (address + size > FLASH_SIZE)
+		size = FLASH_SIZE - address;
+	memcpy(&flash[address], buffer, size);
+}
+
+
+/*!
+ *   Allowed while the chip programs the other buffer.
+ */
+static void sim_dataflash_write_buffer(int buffer_nr, int size, unsigned char *buffer)
+{
+	buffer_nr = buffer_nr == 2 ? 2 : 1;
+	if (! sim_dataflash_is_ready() && program_buffer_nr == buffer_nr)
+		sitl_dataflash_stats.busy_violations++;
+	if (size > PAGE_SIZE)
+		size = PAGE_SIZE;
+	memcpy(sram_buffer[buffer_nr - 1], buffer, size);
+}
+
+
+static void sim_dataflash_program_buffer(int buffer_nr, int page)
+{
+	buffer_nr = buffer_nr == 2 ? 2 : 1;
+	sim_dataflash_check_ready();
+	sim_dataflash_copy(page, PAGE_SIZE, sram_buffer[buffer_nr - 1]);
+	sim_dataflash_programmed(page);
+	program_buffer_nr = buffer_nr;
+	sim_dataflash_start(PAGE_PROGRAM_TICKS);
+}
+
+
+/*!
+ *   As the driver: every page goes through SRAM buffer 1 (write_buffer(1)
+ *   and program_buffer(1)), after polling the chip until it is ready. So a
+ *   page another task left in buffer 1 is overwritten, and a last page
+ *   shorter than PAGE_SIZE is programmed with the rest of the buffer.
+ */
+static void sim_dataflash_write(int page, int size, unsigned char *buffer)
+{
+	int length;
+
+	for (; size > 0 && page <= MAX_PAGE; page++, buffer += length, size -= length)
+	{
+		length = size > PAGE_SIZE ? PAGE_SIZE : size;
+		if (! sim_dataflash_is_ready())
+		{
+			sim_dataflash_wait_ready();
+			busy = 0;   // polled until ready, no time passes in the simulation
+			program_buffer_nr = 0;
+		}
+		sim_dataflash_write_buffer(1, length, buffer);
+		sim_dataflash_program_buffer(1, page);
+	}
+}
+
+
+static void sim_dataflash_erase_block(int page)
+{
+	sim_dataflash_check_ready();
+	page &= ~(DATAFLASH_BLOCK_PAGES - 1);
+	memset(&flash[(long)page * PAGE_SIZE], 0xFF, (long)DATAFLASH_BLOCK_PAGES * PAGE_SIZE);
+	sitl_dataflash_stats.blocks_erased++;
+	sim_dataflash_start(BLOCK_ERASE_TICKS);
+}
+
+
+/*!
+ *   Sector 0 is split in 0a (one block) and 0b (the rest of the sector).
+ */
+static void sim_dataflash_erase_sector(int page)
+{
+	int first = page & ~(DATAFLASH_SECTOR_PAGES - 1), count = DATAFLASH_SECTOR_PAGES;
+
+	sim_dataflash_check_ready();
+	if (first == 0)
+	{
+		first = page < DATAFLASH_BLOCK_PAGES ? 0 : DATAFLASH_BLOCK_PAGES;
+		count = page < DATAFLASH_BLOCK_PAGES ? DATAFLASH_BLOCK_PAGES : DATAFLASH_SECTOR_PAGES - DATAFLASH_BLOCK_PAGES;
+	}
+	memset(&flash[(long)first * PAGE_SIZE], 0xFF, (long)count * PAGE_SIZE);
+	sitl_dataflash_stats.sectors_erased++;
+	sim_dataflash_start(SECTOR_ERASE_TICKS);
+}
+
+
+void dataflash_open()
+{
+	dataflash.open = sim_dataflash_open;
+	dataflash.read = sim_dataflash_read;
+	dataflash.write = sim_dataflash_write;
+	dataflash.read_Mbit = sim_dataflash_read_Mbit;
+	dataflash.write_buffer = sim_dataflash_write_buffer;
+	dataflash.program_buffer = sim_dataflash_program_buffer;
+	dataflash.is_ready = sim_dataflash_is_ready;
+	dataflash.read_array = sim_dataflash_read_array;
+	dataflash.erase_block = sim_dataflash_erase_block;
+	dataflash.erase_sector = sim_dataflash_erase_sector;
+	sim_dataflash_open();
+}
+
+
+/*!
+ *   Selects the page size of the chip: 528 (default) or 264. Call it before
+ *   dataflash_open().
+ */
+void sitl_dataflash_geometry(int page_size)
+{
+	density = page_size == 264 ? 5 : 6;
+}
+
+
+/*!
+ *   The geometry of an image, from its size.
+ *   @return 0 when the size fits neither geometry
+ */
+static int sim_dataflash_image_geometry(long size)
+{
+	if (size == 4096l * 528l)
+		return 528;
+	if (size == 4096l * 264l)
+		return 264;
+	return 0;
+}
+
+
+/*!
+ *   Maps an image file in memory as the contents of the chip: a file that
+ *   exists selects the geometry by its size, a new one is created formatted
+ *   with the current geometry.
+ *   @return 1 when the image existed, 0 when it was created, -1 on errors
+ */
+int sitl_dataflash_map(const char *filename)
+{
+	struct stat st;
+	int fd = open(filename, O_RDWR | O_CREAT, 0644);
+	int existed;
+
+	if (fd < 0 || fstat(fd, &st) != 0)
+	{
+		perror(filename);
+		return -1;
+	}
+	existed = st.st_size > 0;
+	if (existed && sim_dataflash_image_geometry(st.st_size) == 0)
+	{
+		fprintf(stderr, "%s: %ld bytes is no image of 4096 pages of 528 or 264 bytes\n", filename, (long)st.st_size);
+		close(fd);
+		return -1;
+	}
+	if (existed)
+		sitl_dataflash_geometry(sim_dataflash_image_geometry(st.st_size));
+	sim_dataflash_layout();
+	sitl_dataflash_close();
+	free(flash);   // of dataflash_open()
+
+	if ((! existed && ftruncate(fd, FLASH_SIZE) != 0) ||
+	    (flash = mmap(NULL, FLASH_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)) == MAP_FAILED)
+	{
+		perror(filename);
+		close(fd);
+		flash = NULL;
+		return -1;
+	}
+	close(fd);   // the mapping stays
+	flash_size = FLASH_SIZE;
+	mapped = 1;
+	return existed;
+}
+
+
+/*!
+ *   Writes a mapped image back to its file.
+ */
+void sitl_dataflash_close()
+{
+	if (! mapped)
+		return;
+	msync(flash, flash_size, MS_SYNC);
+	munmap(flash, flash_size);
+	flash = NULL;
+	flash_size = 0;
+	mapped = 0;
+}
+
+
+/*!
+ *   Loads a copy of a raw flash image, its size selects the geometry.
+ *   @return 1 when the image was loaded, 0 when the chip stays formatted.
+ */
+int sitl_dataflash_load(const char *filename)
+{
+	FILE *f = fopen(filename, "rb");
+	int loaded;
+
+	if (f != NULL && fseek(f, 0, SEEK_END) == 0 && sim_dataflash_image_geometry(ftell(f)) != 0)
+		sitl_dataflash_geometry(sim_dataflash_image_geometry(ftell(f)));
+	sim_dataflash_open();
+	if (f == NULL)
+		return 0;
+	rewind(f);
+	loaded = fread(flash, 1, FLASH_SIZE, f) > 0;
+	fclose(f);
+	return loaded;
+}
+
+
+void sitl_dataflash_save(const char *filename)
+{
+	FILE *f = fopen(filename, "wb");
+
+	if (f == NULL)
+	{
+		perror(filename);
+		return;
+	}
+	fwrite(flash, 1, FLASH_SIZE, f);
+	fclose(f);
+}
@@ -0,0 +1,83 @@
+/*!
+ *  Stand-in for lib/ppm_in and lib/pwm_in: the RC receiver.
+ *
+ *  By default no transmitter is switched on, so the control task falls back
+ *  to autopilot mode. The receiver outputs the last received pulses: sticks
+ *  centered and throttle closed. sitl_ppm_set_connection() and
+ *  sitl_ppm_set_channel() simulate a pilot.
+ *
+ *  @file     sim_ppm_in.c
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include "ppm_in/ppm_in.h"
+#include "pwm_in/pwm_in.h"
+#include "configuration.h"
+#include "sitl.h"
+
+volatile struct ppm_info ppm;
+
+static int transmitter_on = 0;
+
+
+void ppm_in_open()
+{
+	int i;
+
+	for (i = 0; i < 14; i++)
+		ppm.channel[i] = 1500;
+	ppm.channel[config.control.channel_motor] = 1000;
+}
+
+
+void ppm_in_guess_num_channels()
+{
+}
+
+
+void ppm_in_update_status(float dt)
+{
+	ppm.connection_alive = transmitter_on;
+}
+
+
+void ppm_in_update_status_ticks_50hz()
+{
+	ppm.connection_alive = transmitter_on;
+}
+
+
+int ppm_signal_quality()
+{
+	return transmitter_on ? 0 : 25;
+}
+
+
+void pwm_in_open()
+{
+}
+
+
+void pwm_in_wait_for()
+{
+}
+
+
+void sitl_ppm_set_channel(int channel, unsigned int us)
+{
+	if (channel >= 0 && channel < 14)
+		ppm.channel[channel] = us;
+}
+
+
+/*!
+ *   Switches the transmitter on or off. When switched off, the channels keep
+ *   their last value like a receiver without failsafe.
+ */
+void sitl_ppm_set_connection(int alive)
+{
+	transmitter_on = alive;
+	ppm.valid_frame = alive;
+	ppm.connection_alive = alive;
+}
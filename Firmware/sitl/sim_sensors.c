@@ -0,0 +1,148 @@
+/*!
+ *  Stand-ins for the sensor libraries: lib/mpu6000, lib/bmp085, lib/adc and
+ *  the pressure conversion of lib/scp1000.
+ *
+ *  The readings are generated from sitl_world. The simulated MPU6000 is
+ *  perfectly calibrated: it assumes imu_rotated = 0 and neutral values of
+ *  32768, which is what sitl_main.c configures on a blank dataflash.
+ *  sitl_world.sensor_noise adds white noise to the readings.
+ *
+ *  @file     sim_sensors.c
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include <math.h>
+
+#include "mpu6000/mpu6000.h"
+#include "bmp085/bmp085.h"
+#include "adc/adc.h"
+#include "scp1000/scp1000.h"
+
+#include "sitl.h"
+
+#define ACC_LSB_PER_G          4096.0f
+#define GYRO_LSB_PER_RAD_S     (32.8f * 180.0f / 3.14159f)
+
+// Noise (standard deviation) for sitl_world.sensor_noise = 1
+#define ACC_NOISE_G            0.01f
+#define GYRO_NOISE_RAD_S       0.005f
+#define PRESSURE_NOISE_PA      3.0f
+
+struct mpu6000_raw_sensors mpu6000_raw_sensor_readings;
+
+
+static int to_int16(float x)
+{
+	if (x > 32767.0f)
+		return 32767;
+	else if (x < -32768.0f)
+		return -32768;
+	return (int)x;
+}
+
+
+void mpu6000_init()
+{
+}
+
+
+/*!
+ *   Inverse of read_mpu6000_sensor_data() in task_sensors_mpu6000.c
+ */
+void mpu6000_update_sensor_readings()
+{
+	float acc_noise = sitl_world.sensor_noise * ACC_NOISE_G;
+	float gyro_noise = sitl_world.sensor_noise * GYRO_NOISE_RAD_S;
+
+	mpu6000_raw_sensor_readings.acc_x = to_int16(-(sitl_world.acc_x_g + acc_noise * sitl_random_gauss()) * ACC_LSB_PER_G);
+	mpu6000_raw_sensor_readings.acc_y = to_int16((sitl_world.acc_y_g + acc_noise * sitl_random_gauss()) * ACC_LSB_PER_G);
+	mpu6000_raw_sensor_readings.acc_z = to_int16(-(sitl_world.acc_z_g + acc_noise * sitl_random_gauss()) * ACC_LSB_PER_G);
+
+	mpu6000_raw_sensor_readings.gyro_x = to_int16(-(sitl_world.p + gyro_noise * sitl_random_gauss()) * GYRO_LSB_PER_RAD_S);
+	mpu6000_raw_sensor_readings.gyro_y = to_int16((sitl_world.q + gyro_noise * sitl_random_gauss()) * GYRO_LSB_PER_RAD_S);
+	mpu6000_raw_sensor_readings.gyro_z = to_int16(-(sitl_world.r + gyro_noise * sitl_random_gauss()) * GYRO_LSB_PER_RAD_S);
+
+	mpu6000_raw_sensor_readings.temp = to_int16((sitl_world.temperature_c - 36.53f) * 340.0f);
+}
+
+
+int mpu6000_is_moving()
+{
+	return sitl_world.speed_ms > 1.0f;
+}
+
+
+/*
+ *   The simulated BMP085 returns compensated values: 0.1 degree C and Pa.
+ */
+void bmp085_init()
+{
+}
+
+
+void bmp085_start_convert_temp()
+{
+}
+
+
+void bmp085_start_convert_pressure()
+{
+}
+
+
+long bmp085_read_temp(void)
+{
+	return (long)(sitl_world.temperature_c * 10.0f);
+}
+
+
+long bmp085_read_pressure(void)
+{
+	return (long)(sitl_world.pressure_pa + sitl_world.sensor_noise * PRESSURE_NOISE_PA * sitl_random_gauss());
+}
+
+
+void bmp085_convert_temp(long raw, int *temp)
+{
+	*temp = (int)raw;
+}
+
+
+void bmp085_convert_pressure(long up, long* pressure)
+{
+	*pressure = up;
+}
+
+
+float scp1000_pressure_to_height(float pressure, float temperature)
+{
+	return log(pressure / 101000.0) * (273.0 + 20.0) * (-287.05 / 9.81);
+}
+
+
+void adc_open()
+{
+}
+
+
+void adc_start()
+{
+}
+
+
+void adc_stop()
+{
+}
+
+
+/*!
+ *   Battery voltages (channels 8 and 9) read as a full 3S pack, the other
+ *   channels as 0V.
+ */
+unsigned int adc_get_channel(int i)
+{
+	if (i == 8 || i == 9)
+		return (unsigned int)(12.6f / (3.3f * 5.1f / 6552.0f));
+	return 0;
+}
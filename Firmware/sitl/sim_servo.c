@@ -0,0 +1,70 @@
+/*!
+ *  Stand-in for lib/servo: remembers the pulse sent to each output.
+ *
+ *  @file     sim_servo.c
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include "servo/servo.h"
+#include "sitl.h"
+
+unsigned int sitl_servo_us[8];
+
+
+void servo_init()
+{
+	servo_all_neutral();
+}
+
+
+void servo_turbopwm()
+{
+}
+
+
+void servo_all_neutral()
+{
+	int i;
+	for (i = 0; i < 8; i++)
+		servo_set_us(i, 1500);
+}
+
+
+unsigned int servo_raw_to_us(unsigned int raw)
+{
+	return raw * 8 / 5;
+}
+
+
+void servo_set_us(int servo, unsigned int us)
+{
+	if (servo >= 0 && servo < 8)
+		sitl_servo_us[servo] = us;
+}
+
+
+void servo_set_ms(int servo, float ms)
+{
+	servo_set_us(servo, (unsigned int)(ms*1000.0));
+}
+
+
+unsigned int servo_read_us(int channel)
+{
+	if (channel >= 0 && channel < 8)
+		return sitl_servo_us[channel];
+	return 0;
+}
+
+
+void servo_set_logical_1(int servo)
+{
+	servo_set_us(servo, servo_raw_to_us(2500));  // same raw value as the real driver
+}
+
+
+void servo_set_logical_0(int servo)
+{
+	servo_set_us(servo, 0);
+}
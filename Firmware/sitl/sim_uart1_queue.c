@@ -0,0 +1,206 @@
+/*!
+ *  Stand-in for lib/uart1_queue: the telemetry/console uart.
+ *
+ *  Everything sent to uart1 (and printf) ends up on stdout right away: the
+ *  transmit buffer of lib/uart1_queue is not simulated, it is never full. Received
+ *  characters are read from an input file and are written in the receive ring
+ *  buffer at the configured baudrate, just like the DMA of the dsPIC does: a
+ *  slow reader loses characters (counted in uart1_rx_overruns). Lines in
+ *  the input file that don't start with '$' get their NMEA-style checksum
+ *  appended, so a command file can simply contain lines like "WN;1;...".
+ *
+ *  @file     sim_uart1_queue.c
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS/FreeRTOS.h"
+#include "FreeRTOS/queue.h"
+#include "FreeRTOS/task.h"
+#include "FreeRTOS/semphr.h"
+
+#include "uart1_queue/uart1_queue.h"
+#include "sitl.h"
+
+#define RX_MASK (UART1_RX_BUFFER_SIZE - 1)
+#define RX_POLL_TICKS (( portTickType ) 10 / portTICK_RATE_MS)
+
+volatile unsigned int uart1_tx_overflows = 0;
+volatile unsigned int uart1_rx_overruns = 0;
+
+// The receive ring buffer, as in lib/uart1_queue/uart1_queue.c
+static char rx_buffer[UART1_RX_BUFFER_SIZE];
+static unsigned int rx_read = 0;
+static unsigned int rx_write = 0;   //!< Next position of the "DMA"
+static xSemaphoreHandle rx_block_done;
+
+static long uart1_baud = 57600;
+static float rx_credit = 0.0f;   //!< Characters that may be received in the current tick
+
+static char *input = NULL;       //!< Contents of the input file, checksums added
+static long  input_length = 0;
+static long  input_position = 0;
+
+
+void uart1_queue_init(long baud)
+{
+	vSemaphoreCreateBinary( rx_block_done );
+	uart1_baud = baud;
+}
+
+
+/*!
+ *   Loads the file whose contents will be received on uart1.
+ */
+void sitl_uart1_open_input(const char *filename)
+{
+	static const char hex[] = "0123456789abcdef";
+	char line[256];
+	FILE *f = fopen(filename, "r");
+
+	if (f == NULL)
+	{
+		perror(filename);
+		exit(1);
+	}
+
+	while (fgets(line, sizeof(line) - 8, f) != NULL)
+	{
+		int len = strcspn(line, "\r\n");
+		line[len] = '\0';
+		if (len == 0)
+			continue;
+
+		input = realloc(input, input_length + len + 8);
+		if (line[0] == '$')
+			input_length += sprintf(&input[input_length], "%s\r\n", line);
+		else
+		{
+			int i;
+			unsigned char checksum = 0;
+			for (i = 0; i < len; i++)
+				checksum ^= line[i];
+			input_length += sprintf(&input[input_length], "$%s*%c%c\r\n", line, hex[checksum / 16], hex[checksum % 16]);
+		}
+	}
+	fclose(f);
+}
+
+
+/*!
+ *   Called every tick: "receives" the characters that arrived during the last
+ *   millisecond, as _DMA1Interrupt() at the end of every block.
+ */
+void sitl_uart1_tick()
+{
+	portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	if (input_position >= input_length)
+		return;
+
+	rx_credit += (float)uart1_baud / 10.0f / 1000.0f;   // 8N1: 10 bits per character
+	while (rx_credit >= 1.0f && input_position < input_length)
+	{
+		rx_buffer[rx_write] = input[input_position++];
+		rx_write = (rx_write + 1) & RX_MASK;
+		rx_credit -= 1.0f;
+		if (rx_write % (UART1_RX_BUFFER_SIZE / 2) == 0)
+		{
+			if (rx_buffer[rx_write] != '\0')
+				uart1_rx_overruns++;
+			xSemaphoreGiveFromISR( rx_block_done, &xHigherPriorityTaskWoken );
+		}
+	}
+}
+
+
+static int rx_available()
+{
+	int i;
+
+	for (i = 0; i < 8; i++)
+		if (rx_buffer[(rx_read + i) & RX_MASK] != '\0')
+			return 1;
+	return 0;
+}
+
+
+/*!
+ *   The same as uart1_getline() in lib/uart1_queue/uart1_queue.c.
+ */
+int uart1_getline(char *line, int size)
+{
+	int length = 0;
+
+	for (;;)
+	{
+		char c;
+
+		if (! rx_available())
+		{
+			xSemaphoreTake( rx_block_done, RX_POLL_TICKS );
+			continue;
+		}
+		c = rx_buffer[rx_read];
+		rx_buffer[rx_read] = '\0';
+		rx_read = (rx_read + 1) & RX_MASK;
+
+		if (c == '\n' || c == '\r')
+		{
+			if (length > 0 && length < size)
+			{
+				line[length] = '\0';
+				return length;
+			}
+			if (length >= size)
+				return -1;
+		}
+		else if (c != '\0' && length++ < size - 1)
+			line[length - 1] = c;
+	}
+}
+
+
+void uart1_puts(char *str)
+{
+	fputs(str, stdout);
+}
+
+
+void uart1_put(char *str, int len)
+{
+	fwrite(str, 1, len, stdout);
+}
+
+
+void uart1_putc(char c)
+{
+	putchar(c);
+}
+
+
+void uart1_put_wait(char *str, int len)
+{
+	fwrite(str, 1, len, stdout);
+}
+
+
+unsigned int uart1_tx_free()
+{
+	return UART1_TX_BUFFER_SIZE - 1;
+}
+
+
+long uart1_baudrate()
+{
+	return uart1_baud;
+}
+
+
+void uart1_tx_wait(unsigned int space)
+{
+}
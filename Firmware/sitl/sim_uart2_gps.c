@@ -0,0 +1,142 @@
+/*!
+ *  Stand-in for lib/uart2 with an MTK-style GPS module connected to it.
+ *
+ *  Every 200ms (5Hz) a RMC and GGA sentence describing sitl_world is queued
+ *  and then "received" character by character at the current baudrate. Each
+ *  character is handed to gps_rx_char(), which is what the uart2 receive
+ *  interrupt does on the real hardware.
+ *
+ *  @file     sim_uart2_gps.c
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include <stdio.h>
+#include <math.h>
+
+#include "uart2/uart2.h"
+#include "gps/gps.h"
+
+#include "common.h"
+#include "sitl.h"
+
+#define GPS_PERIOD_MS 200
+#define KTS2MS 0.5144f
+
+static long uart2_baud = 38400;
+static float rx_credit = 0.0f;
+
+static char sentences[256];      //!< Sentences still to be received
+static int  sentences_length = 0;
+static int  sentences_position = 0;
+
+
+void uart2_open(long baud)
+{
+	uart2_baud = baud;
+}
+
+
+char uart2_dataready()
+{
+	return 0;
+}
+
+
+char uart2_getc()
+{
+	return 0;
+}
+
+
+void uart2_puts(char *str)
+{
+	// Configuration sentences sent to the GPS module are ignored
+}
+
+
+void uart2_putc(char c)
+{
+}
+
+
+/*!
+ *   Formats a NMEA sentence and appends it to the sentence buffer.
+ *   @param body Sentence without the '$' and checksum
+ */
+static void queue_sentence(const char *body)
+{
+	unsigned char checksum = 0;
+	const char *c;
+
+	for (c = body; *c != '\0'; c++)
+		checksum ^= *c;
+
+	sentences_length += snprintf(&sentences[sentences_length], sizeof(sentences) - sentences_length,
+	                             "$%s*%02X\r\n", body, checksum);
+}
+
+
+/*!
+ *   Formats an angle in radians as NMEA ddmm.mmmmm or dddmm.mmmmm
+ */
+static void format_position(char *str, int size, double rad, int degree_digits)
+{
+	double deg = fabs(RAD2DEG(rad));
+	int whole = (int)deg;
+
+	if (snprintf(str, size, "%0*d%08.5f", degree_digits, whole, (deg - whole) * 60.0) >= size)
+		str[0] = '\0';   // no position rather than a wrong one
+}
+
+
+static void queue_position_report()
+{
+	char body[120], lat[16], lon[16], time[16];
+	unsigned long seconds = sitl_time_ms / 1000 + 12*3600l;   // simulation starts at noon
+	float heading_deg = RAD2DEG(sitl_world.heading_rad);
+
+	if (heading_deg < 0.0f)
+		heading_deg += 360.0f;
+
+	snprintf(time, sizeof(time), "%02lu%02lu%02lu.%03lu", (seconds / 3600) % 24, (seconds / 60) % 60, seconds % 60, sitl_time_ms % 1000);
+	format_position(lat, sizeof(lat), sitl_world.latitude_rad, 2);
+	format_position(lon, sizeof(lon), sitl_world.longitude_rad, 3);
+
+	sentences_length = 0;
+	sentences_position = 0;
+
+	snprintf(body, sizeof(body), "GPRMC,%s,%c,%s,%c,%s,%c,%.3f,%.2f,010612,,,A",
+	         time, sitl_world.gps_fix ? 'A' : 'V',
+	         lat, sitl_world.latitude_rad < 0.0 ? 'S' : 'N',
+	         lon, sitl_world.longitude_rad < 0.0 ? 'W' : 'E',
+	         sitl_world.speed_ms / KTS2MS, heading_deg);
+	queue_sentence(body);
+
+	snprintf(body, sizeof(body), "GPGGA,%s,%s,%c,%s,%c,%d,%d,1.00,%.1f,M,47.3,M,,",
+	         time,
+	         lat, sitl_world.latitude_rad < 0.0 ? 'S' : 'N',
+	         lon, sitl_world.longitude_rad < 0.0 ? 'W' : 'E',
+	         sitl_world.gps_fix ? 1 : 0, sitl_world.satellites_in_view, sitl_world.height_m);
+	queue_sentence(body);
+}
+
+
+/*!
+ *   Called every tick: generates the GPS output and receives the characters
+ *   that arrived during the last millisecond.
+ */
+void sitl_gps_tick()
+{
+	if (sitl_time_ms % GPS_PERIOD_MS == 0)
+		queue_position_report();
+
+	rx_credit += (float)uart2_baud / 10.0f / 1000.0f;   // 8N1: 10 bits per character
+	while (rx_credit >= 1.0f && sentences_position < sentences_length)
+	{
+		gps_rx_char(sentences[sentences_position++]);
+		rx_credit -= 1.0f;
+	}
+	if (sentences_position >= sentences_length)
+		rx_credit = 0.0f;
+}
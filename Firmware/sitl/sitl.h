@@ -0,0 +1,146 @@
+/*!
+ *  Software-in-the-loop (SITL) build of the gluonpilot firmware.
+ *
+ *  The unmodified rtos_pilot tasks run on a POSIX host on top of the FreeRTOS
+ *  POSIX port (lib/FreeRTOS/posix). The hardware drivers are replaced by the
+ *  sim_*.c stand-ins, which read the "true" state of the aircraft from
+ *  sitl_world and emulate the sensors, the GPS (NMEA over uart2), the
+ *  dataflash chip, the servo outputs and the RC receiver. sitl_world itself is
+ *  moved by the flight model in sitl_aircraft.c, which flies on the servo
+ *  outputs: the control loop is closed.
+ *
+ *  The 1kHz FreeRTOS tick is generated by the idle task: simulated time only
+ *  moves forward when all tasks are blocked, which makes a run deterministic
+ *  and (a lot) faster than real-time.
+ *
+ *  @file     sitl.h
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#ifndef SITL_H
+#define SITL_H
+
+#include <stdio.h>
+
+/*!
+ *   The simulated aircraft and its environment. Everything the stand-in
+ *   drivers need to generate their sensor readings.
+ */
+struct SitlWorld
+{
+	double latitude_rad;   //!< Position, radians
+	double longitude_rad;
+	float height_m;        //!< Height above sea level
+	float speed_ms;        //!< Speed over ground
+	float heading_rad;     //!< Course over ground. Zero is north.
+
+	float p, q, r;         //!< Body rates, rad/s
+	float acc_x_g;         //!< Specific force along the body axes, g (level and at rest: acc_z_g = -1)
+	float acc_y_g;
+	float acc_z_g;
+
+	float pressure_pa;     //!< Static pressure
+	float temperature_c;
+
+	unsigned int gps_fix : 1;  //!< 0 = GPS outputs void (no lock) sentences
+	int satellites_in_view;
+
+	// Disturbances, all off by default
+	float wind_north_ms;           //!< Mean wind, direction the air moves to
+	float wind_east_ms;
+	float gust_ms;                 //!< Standard deviation of the turbulence
+	float sensor_noise;            //!< 0 = perfect sensors, 1 = typical MPU6000 and BMP085 noise
+	float gps_dropout_interval_s;  //!< Mean time between GPS outages, 0 = never
+	float gps_dropout_duration_s;
+};
+
+extern struct SitlWorld sitl_world;
+
+
+/*!
+ *   State of the 6-DOF flight model (sitl_aircraft.c)
+ */
+struct SitlAircraft
+{
+	float north_m, east_m, down_m;   //!< Position relative to the start position, on the ground
+	float u, v, w;                   //!< Speed along the body axes, m/s
+	float p, q, r;                   //!< Body rates, rad/s
+	float attitude[4];               //!< Quaternion, body to north-east-down
+	float roll, pitch, yaw;          //!< Same attitude, radians
+
+	float airspeed_ms;
+	float alpha;                     //!< Angle of attack, radians
+
+	float aileron, elevator, rudder; //!< Control positions found in the servo outputs [-1..1]
+	float throttle;                  //!< [0..1]
+
+	unsigned int on_ground : 1;
+	int touchdowns;
+	float touchdown_speed_ms;        //!< Vertical speed at the last touchdown
+	float max_height_m;              //!< Above the ground
+	float distance_m;                //!< Flown over the ground
+};
+
+extern struct SitlAircraft sitl_aircraft;
+
+//! Simulated time since the start of the scheduler, in milliseconds (= ticks).
+extern unsigned long sitl_time_ms;
+
+//! Last pulse sent to each of the 8 servo outputs, in microseconds.
+extern unsigned int sitl_servo_us[8];
+
+
+// sitl_world.c
+void sitl_world_init(double latitude_deg, double longitude_deg, float height_m);
+void sitl_world_update(float dt);
+void sitl_random_seed(unsigned long seed);
+float sitl_random_uniform();
+float sitl_random_gauss();
+
+// sitl_aircraft.c
+void sitl_aircraft_init();
+void sitl_aircraft_launch(float height_agl_m, float speed_ms, float heading_rad);
+void sitl_aircraft_update(float dt);
+
+// sitl_metrics.c
+void sitl_metrics_update(float dt);
+void sitl_metrics_write(FILE *f);
+
+// sim_uart1_queue.c
+void sitl_uart1_open_input(const char *filename);
+void sitl_uart1_tick();
+
+// sim_uart2_gps.c
+void sitl_gps_tick();
+
+// sim_dataflash.c
+
+/*!
+ *   What the emulated dataflash went through, see sim_dataflash.c
+ */
+struct SitlDataflashStats
+{
+	unsigned long pages_programmed;
+	unsigned long max_page_programs;   //!< Of the page programmed most, the wear
+	unsigned long blocks_erased;
+	unsigned long sectors_erased;
+	unsigned long bytes_read;
+	unsigned long busy_ticks;          //!< Programming or erasing
+	unsigned long stall_ticks;         //!< Reads and writes waiting for the chip
+	unsigned long busy_violations;     //!< Programs and erases started while busy
+};
+
+extern struct SitlDataflashStats sitl_dataflash_stats;
+
+void sitl_dataflash_geometry(int page_size);
+int  sitl_dataflash_map(const char *filename);
+void sitl_dataflash_close();
+int  sitl_dataflash_load(const char *filename);
+void sitl_dataflash_save(const char *filename);
+
+// sim_ppm_in.c
+void sitl_ppm_set_channel(int channel, unsigned int us);
+void sitl_ppm_set_connection(int alive);
+
+#endif // SITL_H
@@ -0,0 +1,380 @@
+/*!
+ *  6-DOF flight model of a small fixed-wing aircraft for the SITL build.
+ *
+ *  The model reads the servo pulses sent by control_mix_out(), undoes the
+ *  configured servo mixing to find the aileron, elevator, rudder and throttle
+ *  positions, and integrates the rigid body equations of motion with linear
+ *  aerodynamic coefficients. The resulting state is written to sitl_world,
+ *  from which the stand-in drivers generate the gyro, accelerometer,
+ *  barometer and NMEA data.
+ *
+ *  The default coefficients describe a 1.4m span, 1kg electric trainer
+ *  (EasyStar class) that cruises at about 14m/s.
+ *
+ *  Axes: north-east-down for the position, x forward, y right, z down for
+ *  the body. The ground is flat, at the height of the start position.
+ *
+ *  @file     sitl_aircraft.c
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include <math.h>
+
+#include "quaternion/quaternion.h"
+
+#include "configuration.h"
+#include "task_control.h"
+#include "control_mix.h"
+#include "common.h"
+#include "sitl.h"
+
+#define EARTH_RADIUS_M   6371000.0
+#define RHO              1.225f    //!< Air density, kg/m3
+
+#define MAX_DEFLECTION   DEG2RAD(25.0)   //!< Control surface deflection for a 500us servo throw
+#define MIN_AIRSPEED     1.0f            //!< Avoids divisions by zero in the non-dimensional rates
+#define GUST_TIME_S      2.0f            //!< Correlation time of the turbulence
+
+//! Airframe and aerodynamic coefficients, per radian
+static const struct
+{
+	float mass, wing_area, span, chord;
+	float ixx, iyy, izz;
+	float max_thrust, prop_max_speed;
+
+	float cl0, cl_alpha, cl_q, cl_elevator, cl_max;
+	float cd0, cd_induced;
+	float cy_beta, cy_rudder;
+	float roll_beta, roll_p, roll_r, roll_aileron, roll_rudder;
+	float pitch0, pitch_alpha, pitch_q, pitch_elevator;
+	float yaw_beta, yaw_p, yaw_r, yaw_aileron, yaw_rudder;
+	float ground_friction;
+} airframe =
+{
+	1.0f, 0.30f, 1.40f, 0.22f,        // kg, m2, m, m
+	0.05f, 0.06f, 0.10f,              // kg.m2
+	9.0f, 25.0f,                      // N, m/s
+
+	0.28f, 4.8f, 6.0f, -0.2f, 1.2f,
+	0.04f, 0.06f,
+	-0.3f, 0.15f,
+	-0.08f, -0.45f, 0.1f, 0.25f, 0.01f,
+	0.02f, -0.8f, -12.0f, 0.9f,
+	0.07f, -0.03f, -0.15f, -0.01f, 0.06f,
+	0.05f
+};
+
+struct SitlAircraft sitl_aircraft;
+
+static double home_latitude_rad, home_longitude_rad;
+static float ground_height_m;
+static float gust[3];   //!< Turbulence, north-east-down
+
+
+/*!
+ *   Undoes control_mix_out(): finds the control surface positions from the
+ *   servo pulses. aileron > 0 rolls right, elevator > 0 pitches up, rudder > 0
+ *   yaws right. All in [-1..1], throttle in [0..1].
+ */
+static void read_controls()
+{
+	int d[6];
+	int i;
+	float aileron = 0.0f, elevator = 0.0f, rudder = 0.0f, motor;
+
+	for (i = 0; i < 6; i++)
+		d[i] = (int)sitl_servo_us[i] - config.control.servo_neutral[i];
+
+	switch (config.control.servo_mix)
+	{
+		case DELTA_RUDDER:
+			rudder = config.control.reverse_servo5 ? d[4] : -d[4];
+			// fall through
+		case DELTA_PLUS:
+		{
+			int d0 = config.control.reverse_servo1 ? d[0] : -d[0];  // aileron + elevator
+			int d1 = config.control.reverse_servo2 ? -d[1] : d[1];  // elevator - aileron
+			aileron = (d0 - d1) / 2;
+			elevator = (d0 + d1) / 2;
+			break;
+		}
+		case DELTA_MIN:
+		{
+			int d0 = config.control.reverse_servo1 ? -d[0] : d[0];  // elevator - aileron
+			int d1 = config.control.reverse_servo2 ? -d[1] : d[1];  // -aileron - elevator
+			aileron = -(d0 + d1) / 2;
+			elevator = (d0 - d1) / 2;
+			break;
+		}
+		case QUADROCOPTER:
+		case HEXACOPTER:
+			break;       // not a fixed-wing: the model stays on the ground
+		case V_TAIL:
+		{
+			int d2 = config.control.reverse_servo3 ? -d[2] : d[2];  // elevator - rudder
+			int d4 = config.control.reverse_servo5 ? -d[4] : d[4];  // -elevator - rudder
+			aileron = ((config.control.reverse_servo1 ? -d[0] : d[0]) + (config.control.reverse_servo2 ? d[1] : -d[1])) / 2;
+			elevator = (d2 - d4) / 2;
+			rudder = -(d2 + d4) / 2;
+			break;
+		}
+		default:         // AILERON and AILERONS_FLAPERONS: the flaperon offset cancels out
+			aileron = ((config.control.reverse_servo1 ? -d[0] : d[0]) + (config.control.reverse_servo2 ? d[1] : -d[1])) / 2;
+			elevator = config.control.reverse_servo3 ? -d[2] : d[2];
+			rudder = config.control.reverse_servo5 ? d[4] : -d[4];
+			break;
+	}
+	motor = config.control.reverse_servo4 ? -d[3] : d[3];
+
+	sitl_aircraft.aileron = BIND(aileron / 500.0f, -1.0f, 1.0f);
+	sitl_aircraft.elevator = BIND(elevator / 500.0f, -1.0f, 1.0f);
+	sitl_aircraft.rudder = BIND(rudder / 500.0f, -1.0f, 1.0f);
+	sitl_aircraft.throttle = control_mix_is_copter(config.control.servo_mix) ? 0.0f : BIND(motor / 1000.0f, 0.0f, 1.0f);
+}
+
+
+/*!
+ *   Body to north-east-down rotation matrix of the current attitude.
+ */
+static void rotation_matrix(float r[3][3])
+{
+	const float *q = sitl_aircraft.attitude;
+
+	r[0][0] = 1.0f - 2.0f*(q[2]*q[2] + q[3]*q[3]);
+	r[0][1] = 2.0f*(q[1]*q[2] - q[0]*q[3]);
+	r[0][2] = 2.0f*(q[1]*q[3] + q[0]*q[2]);
+	r[1][0] = 2.0f*(q[1]*q[2] + q[0]*q[3]);
+	r[1][1] = 1.0f - 2.0f*(q[1]*q[1] + q[3]*q[3]);
+	r[1][2] = 2.0f*(q[2]*q[3] - q[0]*q[1]);
+	r[2][0] = 2.0f*(q[1]*q[3] - q[0]*q[2]);
+	r[2][1] = 2.0f*(q[2]*q[3] + q[0]*q[1]);
+	r[2][2] = 1.0f - 2.0f*(q[1]*q[1] + q[2]*q[2]);
+}
+
+
+static void update_euler_angles()
+{
+	sitl_aircraft.roll = quaternion_to_roll(sitl_aircraft.attitude);
+	sitl_aircraft.pitch = quaternion_to_pitch(sitl_aircraft.attitude);
+	sitl_aircraft.yaw = quaternion_to_yaw(sitl_aircraft.attitude);
+}
+
+
+/*!
+ *   Updates the turbulence: a first order Gauss-Markov process per axis, with
+ *   a standard deviation of sitl_world.gust_ms. Vertical gusts are weaker.
+ */
+static void update_gusts(float dt)
+{
+	int i;
+	float sigma = sitl_world.gust_ms * sqrtf(2.0f * dt / GUST_TIME_S);
+
+	for (i = 0; i < 3; i++)
+		gust[i] += -gust[i] * dt / GUST_TIME_S + sigma * (i == 2 ? 0.5f : 1.0f) * sitl_random_gauss();
+}
+
+
+/*!
+ *   Aerodynamic and propulsion forces (N) and moments (Nm) along the body axes.
+ *   The aerodynamics depend on the speed relative to the (moving) air.
+ */
+static void forces_and_moments(float r[3][3], float force[3], float moment[3])
+{
+	float wind[3] = { sitl_world.wind_north_ms + gust[0], sitl_world.wind_east_ms + gust[1], gust[2] };
+	float u = sitl_aircraft.u - (r[0][0] * wind[0] + r[1][0] * wind[1] + r[2][0] * wind[2]);
+	float v = sitl_aircraft.v - (r[0][1] * wind[0] + r[1][1] * wind[1] + r[2][1] * wind[2]);
+	float w = sitl_aircraft.w - (r[0][2] * wind[0] + r[1][2] * wind[1] + r[2][2] * wind[2]);
+	float va = sqrtf(u*u + v*v + w*w);
+	float va_safe = MAX(va, MIN_AIRSPEED);
+	float alpha = atan2f(w, MAX(u, 0.1f));
+	float beta = asinf(BIND(v / va_safe, -1.0f, 1.0f));
+	float qbar_s = 0.5f * RHO * va * va * airframe.wing_area;
+	float p_hat = sitl_aircraft.p * airframe.span / (2.0f * va_safe);
+	float q_hat = sitl_aircraft.q * airframe.chord / (2.0f * va_safe);
+	float r_hat = sitl_aircraft.r * airframe.span / (2.0f * va_safe);
+	float da = sitl_aircraft.aileron * MAX_DEFLECTION;
+	float de = sitl_aircraft.elevator * MAX_DEFLECTION;
+	float dr = sitl_aircraft.rudder * MAX_DEFLECTION;
+	float cl, cd, cy, lift, drag, thrust;
+
+	cl = airframe.cl0 + airframe.cl_alpha * alpha + airframe.cl_q * q_hat + airframe.cl_elevator * de;
+	cl = BIND(cl, -airframe.cl_max, airframe.cl_max);   // stall
+	cd = airframe.cd0 + airframe.cd_induced * cl * cl;
+	cy = airframe.cy_beta * beta + airframe.cy_rudder * dr;
+
+	lift = qbar_s * cl;
+	drag = qbar_s * cd;
+	thrust = airframe.max_thrust * sitl_aircraft.throttle * MAX(1.0f - u / airframe.prop_max_speed, 0.0f);
+
+	force[0] = thrust - drag * cosf(alpha) + lift * sinf(alpha);
+	force[1] = qbar_s * cy;
+	force[2] = -drag * sinf(alpha) - lift * cosf(alpha);
+
+	moment[0] = qbar_s * airframe.span *
+	            (airframe.roll_beta * beta + airframe.roll_p * p_hat + airframe.roll_r * r_hat + airframe.roll_aileron * da + airframe.roll_rudder * dr);
+	moment[1] = qbar_s * airframe.chord *
+	            (airframe.pitch0 + airframe.pitch_alpha * alpha + airframe.pitch_q * q_hat + airframe.pitch_elevator * de);
+	moment[2] = qbar_s * airframe.span *
+	            (airframe.yaw_beta * beta + airframe.yaw_p * p_hat + airframe.yaw_r * r_hat + airframe.yaw_aileron * da + airframe.yaw_rudder * dr);
+
+	sitl_aircraft.airspeed_ms = va;
+	sitl_aircraft.alpha = alpha;
+}
+
+
+/*!
+ *   Keeps the aircraft on (or above) the ground. On the ground it can only
+ *   roll forward, wings level, nose between level and 15 degrees up.
+ */
+static void ground_contact(float ned_speed[3], float dt)
+{
+	float horizontal_speed;
+
+	if (sitl_aircraft.down_m < 0.0f)
+	{
+		sitl_aircraft.on_ground = 0;
+		return;
+	}
+
+	if (! sitl_aircraft.on_ground)
+	{
+		sitl_aircraft.touchdowns++;
+		sitl_aircraft.touchdown_speed_ms = ned_speed[2];
+	}
+	sitl_aircraft.on_ground = 1;
+	sitl_aircraft.down_m = 0.0f;
+
+	// No sideways sliding, rolling friction
+	horizontal_speed = ned_speed[0] * cosf(sitl_aircraft.yaw) + ned_speed[1] * sinf(sitl_aircraft.yaw);
+	horizontal_speed = MAX(horizontal_speed - airframe.ground_friction * G * dt, 0.0f);
+	ned_speed[0] = horizontal_speed * cosf(sitl_aircraft.yaw);
+	ned_speed[1] = horizontal_speed * sinf(sitl_aircraft.yaw);
+	ned_speed[2] = 0.0f;
+
+	sitl_aircraft.roll = 0.0f;
+	sitl_aircraft.pitch = BIND(sitl_aircraft.pitch, 0.0f, DEG2RAD(15.0));
+	quaternion_from_attitude(sitl_aircraft.roll, sitl_aircraft.pitch, sitl_aircraft.yaw, sitl_aircraft.attitude);  // order: roll, pitch, yaw
+	sitl_aircraft.p = 0.0f;
+	sitl_aircraft.r = 0.0f;
+	if (sitl_aircraft.pitch == 0.0f && sitl_aircraft.q < 0.0f)
+		sitl_aircraft.q = 0.0f;
+}
+
+
+/*!
+ *   Places the aircraft on the ground at the current sitl_world position,
+ *   engine off, pointing north.
+ */
+void sitl_aircraft_init()
+{
+	home_latitude_rad = sitl_world.latitude_rad;
+	home_longitude_rad = sitl_world.longitude_rad;
+	ground_height_m = sitl_world.height_m;
+
+	sitl_aircraft.north_m = 0.0f;
+	sitl_aircraft.east_m = 0.0f;
+	sitl_aircraft.down_m = 0.0f;
+	sitl_aircraft.u = sitl_aircraft.v = sitl_aircraft.w = 0.0f;
+	sitl_aircraft.p = sitl_aircraft.q = sitl_aircraft.r = 0.0f;
+	sitl_aircraft.roll = sitl_aircraft.pitch = sitl_aircraft.yaw = 0.0f;
+	quaternion_from_attitude(0.0f, 0.0f, 0.0f, sitl_aircraft.attitude);
+	sitl_aircraft.on_ground = 1;
+	sitl_aircraft.touchdowns = 0;
+	sitl_aircraft.touchdown_speed_ms = 0.0f;
+	sitl_aircraft.max_height_m = 0.0f;
+	sitl_aircraft.distance_m = 0.0f;
+
+	gust[0] = gust[1] = gust[2] = 0.0f;
+}
+
+
+/*!
+ *   Hand launch: puts the aircraft in level flight at the given height above
+ *   the ground, speed and heading.
+ */
+void sitl_aircraft_launch(float height_agl_m, float speed_ms, float heading_rad)
+{
+	sitl_aircraft.down_m = -height_agl_m;
+	sitl_aircraft.u = speed_ms;
+	sitl_aircraft.v = sitl_aircraft.w = 0.0f;
+	sitl_aircraft.yaw = heading_rad;
+	quaternion_from_attitude(0.0f, 0.0f, heading_rad, sitl_aircraft.attitude);
+	update_euler_angles();
+	sitl_aircraft.on_ground = height_agl_m <= 0.0f;
+}
+
+
+/*!
+ *   Advances the flight model by dt seconds and updates sitl_world.
+ */
+void sitl_aircraft_update(float dt)
+{
+	float r[3][3], force[3], moment[3], ned_speed[3], gravity[3];
+	float old_u = sitl_aircraft.u, old_v = sitl_aircraft.v, old_w = sitl_aircraft.w;
+	float p = sitl_aircraft.p, q = sitl_aircraft.q, rr = sitl_aircraft.r;
+	int i;
+
+	read_controls();
+	update_gusts(dt);
+	rotation_matrix(r);
+	forces_and_moments(r, force, moment);
+
+	// Gravity along the body axes
+	for (i = 0; i < 3; i++)
+		gravity[i] = r[2][i] * G;
+
+	// Translation, in the rotating body frame
+	sitl_aircraft.u += (force[0] / airframe.mass + gravity[0] - (q*old_w - rr*old_v)) * dt;
+	sitl_aircraft.v += (force[1] / airframe.mass + gravity[1] - (rr*old_u - p*old_w)) * dt;
+	sitl_aircraft.w += (force[2] / airframe.mass + gravity[2] - (p*old_v - q*old_u)) * dt;
+
+	// Rotation (principal axes)
+	sitl_aircraft.p += (moment[0] - (airframe.izz - airframe.iyy) * q * rr) / airframe.ixx * dt;
+	sitl_aircraft.q += (moment[1] - (airframe.ixx - airframe.izz) * p * rr) / airframe.iyy * dt;
+	sitl_aircraft.r += (moment[2] - (airframe.iyy - airframe.ixx) * p * q) / airframe.izz * dt;
+
+	quaternion_update_with_rates(sitl_aircraft.p, sitl_aircraft.q, sitl_aircraft.r, sitl_aircraft.attitude, dt);
+	update_euler_angles();
+	rotation_matrix(r);
+
+	for (i = 0; i < 3; i++)
+		ned_speed[i] = r[i][0] * sitl_aircraft.u + r[i][1] * sitl_aircraft.v + r[i][2] * sitl_aircraft.w;
+
+	sitl_aircraft.north_m += ned_speed[0] * dt;
+	sitl_aircraft.east_m += ned_speed[1] * dt;
+	sitl_aircraft.down_m += ned_speed[2] * dt;
+	sitl_aircraft.distance_m += sqrtf(ned_speed[0]*ned_speed[0] + ned_speed[1]*ned_speed[1]) * dt;
+
+	ground_contact(ned_speed, dt);
+	if (sitl_aircraft.on_ground)
+	{
+		rotation_matrix(r);
+		sitl_aircraft.u = r[0][0] * ned_speed[0] + r[1][0] * ned_speed[1] + r[2][0] * ned_speed[2];
+		sitl_aircraft.v = r[0][1] * ned_speed[0] + r[1][1] * ned_speed[1] + r[2][1] * ned_speed[2];
+		sitl_aircraft.w = r[0][2] * ned_speed[0] + r[1][2] * ned_speed[1] + r[2][2] * ned_speed[2];
+		for (i = 0; i < 3; i++)
+			gravity[i] = r[2][i] * G;
+	}
+	sitl_aircraft.max_height_m = MAX(sitl_aircraft.max_height_m, -sitl_aircraft.down_m);
+
+	// What the sensors see: accelerometers measure the specific force = acceleration - gravity
+	if (dt > 0.0f)
+	{
+		sitl_world.acc_x_g = ((sitl_aircraft.u - old_u) / dt + (q*old_w - rr*old_v) - gravity[0]) / G;
+		sitl_world.acc_y_g = ((sitl_aircraft.v - old_v) / dt + (rr*old_u - p*old_w) - gravity[1]) / G;
+		sitl_world.acc_z_g = ((sitl_aircraft.w - old_w) / dt + (p*old_v - q*old_u) - gravity[2]) / G;
+	}
+	sitl_world.p = sitl_aircraft.p;
+	sitl_world.q = sitl_aircraft.q;
+	sitl_world.r = sitl_aircraft.r;
+
+	sitl_world.latitude_rad = home_latitude_rad + sitl_aircraft.north_m / EARTH_RADIUS_M;
+	sitl_world.longitude_rad = home_longitude_rad + sitl_aircraft.east_m / (EARTH_RADIUS_M * cos(home_latitude_rad));
+	sitl_world.height_m = ground_height_m - sitl_aircraft.down_m;
+	sitl_world.speed_ms = sqrtf(ned_speed[0]*ned_speed[0] + ned_speed[1]*ned_speed[1]);
+	if (sitl_world.speed_ms > 0.5f)
+		sitl_world.heading_rad = atan2f(ned_speed[1], ned_speed[0]);
+	else
+		sitl_world.heading_rad = sitl_aircraft.yaw;
+}
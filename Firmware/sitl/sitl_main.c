@@ -0,0 +1,366 @@
+/*!
+ *  The main file of the software-in-the-loop (SITL) build: rtos_pilot.c for
+ *  a POSIX host.
+ *
+ *  Usage: sitl [-t seconds] [-r realtime-factor] [-f flash.bin] [-d page-size] [-c]
+ *              [-i uart1-input.txt] [-p latitude,longitude,height] [-l height,speed,heading]
+ *              [-o trace.csv] [-w speed,direction,gust] [-e noise] [-g interval,duration]
+ *              [-s seed] [-m metrics.csv]
+ *
+ *   -t  Simulated time after which the simulation ends (default: 60s)
+ *   -r  Pace the simulation: 1 = real-time, 2 = twice as fast.
+ *       Default 0: as fast as possible.
+ *   -f  Dataflash image, mapped in memory (created when it doesn't exist), so
+ *       the configuration, flight plan and logs survive between runs.
+ *   -d  Page size of a new dataflash image: 528 (AT45DB161D, default) or 264
+ *       (AT45DB081). An existing image keeps its own.
+ *   -c  Exit with status 2 when a page program or erase was started while
+ *       the dataflash was busy (see sim_dataflash.c), or when received
+ *       characters were lost on uart1 (a command read too late).
+ *   -i  File with commands that are received on uart1, one per line
+ *       (e.g. "WN;1;...").
+ *   -p  Start position in degrees and meter (default: 50.83,4.35,60)
+ *   -l  Hand launch: start flying at the given height above the ground (m),
+ *       speed (m/s) and heading (degrees). Default: on the ground.
+ *   -o  Write the state of the flight model to a CSV file, at 10Hz.
+ *   -w  Wind speed (m/s), the direction it comes from (degrees) and the
+ *       standard deviation of the turbulence (m/s).
+ *   -e  Sensor noise: 0 = none (default), 1 = typical.
+ *   -g  GPS outages: mean time between two outages and their mean duration (s).
+ *   -s  Seed for the random turbulence, noise and outages.
+ *   -m  Write the flight quality metrics (see sitl_metrics.c) to a CSV file.
+ *
+ *  Everything sent to uart1 (telemetry and printf) is written to stdout. A
+ *  summary of the flight and of the dataflash use is written to stderr at
+ *  the end of the run.
+ *
+ *  @file     sitl_main.c
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+
+// FreeRTOS includes
+#include "FreeRTOS/FreeRTOS.h"
+#include "FreeRTOS/task.h"
+#include "FreeRTOS/queue.h"
+#include "FreeRTOS/croutine.h"
+#include "FreeRTOS/semphr.h"
+
+// Gluonpilot library includes
+#include "microcontroller/microcontroller.h"
+#include "uart1_queue/uart1_queue.h"
+#include "dataflash/dataflash.h"
+#include "ppm_in/ppm_in.h"
+#include "led/led.h"
+#include "servo/servo.h"
+
+// rtos_pilot includes
+#include "task_control.h"
+#include "task_sensors_mpu6000.h"
+#include "communication.h"
+#include "configuration.h"
+#include "task_datalogger.h"
+#include "handler_navigation.h"
+#include "gluonscript.h"
+#include "task_gps.h"
+
+#include "common.h"
+#include "sitl.h"
+
+extern xSemaphoreHandle xGpsSemaphore;
+extern xSemaphoreHandle xSpiSemaphore;
+
+static char version[] = "0.9 Beta 2";
+
+unsigned long idle_counter = 0;
+unsigned long sitl_time_ms = 0;
+
+static unsigned long duration_ms = 60000;
+static float realtime_factor = 0.0f;
+static const char *flash_filename = NULL;
+static FILE *trace = NULL;
+static FILE *metrics = NULL;
+
+
+/*!
+ *   Prepares a blank dataflash: the default configuration, adapted to the
+ *   (perfectly calibrated) simulated sensors.
+ */
+static void sitl_configuration_default()
+{
+	configuration_default();
+
+	config.sensors.acc_x_neutral = 32768;
+	config.sensors.acc_y_neutral = 32768;
+	config.sensors.acc_z_neutral = 32768;
+	config.sensors.gyro_x_neutral = 32768.0f;
+	config.sensors.gyro_y_neutral = 32768.0f;
+	config.sensors.gyro_z_neutral = 32768.0f;
+	config.sensors.imu_rotated = ROTATION_0;
+
+	config.control.use_pwm = 0;
+
+	// Throttle stick in the lowest position when the RC transmitter was calibrated
+	config.control.channel_neutral[config.control.channel_motor] = 1000;
+	config.control.autopilot_auto_throttle = 1;
+	config.control.auto_throttle_cruise_pct = 50;
+
+	configuration_write();
+}
+
+
+/*!
+ *   Sleeps until the host clock catches up with the simulated time.
+ */
+static void sitl_pace()
+{
+	static struct timespec start;
+	struct timespec now, delay;
+	double ahead_s;
+
+	if (sitl_time_ms == 1)
+		clock_gettime(CLOCK_MONOTONIC, &start);
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	ahead_s = (double)sitl_time_ms / 1000.0 / realtime_factor
+	          - ((double)(now.tv_sec - start.tv_sec) + (double)(now.tv_nsec - start.tv_nsec) / 1e9);
+	if (ahead_s > 0.0)
+	{
+		delay.tv_sec = (time_t)ahead_s;
+		delay.tv_nsec = (long)((ahead_s - (double)delay.tv_sec) * 1e9);
+		nanosleep(&delay, NULL);
+	}
+}
+
+
+/*!
+ *   Writes a line with the state of the flight model to the trace file.
+ */
+static void sitl_trace()
+{
+	if (sitl_time_ms == 0)
+		fprintf(trace, "time_s;latitude_deg;longitude_deg;height_m;north_m;east_m;agl_m;airspeed_ms;speed_ms;"
+		               "roll_deg;pitch_deg;heading_deg;throttle;aileron;elevator;rudder;flight_mode;codeline\n");
+	fprintf(trace, "%.2f;%.7f;%.7f;%.2f;%.2f;%.2f;%.2f;%.2f;%.2f;%.1f;%.1f;%.1f;%.2f;%.2f;%.2f;%.2f;%d;%d\n",
+	        (double)sitl_time_ms / 1000.0, RAD2DEG(sitl_world.latitude_rad), RAD2DEG(sitl_world.longitude_rad),
+	        sitl_world.height_m, sitl_aircraft.north_m, sitl_aircraft.east_m, -sitl_aircraft.down_m,
+	        sitl_aircraft.airspeed_ms, sitl_world.speed_ms,
+	        RAD2DEG(sitl_aircraft.roll), RAD2DEG(sitl_aircraft.pitch), RAD2DEG(sitl_aircraft.yaw),
+	        sitl_aircraft.throttle, sitl_aircraft.aileron, sitl_aircraft.elevator, sitl_aircraft.rudder,
+	        (int)control_state.flight_mode, gluonscript_data.current_codeline);
+}
+
+
+static void usage(const char *name)
+{
+	fprintf(stderr, "Usage: %s [-t seconds] [-r realtime-factor] [-f flash.bin] [-d page-size] [-c]\n"
+	                "          [-i uart1-input.txt] [-p lat,lon,height] [-l height,speed,heading] [-o trace.csv]\n"
+	                "          [-w speed,direction,gust] [-e noise] [-g interval,duration] [-s seed] [-m metrics.csv]\n", name);
+	exit(1);
+}
+
+
+int main(int argc, char *argv[])
+{
+	double latitude = 50.83, longitude = 4.35;
+	float height = 60.0f;
+	float launch_height = 0.0f, launch_speed = 0.0f, launch_heading = 0.0f;
+	float wind_speed = 0.0f, wind_direction = 0.0f, gust = 0.0f;
+	float noise = 0.0f, gps_dropout_interval = 0.0f, gps_dropout_duration = 0.0f;
+	int c, check = 0, image = 0;
+	unsigned int telemetry_sent, telemetry_deferred, telemetry_dropped;
+
+	while ((c = getopt(argc, argv, "t:r:f:d:ci:p:l:o:w:e:g:s:m:")) != -1)
+	{
+		switch (c)
+		{
+			case 't':
+				duration_ms = (unsigned long)(atof(optarg) * 1000.0);
+				break;
+			case 'r':
+				realtime_factor = atof(optarg);
+				break;
+			case 'f':
+				flash_filename = optarg;
+				break;
+			case 'd':
+				if (atoi(optarg) != 528 && atoi(optarg) != 264)
+					usage(argv[0]);
+				sitl_dataflash_geometry(atoi(optarg));
+				break;
+			case 'c':
+				check = 1;
+				break;
+			case 'i':
+				sitl_uart1_open_input(optarg);
+				break;
+			case 'p':
+				if (sscanf(optarg, "%lf,%lf,%f", &latitude, &longitude, &height) != 3)
+					usage(argv[0]);
+				break;
+			case 'l':
+				if (sscanf(optarg, "%f,%f,%f", &launch_height, &launch_speed, &launch_heading) != 3)
+					usage(argv[0]);
+				break;
+			case 'o':
+				trace = fopen(optarg, "w");
+				if (trace == NULL)
+				{
+					perror(optarg);
+					return 1;
+				}
+				break;
+			case 'w':
+				if (sscanf(optarg, "%f,%f,%f", &wind_speed, &wind_direction, &gust) != 3)
+					usage(argv[0]);
+				break;
+			case 'e':
+				noise = atof(optarg);
+				break;
+			case 'g':
+				if (sscanf(optarg, "%f,%f", &gps_dropout_interval, &gps_dropout_duration) != 2)
+					usage(argv[0]);
+				break;
+			case 's':
+				sitl_random_seed(strtoul(optarg, NULL, 10));
+				break;
+			case 'm':
+				metrics = fopen(optarg, "w");
+				if (metrics == NULL)
+				{
+					perror(optarg);
+					return 1;
+				}
+				break;
+			default:
+				usage(argv[0]);
+		}
+	}
+
+	sitl_world_init(latitude, longitude, height);
+	if (launch_height > 0.0f || launch_speed > 0.0f)
+		sitl_aircraft_launch(launch_height, launch_speed, DEG2RAD(launch_heading));
+
+	// The wind comes from wind_direction
+	sitl_world.wind_north_ms = -wind_speed * cosf(DEG2RAD(wind_direction));
+	sitl_world.wind_east_ms = -wind_speed * sinf(DEG2RAD(wind_direction));
+	sitl_world.gust_ms = gust;
+	sitl_world.sensor_noise = noise;
+	sitl_world.gps_dropout_interval_s = gps_dropout_interval;
+	sitl_world.gps_dropout_duration_s = gps_dropout_duration;
+
+	microcontroller_init();
+	uart1_queue_init(57600l);
+
+	printf("Gluonpilot v%s SITL", version);
+	printf(" [%s %s, config: %dB, record: %dB, navigation: %dB, double: %dB]\r\n\r\n",
+                __DATE__, __TIME__, (int)sizeof(struct Configuration), (int)sizeof(union LogRecord), (int)sizeof(gluonscript_data.codes), (int)sizeof(double));
+
+	led_init();
+
+	vSemaphoreCreateBinary( xSpiSemaphore );
+	vSemaphoreCreateBinary( xGpsSemaphore );
+
+	// The simulated sensor board is a v0.1q (GP2) with MPU6000
+	HARDWARE_VERSION = V01Q;
+
+	if (flash_filename != NULL && (image = sitl_dataflash_map(flash_filename)) < 0)
+		return 1;
+	dataflash_open();
+	if (image)
+		configuration_load();
+	else
+	{
+		printf("Blank dataflash: loading default configuration\r\n");
+		sitl_configuration_default();
+	}
+
+	ppm_in_open();
+
+	// Same tasks and priorities as rtos_pilot.c. No OSD: there's no video to overlay.
+	if (config.control.servo_mix == QUADROCOPTER)
+		xTaskCreate( control_copter_task,            ( signed portCHAR * ) "CControl",      ( configMINIMAL_STACK_SIZE * 3 ), NULL, tskIDLE_PRIORITY + 7, NULL );
+	else
+		xTaskCreate( control_wing_task,            ( signed portCHAR * ) "WControl",      ( configMINIMAL_STACK_SIZE * 3 ), NULL, tskIDLE_PRIORITY + 7, NULL );
+	xTaskCreate( sensors_mpu6000_task,         ( signed portCHAR * ) "Sensors",      ( configMINIMAL_STACK_SIZE * 5 ), NULL, tskIDLE_PRIORITY + 6, NULL );
+	xTaskCreate( sensors_gps_task,             ( signed portCHAR * ) "GpsNavi",      ( configMINIMAL_STACK_SIZE * 4 ), NULL, tskIDLE_PRIORITY + 5, NULL );
+	xTaskCreate( communication_input_task,     ( signed portCHAR * ) "ConsoleInput", ( configMINIMAL_STACK_SIZE * 5 ), NULL, tskIDLE_PRIORITY + 4, NULL );
+	xTaskCreate( datalogger_task,              ( signed portCHAR * ) "Dataflash",    ( configMINIMAL_STACK_SIZE * 3 ), NULL, tskIDLE_PRIORITY + 3, NULL );
+	xTaskCreate( communication_telemetry_task, ( signed portCHAR * ) "Telemetry",    ( configMINIMAL_STACK_SIZE * 2 ), NULL, tskIDLE_PRIORITY + 2, NULL );
+
+	// Returns when the simulation has ended (or a task called vTaskEndScheduler)
+	vTaskStartScheduler();
+
+	fflush(stdout);
+	sitl_dataflash_close();
+	if (trace != NULL)
+		fclose(trace);
+	if (metrics != NULL)
+	{
+		sitl_metrics_write(metrics);
+		fclose(metrics);
+	}
+
+	fprintf(stderr, "\nSimulated %.1fs: flown %.0fm, max height %.1fm above ground, %d touchdown(s)",
+	        (double)sitl_time_ms / 1000.0, sitl_aircraft.distance_m, sitl_aircraft.max_height_m, sitl_aircraft.touchdowns);
+	if (sitl_aircraft.touchdowns > 0)
+		fprintf(stderr, ", last at %.1fm/s vertical", sitl_aircraft.touchdown_speed_ms);
+	fprintf(stderr, ", %s at line %d of the flight plan\n",
+	        sitl_aircraft.on_ground ? "on the ground" : "flying", gluonscript_data.current_codeline);
+	fprintf(stderr, "Dataflash (%d bytes pages): %lu pages programmed (at most %lu times the same), %lu blocks and %lu sectors erased, "
+	        "%lukB read, busy %.1f%% of the time, waited %lums, %lu operations while busy\n",
+	        PAGE_SIZE, sitl_dataflash_stats.pages_programmed, sitl_dataflash_stats.max_page_programs,
+	        sitl_dataflash_stats.blocks_erased, sitl_dataflash_stats.sectors_erased, sitl_dataflash_stats.bytes_read / 1024,
+	        sitl_time_ms > 0 ? 100.0 * sitl_dataflash_stats.busy_ticks / sitl_time_ms : 0.0,
+	        sitl_dataflash_stats.stall_ticks, sitl_dataflash_stats.busy_violations);
+	if (uart1_rx_overruns > 0)
+		fprintf(stderr, "Uart1: %u received characters lost\n", uart1_rx_overruns);
+	telemetry_report(&telemetry_sent, &telemetry_deferred, &telemetry_dropped);
+	fprintf(stderr, "Telemetry (%ld baud): %u samples sent, %u deferred, %u dropped\n",
+	        uart1_baudrate(), telemetry_sent, telemetry_deferred, telemetry_dropped);
+
+	return check && (sitl_dataflash_stats.busy_violations > 0 || uart1_rx_overruns > 0) ? 2 : 0;
+}
+
+
+void vApplicationStackOverflowHook( xTaskHandle *pxTask, signed portCHAR *pcTaskName )
+{
+	fprintf(stderr, "\n\rStack overflow! %s\n\r", (char*)pcTaskName);
+	abort();
+}
+
+
+/*!
+ *   Simulates one millisecond: the world, the uarts and the FreeRTOS tick.
+ *   The idle task only runs when all other tasks are blocked, which is the
+ *   moment the real processor would wait for the next (tick) interrupt.
+ */
+void vApplicationIdleHook( void )
+{
+	idle_counter++;
+
+	if (trace != NULL && sitl_time_ms % 100 == 0)
+		sitl_trace();
+
+	sitl_time_ms++;
+	sitl_world_update(0.001f);
+	sitl_metrics_update(0.001f);
+	sitl_gps_tick();
+	sitl_uart1_tick();
+
+	vTaskIncrementTick();
+
+	if (realtime_factor > 0.0f)
+		sitl_pace();
+
+	if (sitl_time_ms >= duration_ms)
+		vTaskEndScheduler();
+
+	portYIELD();
+}
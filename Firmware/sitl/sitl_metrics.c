@@ -0,0 +1,122 @@
+/*!
+ *  Flight quality metrics of a SITL run, used to compare controller gains.
+ *
+ *  At the control loop rate (50Hz) and only while flying, the "true" state
+ *  of the flight model is compared with what the controllers want:
+ *   - tracking errors (RMS) of roll, pitch, heading and altitude
+ *   - servo activity: mean movement of the aileron, elevator and throttle in
+ *     microseconds per second. Lower means less wear and power.
+ *   - maximum roll angle and whether the aircraft hit the ground hard
+ *
+ *  @file     sitl_metrics.c
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include <stdio.h>
+#include <math.h>
+
+#include "configuration.h"
+#include "task_control.h"
+#include "handler_navigation.h"
+#include "common.h"
+#include "sitl.h"
+
+#define SAMPLE_PERIOD_S   0.02f
+#define CRASH_SPEED_MS    2.0f    //!< Vertical speed above which a touchdown is a crash
+
+static float sample_time_s = 0.0f;
+static long samples = 0;
+
+static double sum_roll2, sum_pitch2, sum_heading2, sum_altitude2;
+static double sum_aileron, sum_elevator, sum_throttle;
+static float last_aileron, last_elevator, last_throttle;
+static float max_roll;
+static int was_on_ground = 1;
+static int crashed = 0;
+
+
+/*!
+ *   Altitude error in the reference used by control_wing_navigate()
+ */
+static float altitude_error()
+{
+	if (config.control.altitude_mode == GPS_ABSOLUTE)
+		return navigation_data.desired_altitude_agl - sitl_world.height_m;
+	else if (config.control.altitude_mode == GPS_RELATIVE)
+		return navigation_data.desired_altitude_agl + navigation_data.home_gps_height - sitl_world.height_m;
+	else
+		return navigation_data.desired_altitude_agl + navigation_data.home_pressure_height - sitl_world.height_m;
+}
+
+
+static float wrap_pi(float angle)
+{
+	while (angle > PI)
+		angle -= 2.0f * PI;
+	while (angle < -PI)
+		angle += 2.0f * PI;
+	return angle;
+}
+
+
+/*!
+ *   Called every simulation step.
+ */
+void sitl_metrics_update(float dt)
+{
+	float e;
+
+	if (sitl_aircraft.on_ground && ! was_on_ground && sitl_aircraft.touchdown_speed_ms > CRASH_SPEED_MS)
+		crashed = 1;
+	was_on_ground = sitl_aircraft.on_ground;
+
+	sample_time_s += dt;
+	if (sample_time_s < SAMPLE_PERIOD_S)
+		return;
+	sample_time_s -= SAMPLE_PERIOD_S;
+
+	if (sitl_aircraft.on_ground)
+		return;
+
+	e = control_state.desired_roll - sitl_aircraft.roll;
+	sum_roll2 += e * e;
+	e = control_state.desired_pitch - sitl_aircraft.pitch;
+	sum_pitch2 += e * e;
+	e = wrap_pi(navigation_data.desired_heading_rad - sitl_world.heading_rad);
+	sum_heading2 += e * e;
+	e = altitude_error();
+	sum_altitude2 += e * e;
+
+	if (samples > 0)
+	{
+		sum_aileron += fabsf(sitl_aircraft.aileron - last_aileron);
+		sum_elevator += fabsf(sitl_aircraft.elevator - last_elevator);
+		sum_throttle += fabsf(sitl_aircraft.throttle - last_throttle);
+	}
+	last_aileron = sitl_aircraft.aileron;
+	last_elevator = sitl_aircraft.elevator;
+	last_throttle = sitl_aircraft.throttle;
+
+	max_roll = MAX(max_roll, fabsf(sitl_aircraft.roll));
+	samples++;
+}
+
+
+/*!
+ *   Writes the metrics as a header and one line of ';'-separated values.
+ */
+void sitl_metrics_write(FILE *f)
+{
+	double n = samples > 0 ? (double)samples : 1.0;
+	double flying_s = samples * SAMPLE_PERIOD_S;
+
+	fprintf(f, "rms_roll_deg;rms_pitch_deg;rms_heading_deg;rms_altitude_m;"
+	           "aileron_us_s;elevator_us_s;throttle_us_s;max_roll_deg;flying_s;crashed\n");
+	fprintf(f, "%.3f;%.3f;%.3f;%.3f;%.1f;%.1f;%.1f;%.1f;%.1f;%d\n",
+	        RAD2DEG(sqrt(sum_roll2 / n)), RAD2DEG(sqrt(sum_pitch2 / n)), RAD2DEG(sqrt(sum_heading2 / n)), sqrt(sum_altitude2 / n),
+	        flying_s > 0.0 ? sum_aileron * 500.0 / flying_s : 0.0,
+	        flying_s > 0.0 ? sum_elevator * 500.0 / flying_s : 0.0,
+	        flying_s > 0.0 ? sum_throttle * 1000.0 / flying_s : 0.0,
+	        RAD2DEG(max_roll), flying_s, crashed);
+}
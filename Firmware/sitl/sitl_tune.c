@@ -0,0 +1,431 @@
+/*!
+ *  Monte-Carlo PID tuning with the SITL build.
+ *
+ *  Flies a flight plan with every combination of the gains in a grid file,
+ *  several times per combination with random wind, turbulence, sensor noise
+ *  and GPS outages, and reports the flight quality metrics (sitl_metrics.c)
+ *  per gain set. Run i of every gain set uses the same random seed, so all
+ *  gain sets are compared in the same conditions.
+ *
+ *  The firmware keeps its state in globals, so each run is a separate sitl
+ *  process. A pool of threads (one per core by default) keeps the processes
+ *  going.
+ *
+ *  Usage: sitl_tune [-j jobs] [-n runs] [-t seconds] [-s seed] [-w max-wind] [-e noise]
+ *                   [-g interval,duration] [-i flightplan.txt] [-x sitl] grid.txt > results.csv
+ *
+ *  The grid file has one line per PID to sweep, the other PIDs keep the
+ *  default configuration:
+ *
+ *      # PID  p-gains       i-gains   d-gains  [i_min i_max d_term_min_var]
+ *      PR     0.3,0.5,0.7   0         0
+ *      PP     0.5:1.0:0.25  0,0.05    0
+ *      PH     0.7           0         0
+ *      PA     0.02,0.03     0         0
+ *
+ *  PR = pid_roll2aileron, PP = pid_pitch2elevator, PH = pid_heading2roll and
+ *  PA = pid_altitude2pitch: the names of the commands that set them. A list is
+ *  either comma separated values or from:to:step.
+ *
+ *  @file     sitl_tune.c
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/wait.h>
+
+#define MAX_VALUES   32
+#define NUM_PIDS     4
+#define NUM_METRICS  10
+
+enum Metric { RMS_ROLL, RMS_PITCH, RMS_HEADING, RMS_ALTITUDE, AILERON_ACTIVITY, ELEVATOR_ACTIVITY,
+              THROTTLE_ACTIVITY, MAX_ROLL, FLYING_S, CRASHED };
+
+static const char *pid_names[NUM_PIDS] = { "PR", "PP", "PH", "PA" };
+
+//! The values to try for one PID
+struct PidGrid
+{
+	int values[3];                 //!< Number of p, i and d gains
+	float gain[3][MAX_VALUES];
+	float i_min, i_max, d_term_min_var;
+	int sweep;                     //!< 0: keep the configured PID
+};
+
+struct PidGains
+{
+	float p, i, d;
+};
+
+static struct PidGrid grid[NUM_PIDS];
+static int gain_sets = 1;
+
+static int runs = 10;
+static float duration_s = 120.0f;
+static unsigned long seed = 1;
+static float max_wind_ms = 6.0f;
+static float noise = 1.0f;
+static float gps_dropout_interval_s = 120.0f, gps_dropout_duration_s = 5.0f;
+static const char *sitl = "build/sitl";
+static char *flightplan = NULL;
+
+static const char default_flightplan[] =
+	"WN;1;4;300;0;50;0\n"
+	"WN;2;4;300;300;70;0\n"
+	"WN;3;4;0;300;50;0\n"
+	"WN;4;4;0;0;70;0\n"
+	"WN;5;6;0;0;0;0\n";
+
+static double (*results)[NUM_METRICS];   //!< Per job
+static int next_job = 0;
+static int jobs_done = 0;
+static pthread_mutex_t job_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+
+static void usage()
+{
+	fprintf(stderr, "Usage: sitl_tune [-j jobs] [-n runs] [-t seconds] [-s seed] [-w max-wind] [-e noise]\n"
+	                "                 [-g interval,duration] [-i flightplan.txt] [-x sitl] grid.txt > results.csv\n");
+	exit(1);
+}
+
+
+/*!
+ *   Parses "0.1,0.2,0.3" or "0.1:0.3:0.1".
+ *   @return The number of values
+ */
+static int parse_values(const char *str, float *values)
+{
+	float from, to, step;
+	int n = 0;
+
+	if (sscanf(str, "%f:%f:%f", &from, &to, &step) == 3 && strchr(str, ':') != NULL)
+	{
+		if (step <= 0.0f)
+			return 0;
+		for (; from <= to + step * 0.001f && n < MAX_VALUES; from += step)
+			values[n++] = from;
+		return n;
+	}
+
+	while (*str != '\0' && n < MAX_VALUES)
+	{
+		values[n++] = atof(str);
+		str = strchr(str, ',');
+		if (str == NULL)
+			break;
+		str++;
+	}
+	return n;
+}
+
+
+static void read_grid(const char *filename)
+{
+	char line[256], name[8], lists[3][128];
+	FILE *f = fopen(filename, "r");
+	int i, j;
+
+	if (f == NULL)
+	{
+		perror(filename);
+		exit(1);
+	}
+
+	for (i = 0; i < NUM_PIDS; i++)
+	{
+		grid[i].sweep = 0;
+		grid[i].i_min = -1.0f;
+		grid[i].i_max = 1.0f;
+		grid[i].d_term_min_var = 0.0f;
+	}
+
+	while (fgets(line, sizeof(line), f) != NULL)
+	{
+		struct PidGrid *pid = NULL;
+
+		if (line[0] == '#' || sscanf(line, "%7s %127s %127s %127s", name, lists[0], lists[1], lists[2]) != 4)
+			continue;
+		for (i = 0; i < NUM_PIDS; i++)
+			if (strcmp(name, pid_names[i]) == 0)
+				pid = &grid[i];
+		if (pid == NULL)
+		{
+			fprintf(stderr, "%s: unknown PID %s\n", filename, name);
+			exit(1);
+		}
+
+		sscanf(line, "%*s %*s %*s %*s %f %f %f", &pid->i_min, &pid->i_max, &pid->d_term_min_var);
+		for (j = 0; j < 3; j++)
+		{
+			pid->values[j] = parse_values(lists[j], pid->gain[j]);
+			if (pid->values[j] == 0)
+			{
+				fprintf(stderr, "%s: invalid gains %s\n", filename, lists[j]);
+				exit(1);
+			}
+		}
+		pid->sweep = 1;
+	}
+	fclose(f);
+
+	for (i = 0; i < NUM_PIDS; i++)
+		if (grid[i].sweep)
+			gain_sets *= grid[i].values[0] * grid[i].values[1] * grid[i].values[2];
+}
+
+
+/*!
+ *   Finds the gains of gain set number n: the grid is enumerated like a
+ *   number with one digit per gain, the last gain changing fastest.
+ */
+static void gain_set(int n, struct PidGains gains[NUM_PIDS])
+{
+	int i;
+
+	for (i = NUM_PIDS - 1; i >= 0; i--)
+	{
+		if (! grid[i].sweep)
+			continue;
+		gains[i].d = grid[i].gain[2][n % grid[i].values[2]];
+		n /= grid[i].values[2];
+		gains[i].i = grid[i].gain[1][n % grid[i].values[1]];
+		n /= grid[i].values[1];
+		gains[i].p = grid[i].gain[0][n % grid[i].values[0]];
+		n /= grid[i].values[0];
+	}
+}
+
+
+/*!
+ *   Flies one run: gain set (job / runs), environment (job % runs).
+ *   @return 0 when the metrics were read
+ */
+static int fly(int job, double metrics[NUM_METRICS])
+{
+	struct PidGains gains[NUM_PIDS];
+	char input_name[] = "/tmp/sitl_tune_input_XXXXXX";
+	char metrics_name[] = "/tmp/sitl_tune_metrics_XXXXXX";
+	char duration[16], seed_str[16], wind[48], noise_str[16], gps[32], line[256];
+	unsigned long run_seed = seed + job % runs;
+	int input_fd, metrics_fd, status, i;
+	FILE *f;
+	pid_t child;
+
+	// The environment of this run, the same for every gain set
+	srand((unsigned int)run_seed);
+	snprintf(wind, sizeof(wind), "%.2f,%.0f,%.2f", max_wind_ms * rand() / (float)RAND_MAX, 360.0f * rand() / (float)RAND_MAX,
+	         0.2f * max_wind_ms * rand() / (float)RAND_MAX);
+	snprintf(duration, sizeof(duration), "%.1f", duration_s);
+	snprintf(seed_str, sizeof(seed_str), "%lu", run_seed);
+	snprintf(noise_str, sizeof(noise_str), "%.2f", noise);
+	snprintf(gps, sizeof(gps), "%.1f,%.1f", gps_dropout_interval_s, gps_dropout_duration_s);
+
+	input_fd = mkstemp(input_name);
+	metrics_fd = mkstemp(metrics_name);
+	if (input_fd < 0 || metrics_fd < 0)
+	{
+		perror("mkstemp");
+		exit(1);
+	}
+	close(metrics_fd);
+
+	gain_set(job / runs, gains);
+	f = fdopen(input_fd, "w");
+	for (i = 0; i < NUM_PIDS; i++)
+		if (grid[i].sweep)
+			fprintf(f, "%s;%f;%f;%f;%f;%f;%f\n", pid_names[i], gains[i].p, gains[i].i, gains[i].d,
+			        grid[i].i_min, grid[i].i_max, grid[i].d_term_min_var);
+	fputs(flightplan != NULL ? flightplan : default_flightplan, f);
+	fclose(f);
+
+	child = fork();
+	if (child == 0)
+	{
+		freopen("/dev/null", "w", stdout);
+		freopen("/dev/null", "w", stderr);
+		execl(sitl, sitl, "-t", duration, "-i", input_name, "-l", "40,14,0", "-w", wind, "-e", noise_str,
+		      "-g", gps, "-s", seed_str, "-m", metrics_name, (char*)NULL);
+		_exit(127);
+	}
+	waitpid(child, &status, 0);
+
+	status = -1;
+	f = fopen(metrics_name, "r");
+	if (f != NULL)
+	{
+		if (fgets(line, sizeof(line), f) != NULL && fgets(line, sizeof(line), f) != NULL &&
+		    sscanf(line, "%lf;%lf;%lf;%lf;%lf;%lf;%lf;%lf;%lf;%lf", &metrics[0], &metrics[1], &metrics[2], &metrics[3],
+		           &metrics[4], &metrics[5], &metrics[6], &metrics[7], &metrics[8], &metrics[9]) == NUM_METRICS)
+			status = 0;
+		fclose(f);
+	}
+	unlink(input_name);
+	unlink(metrics_name);
+	return status;
+}
+
+
+static void *worker(void *unused)
+{
+	int total = gain_sets * runs;
+
+	for (;;)
+	{
+		int job;
+
+		pthread_mutex_lock(&job_mutex);
+		job = next_job++;
+		pthread_mutex_unlock(&job_mutex);
+		if (job >= total)
+			return NULL;
+
+		if (fly(job, results[job]) != 0)
+		{
+			fprintf(stderr, "Run %d failed\n", job);
+			results[job][CRASHED] = -1.0;
+		}
+
+		pthread_mutex_lock(&job_mutex);
+		jobs_done++;
+		fprintf(stderr, "\r%d/%d runs", jobs_done, total);
+		pthread_mutex_unlock(&job_mutex);
+	}
+}
+
+
+static char *read_file(const char *filename)
+{
+	FILE *f = fopen(filename, "r");
+	long size;
+	char *contents;
+
+	if (f == NULL)
+	{
+		perror(filename);
+		exit(1);
+	}
+	fseek(f, 0, SEEK_END);
+	size = ftell(f);
+	rewind(f);
+	contents = calloc(size + 1, 1);
+	fread(contents, 1, size, f);
+	fclose(f);
+	return contents;
+}
+
+
+/*!
+ *   Lower is better. Tracking errors count in degrees and meters, servo
+ *   activity a little, a crash or failed run disqualifies the gain set.
+ */
+static double cost(const double *m)
+{
+	if (m[CRASHED] != 0.0)
+		return 1e9;
+	return m[RMS_ROLL] + m[RMS_PITCH] + 0.5 * m[RMS_HEADING] + m[RMS_ALTITUDE] + 0.01 * (m[AILERON_ACTIVITY] + m[ELEVATOR_ACTIVITY]);
+}
+
+
+int main(int argc, char *argv[])
+{
+	pthread_t *threads;
+	int threads_count = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	int c, i, j, k, best = 0;
+	double best_cost = 1e10;
+
+	while ((c = getopt(argc, argv, "j:n:t:s:w:e:g:i:x:")) != -1)
+	{
+		switch (c)
+		{
+			case 'j': threads_count = atoi(optarg); break;
+			case 'n': runs = atoi(optarg); break;
+			case 't': duration_s = atof(optarg); break;
+			case 's': seed = strtoul(optarg, NULL, 10); break;
+			case 'w': max_wind_ms = atof(optarg); break;
+			case 'e': noise = atof(optarg); break;
+			case 'g':
+				if (sscanf(optarg, "%f,%f", &gps_dropout_interval_s, &gps_dropout_duration_s) != 2)
+					usage();
+				break;
+			case 'i': flightplan = read_file(optarg); break;
+			case 'x': sitl = optarg; break;
+			default: usage();
+		}
+	}
+	if (optind != argc - 1 || runs < 1 || threads_count < 1)
+		usage();
+
+	read_grid(argv[optind]);
+	fprintf(stderr, "%d gain sets x %d runs of %.0fs on %d threads\n", gain_sets, runs, duration_s, threads_count);
+
+	results = calloc((size_t)gain_sets * runs, sizeof(*results));
+	threads = calloc(threads_count, sizeof(pthread_t));
+	for (i = 0; i < threads_count; i++)
+		pthread_create(&threads[i], NULL, worker, NULL);
+	for (i = 0; i < threads_count; i++)
+		pthread_join(threads[i], NULL);
+	fprintf(stderr, "\n");
+
+	// One line per gain set: the gains, the mean of the metrics and the number of crashes
+	printf("set");
+	for (i = 0; i < NUM_PIDS; i++)
+		if (grid[i].sweep)
+			printf(";%s_p;%s_i;%s_d", pid_names[i], pid_names[i], pid_names[i]);
+	printf(";rms_roll_deg;rms_pitch_deg;rms_heading_deg;rms_altitude_m;aileron_us_s;elevator_us_s;throttle_us_s;"
+	       "max_roll_deg;flying_s;crashes;cost\n");
+
+	for (i = 0; i < gain_sets; i++)
+	{
+		struct PidGains gains[NUM_PIDS];
+		double mean[NUM_METRICS] = { 0.0 };
+		double max_roll = 0.0, set_cost;
+		int crashes = 0;
+
+		for (j = 0; j < runs; j++)
+		{
+			double *m = results[i * runs + j];
+			for (k = 0; k < NUM_METRICS; k++)
+				mean[k] += m[k] / runs;
+			max_roll = fmax(max_roll, m[MAX_ROLL]);
+			if (m[CRASHED] != 0.0)
+				crashes++;
+		}
+		mean[MAX_ROLL] = max_roll;
+		mean[CRASHED] = crashes;
+		set_cost = cost(mean);
+
+		gain_set(i, gains);
+		printf("%d", i);
+		for (k = 0; k < NUM_PIDS; k++)
+			if (grid[k].sweep)
+				printf(";%g;%g;%g", gains[k].p, gains[k].i, gains[k].d);
+		printf(";%.3f;%.3f;%.3f;%.3f;%.1f;%.1f;%.1f;%.1f;%.1f;%d;%.3f\n", mean[RMS_ROLL], mean[RMS_PITCH], mean[RMS_HEADING],
+		       mean[RMS_ALTITUDE], mean[AILERON_ACTIVITY], mean[ELEVATOR_ACTIVITY], mean[THROTTLE_ACTIVITY], mean[MAX_ROLL],
+		       mean[FLYING_S], crashes, set_cost);
+
+		if (set_cost < best_cost)
+		{
+			best_cost = set_cost;
+			best = i;
+		}
+	}
+
+	fprintf(stderr, "Best: set %d", best);
+	{
+		struct PidGains gains[NUM_PIDS];
+		gain_set(best, gains);
+		for (k = 0; k < NUM_PIDS; k++)
+			if (grid[k].sweep)
+				fprintf(stderr, ", %s %g/%g/%g", pid_names[k], gains[k].p, gains[k].i, gains[k].d);
+	}
+	fprintf(stderr, " (cost %.3f)\n", best_cost);
+
+	return 0;
+}
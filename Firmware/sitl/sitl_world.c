@@ -0,0 +1,117 @@
+/*!
+ *  The simulated world: the "true" state of the aircraft that is fed to the
+ *  stand-in sensor drivers.
+ *
+ *  The aircraft starts level on the ground at the start position with a valid
+ *  GPS lock. From then on its motion is calculated by the flight model in
+ *  sitl_aircraft.c.
+ *
+ *  Wind, sensor noise and GPS outages are random, but a run is reproducible:
+ *  everything is drawn from one generator seeded with sitl_random_seed().
+ *
+ *  @file     sitl_world.c
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include <math.h>
+
+#include "common.h"
+#include "sitl.h"
+
+struct SitlWorld sitl_world;
+
+static unsigned long random_state = 1;
+static float gps_dropout_left_s = 0.0f;
+
+
+void sitl_random_seed(unsigned long seed)
+{
+	random_state = seed * 2654435761ul + 1;
+}
+
+
+/*!
+ *   @return Uniformly distributed number in [0..1[
+ */
+float sitl_random_uniform()
+{
+	// Numerical Recipes' 32 bit linear congruential generator
+	random_state = (random_state * 1664525ul + 1013904223ul) & 0xFFFFFFFFul;
+	return (float)(random_state >> 8) / 16777216.0f;
+}
+
+
+/*!
+ *   @return Normally distributed number, zero mean and unit variance
+ */
+float sitl_random_gauss()
+{
+	float u1 = sitl_random_uniform(), u2 = sitl_random_uniform();
+
+	return sqrtf(-2.0f * logf(1.0f - u1)) * cosf(2.0f * (float)PI * u2);
+}
+
+
+/*!
+ *   Places the aircraft on the ground at the given position.
+ */
+void sitl_world_init(double latitude_deg, double longitude_deg, float height_m)
+{
+	sitl_world.latitude_rad = DEG2RAD(latitude_deg);
+	sitl_world.longitude_rad = DEG2RAD(longitude_deg);
+	sitl_world.height_m = height_m;
+	sitl_world.speed_ms = 0.0f;
+	sitl_world.heading_rad = 0.0f;
+
+	sitl_world.p = 0.0f;
+	sitl_world.q = 0.0f;
+	sitl_world.r = 0.0f;
+	sitl_world.acc_x_g = 0.0f;
+	sitl_world.acc_y_g = 0.0f;
+	sitl_world.acc_z_g = -1.0f;
+
+	sitl_world.temperature_c = 20.0f;
+	sitl_world.gps_fix = 1;
+	sitl_world.satellites_in_view = 9;
+
+	sitl_world.wind_north_ms = 0.0f;
+	sitl_world.wind_east_ms = 0.0f;
+	sitl_world.gust_ms = 0.0f;
+	sitl_world.sensor_noise = 0.0f;
+	sitl_world.gps_dropout_interval_s = 0.0f;
+	sitl_world.gps_dropout_duration_s = 0.0f;
+
+	sitl_aircraft_init();
+	sitl_world_update(0.0f);
+}
+
+
+/*!
+ *   Advances the world by dt seconds.
+ */
+void sitl_world_update(float dt)
+{
+	if (dt > 0.0f)
+		sitl_aircraft_update(dt);
+
+	// GPS outages: start at random, last gps_dropout_duration_s on average
+	if (gps_dropout_left_s > 0.0f)
+	{
+		gps_dropout_left_s -= dt;
+		if (gps_dropout_left_s <= 0.0f)
+		{
+			sitl_world.gps_fix = 1;
+			sitl_world.satellites_in_view = 9;
+		}
+	}
+	else if (sitl_world.gps_dropout_interval_s > 0.0f && sitl_random_uniform() < dt / sitl_world.gps_dropout_interval_s)
+	{
+		gps_dropout_left_s = sitl_world.gps_dropout_duration_s * (0.5f + sitl_random_uniform());
+		sitl_world.gps_fix = 0;
+		sitl_world.satellites_in_view = 0;
+	}
+
+	// Inverse of scp1000_pressure_to_height(), so the barometric height matches the true height
+	sitl_world.pressure_pa = 101000.0f * expf(-sitl_world.height_m * 9.81f / (287.05f * (273.0f + 20.0f)));
+}
@@ -0,0 +1,220 @@
+/*!
+ *  Converts the binary telemetry of a uart1 capture back to CSV lines.
+ *
+ *  A capture made after the TB command (sitl's stdout, or a terminal log of
+ *  the radio link) holds binary frames (see communication.h) between text
+ *  lines. Every frame is printed as the line the CSV telemetry would have
+ *  sent, without "$" and checksum, and the text lines are copied, so the
+ *  output can be fed to the same converters as a CSV capture.
+ *
+ *  Usage: telemetry_decode [-q] [file]
+ *
+ *   -q  Only print the statistics
+ *
+ *  Reads stdin without a file. The number of frames of every type, the bad
+ *  frames (crc or header) and the frames lost (gaps in the sequence numbers)
+ *  go to stderr. The exit status is 1 when there were bad frames.
+ *
+ *  @file     telemetry_decode.c
+ *  @date     18-oct-2026
+ *  @since    0.9
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "crc16/crc16.h"
+
+#include "communication.h"
+
+#define MAX_PAYLOAD 255
+
+static int quiet = 0;
+static long frames[256];
+static long crc_errors = 0, lost = 0, bytes = 0;
+
+
+static void usage()
+{
+	fprintf(stderr, "Usage: telemetry_decode [-q] [file]\n");
+	exit(2);
+}
+
+
+static unsigned int u16(const unsigned char *p)
+{
+	return p[0] | (p[1] << 8);
+}
+
+
+static int s16(const unsigned char *p)
+{
+	return (short)u16(p);
+}
+
+
+static unsigned long u32(const unsigned char *p)
+{
+	return u16(p) | ((unsigned long)u16(p + 2) << 16);
+}
+
+
+static float f32(const unsigned char *p)
+{
+	union { float f; unsigned int l; } bits;
+
+	bits.l = (unsigned int)u32(p);
+	return bits.f;
+}
+
+
+static int payload_size(int type)
+{
+	switch (type)
+	{
+		case 'R': return TELEMETRY_SIZE_R;
+		case 'P': return TELEMETRY_SIZE_P;
+		case 'A': return TELEMETRY_SIZE_A;
+		case 'S': return TELEMETRY_SIZE_S;
+		case 'H': return TELEMETRY_SIZE_H;
+		case 'T': return TELEMETRY_SIZE_T;
+		case 'G': return TELEMETRY_SIZE_G;
+		case 'C': return TELEMETRY_SIZE_C;
+		default:  return -1;
+	}
+}
+
+
+/*!
+ *   Prints a frame with a valid crc as its CSV line.
+ */
+static void print_frame(int type, const unsigned char *p)
+{
+	if (quiet)
+		return;
+	switch (type)
+	{
+		case 'R':
+			printf("TR;%u;%u;%u;%u;%u;%u\n", u16(p), u16(p + 2), u16(p + 4), u16(p + 6), u16(p + 8), u16(p + 10));
+			break;
+		case 'P':
+			printf("TP;%d;%d;%d;%d;%d;%d\n", s16(p), s16(p + 2), s16(p + 4), s16(p + 6), s16(p + 8), s16(p + 10));
+			break;
+		case 'A':
+			printf("TA;%d;%d;%d\n", s16(p), s16(p + 2), s16(p + 4));
+			break;
+		case 'S':
+			printf("TS;%u;%u;%u\n", u16(p), u16(p + 2), u16(p + 4));
+			break;
+		case 'H':
+			printf("TH;%lu;%d\n", u32(p), s16(p + 4));
+			break;
+		case 'T':
+			printf("TT;%u;%u;%u;%u;%u;%u;%u;%u\n", u16(p), u16(p + 2), u16(p + 4), u16(p + 6),
+			       u16(p + 8), u16(p + 10), u16(p + 12), u16(p + 14));
+			break;
+		case 'G':
+			printf("TG;%c;%.9f;%.9f;%u;%u;%u;%d\n", '0' + p[0], f32(p + 1), f32(p + 5),
+			       u16(p + 9), u16(p + 11), p[13], s16(p + 14));
+			break;
+		case 'C':
+			printf("TC;%d;%d;%d;%u;%u;%u;%d;%d;%d;%u;%u\n", p[0], s16(p + 1), s16(p + 3), u16(p + 5),
+			       u16(p + 7), u16(p + 9), p[11], p[12], s16(p + 13), u16(p + 15), u16(p + 17));
+			break;
+	}
+}
+
+
+/*!
+ *   Reads the rest of a frame after its sync bytes. A frame with an unknown
+ *   type or a wrong length is counted as bad, the search for the next frame
+ *   continues after its header.
+ */
+static void read_frame(FILE *f)
+{
+	static int last_sequence = -1;
+	unsigned char frame[TELEMETRY_FRAME_SIZE(MAX_PAYLOAD)];
+	int length, size;
+
+	frame[0] = TELEMETRY_FRAME_SYNC1;
+	frame[1] = TELEMETRY_FRAME_SYNC2;
+	if (fread(&frame[2], 1, 3, f) != 3)
+		return;
+	length = frame[4];
+	size = payload_size(frame[2]);
+	if (size < 0 || size != length)
+	{
+		crc_errors++;   // a frame with a damaged header: resynchronize after it
+		return;
+	}
+	if (fread(&frame[TELEMETRY_FRAME_HEADER], 1, length + 2, f) != (size_t)(length + 2))
+		return;
+	bytes += TELEMETRY_FRAME_SIZE(length);
+
+	if (crc16_update(CRC16_INIT, &frame[2], 3 + length) != u16(&frame[TELEMETRY_FRAME_HEADER + length]))
+	{
+		crc_errors++;
+		return;
+	}
+	if (last_sequence >= 0)
+		lost += (frame[3] - last_sequence - 1) & 0xFF;
+	last_sequence = frame[3];
+	frames[frame[2]]++;
+	print_frame(frame[2], &frame[TELEMETRY_FRAME_HEADER]);
+}
+
+
+int main(int argc, char *argv[])
+{
+	FILE *f = stdin;
+	int c, type, at_line_start = 1;
+
+	while ((c = getopt(argc, argv, "q")) != -1)
+	{
+		switch (c)
+		{
+			case 'q': quiet = 1; break;
+			default: usage();
+		}
+	}
+	if (optind < argc - 1)
+		usage();
+	if (optind == argc - 1 && (f = fopen(argv[optind], "rb")) == NULL)
+	{
+		fprintf(stderr, "%s: can't read the capture\n", argv[optind]);
+		return 1;
+	}
+
+	while ((c = getc(f)) != EOF)
+	{
+		if (c == TELEMETRY_FRAME_SYNC1)
+		{
+			if ((c = getc(f)) == TELEMETRY_FRAME_SYNC2)
+			{
+				if (! at_line_start && ! quiet)
+					putchar('\n');   // a frame in the middle of a text line
+				at_line_start = 1;
+				read_frame(f);
+				continue;
+			}
+			ungetc(c, f);
+			continue;
+		}
+		if (c == '\r')
+			continue;
+		if (! quiet)
+			putchar(c);
+		at_line_start = c == '\n';
+	}
+	if (f != stdin)
+		fclose(f);
+	fflush(stdout);
+
+	for (type = 0; type < 256; type++)
+		if (frames[type] > 0)
+			fprintf(stderr, "T%c: %ld frames\n", type, frames[type]);
+	fprintf(stderr, "%ld bytes of frames, %ld bad frames, %ld frames lost\n", bytes, crc_errors, lost);
+	return crc_errors > 0;
+}
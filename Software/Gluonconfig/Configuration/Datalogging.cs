@@ -45,6 +45,7 @@ namespace Configuration
             {
                 serial.DatalogTableCommunicationReceived -= new SerialCommunication.ReceiveDatalogTableCommunicationFrame(ReceiveDatalogTable);
                 serial.DatalogLineCommunicationReceived -= new SerialCommunication.ReceiveDatalogLineCommunicationFrame(ReceiveDatalogLine);
+                serial.DatalogFormatCommunicationReceived -= new SerialCommunication.ReceiveDatalogFormatCommunicationFrame(ReceiveDatalogFormat);
             }
         }
 
@@ -58,6 +59,7 @@ namespace Configuration
 
             serial.DatalogTableCommunicationReceived += new SerialCommunication.ReceiveDatalogTableCommunicationFrame(ReceiveDatalogTable);
             serial.DatalogLineCommunicationReceived += new SerialCommunication.ReceiveDatalogLineCommunicationFrame(ReceiveDatalogLine);
+            serial.DatalogFormatCommunicationReceived += new SerialCommunication.ReceiveDatalogFormatCommunicationFrame(ReceiveDatalogFormat);
         }
 
         public void Disconnect()
@@ -68,6 +70,7 @@ namespace Configuration
 
             serial.DatalogTableCommunicationReceived -= new SerialCommunication.ReceiveDatalogTableCommunicationFrame(ReceiveDatalogTable);
             serial.DatalogLineCommunicationReceived -= new SerialCommunication.ReceiveDatalogLineCommunicationFrame(ReceiveDatalogLine);
+            serial.DatalogFormatCommunicationReceived -= new SerialCommunication.ReceiveDatalogFormatCommunicationFrame(ReceiveDatalogFormat);
         }
 
         private void _btn_read_Click(object sender, EventArgs e)
@@ -165,6 +168,18 @@ namespace Configuration
 
         }
 
+        void ReceiveDatalogFormat(int percent)
+        {
+            this.BeginInvoke(new Action<int>(DatalogFormat), new object[] { percent });
+        }
+        private void DatalogFormat(int percent)
+        {
+            _pb.Value = Math.Max(0, Math.Min(100, percent));
+            _btn_format.Enabled = percent >= 100;
+            if (percent >= 100)
+                serial.SendDatalogTableRequest();   // the table is empty now
+        }
+
         private void _btn_format_Click(object sender, EventArgs e)
         {
             if (MessageBox.Show(this, "Are you sure you want to erase all loggings?", "Please confirm", MessageBoxButtons.YesNo, MessageBoxIcon.Exclamation) == DialogResult.Yes)
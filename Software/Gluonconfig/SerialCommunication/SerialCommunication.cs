@@ -34,6 +34,7 @@ namespace Communication
         public delegate void ReceiveAttitudeCommunicationFrame(Attitude attitude);
         public delegate void ReceiveDatalogTableCommunicationFrame(DatalogTable table);
         public delegate void ReceiveDatalogLineCommunicationFrame(DatalogLine line);
+        public delegate void ReceiveDatalogFormatCommunicationFrame(int percent);
         public delegate void ReceiveNavigationInstructionCommunicationFrame(NavigationInstruction ni);
         public delegate void ReceiveControlInfoCommunicationFrame(ControlInfo ci);
         public delegate void ReceiveServosCommunicationFrame(Servos s);
@@ -62,6 +63,7 @@ namespace Communication
         // Datalog
         public abstract event ReceiveDatalogTableCommunicationFrame DatalogTableCommunicationReceived;
         public abstract event ReceiveDatalogLineCommunicationFrame DatalogLineCommunicationReceived;
+        public abstract event ReceiveDatalogFormatCommunicationFrame DatalogFormatCommunicationReceived;
         // Navigation
         public abstract event ReceiveNavigationInstructionCommunicationFrame NavigationInstructionCommunicationReceived;
         // ControlInfo
@@ -101,6 +103,7 @@ namespace Communication
 
         public abstract void Close();
 
+        public abstract void SendBinaryTelemetry(bool enable);
         public abstract void SendTelemetry(int basicgps, int gyroaccraw, int gyroaccproc, int ppm, int pressuretemp, int attitude, int control);
 
         public abstract void SendServoReverse(bool a, bool b, bool c, bool d, bool e, bool f, bool manual_trim);
@@ -54,6 +54,15 @@ namespace Communication
         private int FramesReceived = 0;
         private bool CommunicationAlive = false;
         private DateTime LastValidFrame;
+
+        // Binary telemetry (TB command): asked for when CSV telemetry arrives,
+        // until the gluonpilot confirms it. Old firmware never does.
+        public bool RequestBinaryTelemetry = true;
+        private TelemetryBinary binary = new TelemetryBinary();
+        private StringBuilder rx_line = new StringBuilder();
+        private bool last_was_frame = false;
+        private int binary_requests = 0;
+        private DateTime last_binary_request = DateTime.MinValue;
         //private Timer CheckCommunicationReceived = new Timer();
 
         // General: all lines received will be broadcasted by this event
@@ -75,6 +84,7 @@ namespace Communication
         // Datalog
         public override event ReceiveDatalogTableCommunicationFrame DatalogTableCommunicationReceived;
         public override event ReceiveDatalogLineCommunicationFrame DatalogLineCommunicationReceived;
+        public override event ReceiveDatalogFormatCommunicationFrame DatalogFormatCommunicationReceived;
         // Navigation
         public override event ReceiveNavigationInstructionCommunicationFrame NavigationInstructionCommunicationReceived;
         // ControlInfo
@@ -129,6 +139,16 @@ namespace Communication
             //_serialPort.Dispose();
         }
 
+        public int BinaryFramesLost
+        {
+            get { return binary.FramesLost; }
+        }
+
+        public int BinaryFramesBad
+        {
+            get { return binary.BadFrames; }
+        }
+
         public double ThroughputKbS()
         {
             double s;
@@ -217,7 +237,7 @@ namespace Communication
                         //Console.WriteLine("Waiting for communication...");
                     }
 
-                    line = _serialPort.ReadLine().Replace("\r", "").Replace("\n", "");
+                    line = ReadLineOrFrame().Replace("\r", "").Replace("\n", "");
                     if (line.Length < 3)
                         continue;
 
@@ -235,13 +255,11 @@ namespace Communication
                     if (logfile != null)
                         logfile.WriteLine("[" + DateTime.Now.ToString("MM/dd/yyyy HH:mm:ss.fff", CultureInfo.InvariantCulture) + "] " + line);
 
-                    lock (this)
-                    {
-                        bytes_read += line.Length + 1;
-                    }
-
                     line = line.Replace("\r", "");
 
+                    if (!last_was_frame)
+                        NegotiateBinaryTelemetry(line);
+
                     string[] lines = line.Split(';');
                     //Console.WriteLine(line + "\n\r");
                     // TR: Gyro & Acc raw
@@ -470,6 +488,12 @@ namespace Communication
                         if (AttitudeCommunicationReceived != null)
                             AttitudeCommunicationReceived(att);
                     }
+                    // DF: Datalog format progress (%)
+                    else if (lines[0].EndsWith("DF") && lines.Length >= 2)
+                    {
+                        if (DatalogFormatCommunicationReceived != null)
+                            DatalogFormatCommunicationReceived(int.Parse(lines[1]));
+                    }
                     // DT: Datalog table
                     else if (lines[0].EndsWith("DT") && lines.Length >= 4)
                     {
@@ -622,6 +646,99 @@ namespace Communication
         }
 
 
+        /*!
+         *    Reads the next text line or binary telemetry frame. A frame is
+         *    returned as the CSV line it replaces (see TelemetryBinary).
+         */
+        private string ReadLineOrFrame()
+        {
+            for (; ; )
+            {
+                int b = ReadCountedByte();
+                if (b == TelemetryBinary.Sync1)
+                {
+                    b = ReadCountedByte();
+                    if (b == TelemetryBinary.Sync2)
+                    {
+                        string frame = ReadFrame();
+                        if (frame != null)
+                        {
+                            last_was_frame = true;
+                            return frame;
+                        }
+                        continue;
+                    }
+                }
+                if (b == '\n')
+                {
+                    string l = rx_line.ToString();
+                    rx_line.Length = 0;
+                    last_was_frame = false;
+                    return l;
+                }
+                rx_line.Append((char)b);
+            }
+        }
+
+        private string ReadFrame()
+        {
+            byte[] frame = new byte[TelemetryBinary.Header];
+            ReadCountedBytes(frame, 0, TelemetryBinary.Header);
+            int length = TelemetryBinary.PayloadSize(frame[0]);
+            if (length != frame[2])
+                return binary.Decode(frame);  // counted as bad
+            Array.Resize(ref frame, TelemetryBinary.Header + length + 2);
+            ReadCountedBytes(frame, TelemetryBinary.Header, length + 2);
+            return binary.Decode(frame);
+        }
+
+        private int ReadCountedByte()
+        {
+            int b = _serialPort.ReadByte();
+            lock (this)
+            {
+                bytes_read++;
+            }
+            return b;
+        }
+
+        private void ReadCountedBytes(byte[] buffer, int offset, int count)
+        {
+            while (count > 0)
+            {
+                int n = _serialPort.Read(buffer, offset, count);
+                offset += n;
+                count -= n;
+                lock (this)
+                {
+                    bytes_read += n;
+                }
+            }
+        }
+
+        /*!
+         *    Asks for binary telemetry when CSV telemetry arrives: after
+         *    connecting and after a reboot of the gluonpilot. Gives up after 3
+         *    requests without an answer.
+         */
+        private void NegotiateBinaryTelemetry(string line)
+        {
+            if (line.StartsWith("TB;1"))
+                binary_requests = 0;
+            else if (RequestBinaryTelemetry && line.Length > 3 && line[0] == 'T' && "RPAHTGCS".IndexOf(line[1]) >= 0 &&
+                     line[2] == ';' && binary_requests < 3 && (DateTime.Now - last_binary_request).TotalSeconds > 2.0)
+            {
+                binary_requests++;
+                last_binary_request = DateTime.Now;
+                SendBinaryTelemetry(true);
+            }
+        }
+
+        public override void SendBinaryTelemetry(bool enable)
+        {
+            WriteChecksumLine("TB;" + (enable ? "1" : "0"));
+        }
+
         public override void SendTelemetry(int basicgps, int gyroaccraw, int gyroaccproc, int ppm, int pressuretemp, int attitude, int control)
         {
             // telemetry
@@ -79,6 +79,7 @@ namespace Communication
         // Datalog
         public override event ReceiveDatalogTableCommunicationFrame DatalogTableCommunicationReceived;
         public override event ReceiveDatalogLineCommunicationFrame DatalogLineCommunicationReceived;
+        public override event ReceiveDatalogFormatCommunicationFrame DatalogFormatCommunicationReceived;
         // Navigation
         public override event ReceiveNavigationInstructionCommunicationFrame NavigationInstructionCommunicationReceived;
         // ControlInfo
@@ -443,6 +444,12 @@ namespace Communication
                         if (AttitudeCommunicationReceived != null)
                             AttitudeCommunicationReceived(att);
                     }
+                    // DF: Datalog format progress (%)
+                    else if (lines[0].EndsWith("DF") && lines.Length >= 2)
+                    {
+                        if (DatalogFormatCommunicationReceived != null)
+                            DatalogFormatCommunicationReceived(int.Parse(lines[1]));
+                    }
                     // DT: Datalog table
                     else if (lines[0].EndsWith("DT") && lines.Length >= 4)
                     {
@@ -703,6 +710,10 @@ namespace Communication
         {
         }
 
+        public override void SendBinaryTelemetry(bool enable)
+        {
+        }
+
         public override void SetSimulationOn()
         {
         }
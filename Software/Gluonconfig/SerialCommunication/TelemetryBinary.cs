@@ -0,0 +1,133 @@
+﻿/*!
+ *   TelemetryBinary.cs
+ *   Decodes the binary telemetry frames of the gluonpilot (TB command, see
+ *   communication.h in the firmware) into the CSV lines they replace, so
+ *   they are parsed as the CSV telemetry.
+ *
+ *   Frame, little endian: [0xA5][0xC3][type][sequence][length][payload][crc16]
+ *
+ */
+
+using System;
+using System.Collections.Generic;
+using System.Text;
+using System.Globalization;
+
+namespace Communication
+{
+    public class TelemetryBinary
+    {
+        public const int Sync1 = 0xA5;
+        public const int Sync2 = 0xC3;
+        public const int Header = 3;      // type, sequence and length, after the sync bytes
+
+        private int last_sequence = -1;
+
+        public int FramesLost = 0;        // gaps in the sequence numbers
+        public int BadFrames = 0;         // wrong crc, type or length
+
+        /*!
+         *    The payload length of a frame type, -1 for an unknown type.
+         */
+        public static int PayloadSize(int type)
+        {
+            switch ((char)type)
+            {
+                case 'R': return 12;
+                case 'P': return 12;
+                case 'A': return 6;
+                case 'S': return 6;
+                case 'H': return 6;
+                case 'T': return 16;
+                case 'G': return 16;
+                case 'C': return 19;
+                default: return -1;
+            }
+        }
+
+        /*!
+         *    CRC-16/CCITT-FALSE, as lib/crc16 of the firmware.
+         */
+        public static int Crc16(byte[] data, int offset, int length)
+        {
+            int crc = 0xFFFF;
+            for (int i = offset; i < offset + length; i++)
+            {
+                crc ^= data[i] << 8;
+                for (int bit = 0; bit < 8; bit++)
+                    crc = (crc & 0x8000) != 0 ? ((crc << 1) ^ 0x1021) & 0xFFFF : (crc << 1) & 0xFFFF;
+            }
+            return crc;
+        }
+
+        private static int U16(byte[] b, int i)
+        {
+            return b[i] | (b[i + 1] << 8);
+        }
+
+        private static int S16(byte[] b, int i)
+        {
+            return (short)U16(b, i);
+        }
+
+        private static long U32(byte[] b, int i)
+        {
+            return (long)U16(b, i) | ((long)U16(b, i + 2) << 16);
+        }
+
+        private static double F32(byte[] b, int i)
+        {
+            byte[] f = new byte[] { b[i], b[i + 1], b[i + 2], b[i + 3] };
+            if (!BitConverter.IsLittleEndian)
+                Array.Reverse(f);
+            return BitConverter.ToSingle(f, 0);
+        }
+
+        /*!
+         *    Decodes a frame without its sync bytes: type, sequence, length,
+         *    payload and crc.
+         *    @return The CSV line, null when the frame is invalid.
+         */
+        public string Decode(byte[] frame)
+        {
+            int length = frame[2];
+            if (PayloadSize(frame[0]) != length || frame.Length < Header + length + 2 ||
+                Crc16(frame, 0, Header + length) != U16(frame, Header + length))
+            {
+                BadFrames++;
+                return null;
+            }
+            if (last_sequence >= 0)
+                FramesLost += (frame[1] - last_sequence - 1) & 0xFF;
+            last_sequence = frame[1];
+
+            byte[] p = new byte[length];
+            Array.Copy(frame, Header, p, 0, length);
+            switch ((char)frame[0])
+            {
+                case 'R':
+                    return "TR;" + U16(p, 0) + ";" + U16(p, 2) + ";" + U16(p, 4) + ";" + U16(p, 6) + ";" + U16(p, 8) + ";" + U16(p, 10);
+                case 'P':
+                    return "TP;" + S16(p, 0) + ";" + S16(p, 2) + ";" + S16(p, 4) + ";" + S16(p, 6) + ";" + S16(p, 8) + ";" + S16(p, 10);
+                case 'A':
+                    return "TA;" + S16(p, 0) + ";" + S16(p, 2) + ";" + S16(p, 4);
+                case 'S':
+                    return "TS;" + U16(p, 0) + ";" + U16(p, 2) + ";" + U16(p, 4);
+                case 'H':
+                    return "TH;" + U32(p, 0) + ";" + S16(p, 4);
+                case 'T':
+                    return "TT;" + U16(p, 0) + ";" + U16(p, 2) + ";" + U16(p, 4) + ";" + U16(p, 6) + ";" +
+                           U16(p, 8) + ";" + U16(p, 10) + ";" + U16(p, 12) + ";" + U16(p, 14);
+                case 'G':
+                    return "TG;" + p[0] + ";" +
+                           F32(p, 1).ToString("0.000000000", CultureInfo.InvariantCulture) + ";" +
+                           F32(p, 5).ToString("0.000000000", CultureInfo.InvariantCulture) + ";" +
+                           U16(p, 9) + ";" + U16(p, 11) + ";" + p[13] + ";" + S16(p, 14);
+                default: // 'C'
+                    return "TC;" + p[0] + ";" + S16(p, 1) + ";" + S16(p, 3) + ";" + U16(p, 5) + ";" +
+                           U16(p, 7) + ";" + U16(p, 9) + ";" + p[11] + ";" + p[12] + ";" +
+                           S16(p, 13) + ";" + U16(p, 15) + ";" + U16(p, 17);
+            }
+        }
+    }
+}